@@ -0,0 +1,177 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/mih-module.h"
+
+// A station wanders around the middle of two APs of the same ESS,
+// where both are about as strong, and lets a HandoverDecisionMihUser
+// choose its AP. It is run twice: once moving to any better AP at
+// once, and once with the default hysteresis margin, time to trigger
+// and dwell time, which suppress most ping-pong handovers.
+//
+//    AP0 ------------ AP1
+//          ~ n0 ~
+//
+// ./waf --run "handover-decision-example --apDistance=100 --stop=60"
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("HandoverDecisionExample");
+
+struct RunStats
+{
+  uint32_t handovers;
+  uint32_t pingPongs;
+  Time latency;
+};
+
+static RunStats g_stats;
+
+static void
+Decision (Address oldPoa, Address newPoa, Time latency)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s handover from " << oldPoa
+               << " to " << newPoa << " after " << latency.GetMilliSeconds () << " ms");
+  g_stats.handovers++;
+  g_stats.latency += latency;
+}
+
+static void
+PingPong (Address poa, uint32_t count)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s ping-pong back to " << poa);
+  g_stats.pingPongs = count;
+}
+
+static RunStats
+Run (bool hysteresis, double apDistance, double stop)
+{
+  g_stats = RunStats ();
+
+  NodeContainer staNode;
+  staNode.Create (1);
+  NodeContainer apNodes;
+  apNodes.Create (2);
+
+  WifiMihLinkSapHelper wifiMihLinkSapHelper;
+  Ptr<mih::WifiMihLinkSap> mihLinkSap = wifiMihLinkSapHelper.Install (staNode.Get (0));
+  // Associate only with the PoAs chosen by the MIH user;
+  mihLinkSap->SetAttribute ("AutonomousHandover", BooleanValue (false));
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+
+  WifiHelper wifi;
+  wifi.SetRemoteStationManager ("ns3::AarfWifiManager");
+
+  WifiMacHelper mac;
+  Ssid ssid = Ssid ("ns-3-ssid");
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+  NetDeviceContainer staDevices = wifi.Install (phy, mac, staNode);
+
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid));
+  wifi.Install (phy, mac, apNodes);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0, 0, 0));
+  positionAlloc->Add (Vector (apDistance, 0, 0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (apNodes);
+  positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (apDistance / 2, 0, 0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::RandomWalk2dMobilityModel",
+                             "Bounds", RectangleValue (Rectangle (apDistance / 2 - 30, apDistance / 2 + 30, -10, 10)),
+                             "Distance", DoubleValue (40),
+                             "Mode", StringValue ("Distance"),
+                             "Speed", StringValue ("ns3::ConstantRandomVariable[Constant=5.0]"));
+  mobility.Install (staNode);
+
+  // The link SAP is found by the station address before association;
+  mih::LinkIdentifier linkIdentifier (mih::LinkType (mih::LinkType::WIRELESS_802_11),
+                                      staDevices.Get (0)->GetAddress (),
+                                      Address ());
+  mihLinkSap->SetLinkIdentifier (linkIdentifier);
+  Ptr<mih::MihFunction> mihf = CreateObject<mih::MihFunction> ();
+  mihf->SetMihfId (mih::MihfId ("mn-mihf@sta"));
+  mihf->Register (mihLinkSap);
+
+  Ptr<mih::HandoverDecisionMihUser> user = CreateObject<mih::HandoverDecisionMihUser> ();
+  if (!hysteresis)
+    {
+      user->SetAttribute ("HysteresisMargin", DoubleValue (0));
+      user->SetAttribute ("TimeToTrigger", TimeValue (Seconds (0)));
+      user->SetAttribute ("MinDwellTime", TimeValue (Seconds (0)));
+    }
+  mihf->AggregateObject (user);
+  staNode.Get (0)->AddApplication (user);
+  user->AddLink (linkIdentifier);
+  user->TraceConnectWithoutContext ("Decision", MakeCallback (&Decision));
+  user->TraceConnectWithoutContext ("PingPong", MakeCallback (&PingPong));
+  user->SetStartTime (Seconds (1));
+
+  Simulator::Stop (Seconds (stop));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return g_stats;
+}
+
+static void
+Print (std::string name, const RunStats &stats)
+{
+  std::cout << name << std::endl;
+  std::cout << "  Handovers:         " << stats.handovers << std::endl;
+  std::cout << "  Ping-pongs:        " << stats.pingPongs << std::endl;
+  std::cout << "  Decision latency:  "
+            << (stats.handovers > 0 ? stats.latency.GetMilliSeconds () / stats.handovers : 0)
+            << " ms on average" << std::endl;
+}
+
+int 
+main (int argc, char *argv[])
+{
+  bool verbose = false;
+  double apDistance = 100;
+  double stop = 60;
+
+  CommandLine cmd;
+  cmd.AddValue ("verbose", "Log the handover decisions", verbose);
+  cmd.AddValue ("apDistance", "Distance between the two APs (m)", apDistance);
+  cmd.AddValue ("stop", "Simulation time (s)", stop);
+  cmd.Parse (argc,argv);
+
+  if (verbose)
+    {
+      LogComponentEnable ("HandoverDecisionExample", LOG_LEVEL_INFO);
+    }
+
+  RunStats immediate = Run (false, apDistance, stop);
+  RunStats damped = Run (true, apDistance, stop);
+
+  Print ("Handover to any better AP", immediate);
+  Print ("Handover with hysteresis, time to trigger and dwell time", damped);
+  return 0;
+}
@@ -0,0 +1,227 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/mih-module.h"
+
+// A UE drives past two eNBs and is handed over from the first one to
+// the second one over X2. Its LteMihLinkSap reports the MIH link
+// events derived from the LTE RRC and PHY: the neighbour cell is
+// detected, the serving cell RSRP crosses the configured threshold
+// and is predicted to go below GoingDownThreshold, then the handover
+// is signalled by LinkHandoverImminent, LinkHandoverComplete and
+// LinkUp.
+//
+//   eNB0 ---------- eNB1
+//    UE -->
+//
+// ./waf --run "lte-mih-example --speed=20 --verbose=1"
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteMihExample");
+
+struct RunStats
+{
+  uint32_t detected;
+  uint32_t reports;
+  Time goingDown;
+  Time handoverImminent;
+  Time handoverComplete;
+  Time linkUp;
+};
+
+static RunStats g_stats;
+
+static void
+LinkDetected (mih::MihfId mihfId, mih::LinkDetectedInformationList linkDetectedInfoList)
+{
+  for (uint32_t i = 0; i < linkDetectedInfoList.size (); i++)
+    {
+      NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkDetected "
+                   << linkDetectedInfoList[i]->GetLinkIdentifier ().GetPoALinkAddress () << ", RSRP "
+                   << (int16_t) linkDetectedInfoList[i]->GetSignalStrength ().GetValue () << " dBm");
+    }
+  g_stats.detected++;
+}
+
+static void
+LinkUp (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+        Address oldAR, Address newAR, bool ipRenewal,
+        mih::MobilityManagementSupport mobilitySupport)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkUp with " << newAR);
+  g_stats.linkUp = Simulator::Now ();
+}
+
+static void
+LinkDown (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+          Address oldAR, mih::LinkDownReason reason)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkDown from " << oldAR);
+}
+
+static void
+LinkParametersReport (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+                      mih::LinkParameterReportList parameters)
+{
+  for (uint32_t i = 0; i < parameters.size (); i++)
+    {
+      Ptr<mih::LinkParameterValue> value =
+        DynamicCast<mih::LinkParameterValue> (parameters[i]->GetParameter ()->GetParameterValue ());
+      NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkParametersReport RSRP "
+                   << (int16_t) value->GetValue () << " dBm");
+    }
+  g_stats.reports++;
+}
+
+static void
+LinkGoingDown (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+               uint64_t timeInterval, mih::LinkGoingDownReason reason)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkGoingDown in " << timeInterval << " ms");
+  if (g_stats.goingDown.IsZero ())
+    {
+      g_stats.goingDown = Simulator::Now ();
+    }
+}
+
+static void
+LinkHandoverImminent (mih::MihfId mihfId, mih::LinkIdentifier oldLinkIdentifier,
+                      mih::LinkIdentifier newLinkIdentifier, Address oldAR, Address newAR)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkHandoverImminent " << oldAR << " -> " << newAR);
+  g_stats.handoverImminent = Simulator::Now ();
+}
+
+static void
+LinkHandoverComplete (mih::MihfId mihfId, mih::LinkIdentifier oldLinkIdentifier,
+                      mih::LinkIdentifier newLinkIdentifier, Address oldAR, Address newAR,
+                      mih::Status status)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkHandoverComplete " << oldAR << " -> " << newAR);
+  g_stats.handoverComplete = Simulator::Now ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  bool verbose = false;
+  double distance = 500;
+  double speed = 50;
+  double rsrpThreshold = -70;
+  double goingDownThreshold = -75;
+  double stop = 0;
+
+  CommandLine cmd;
+  cmd.AddValue ("verbose", "Log the MIH link events", verbose);
+  cmd.AddValue ("distance", "Distance between the two eNBs (m)", distance);
+  cmd.AddValue ("speed", "Speed of the UE (m/s)", speed);
+  cmd.AddValue ("rsrpThreshold", "Serving cell RSRP threshold reported below (dBm)", rsrpThreshold);
+  cmd.AddValue ("goingDownThreshold", "Serving cell RSRP the link is expected to be lost below (dBm)", goingDownThreshold);
+  cmd.AddValue ("stop", "Simulation time (s), by default until the UE traveled twice the distance between the eNBs", stop);
+  cmd.Parse (argc,argv);
+  if (stop <= 0)
+    {
+      stop = 2 * distance / speed;
+    }
+
+  if (verbose)
+    {
+      LogComponentEnable ("LteMihExample", LOG_LEVEL_INFO);
+    }
+
+  Config::SetDefault ("ns3::LteHelper::UseIdealRrc", BooleanValue (true));
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper> ();
+  lteHelper->SetEpcHelper (epcHelper);
+  lteHelper->SetHandoverAlgorithmType ("ns3::A3RsrpHandoverAlgorithm");
+
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  NodeContainer ueNodes;
+  ueNodes.Create (1);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0, 0, 0));
+  positionAlloc->Add (Vector (distance, 0, 0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (ueNodes);
+  ueNodes.Get (0)->GetObject<MobilityModel> ()->SetPosition (Vector (0, 20, 0));
+  ueNodes.Get (0)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (speed, 0, 0));
+
+  NetDeviceContainer enbDevices = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevices = lteHelper->InstallUeDevice (ueNodes);
+
+  InternetStackHelper internet;
+  internet.Install (ueNodes);
+  epcHelper->AssignUeIpv4Address (ueDevices);
+  lteHelper->Attach (ueDevices.Get (0), enbDevices.Get (0));
+  lteHelper->AddX2Interface (enbNodes);
+
+  LteMihLinkSapHelper lteMihLinkSapHelper;
+  Ptr<mih::LteMihLinkSap> enbLinkSaps[2];
+  for (uint32_t i = 0; i < enbDevices.GetN (); i++)
+    {
+      enbLinkSaps[i] = lteMihLinkSapHelper.Install (enbDevices.Get (i));
+    }
+  Ptr<mih::LteMihLinkSap> mihLinkSap = lteMihLinkSapHelper.Install (ueDevices.Get (0));
+  mihLinkSap->SetAttribute ("GoingDownThreshold", DoubleValue (goingDownThreshold));
+  mihLinkSap->EventSubscribe (mih::EventList::LINK_DETECTED, MakeCallback (&LinkDetected),
+                              mih::EventList::LINK_UP, MakeCallback (&LinkUp),
+                              mih::EventList::LINK_DOWN, MakeCallback (&LinkDown),
+                              mih::EventList::LINK_PARAMETERS_REPORT, MakeCallback (&LinkParametersReport),
+                              mih::EventList::LINK_GOING_DOWN, MakeCallback (&LinkGoingDown),
+                              mih::EventList::LINK_HANDOVER_IMMINENT, MakeCallback (&LinkHandoverImminent),
+                              mih::EventList::LINK_HANDOVER_COMPLETE, MakeCallback (&LinkHandoverComplete),
+                              mih::EventList::INVALID, mih::MihLinkPduTransmitStatusIndicationCallback ());
+  mih::ThresholdList thresholds;
+  thresholds.push_back (Create<mih::Threshold> ((uint16_t) (int16_t) rsrpThreshold,
+                                                mih::Threshold::BELOW_THRESHOLD));
+  mih::LinkConfigurationParameterList configureParameters;
+  configureParameters.push_back (Create<mih::LinkConfigurationParameter> (Create<mih::LinkParameterLte> (mih::LinkParameterLte::RSRP),
+                                                                          0,
+                                                                          mih::LinkConfigurationParameter::NORMAL_THRESHOLD,
+                                                                          thresholds));
+  mihLinkSap->ConfigureThresholds (configureParameters);
+
+  Simulator::Stop (Seconds (stop));
+  Simulator::Run ();
+
+  std::cout << "Neighbour cells detected: " << g_stats.detected << std::endl;
+  std::cout << "RSRP reports:             " << g_stats.reports << std::endl;
+  std::cout << "LinkGoingDown:            " << g_stats.goingDown.GetSeconds () << " s" << std::endl;
+  std::cout << "LinkHandoverImminent:     " << g_stats.handoverImminent.GetSeconds () << " s" << std::endl;
+  std::cout << "LinkHandoverComplete:     " << g_stats.handoverComplete.GetSeconds () << " s" << std::endl;
+  std::cout << "Last LinkUp:              " << g_stats.linkUp.GetSeconds () << " s" << std::endl;
+  std::cout << "Handover execution:       "
+            << (g_stats.handoverComplete - g_stats.handoverImminent).GetMilliSeconds () << " ms" << std::endl;
+  std::cout << "Serving cell:             " << mihLinkSap->GetServingCellId () << std::endl;
+  std::cout << "UEs per eNB:              " << enbLinkSaps[0]->GetStationCount ()
+            << " " << enbLinkSaps[1]->GetStationCount () << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,254 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/bridge-module.h"
+#include "ns3/mih-module.h"
+
+// Variant of wifi-mih-link-down-example where the station walks from
+// one AP to the next one while sending to a server behind both. It is
+// run twice: once waiting for LinkDown (beacon loss) before
+// associating with the next AP (break before make), and once
+// reassociating as soon as LinkGoingDown is predicted from the
+// signal strength trend (make before break).
+//
+//   Wifi 10.1.1.0 (one ESS, bridged)
+//
+//    AP0 ----------- AP1
+//     |    n0 -->     |
+//     +-----+---------+
+//           |  csma
+//         server
+//
+// ./waf --run "wifi-mih-going-down-example --speed=10"
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("WifiMihGoingDownExample");
+
+struct RunStats
+{
+  uint32_t sent;
+  uint32_t received;
+  Time lastRx;
+  Time maxGap;
+  Time goingDown;
+  Time linkDown;
+  Time linkUp;
+};
+
+static RunStats g_stats;
+
+static void
+ServerRx (Ptr<const Packet> packet)
+{
+  Time now = Simulator::Now ();
+  if (g_stats.received > 0 && now - g_stats.lastRx > g_stats.maxGap)
+    {
+      g_stats.maxGap = now - g_stats.lastRx;
+    }
+  g_stats.lastRx = now;
+  g_stats.received++;
+}
+
+static void
+ClientTx (const Ipv4Header &header, Ptr<const Packet> packet, uint32_t interface)
+{
+  g_stats.sent++;
+}
+
+static void
+LinkGoingDown (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+               uint64_t timeInterval, mih::LinkGoingDownReason reason)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkGoingDown, expected in " << timeInterval << " ms");
+  if (g_stats.goingDown.IsZero ())
+    {
+      g_stats.goingDown = Simulator::Now ();
+    }
+}
+
+static void
+LinkDown (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+          Address oldAR, mih::LinkDownReason reason)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkDown");
+  if (g_stats.linkDown.IsZero ())
+    {
+      g_stats.linkDown = Simulator::Now ();
+    }
+}
+
+static void
+LinkUp (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+        Address oldAR, Address newAR, bool ipRenewal,
+        mih::MobilityManagementSupport mobilitySupport)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkUp with " << newAR);
+  g_stats.linkUp = Simulator::Now ();
+}
+
+static RunStats
+Run (bool makeBeforeBreak, double speed, double apDistance, double stop)
+{
+  g_stats = RunStats ();
+
+  NodeContainer staNode;
+  staNode.Create (1);
+  NodeContainer apNodes;
+  apNodes.Create (2);
+  NodeContainer serverNode;
+  serverNode.Create (1);
+
+  WifiMihLinkSapHelper wifiMihLinkSapHelper;
+  Ptr<mih::WifiMihLinkSap> mihLinkSap = wifiMihLinkSapHelper.Install (staNode.Get (0));
+  mihLinkSap->SetAttribute ("HandoverOnGoingDown", BooleanValue (makeBeforeBreak));
+  mihLinkSap->EventSubscribe (mih::EventList::INVALID, mih::MihLinkDetectedIndicationCallback (),
+                              mih::EventList::LINK_UP, MakeCallback (&LinkUp),
+                              mih::EventList::LINK_DOWN, MakeCallback (&LinkDown),
+                              mih::EventList::INVALID, mih::MihLinkParametersReportIndicationCallback (),
+                              mih::EventList::LINK_GOING_DOWN, MakeCallback (&LinkGoingDown),
+                              mih::EventList::INVALID, mih::MihLinkHandoverImminentIndicationCallback (),
+                              mih::EventList::INVALID, mih::MihLinkHandoverCompleteIndicationCallback (),
+                              mih::EventList::INVALID, mih::MihLinkPduTransmitStatusIndicationCallback ());
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+
+  WifiHelper wifi;
+  wifi.SetRemoteStationManager ("ns3::AarfWifiManager");
+
+  WifiMacHelper mac;
+  Ssid ssid = Ssid ("ns-3-ssid");
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+  NetDeviceContainer staDevices = wifi.Install (phy, mac, staNode);
+
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid));
+  NetDeviceContainer apDevices = wifi.Install (phy, mac, apNodes);
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", StringValue ("100Mbps"));
+  csma.SetChannelAttribute ("Delay", TimeValue (MicroSeconds (10)));
+  NodeContainer backboneNodes (serverNode, apNodes);
+  NetDeviceContainer backboneDevices = csma.Install (backboneNodes);
+
+  BridgeHelper bridge;
+  for (uint32_t i = 0; i < apNodes.GetN (); i++)
+    {
+      NetDeviceContainer bridgedDevices (apDevices.Get (i), backboneDevices.Get (i + 1));
+      bridge.Install (apNodes.Get (i), bridgedDevices);
+    }
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0, 0, 0));
+  positionAlloc->Add (Vector (apDistance, 0, 0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (apNodes);
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (10, 5, 0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (staNode);
+  staNode.Get (0)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (speed, 0, 0));
+
+  InternetStackHelper stack;
+  stack.Install (staNode);
+  stack.Install (serverNode);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer serverInterfaces = address.Assign (NetDeviceContainer (backboneDevices.Get (0)));
+  address.Assign (staDevices);
+
+  uint16_t port = 4000;
+  UdpServerHelper server (port);
+  ApplicationContainer apps = server.Install (serverNode.Get (0));
+  apps.Get (0)->TraceConnectWithoutContext ("Rx", MakeCallback (&ServerRx));
+  apps.Start (Seconds (0.5));
+
+  // 100 packets per second from the station to the server;
+  UdpClientHelper client (serverInterfaces.GetAddress (0), port);
+  client.SetAttribute ("MaxPackets", UintegerValue (1000000));
+  client.SetAttribute ("Interval", TimeValue (MilliSeconds (10)));
+  client.SetAttribute ("PacketSize", UintegerValue (512));
+  apps = client.Install (staNode.Get (0));
+  apps.Start (Seconds (1.0));
+  apps.Stop (Seconds (stop - 0.5));
+  // UdpClient has no Tx trace, count what the station sends instead;
+  staNode.Get (0)->GetObject<Ipv4L3Protocol> ()->TraceConnectWithoutContext ("SendOutgoing", MakeCallback (&ClientTx));
+
+  Simulator::Stop (Seconds (stop));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return g_stats;
+}
+
+static void
+Print (std::string name, const RunStats &stats)
+{
+  uint32_t lost = stats.sent - stats.received;
+  std::cout << name << std::endl;
+  std::cout << "  LinkGoingDown:     " << stats.goingDown.GetSeconds () << " s" << std::endl;
+  std::cout << "  LinkDown:          " << stats.linkDown.GetSeconds () << " s" << std::endl;
+  std::cout << "  Last LinkUp:       " << stats.linkUp.GetSeconds () << " s" << std::endl;
+  std::cout << "  Sent/received:     " << stats.sent << "/" << stats.received << std::endl;
+  std::cout << "  Lost:              " << lost << " (" << 100.0 * lost / std::max<uint32_t> (stats.sent, 1) << " %)" << std::endl;
+  std::cout << "  Interruption:      " << stats.maxGap.GetMilliSeconds () << " ms" << std::endl;
+}
+
+int 
+main (int argc, char *argv[])
+{
+  bool verbose = false;
+  double speed = 10;
+  double apDistance = 150;
+  double stop = 16;
+
+  CommandLine cmd;
+  cmd.AddValue ("verbose", "Log the MIH link events", verbose);
+  cmd.AddValue ("speed", "Speed of the station (m/s)", speed);
+  cmd.AddValue ("apDistance", "Distance between the two APs (m)", apDistance);
+  cmd.AddValue ("stop", "Simulation time (s)", stop);
+  cmd.Parse (argc,argv);
+
+  if (verbose)
+    {
+      LogComponentEnable ("WifiMihGoingDownExample", LOG_LEVEL_INFO);
+    }
+
+  RunStats breakBeforeMake = Run (false, speed, apDistance, stop);
+  RunStats makeBeforeBreak = Run (true, speed, apDistance, stop);
+
+  Print ("Handover on LinkDown (break before make)", breakBeforeMake);
+  Print ("Handover on LinkGoingDown (make before break)", makeBeforeBreak);
+  std::cout << "Gain: " << (int32_t) (breakBeforeMake.sent - breakBeforeMake.received) -
+    (int32_t) (makeBeforeBreak.sent - makeBeforeBreak.received) << " packets, "
+            << (breakBeforeMake.maxGap - makeBeforeBreak.maxGap).GetMilliSeconds ()
+            << " ms of interruption" << std::endl;
+  return 0;
+}
@@ -0,0 +1,187 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/mih-module.h"
+
+// A station associated with AP0 on channel 1 asks its MIH function to
+// scan channels 1, 6 and 11 with MIH_Link_Actions LINK_SCAN requests,
+// then powers its radio down and back up with LINK_POWER_DOWN and
+// LINK_POWER_UP.
+//
+//   AP0 (ch 1)    AP1 (ch 6)    AP2 (ch 11)
+//         \           |           /
+//                     n0
+//
+// The second scan comes within ScanCacheTimeToLive of the first one
+// and is answered from the cache, the third one probes again. Every
+// request is confirmed once the scan is complete, however long the
+// dwell time.
+//
+// ./waf --run "wifi-mih-scan-example --dwell=20"
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("WifiMihScanExample");
+
+static Ptr<mih::MihFunction> g_mihf;
+static Ptr<mih::WifiMihLinkSap> g_mihLinkSap;
+static uint32_t g_linkUps = 0;
+static uint32_t g_scans = 0;
+
+static void
+ActionsConfirm (Time requested, mih::MihfId mihfId, mih::Status status,
+                mih::LinkActionResponseList responses)
+{
+  std::cout << Simulator::Now ().GetSeconds () << "s actions confirmed after "
+            << (Simulator::Now () - requested).GetMicroSeconds () << " us" << std::endl;
+  for (mih::LinkActionResponseListI i = responses.begin (); i != responses.end (); i++)
+    {
+      mih::ScanResponseList scans = (*i)->GetScanResponseList ();
+      std::cout << "  result " << (uint32_t) (*i)->GetActionResult ()
+                << ", " << scans.size () << " PoAs" << std::endl;
+      for (mih::ScanResponseListI j = scans.begin (); j != scans.end (); j++)
+        {
+          std::cout << "    " << (*j)->GetPoALinkAddress ()
+                    << " " << (*j)->GetNetworkIdentifier ().PeekString ()
+                    << " " << (int16_t) (*j)->GetSignalStrength ().GetValue () << " dBm" << std::endl;
+        }
+      if (!scans.empty ())
+        {
+          g_scans++;
+        }
+    }
+}
+
+static void
+Action (mih::LinkAction::Type type, uint8_t attribute)
+{
+  mih::LinkActionRequestList requests;
+  requests.push_back (Create<mih::LinkActionRequest> (g_mihLinkSap->GetLinkIdentifier (),
+                                                      mih::LinkAction (type, attribute)));
+  g_mihf->LinkActions (g_mihf->GetMihfId (), requests,
+                       MakeCallback (&ActionsConfirm).Bind (Simulator::Now ()));
+}
+
+static void
+LinkDown (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+          Address oldAR, mih::LinkDownReason reason)
+{
+  std::cout << Simulator::Now ().GetSeconds () << "s LinkDown from " << oldAR << std::endl;
+}
+
+static void
+LinkUp (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+        Address oldAR, Address newAR, bool ipRenewal,
+        mih::MobilityManagementSupport mobilitySupport)
+{
+  std::cout << Simulator::Now ().GetSeconds () << "s LinkUp with " << newAR << std::endl;
+  g_linkUps++;
+}
+
+int 
+main (int argc, char *argv[])
+{
+  uint32_t dwell = 20;
+  double cacheTimeToLive = 1;
+
+  CommandLine cmd;
+  cmd.AddValue ("dwell", "Time spent on each scanned channel (ms)", dwell);
+  cmd.AddValue ("ttl", "Lifetime of the scan results (s)", cacheTimeToLive);
+  cmd.Parse (argc,argv);
+
+  NodeContainer staNode;
+  staNode.Create (1);
+  NodeContainer apNodes;
+  apNodes.Create (3);
+
+  WifiMihLinkSapHelper wifiMihLinkSapHelper;
+  g_mihLinkSap = wifiMihLinkSapHelper.Install (staNode.Get (0));
+  g_mihLinkSap->SetAttribute ("ScanChannels", StringValue ("1,6,11"));
+  g_mihLinkSap->SetAttribute ("ScanDwellTime", TimeValue (MilliSeconds (dwell)));
+  g_mihLinkSap->SetAttribute ("ScanCacheTimeToLive", TimeValue (Seconds (cacheTimeToLive)));
+  g_mihLinkSap->EventSubscribe (mih::EventList::INVALID, mih::MihLinkDetectedIndicationCallback (),
+                                mih::EventList::LINK_UP, MakeCallback (&LinkUp),
+                                mih::EventList::LINK_DOWN, MakeCallback (&LinkDown),
+                                mih::EventList::INVALID, mih::MihLinkParametersReportIndicationCallback (),
+                                mih::EventList::INVALID, mih::MihLinkGoingDownIndicationCallback (),
+                                mih::EventList::INVALID, mih::MihLinkHandoverImminentIndicationCallback (),
+                                mih::EventList::INVALID, mih::MihLinkHandoverCompleteIndicationCallback (),
+                                mih::EventList::INVALID, mih::MihLinkPduTransmitStatusIndicationCallback ());
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211g);
+  wifi.SetRemoteStationManager ("ns3::AarfWifiManager");
+
+  WifiMacHelper mac;
+  Ssid ssid = Ssid ("ns-3-ssid");
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+  phy.Set ("ChannelNumber", UintegerValue (1));
+  NetDeviceContainer staDevices = wifi.Install (phy, mac, staNode);
+
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid));
+  uint8_t apChannels[] = { 1, 6, 11 };
+  for (uint32_t i = 0; i < apNodes.GetN (); i++)
+    {
+      phy.Set ("ChannelNumber", UintegerValue (apChannels[i]));
+      wifi.Install (phy, mac, apNodes.Get (i));
+    }
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0, 0, 0));
+  positionAlloc->Add (Vector (30, 0, 0));
+  positionAlloc->Add (Vector (60, 0, 0));
+  positionAlloc->Add (Vector (20, 10, 0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (apNodes);
+  mobility.Install (staNode);
+
+  // The link SAP is found by the station address;
+  g_mihLinkSap->SetLinkIdentifier (mih::LinkIdentifier (mih::LinkType (mih::LinkType::WIRELESS_802_11),
+                                                        staDevices.Get (0)->GetAddress (),
+                                                        Address ()));
+  g_mihf = CreateObject<mih::MihFunction> ();
+  g_mihf->SetMihfId (mih::MihfId ("mn-mihf@sta"));
+  g_mihf->Register (g_mihLinkSap);
+
+  Simulator::Schedule (Seconds (2), &Action, mih::LinkAction::NONE, mih::LinkAction::LINK_SCAN);
+  Simulator::Schedule (Seconds (2.5), &Action, mih::LinkAction::NONE, mih::LinkAction::LINK_SCAN);
+  Simulator::Schedule (Seconds (4), &Action, mih::LinkAction::NONE, mih::LinkAction::LINK_SCAN);
+  Simulator::Schedule (Seconds (5), &Action, mih::LinkAction::LINK_POWER_DOWN, mih::LinkAction::INVALID);
+  Simulator::Schedule (Seconds (5.5), &Action, mih::LinkAction::NONE, mih::LinkAction::LINK_SCAN);
+  Simulator::Schedule (Seconds (6), &Action, mih::LinkAction::LINK_POWER_UP, mih::LinkAction::INVALID);
+
+  Simulator::Stop (Seconds (8));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  g_mihLinkSap = 0;
+  g_mihf = 0;
+
+  std::cout << "Scans: " << g_scans << ", LinkUps: " << g_linkUps << std::endl;
+  return 0;
+}
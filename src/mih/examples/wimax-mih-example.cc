@@ -0,0 +1,198 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wimax-module.h"
+#include "ns3/mih-module.h"
+
+// A SS drives away from its BS until it loses the downlink, then
+// comes back. Its WimaxMihLinkSap reports the MIH link events derived
+// from the SS state and the downlink CINR: the BS is detected, the
+// SS registers (LinkUp), the CINR crosses the configured threshold
+// and is predicted to go below GoingDownThreshold, the link goes down
+// and, once back in range, the BS is detected again and the SS
+// registers anew.
+//
+//   BS
+//    SS --> <--
+//
+// ./waf --run "wimax-mih-example --speed=100 --verbose=1"
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("WimaxMihExample");
+
+struct RunStats
+{
+  uint32_t detected;
+  uint32_t reports;
+  uint32_t linkUps;
+  Time goingDown;
+  Time linkDown;
+  Time linkUp;
+};
+
+static RunStats g_stats;
+
+static void
+LinkDetected (mih::MihfId mihfId, mih::LinkDetectedInformationList linkDetectedInfoList)
+{
+  for (uint32_t i = 0; i < linkDetectedInfoList.size (); i++)
+    {
+      NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkDetected "
+                   << linkDetectedInfoList[i]->GetLinkIdentifier ().GetPoALinkAddress () << ", CINR "
+                   << linkDetectedInfoList[i]->GetSinr () << " dB");
+    }
+  g_stats.detected++;
+}
+
+static void
+LinkUp (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+        Address oldAR, Address newAR, bool ipRenewal,
+        mih::MobilityManagementSupport mobilitySupport)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkUp with " << newAR);
+  g_stats.linkUps++;
+  g_stats.linkUp = Simulator::Now ();
+}
+
+static void
+LinkDown (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+          Address oldAR, mih::LinkDownReason reason)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkDown from " << oldAR);
+  g_stats.linkDown = Simulator::Now ();
+}
+
+static void
+LinkParametersReport (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+                      mih::LinkParameterReportList parameters)
+{
+  for (uint32_t i = 0; i < parameters.size (); i++)
+    {
+      Ptr<mih::LinkParameterValue> value =
+        DynamicCast<mih::LinkParameterValue> (parameters[i]->GetParameter ()->GetParameterValue ());
+      NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkParametersReport CINR "
+                   << (int16_t) value->GetValue () << " dB");
+    }
+  g_stats.reports++;
+}
+
+static void
+LinkGoingDown (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+               uint64_t timeInterval, mih::LinkGoingDownReason reason)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s LinkGoingDown in " << timeInterval << " ms");
+  if (g_stats.goingDown.IsZero ())
+    {
+      g_stats.goingDown = Simulator::Now ();
+    }
+}
+
+static void
+TurnBack (Ptr<ConstantVelocityMobilityModel> mobility, double speed)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s turning back at "
+               << mobility->GetPosition ().x << " m");
+  mobility->SetVelocity (Vector (-speed, 0, 0));
+}
+
+int
+main (int argc, char *argv[])
+{
+  bool verbose = false;
+  double speed = 100;
+  double distance = 3500;
+  double cinrThreshold = 20;
+  double goingDownThreshold = 10;
+
+  CommandLine cmd;
+  cmd.AddValue ("verbose", "Log the MIH link events", verbose);
+  cmd.AddValue ("speed", "Speed of the SS (m/s)", speed);
+  cmd.AddValue ("distance", "Distance from the BS the SS turns back at (m)", distance);
+  cmd.AddValue ("cinrThreshold", "Downlink CINR threshold reported below (dB)", cinrThreshold);
+  cmd.AddValue ("goingDownThreshold", "Downlink CINR the link is expected to be lost below (dB)", goingDownThreshold);
+  cmd.Parse (argc,argv);
+  double stop = 2 * distance / speed;
+
+  if (verbose)
+    {
+      LogComponentEnable ("WimaxMihExample", LOG_LEVEL_INFO);
+    }
+
+  NodeContainer bsNodes;
+  bsNodes.Create (1);
+  NodeContainer ssNodes;
+  ssNodes.Create (1);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (bsNodes);
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (ssNodes);
+  Ptr<ConstantVelocityMobilityModel> ssMobility = ssNodes.Get (0)->GetObject<ConstantVelocityMobilityModel> ();
+  ssMobility->SetPosition (Vector (10, 0, 0));
+  ssMobility->SetVelocity (Vector (speed, 0, 0));
+  Simulator::Schedule (Seconds (distance / speed), &TurnBack, ssMobility, speed);
+
+  WimaxHelper wimax;
+  NetDeviceContainer bsDevices = wimax.Install (bsNodes, WimaxHelper::DEVICE_TYPE_BASE_STATION,
+                                                WimaxHelper::SIMPLE_PHY_TYPE_OFDM,
+                                                WimaxHelper::SCHED_TYPE_SIMPLE);
+  NetDeviceContainer ssDevices = wimax.Install (ssNodes, WimaxHelper::DEVICE_TYPE_SUBSCRIBER_STATION,
+                                                WimaxHelper::SIMPLE_PHY_TYPE_OFDM,
+                                                WimaxHelper::SCHED_TYPE_SIMPLE);
+
+  WimaxMihLinkSapHelper wimaxMihLinkSapHelper;
+  Ptr<mih::WimaxMihLinkSap> bsLinkSap = wimaxMihLinkSapHelper.Install (bsDevices.Get (0));
+  Ptr<mih::WimaxMihLinkSap> mihLinkSap = wimaxMihLinkSapHelper.Install (ssDevices.Get (0));
+  mihLinkSap->SetAttribute ("GoingDownThreshold", DoubleValue (goingDownThreshold));
+  mihLinkSap->EventSubscribe (mih::EventList::LINK_DETECTED, MakeCallback (&LinkDetected),
+                              mih::EventList::LINK_UP, MakeCallback (&LinkUp),
+                              mih::EventList::LINK_DOWN, MakeCallback (&LinkDown),
+                              mih::EventList::LINK_PARAMETERS_REPORT, MakeCallback (&LinkParametersReport),
+                              mih::EventList::LINK_GOING_DOWN, MakeCallback (&LinkGoingDown),
+                              mih::EventList::INVALID, mih::MihLinkHandoverImminentIndicationCallback (),
+                              mih::EventList::INVALID, mih::MihLinkHandoverCompleteIndicationCallback (),
+                              mih::EventList::INVALID, mih::MihLinkPduTransmitStatusIndicationCallback ());
+  mih::ThresholdList thresholds;
+  thresholds.push_back (Create<mih::Threshold> ((uint16_t) (int16_t) cinrThreshold,
+                                                mih::Threshold::BELOW_THRESHOLD));
+  mih::LinkConfigurationParameterList configureParameters;
+  configureParameters.push_back (Create<mih::LinkConfigurationParameter> (Create<mih::LinkParameter80216> (mih::LinkParameter80216::CINR),
+                                                                          0,
+                                                                          mih::LinkConfigurationParameter::NORMAL_THRESHOLD,
+                                                                          thresholds));
+  mihLinkSap->ConfigureThresholds (configureParameters);
+
+  Simulator::Stop (Seconds (stop));
+  Simulator::Run ();
+
+  std::cout << "BS detections:       " << g_stats.detected << std::endl;
+  std::cout << "CINR reports:        " << g_stats.reports << std::endl;
+  std::cout << "LinkUps:             " << g_stats.linkUps << std::endl;
+  std::cout << "LinkGoingDown:       " << g_stats.goingDown.GetSeconds () << " s" << std::endl;
+  std::cout << "LinkDown:            " << g_stats.linkDown.GetSeconds () << " s" << std::endl;
+  std::cout << "Last LinkUp:         " << g_stats.linkUp.GetSeconds () << " s" << std::endl;
+  std::cout << "Link interruption:   "
+            << (g_stats.linkUp - g_stats.linkDown).GetMilliSeconds () << " ms" << std::endl;
+  std::cout << "SSs registered:      " << bsLinkSap->GetStationCount () << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,280 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iomanip>
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/callback.h"
+#include "ns3/data-collector.h"
+#include "ns3/mih-function.h"
+#include "ns3/mih-stats-helper.h"
+
+NS_LOG_COMPONENT_DEFINE ("MihStatsHelper");
+
+namespace ns3 {
+
+static uint32_t
+GetMessageKey (mih::MihHeader::ServiceIdE serviceId,
+               mih::MihHeader::OpCodeE opCode,
+               mih::MihHeader::ActionIdE actionId)
+{
+  return (serviceId << 16) | (actionId << 8) | opCode;
+}
+
+static std::string
+GetMessageName (uint32_t key)
+{
+  static const char *management[] = { "?", "Capability_Discover", "Register", "DeRegister",
+                                       "Event_Subscribe", "Event_Unsubscribe" };
+  static const char *event[] = { "?", "Link_Detected", "Link_Up", "Link_Down",
+                                  "Link_Parameters_Report", "Link_Going_Down",
+                                  "Link_Handover_Imminent", "Link_Handover_Complete",
+                                  "Link_Event_Batch" };
+  static const char *command[] = { "?", "Link_Get_Parameters", "Link_Configure_Thresholds",
+                                    "Link_Actions", "Net_HO_Candidate_Query",
+                                    "MN_HO_Candidate_Query", "N2N_HO_Query_Resources",
+                                    "MN_HO_Commit", "Net_HO_Commit", "N2N_HO_Commit",
+                                    "MN_HO_Complete", "N2N_HO_Complete" };
+  static const char *opCodes[] = { "?", "request", "response", "indication" };
+  uint32_t serviceId = key >> 16;
+  uint32_t actionId = (key >> 8) & 0xff;
+  uint32_t opCode = key & 0xff;
+  std::string name = "?";
+  switch (serviceId)
+    {
+    case mih::MihHeader::MANAGEMENT:
+      name = actionId < 6 ? management[actionId] : "?";
+      break;
+    case mih::MihHeader::EVENT:
+      name = actionId < 9 ? event[actionId] : "?";
+      break;
+    case mih::MihHeader::COMMAND:
+      name = actionId < 12 ? command[actionId] : "?";
+      break;
+    case mih::MihHeader::INFORMATION:
+      name = actionId == mih::MihHeader::MIH_GET_INFORMATION ? "Get_Information" : "?";
+      break;
+    }
+  return "MIH_" + name + " " + (opCode < 4 ? opCodes[opCode] : "?");
+}
+
+// Histogram::GetBinCount is not const, so the summary works on a copy;
+static void
+WriteHistogram (std::ostream &os, Histogram histogram, std::string unit)
+{
+  for (uint32_t bin = 0; bin < histogram.GetNBins (); bin++)
+    {
+      if (histogram.GetBinCount (bin) == 0)
+        {
+          continue;
+        }
+      os << "    [" << histogram.GetBinStart (bin) << ", " << histogram.GetBinEnd (bin) << ") "
+         << unit << ": " << histogram.GetBinCount (bin) << std::endl;
+    }
+}
+
+MihStatsHelper::MihStatsHelper ()
+  : m_txSizeHistogram (32),
+    m_transactionLatencyHistogram (10),
+    m_eventDelayHistogram (10),
+    m_protocols (0)
+{
+  m_txSize = CreateObject<MinMaxAvgTotalCalculator<uint32_t> > ();
+  m_txSize->SetKey ("pdu-tx-size");
+  m_rxSize = CreateObject<MinMaxAvgTotalCalculator<uint32_t> > ();
+  m_rxSize->SetKey ("pdu-rx-size");
+  m_transactionLatency = CreateObject<MinMaxAvgTotalCalculator<double> > ();
+  m_transactionLatency->SetKey ("transaction-latency-ms");
+  m_eventDelay = CreateObject<MinMaxAvgTotalCalculator<double> > ();
+  m_eventDelay->SetKey ("event-delay-ms");
+  m_queueDepth = CreateObject<MinMaxAvgTotalCalculator<uint32_t> > ();
+  m_queueDepth->SetKey ("pending-request-queue-depth");
+  m_retransmissions = CreateObject<CounterCalculator<uint32_t> > ();
+  m_retransmissions->SetKey ("transaction-retransmissions");
+  m_timeouts = CreateObject<CounterCalculator<uint32_t> > ();
+  m_timeouts->SetKey ("transaction-timeouts");
+}
+
+void
+MihStatsHelper::SetLatencyBinWidth (Time width)
+{
+  NS_ASSERT (width.IsStrictlyPositive ());
+  m_transactionLatencyHistogram.SetDefaultBinWidth (width.GetSeconds () * 1000);
+  m_eventDelayHistogram.SetDefaultBinWidth (width.GetSeconds () * 1000);
+}
+
+void
+MihStatsHelper::SetSizeBinWidth (uint32_t bytes)
+{
+  NS_ASSERT (bytes > 0);
+  m_txSizeHistogram.SetDefaultBinWidth (bytes);
+}
+
+void
+MihStatsHelper::Install (Ptr<mih::MihProtocol> protocol)
+{
+  NS_LOG_FUNCTION (this << protocol);
+  protocol->SetAttribute ("EventTimestamps", BooleanValue (true));
+  protocol->TraceConnectWithoutContext ("PduTx", MakeCallback (&MihStatsHelper::PduTx, this));
+  protocol->TraceConnectWithoutContext ("PduRx", MakeCallback (&MihStatsHelper::PduRx, this));
+  protocol->TraceConnectWithoutContext ("TransactionLatency",
+                                        MakeCallback (&MihStatsHelper::TransactionLatency, this));
+  protocol->TraceConnectWithoutContext ("TransactionRetransmit",
+                                        MakeCallback (&MihStatsHelper::TransactionRetransmit, this));
+  protocol->TraceConnectWithoutContext ("TransactionTimeout",
+                                        MakeCallback (&MihStatsHelper::TransactionTimeout, this));
+  protocol->TraceConnectWithoutContext ("PendingRequestQueueDepth",
+                                        MakeCallback (&MihStatsHelper::QueueDepth, this));
+  protocol->TraceConnectWithoutContext ("EventDelay", MakeCallback (&MihStatsHelper::EventDelay, this));
+  m_protocols++;
+}
+
+void
+MihStatsHelper::Install (Ptr<mih::MihFunction> mihf)
+{
+  Ptr<mih::MihProtocol> protocol = mihf->GetObject<mih::MihProtocol> ();
+  NS_ASSERT_MSG (protocol != 0, "No MihProtocol aggregated to " << mihf->GetMihfId ());
+  Install (protocol);
+}
+
+void
+MihStatsHelper::AddDataCalculators (DataCollector &collector) const
+{
+  m_txSize->SetContext ("mih");
+  m_rxSize->SetContext ("mih");
+  m_transactionLatency->SetContext ("mih");
+  m_eventDelay->SetContext ("mih");
+  m_queueDepth->SetContext ("mih");
+  m_retransmissions->SetContext ("mih");
+  m_timeouts->SetContext ("mih");
+  collector.AddDataCalculator (m_txSize);
+  collector.AddDataCalculator (m_rxSize);
+  collector.AddDataCalculator (m_transactionLatency);
+  collector.AddDataCalculator (m_eventDelay);
+  collector.AddDataCalculator (m_queueDepth);
+  collector.AddDataCalculator (m_retransmissions);
+  collector.AddDataCalculator (m_timeouts);
+}
+
+uint32_t
+MihStatsHelper::GetTxPduCount (void) const
+{
+  return m_txSize->getCount ();
+}
+
+uint32_t
+MihStatsHelper::GetEventIndicationCount (void) const
+{
+  return m_eventDelay->getCount ();
+}
+
+void
+MihStatsHelper::PduTx (mih::MihfId peer, mih::MihHeader::ServiceIdE serviceId,
+                       mih::MihHeader::OpCodeE opCode, mih::MihHeader::ActionIdE actionId,
+                       uint32_t size)
+{
+  m_txSize->Update (size);
+  m_txSizeHistogram.AddValue (size);
+  MessageStats &message = m_txMessages[GetMessageKey (serviceId, opCode, actionId)];
+  message.count++;
+  message.bytes += size;
+}
+
+void
+MihStatsHelper::PduRx (mih::MihfId peer, mih::MihHeader::ServiceIdE serviceId,
+                       mih::MihHeader::OpCodeE opCode, mih::MihHeader::ActionIdE actionId,
+                       uint32_t size)
+{
+  m_rxSize->Update (size);
+}
+
+void
+MihStatsHelper::TransactionLatency (mih::MihfId peer, uint16_t transactionId, Time latency)
+{
+  double ms = latency.GetSeconds () * 1000;
+  m_transactionLatency->Update (ms);
+  m_transactionLatencyHistogram.AddValue (ms);
+}
+
+void
+MihStatsHelper::TransactionRetransmit (mih::MihfId peer, uint16_t transactionId, uint32_t transmissions)
+{
+  m_retransmissions->Update ();
+}
+
+void
+MihStatsHelper::TransactionTimeout (mih::MihfId peer, uint16_t transactionId)
+{
+  m_timeouts->Update ();
+}
+
+void
+MihStatsHelper::QueueDepth (mih::MihfId peer, uint32_t depth)
+{
+  m_queueDepth->Update (depth);
+}
+
+void
+MihStatsHelper::EventDelay (mih::MihfId source, Time delay)
+{
+  double ms = delay.GetSeconds () * 1000;
+  m_eventDelay->Update (ms);
+  m_eventDelayHistogram.AddValue (ms);
+}
+
+void
+MihStatsHelper::WriteSummary (std::ostream &os) const
+{
+  os << "MIH signalling of " << m_protocols << " MIH functions" << std::endl;
+  os << "  PDUs sent:           " << m_txSize->getCount () << " ("
+     << static_cast<uint64_t> (m_txSize->getSum ()) << " bytes, "
+     << m_txSize->getMean () << " on average)" << std::endl;
+  os << "  PDUs received:       " << m_rxSize->getCount () << " ("
+     << static_cast<uint64_t> (m_rxSize->getSum ()) << " bytes)" << std::endl;
+  for (MessageStatsMap::const_iterator i = m_txMessages.begin (); i != m_txMessages.end (); i++)
+    {
+      os << "    " << std::left << std::setw (40) << GetMessageName (i->first) << std::right
+         << std::setw (8) << i->second.count << " PDUs "
+         << std::setw (10) << i->second.bytes << " bytes" << std::endl;
+    }
+  os << "  PDU size histogram:" << std::endl;
+  WriteHistogram (os, m_txSizeHistogram, "bytes");
+  os << "  Transactions:        " << m_transactionLatency->getCount () << " answered, "
+     << m_retransmissions->GetCount () << " retransmissions, "
+     << m_timeouts->GetCount () << " timed out" << std::endl;
+  if (m_transactionLatency->getCount () > 0)
+    {
+      os << "  Transaction latency: " << m_transactionLatency->getMin () << "/"
+         << m_transactionLatency->getMean () << "/" << m_transactionLatency->getMax ()
+         << " ms (min/avg/max)" << std::endl;
+      WriteHistogram (os, m_transactionLatencyHistogram, "ms");
+    }
+  if (m_queueDepth->getCount () > 0)
+    {
+      os << "  Pending requests:    " << m_queueDepth->getMean () << " queued on average, "
+         << m_queueDepth->getMax () << " at most" << std::endl;
+    }
+  os << "  Event indications:   " << m_eventDelay->getCount () << " delivered" << std::endl;
+  if (m_eventDelay->getCount () > 0)
+    {
+      os << "  Event delay:         " << m_eventDelay->getMin () << "/"
+         << m_eventDelay->getMean () << "/" << m_eventDelay->getMax ()
+         << " ms (min/avg/max)" << std::endl;
+      WriteHistogram (os, m_eventDelayHistogram, "ms");
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,141 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MIH_STATS_HELPER_H
+#define MIH_STATS_HELPER_H
+
+#include <map>
+#include <ostream>
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/basic-data-calculators.h"
+#include "ns3/histogram.h"
+#include "ns3/mih-protocol.h"
+
+namespace ns3 {
+
+class DataCollector;
+namespace mih {
+  class MihFunction;
+}
+
+/**
+ * \brief Helper class that gathers the MIH signalling statistics of
+ * a set of ns3::mih::MihProtocol objects
+ *
+ * The PDUs sent and received, the request to response latency of the
+ * transactions, the depth of the pending request queues and the end
+ * to end delay of the remote event indications are summed up in
+ * calculators of the stats module and in fixed-width histograms.
+ * The helper must outlive the simulation, the trace sources call
+ * back into it.
+ */
+class MihStatsHelper
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  MihStatsHelper ();
+
+  /**
+   * \param width the bin width of the latency and delay histograms
+   *
+   * Must be called before any sample is recorded.
+   */
+  void SetLatencyBinWidth (Time width);
+  /**
+   * \param bytes the bin width of the PDU size histograms
+   *
+   * Must be called before any sample is recorded.
+   */
+  void SetSizeBinWidth (uint32_t bytes);
+
+  /**
+   * Connect to the trace sources of this protocol, and tag the event
+   * indications it sends from now on with the time they were raised.
+   *
+   * \param protocol the MihProtocol to gather the statistics of
+   */
+  void Install (Ptr<mih::MihProtocol> protocol);
+  /**
+   * \param mihf the MihFunction the MihProtocol to gather the
+   * statistics of is aggregated to
+   */
+  void Install (Ptr<mih::MihFunction> mihf);
+
+  /**
+   * Add the calculators to this collector, under the "mih" context,
+   * for its OMNeT++ or SQLite output.
+   *
+   * \param collector the DataCollector of the run
+   */
+  void AddDataCalculators (DataCollector &collector) const;
+
+  /**
+   * \param os the stream the summary of the run is written to
+   */
+  void WriteSummary (std::ostream &os) const;
+
+  /**
+   * \returns the number of PDUs sent so far, retransmissions included
+   */
+  uint32_t GetTxPduCount (void) const;
+  /**
+   * \returns the number of remote event indications delivered so far
+   */
+  uint32_t GetEventIndicationCount (void) const;
+
+private:
+  MihStatsHelper (const MihStatsHelper &);
+  MihStatsHelper &operator = (const MihStatsHelper &);
+
+  struct MessageStats
+  {
+    uint32_t count;
+    uint64_t bytes;
+  };
+  typedef std::map<uint32_t, MessageStats> MessageStatsMap;
+
+  void PduTx (mih::MihfId peer, mih::MihHeader::ServiceIdE serviceId,
+              mih::MihHeader::OpCodeE opCode, mih::MihHeader::ActionIdE actionId,
+              uint32_t size);
+  void PduRx (mih::MihfId peer, mih::MihHeader::ServiceIdE serviceId,
+              mih::MihHeader::OpCodeE opCode, mih::MihHeader::ActionIdE actionId,
+              uint32_t size);
+  void TransactionLatency (mih::MihfId peer, uint16_t transactionId, Time latency);
+  void TransactionRetransmit (mih::MihfId peer, uint16_t transactionId, uint32_t transmissions);
+  void TransactionTimeout (mih::MihfId peer, uint16_t transactionId);
+  void QueueDepth (mih::MihfId peer, uint32_t depth);
+  void EventDelay (mih::MihfId source, Time delay);
+
+  Ptr<MinMaxAvgTotalCalculator<uint32_t> > m_txSize;
+  Ptr<MinMaxAvgTotalCalculator<uint32_t> > m_rxSize;
+  Ptr<MinMaxAvgTotalCalculator<double> > m_transactionLatency; // ms;
+  Ptr<MinMaxAvgTotalCalculator<double> > m_eventDelay;         // ms;
+  Ptr<MinMaxAvgTotalCalculator<uint32_t> > m_queueDepth;
+  Ptr<CounterCalculator<uint32_t> > m_retransmissions;
+  Ptr<CounterCalculator<uint32_t> > m_timeouts;
+  Histogram m_txSizeHistogram;
+  Histogram m_transactionLatencyHistogram;
+  Histogram m_eventDelayHistogram;
+  MessageStatsMap m_txMessages;
+  uint32_t m_protocols;
+};
+
+} // namespace ns3
+
+#endif /* MIH_STATS_HELPER_H */
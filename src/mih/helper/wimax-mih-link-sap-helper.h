@@ -0,0 +1,49 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIMAX_MIH_LINK_SAP_HELPER_H
+#define WIMAX_MIH_LINK_SAP_HELPER_H
+
+#include "ns3/ptr.h"
+#include "ns3/net-device.h"
+#include "ns3/wimax-mih-link-sap.h"
+
+namespace ns3 {
+
+/**
+ * \brief Helper class that adds ns3::mih::WimaxMihLinkSap objects
+ */
+class WimaxMihLinkSapHelper
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  WimaxMihLinkSapHelper ();
+
+  /**
+   * \param device the SubscriberStationNetDevice or BaseStationNetDevice the
+   * WimaxMihLinkSap reports the events of; it must be installed already
+   * \returns a newly-created WimaxMihLinkSap, aggregated to the node of
+   * the device, or 0 if the device is not a WiMAX one
+   */
+  Ptr<mih::WimaxMihLinkSap> Install (Ptr<NetDevice> device) const;
+
+};
+
+} // namespace ns3
+
+#endif /* WIMAX_MIH_LINK_SAP_HELPER_H */
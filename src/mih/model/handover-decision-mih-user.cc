@@ -0,0 +1,580 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <limits>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+#include "ns3/supported-rates.h"
+#include "mih-function.h"
+#include "mih-link-parameter-80211.h"
+#include "mih-link-parameter-80216.h"
+#include "mih-link-parameter-lte.h"
+#include "mih-link-parameter-value.h"
+#include "handover-decision-mih-user.h"
+
+NS_LOG_COMPONENT_DEFINE ("HandoverDecisionMihUser");
+
+namespace ns3 {
+  namespace mih {
+
+    NS_OBJECT_ENSURE_REGISTERED (HandoverDecisionMihUser);
+
+    TypeId
+    HandoverDecisionMihUser::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::mih::HandoverDecisionMihUser")
+        .SetParent<Application> ()
+        .AddConstructor<HandoverDecisionMihUser> ()
+        .AddAttribute ("RssiWeight",
+                       "Score per dBm of signal strength.",
+                       DoubleValue (1.0),
+                       MakeDoubleAccessor (&HandoverDecisionMihUser::m_rssiWeight),
+                       MakeDoubleChecker<double> ())
+        .AddAttribute ("SnrWeight",
+                       "Score per dB of SNR.",
+                       DoubleValue (0.0),
+                       MakeDoubleAccessor (&HandoverDecisionMihUser::m_snrWeight),
+                       MakeDoubleChecker<double> ())
+        .AddAttribute ("StationCountWeight",
+                       "Score lost per station already served by the PoA.",
+                       DoubleValue (1.0),
+                       MakeDoubleAccessor (&HandoverDecisionMihUser::m_stationCountWeight),
+                       MakeDoubleChecker<double> ())
+        .AddAttribute ("DataRateWeight",
+                       "Score per Mb/s of the highest PoA data rate.",
+                       DoubleValue (0.0),
+                       MakeDoubleAccessor (&HandoverDecisionMihUser::m_dataRateWeight),
+                       MakeDoubleChecker<double> ())
+        .AddAttribute ("CostWeight",
+                       "Score lost per unit of the cost given by the information server.",
+                       DoubleValue (0.0),
+                       MakeDoubleAccessor (&HandoverDecisionMihUser::m_costWeight),
+                       MakeDoubleChecker<double> ())
+        .AddAttribute ("VerticalPenalty",
+                       "Score lost by the PoAs of another link type than the serving one.",
+                       DoubleValue (0.0),
+                       MakeDoubleAccessor (&HandoverDecisionMihUser::m_verticalPenalty),
+                       MakeDoubleChecker<double> ())
+        .AddAttribute ("HysteresisMargin",
+                       "Score by which a candidate must beat the serving PoA.",
+                       DoubleValue (5.0),
+                       MakeDoubleAccessor (&HandoverDecisionMihUser::m_hysteresisMargin),
+                       MakeDoubleChecker<double> (0.0))
+        .AddAttribute ("TimeToTrigger",
+                       "Time a candidate must stay better than the serving PoA.",
+                       TimeValue (MilliSeconds (200)),
+                       MakeTimeAccessor (&HandoverDecisionMihUser::m_timeToTrigger),
+                       MakeTimeChecker ())
+        .AddAttribute ("MinDwellTime",
+                       "Minimum time between two handovers not forced by the serving link.",
+                       TimeValue (Seconds (2)),
+                       MakeTimeAccessor (&HandoverDecisionMihUser::m_minDwellTime),
+                       MakeTimeChecker ())
+        .AddAttribute ("CandidateTimeout",
+                       "Time after which a PoA no longer indicated is not a candidate.",
+                       TimeValue (Seconds (2)),
+                       MakeTimeAccessor (&HandoverDecisionMihUser::m_candidateTimeout),
+                       MakeTimeChecker ())
+        .AddAttribute ("PingPongInterval",
+                       "A handover back to the PoA left less than this ago is a ping-pong.",
+                       TimeValue (Seconds (5)),
+                       MakeTimeAccessor (&HandoverDecisionMihUser::m_pingPongInterval),
+                       MakeTimeChecker ())
+        .AddAttribute ("ReportInterval",
+                       "Period of the serving link signal reports configured by AddLink, "
+                       "none if zero.",
+                       TimeValue (MilliSeconds (100)),
+                       MakeTimeAccessor (&HandoverDecisionMihUser::m_reportInterval),
+                       MakeTimeChecker ())
+        .AddTraceSource ("Decision", "A handover was decided.",
+                         MakeTraceSourceAccessor (&HandoverDecisionMihUser::m_decisionTrace),
+                         "ns3::mih::HandoverDecisionMihUser::DecisionTracedCallback")
+        .AddTraceSource ("PingPong", "A handover went back to the PoA just left.",
+                         MakeTraceSourceAccessor (&HandoverDecisionMihUser::m_pingPongTrace),
+                         "ns3::mih::HandoverDecisionMihUser::PingPongTracedCallback")
+        ;
+      return tid;
+    }
+    HandoverDecisionMihUser::HandoverDecisionMihUser (void) :
+      m_running (false),
+      m_serving (NO_CANDIDATE),
+      m_servingGoingDown (false),
+      m_qualified (NO_CANDIDATE),
+      m_lastHandover (Seconds (-1e6)),
+      m_handovers (0),
+      m_pingPongs (0)
+    {
+      NS_LOG_FUNCTION (this);
+    }
+    HandoverDecisionMihUser::~HandoverDecisionMihUser (void)
+    {
+      NS_LOG_FUNCTION (this);
+    }
+    void
+    HandoverDecisionMihUser::DoDispose (void)
+    {
+      NS_LOG_FUNCTION (this);
+      m_evaluationEvent.Cancel ();
+      m_poa.clear ();
+      m_link.clear ();
+      m_rssi.clear ();
+      m_snr.clear ();
+      m_stationCount.clear ();
+      m_dataRate.clear ();
+      m_cost.clear ();
+      m_linkType.clear ();
+      m_expiry.clear ();
+      m_score.clear ();
+      m_candidateIndex.clear ();
+      m_links.clear ();
+      Application::DoDispose ();
+    }
+    void
+    HandoverDecisionMihUser::StartApplication (void)
+    {
+      NS_LOG_FUNCTION (this);
+      m_running = true;
+      m_urgentSince = Simulator::Now ();
+      Evaluate ();
+    }
+    void
+    HandoverDecisionMihUser::StopApplication (void)
+    {
+      NS_LOG_FUNCTION (this);
+      m_running = false;
+      m_evaluationEvent.Cancel ();
+    }
+    void
+    HandoverDecisionMihUser::AddLink (LinkIdentifier linkIdentifier)
+    {
+      NS_LOG_FUNCTION (this);
+
+      Ptr<MihFunction> mihf = 0;
+      mihf = GetObject<MihFunction> ();
+      NS_ASSERT (mihf != 0);
+
+      m_links.push_back (linkIdentifier);
+      mihf->EventSubscribe (mihf->GetMihfId (),
+                            linkIdentifier,
+                            MakeCallback (&HandoverDecisionMihUser::ConfirmEventSubscribe, this),
+                            EventList::LINK_DETECTED,
+                            MakeCallback (&HandoverDecisionMihUser::RecvLinkDetected, this),
+                            EventList::LINK_UP,
+                            MakeCallback (&HandoverDecisionMihUser::RecvLinkUp, this),
+                            EventList::LINK_DOWN,
+                            MakeCallback (&HandoverDecisionMihUser::RecvLinkDown, this),
+                            EventList::LINK_PARAMETERS_REPORT,
+                            MakeCallback (&HandoverDecisionMihUser::RecvLinkParametersReport, this),
+                            EventList::LINK_GOING_DOWN,
+                            MakeCallback (&HandoverDecisionMihUser::RecvLinkGoingDown, this));
+      if (m_reportInterval.IsZero ())
+        {
+          return;
+        }
+      // Periodic reports of the serving link signal;
+      Ptr<LinkParameterType> parameterType = 0;
+      switch (linkIdentifier.GetType ().GetType ())
+        {
+        case LinkType::WIRELESS_802_11:
+          parameterType = Create<LinkParameter80211> (LinkParameter80211::BEACON_CHANNEL_RSSI);
+          break;
+        case LinkType::WIRELESS_802_16:
+          parameterType = Create<LinkParameter80216> (LinkParameter80216::CINR);
+          break;
+        case LinkType::LTE:
+          parameterType = Create<LinkParameterLte> (LinkParameterLte::RSRP);
+          break;
+        default:
+          return;
+        }
+      LinkConfigurationParameterList configureParameters;
+      configureParameters.push_back (Create<LinkConfigurationParameter> (parameterType,
+                                                                         m_reportInterval.GetMilliSeconds (),
+                                                                         LinkConfigurationParameter::NORMAL_THRESHOLD,
+                                                                         ThresholdList ()));
+      mihf->LinkConfigureThresholds (mihf->GetMihfId (),
+                                     linkIdentifier,
+                                     configureParameters,
+                                     MakeCallback (&HandoverDecisionMihUser::ConfirmLinkConfigureThresholds, this));
+    }
+    void
+    HandoverDecisionMihUser::GetInformation (MihfId destMihf, double radius)
+    {
+      NS_LOG_FUNCTION (this << destMihf << radius);
+
+      Ptr<MihFunction> mihf = 0;
+      mihf = GetObject<MihFunction> ();
+      NS_ASSERT (mihf != 0);
+
+      mihf->GetInformation (destMihf, radius, LinkType (), 0,
+                            MakeCallback (&HandoverDecisionMihUser::ConfirmGetInformation, this));
+    }
+    uint32_t
+    HandoverDecisionMihUser::GetNCandidates (void) const
+    {
+      return m_poa.size ();
+    }
+    Address
+    HandoverDecisionMihUser::GetServingPoa (void) const
+    {
+      if (m_serving == NO_CANDIDATE)
+        {
+          return Address ();
+        }
+      return m_poa[m_serving];
+    }
+    uint32_t
+    HandoverDecisionMihUser::GetNHandovers (void) const
+    {
+      return m_handovers;
+    }
+    uint32_t
+    HandoverDecisionMihUser::GetNPingPongs (void) const
+    {
+      return m_pingPongs;
+    }
+    uint32_t
+    HandoverDecisionMihUser::GetCandidate (Address poa, LinkIdentifier linkIdentifier)
+    {
+      std::map<Address, uint32_t>::iterator i = m_candidateIndex.find (poa);
+      if (i != m_candidateIndex.end ())
+        {
+          return i->second;
+        }
+      uint32_t candidate = m_poa.size ();
+      m_candidateIndex[poa] = candidate;
+      m_poa.push_back (poa);
+      m_link.push_back (linkIdentifier);
+      // Unknown criteria neither favour nor penalize a PoA;
+      m_rssi.push_back (0.0);
+      m_snr.push_back (0.0);
+      m_stationCount.push_back (0.0);
+      m_dataRate.push_back (0.0);
+      m_cost.push_back (0.0);
+      m_linkType.push_back (linkIdentifier.GetType ().GetType ());
+      m_expiry.push_back (0.0);
+      m_score.push_back (0.0);
+      return candidate;
+    }
+    void
+    HandoverDecisionMihUser::Score (void)
+    {
+      uint32_t n = m_poa.size ();
+      double now = Simulator::Now ().GetSeconds ();
+      uint8_t servingType = m_serving == NO_CANDIDATE ? 0 : m_linkType[m_serving];
+      double excluded = -std::numeric_limits<double>::infinity ();
+      const double *rssi = &m_rssi[0];
+      const double *snr = &m_snr[0];
+      const double *stationCount = &m_stationCount[0];
+      const double *dataRate = &m_dataRate[0];
+      const double *cost = &m_cost[0];
+      const uint8_t *linkType = &m_linkType[0];
+      const double *expiry = &m_expiry[0];
+      double *score = &m_score[0];
+      // No branch, so that this loop is vectorized;
+      for (uint32_t i = 0; i < n; i++)
+        {
+          double s = m_rssiWeight * rssi[i]
+            + m_snrWeight * snr[i]
+            + m_dataRateWeight * dataRate[i]
+            - m_stationCountWeight * stationCount[i]
+            - m_costWeight * cost[i]
+            - m_verticalPenalty * (linkType[i] != servingType);
+          score[i] = expiry[i] >= now ? s : excluded;
+        }
+    }
+    void
+    HandoverDecisionMihUser::Evaluate (void)
+    {
+      NS_LOG_FUNCTION (this);
+      if (!m_running || m_poa.empty ())
+        {
+          return;
+        }
+      Score ();
+      uint32_t best = NO_CANDIDATE;
+      double bestScore = -std::numeric_limits<double>::infinity ();
+      for (uint32_t i = 0; i < m_score.size (); i++)
+        {
+          if (i != m_serving && m_score[i] > bestScore)
+            {
+              best = i;
+              bestScore = m_score[i];
+            }
+        }
+      if (best == NO_CANDIDATE)
+        {
+          m_qualified = NO_CANDIDATE;
+          return;
+        }
+      if (m_poa[best] == m_target)
+        {
+          // Already requested;
+          return;
+        }
+      Time now = Simulator::Now ();
+      if (m_serving == NO_CANDIDATE || m_servingGoingDown)
+        {
+          Handover (best, now - m_urgentSince);
+          return;
+        }
+      NS_LOG_LOGIC ("Best candidate " << m_poa[best] << " scores " << bestScore
+                    << ", serving PoA " << m_score[m_serving]);
+      if (bestScore < m_score[m_serving] + m_hysteresisMargin)
+        {
+          m_qualified = NO_CANDIDATE;
+          return;
+        }
+      if (best != m_qualified)
+        {
+          m_qualified = best;
+          m_qualifiedSince = now;
+        }
+      Time ready = std::max (m_qualifiedSince + m_timeToTrigger,
+                             m_lastHandover + m_minDwellTime);
+      if (now < ready)
+        {
+          ScheduleEvaluation (ready - now);
+          return;
+        }
+      Handover (best, now - m_qualifiedSince);
+    }
+    void
+    HandoverDecisionMihUser::ScheduleEvaluation (Time delay)
+    {
+      if (m_evaluationEvent.IsRunning ()
+          && Simulator::GetDelayLeft (m_evaluationEvent) <= delay)
+        {
+          return;
+        }
+      m_evaluationEvent.Cancel ();
+      m_evaluationEvent = Simulator::Schedule (delay, &HandoverDecisionMihUser::Evaluate, this);
+    }
+    void
+    HandoverDecisionMihUser::Handover (uint32_t candidate, Time latency)
+    {
+      NS_LOG_FUNCTION (this << m_poa[candidate] << latency);
+
+      Ptr<MihFunction> mihf = 0;
+      mihf = GetObject<MihFunction> ();
+      NS_ASSERT (mihf != 0);
+
+      Time now = Simulator::Now ();
+      Address poa = m_poa[candidate];
+      Address oldPoa = GetServingPoa ();
+      if (poa == m_previousPoa && now - m_lastHandover < m_pingPongInterval)
+        {
+          m_pingPongs++;
+          m_pingPongTrace (poa, m_pingPongs);
+        }
+      if (!oldPoa.IsInvalid ())
+        {
+          m_previousPoa = oldPoa;
+        }
+      m_handovers++;
+      m_lastHandover = now;
+      m_target = poa;
+      m_qualified = NO_CANDIDATE;
+      m_evaluationEvent.Cancel ();
+      m_decisionTrace (oldPoa, poa, latency);
+
+      Ptr<LinkActionRequest> actionRequest = Create<LinkActionRequest> (m_link[candidate],
+                                                                        LinkAction (LinkAction::NONE),
+                                                                        0);
+      actionRequest->SetPoaAddress (poa);
+      LinkActionRequestList actions;
+      actions.push_back (actionRequest);
+      mihf->LinkActions (mihf->GetMihfId (),
+                         actions,
+                         MakeCallback (&HandoverDecisionMihUser::ConfirmLinkActions, this));
+    }
+
+    // Event callbacks;
+    void
+    HandoverDecisionMihUser::RecvLinkDetected (MihfId sourceIdentifier,
+                                               LinkDetectedInformationList detectedInfoList)
+    {
+      NS_LOG_FUNCTION (this << sourceIdentifier << detectedInfoList.size ());
+      double expiry = (Simulator::Now () + m_candidateTimeout).GetSeconds ();
+      for (LinkDetectedInformationI i = detectedInfoList.begin (); i != detectedInfoList.end (); i++)
+        {
+          LinkIdentifier linkIdentifier = (*i)->GetLinkIdentifier ();
+          uint32_t candidate = GetCandidate (linkIdentifier.GetPoALinkAddress (), linkIdentifier);
+          // Signal strength in dBm, stored as a signed value;
+          m_rssi[candidate] = static_cast<int16_t> ((*i)->GetSignalStrength ().GetValue ());
+          m_snr[candidate] = (*i)->GetSinr ();
+          m_stationCount[candidate] = (*i)->GetStationCount ();
+          SupportedRates rates = (*i)->GetSupportedRates ();
+          for (uint8_t j = 0; j < rates.GetNRates (); j++)
+            {
+              m_dataRate[candidate] = std::max (m_dataRate[candidate], rates.GetRate (j) / 1e6);
+            }
+          if (candidate != m_serving)
+            {
+              m_expiry[candidate] = expiry;
+            }
+        }
+      Evaluate ();
+    }
+    void
+    HandoverDecisionMihUser::RecvLinkUp (MihfId sourceIdentifier,
+                                         LinkIdentifier linkIdentifier,
+                                         Address oldAR,
+                                         Address newAR,
+                                         bool ipRenewalFlag,
+                                         MobilityManagementSupport mobilityProtocol)
+    {
+      NS_LOG_FUNCTION (this << sourceIdentifier << linkIdentifier);
+      uint32_t candidate = GetCandidate (linkIdentifier.GetPoALinkAddress (), linkIdentifier);
+      if (m_serving != NO_CANDIDATE && m_serving != candidate)
+        {
+          m_expiry[m_serving] = (Simulator::Now () + m_candidateTimeout).GetSeconds ();
+        }
+      m_serving = candidate;
+      m_link[candidate] = linkIdentifier;
+      m_expiry[candidate] = std::numeric_limits<double>::infinity ();
+      m_servingGoingDown = false;
+      m_target = Address ();
+      m_qualified = NO_CANDIDATE;
+      Evaluate ();
+    }
+    void
+    HandoverDecisionMihUser::RecvLinkDown (MihfId sourceIdentifier,
+                                           LinkIdentifier linkIdentifier,
+                                           Address oldAR,
+                                           LinkDownReason reason)
+    {
+      NS_LOG_FUNCTION (this << sourceIdentifier << linkIdentifier);
+      if (m_serving != NO_CANDIDATE)
+        {
+          // Not a candidate again until detected;
+          m_expiry[m_serving] = 0.0;
+          m_previousPoa = m_poa[m_serving];
+        }
+      m_serving = NO_CANDIDATE;
+      m_servingGoingDown = false;
+      m_target = Address ();
+      m_urgentSince = Simulator::Now ();
+      Evaluate ();
+    }
+    void
+    HandoverDecisionMihUser::RecvLinkParametersReport (MihfId sourceIdentifier,
+                                                       LinkIdentifier linkIdentifier,
+                                                       LinkParameterReportList params)
+    {
+      NS_LOG_FUNCTION (this << sourceIdentifier << linkIdentifier);
+      if (m_serving == NO_CANDIDATE)
+        {
+          return;
+        }
+      for (LinkParameterReportListI i = params.begin (); i != params.end (); i++)
+        {
+          Ptr<LinkParameterValue> value = DynamicCast<LinkParameterValue> ((*i)->GetParameter ()->GetParameterValue ());
+          if (value == 0)
+            {
+              continue;
+            }
+          double sample = static_cast<int16_t> (value->GetValue ());
+          if (DynamicCast<LinkParameter80216> ((*i)->GetParameter ()->GetLinkParameterType ()) != 0)
+            {
+              m_snr[m_serving] = sample;
+            }
+          else
+            {
+              m_rssi[m_serving] = sample;
+            }
+        }
+      Evaluate ();
+    }
+    void
+    HandoverDecisionMihUser::RecvLinkGoingDown (MihfId sourceIdentifier,
+                                                LinkIdentifier linkIdentifier,
+                                                uint64_t timeInterval,
+                                                LinkGoingDownReason reason)
+    {
+      NS_LOG_FUNCTION (this << sourceIdentifier << linkIdentifier << timeInterval);
+      if (m_serving == NO_CANDIDATE || m_servingGoingDown)
+        {
+          return;
+        }
+      m_servingGoingDown = true;
+      m_urgentSince = Simulator::Now ();
+      Evaluate ();
+    }
+
+    // Command confirm callbacks;
+    void
+    HandoverDecisionMihUser::ConfirmEventSubscribe (MihfId sourceIdentifier,
+                                                    Status status,
+                                                    LinkIdentifier linkIdentifier,
+                                                    EventList events)
+    {
+      NS_LOG_FUNCTION (this << sourceIdentifier << linkIdentifier);
+      NS_LOG_DEBUG ("Status = " << status);
+    }
+    void
+    HandoverDecisionMihUser::ConfirmLinkConfigureThresholds (MihfId sourceIdentifier,
+                                                             Status status,
+                                                             LinkIdentifier linkIdentifier,
+                                                             LinkConfigurationStatusList configurationStatus)
+    {
+      NS_LOG_FUNCTION (this << sourceIdentifier << linkIdentifier);
+      NS_LOG_DEBUG ("Status = " << status);
+    }
+    void
+    HandoverDecisionMihUser::ConfirmLinkActions (MihfId sourceIdentifier,
+                                                 Status status,
+                                                 LinkActionResponseList actionResponses)
+    {
+      NS_LOG_FUNCTION (this << sourceIdentifier);
+      NS_LOG_DEBUG ("Status = " << status);
+      if (status.GetType () != Status::SUCCESS)
+        {
+          // Let the next indication choose again;
+          m_target = Address ();
+        }
+    }
+    void
+    HandoverDecisionMihUser::ConfirmGetInformation (MihfId sourceIdentifier,
+                                                    Status status,
+                                                    PoaDescriptorList poaDescriptors)
+    {
+      NS_LOG_FUNCTION (this << sourceIdentifier << poaDescriptors.size ());
+      for (PoaDescriptorListI i = poaDescriptors.begin (); i != poaDescriptors.end (); i++)
+        {
+          LinkType linkType = (*i)->GetLinkType ();
+          Address poa = (*i)->GetPoALinkAddress ();
+          Address device;
+          for (uint32_t j = 0; j < m_links.size (); j++)
+            {
+              if (m_links[j].GetType () == linkType)
+                {
+                  device = m_links[j].GetDeviceLinkAddress ();
+                }
+            }
+          uint32_t candidate = GetCandidate (poa, LinkIdentifier (linkType, device, poa));
+          DataRate dataRate = (*i)->GetDataRate ();
+          // kb/s;
+          m_dataRate[candidate] = dataRate.GetValue () / 1000.0;
+          m_cost[candidate] = (*i)->GetCost ();
+          m_linkType[candidate] = linkType.GetType ();
+        }
+    }
+  } // namespace mih
+} // namespace ns3
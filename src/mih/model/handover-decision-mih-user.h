@@ -0,0 +1,162 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef   	HANDOVER_DECISION_MIH_USER_H
+#define   	HANDOVER_DECISION_MIH_USER_H
+
+#include <vector>
+#include <map>
+#include "ns3/application.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
+#include "mih-callbacks.h"
+
+namespace ns3 {
+  namespace mih {
+    /**
+     * MIH user choosing the PoA of the links of its MIHF.
+     *
+     * The PoAs indicated by MIH_Link_Detected, the serving one updated
+     * by MIH_Link_Parameters_Report, and the ones returned by
+     * MIH_Get_Information are kept as candidates. Each indication
+     * scores all of them at once, as a weighted sum of their criteria;
+     * the best one is moved to through MIH_Link_Actions once it beat
+     * the serving PoA by HysteresisMargin for TimeToTrigger, and no
+     * sooner than MinDwellTime after the previous handover. Losing the
+     * serving PoA, or being told it is going down, moves to the best
+     * candidate at once.
+     *
+     * The candidates are stored one column per criterion, so that the
+     * scoring loop runs over contiguous arrays.
+     */
+    class HandoverDecisionMihUser : public Application {
+    public:
+      static TypeId GetTypeId (void);
+      HandoverDecisionMihUser (void);
+      virtual ~HandoverDecisionMihUser (void);
+
+      // Subscribe to the events of this link of the local MIHF;
+      void AddLink (LinkIdentifier linkIdentifier);
+      // Add the PoAs known to this information server around the node;
+      void GetInformation (MihfId destMihf, double radius);
+      uint32_t GetNCandidates (void) const;
+      Address GetServingPoa (void) const;
+      uint32_t GetNHandovers (void) const;
+      uint32_t GetNPingPongs (void) const;
+
+      // Event callbacks;
+      void RecvLinkDetected (MihfId sourceIdentifier,
+                             LinkDetectedInformationList detectedInfoList);
+      void RecvLinkUp (MihfId sourceIdentifier,
+                       LinkIdentifier linkIdentifier,
+                       Address oldAR,
+                       Address newAR,
+                       bool ipRenewalFlag,
+                       MobilityManagementSupport mobilityProtocol);
+      void RecvLinkDown (MihfId sourceIdentifier,
+                         LinkIdentifier linkIdentifier,
+                         Address oldAR,
+                         LinkDownReason reason);
+      void RecvLinkParametersReport (MihfId sourceIdentifier,
+                                     LinkIdentifier linkIdentifier,
+                                     LinkParameterReportList params);
+      void RecvLinkGoingDown (MihfId sourceIdentifier,
+                              LinkIdentifier linkIdentifier,
+                              uint64_t timeInterval,
+                              LinkGoingDownReason reason);
+      // Command confirm callbacks;
+      void ConfirmEventSubscribe (MihfId sourceIdentifier,
+                                  Status status,
+                                  LinkIdentifier linkIdentifier,
+                                  EventList events);
+      void ConfirmLinkConfigureThresholds (MihfId sourceIdentifier,
+                                           Status status,
+                                           LinkIdentifier linkIdentifier,
+                                           LinkConfigurationStatusList configurationStatus);
+      void ConfirmLinkActions (MihfId sourceIdentifier,
+                               Status status,
+                               LinkActionResponseList actionResponses);
+      void ConfirmGetInformation (MihfId sourceIdentifier,
+                                  Status status,
+                                  PoaDescriptorList poaDescriptors);
+
+      // Handover decided from the old PoA, invalid if the link was
+      // down, to the new one, latency since it became needed;
+      typedef void (* DecisionTracedCallback) (Address oldPoa, Address newPoa, Time latency);
+      // Handover back to a PoA left less than PingPongInterval ago,
+      // with the number of ping-pongs so far;
+      typedef void (* PingPongTracedCallback) (Address poa, uint32_t count);
+    protected:
+      virtual void DoDispose (void);
+    private:
+      virtual void StartApplication (void);
+      virtual void StopApplication (void);
+      uint32_t GetCandidate (Address poa, LinkIdentifier linkIdentifier);
+      void Score (void);
+      void Evaluate (void);
+      void ScheduleEvaluation (Time delay);
+      void Handover (uint32_t candidate, Time latency);
+
+      static const uint32_t NO_CANDIDATE = 0xffffffff;
+
+      // Candidate PoAs, one vector per column;
+      std::vector<Address> m_poa;
+      std::vector<LinkIdentifier> m_link;
+      std::vector<double> m_rssi;          // dBm;
+      std::vector<double> m_snr;           // dB;
+      std::vector<double> m_stationCount;
+      std::vector<double> m_dataRate;      // Mb/s;
+      std::vector<double> m_cost;
+      std::vector<uint8_t> m_linkType;
+      std::vector<double> m_expiry;        // s, infinite while serving;
+      std::vector<double> m_score;
+      std::map<Address, uint32_t> m_candidateIndex;
+
+      double m_rssiWeight;
+      double m_snrWeight;
+      double m_stationCountWeight;
+      double m_dataRateWeight;
+      double m_costWeight;
+      double m_verticalPenalty;
+      double m_hysteresisMargin;
+      Time m_reportInterval;
+      Time m_timeToTrigger;
+      Time m_minDwellTime;
+      Time m_candidateTimeout;
+      Time m_pingPongInterval;
+
+      bool m_running;
+      std::vector<LinkIdentifier> m_links;
+      uint32_t m_serving;
+      Address m_target;
+      bool m_servingGoingDown;
+      Time m_urgentSince;
+      uint32_t m_qualified;
+      Time m_qualifiedSince;
+      Time m_lastHandover;
+      Address m_previousPoa;
+      uint32_t m_handovers;
+      uint32_t m_pingPongs;
+      EventId m_evaluationEvent;
+
+      TracedCallback<Address, Address, Time> m_decisionTrace;
+      TracedCallback<Address, uint32_t> m_pingPongTrace;
+    };
+  } // namespace mih
+} // namespace ns3
+
+#endif 	    /* !HANDOVER_DECISION_MIH_USER_H */
@@ -0,0 +1,445 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <sstream>
+#include "ns3/log.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/mac16-address.h"
+#include "lte-mih-link-sap.h"
+#include "mih-device-information.h"
+#include "mih-link-parameter-lte.h"
+
+NS_LOG_COMPONENT_DEFINE ("LteMihLinkSap");
+
+namespace ns3 {
+  namespace mih {
+    NS_OBJECT_ENSURE_REGISTERED (LteMihLinkSap);
+
+    TypeId
+    LteMihLinkSap::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::mih::LteMihLinkSap")
+        .SetParent<MihLinkSap> ()
+        .AddConstructor<LteMihLinkSap> ()
+        .AddAttribute ("LinkDetectedInterval",
+                       "Minimum time between two LinkDetected of the same neighbour cell.",
+                       TimeValue (Seconds (1)),
+                       MakeTimeAccessor (&LteMihLinkSap::m_linkDetectedInterval),
+                       MakeTimeChecker ())
+        .AddAttribute ("RsrpTimeConstant",
+                       "Time constant of the moving average of the serving cell RSRP.",
+                       TimeValue (MilliSeconds (400)),
+                       MakeTimeAccessor (&LteMihLinkSap::m_rsrpTimeConstant),
+                       MakeTimeChecker ())
+        .AddAttribute ("RsrpTrendTimeConstant",
+                       "Time constant of the moving average of the RSRP slope.",
+                       TimeValue (Seconds (2)),
+                       MakeTimeAccessor (&LteMihLinkSap::m_rsrpTrendTimeConstant),
+                       MakeTimeChecker ())
+        .AddAttribute ("GoingDownThreshold",
+                       "Serving cell RSRP (dBm) below which the link is expected to be lost.",
+                       DoubleValue (-110.0),
+                       MakeDoubleAccessor (&LteMihLinkSap::m_goingDownThreshold),
+                       MakeDoubleChecker<double> ())
+        .AddAttribute ("GoingDownHorizon",
+                       "Raise LinkGoingDown once the RSRP trend is predicted to fall below "
+                       "GoingDownThreshold within this time.",
+                       TimeValue (Seconds (1)),
+                       MakeTimeAccessor (&LteMihLinkSap::m_goingDownHorizon),
+                       MakeTimeChecker ())
+        .AddAttribute ("GoingDownHysteresis",
+                       "RSRP (dB) above GoingDownThreshold the serving cell must get back to, "
+                       "and no longer fall, before LinkGoingDown may be raised again.",
+                       DoubleValue (3.0),
+                       MakeDoubleAccessor (&LteMihLinkSap::m_goingDownHysteresis),
+                       MakeDoubleChecker<double> (0.0))
+        ;
+      return tid;
+    }
+    LteMihLinkSap::LteMihLinkSap (void) :
+      m_linkIdentifier (),
+      m_servingCellId (0),
+      m_servingRsrp (0),
+      m_stationCount (0),
+      m_goingDownRaised (false)
+    {
+      NS_LOG_FUNCTION_NOARGS ();
+      m_linkIdentifier.SetType (LinkType (LinkType::LTE));
+      m_thresholdEngine.SetReportCallback (MakeCallback (&LteMihLinkSap::ReportLinkParameters, this));
+    }
+    LteMihLinkSap::~LteMihLinkSap (void)
+    {
+      NS_LOG_FUNCTION_NOARGS ();
+    }
+    void
+    LteMihLinkSap::DoDispose (void)
+    {
+      NS_LOG_FUNCTION (this);
+      m_thresholdEngine.Clear ();
+      m_detectedCells.clear ();
+      MihLinkSap::DoDispose ();
+    }
+    bool
+    LteMihLinkSap::ConnectDevice (Ptr<NetDevice> device)
+    {
+      NS_LOG_FUNCTION (this << device);
+      SetLinkAddress (device->GetAddress ());
+      std::ostringstream oss;
+      oss << "/NodeList/" << device->GetNode ()->GetId ()
+          << "/DeviceList/" << device->GetIfIndex () << "/";
+      std::string path = oss.str ();
+      std::string typeName = device->GetInstanceTypeId ().GetName ();
+      if (typeName == "ns3::LteUeNetDevice")
+        {
+          path += "$ns3::LteUeNetDevice/";
+          Config::ConnectWithoutContext (path + "ComponentCarrierMapUe/*/LteUePhy/ReportUeMeasurements",
+                                         MakeCallback (&LteMihLinkSap::ReportUeMeasurements, this));
+          Config::ConnectWithoutContext (path + "LteUeRrc/ConnectionEstablished",
+                                         MakeCallback (&LteMihLinkSap::UeConnectionEstablished, this));
+          Config::ConnectWithoutContext (path + "LteUeRrc/ConnectionTimeout",
+                                         MakeCallback (&LteMihLinkSap::UeConnectionTimeout, this));
+          Config::ConnectWithoutContext (path + "LteUeRrc/HandoverStart",
+                                         MakeCallback (&LteMihLinkSap::UeHandoverStart, this));
+          Config::ConnectWithoutContext (path + "LteUeRrc/HandoverEndOk",
+                                         MakeCallback (&LteMihLinkSap::UeHandoverEndOk, this));
+          Config::ConnectWithoutContext (path + "LteUeRrc/HandoverEndError",
+                                         MakeCallback (&LteMihLinkSap::UeHandoverEndError, this));
+          return true;
+        }
+      if (typeName == "ns3::LteEnbNetDevice")
+        {
+          path += "$ns3::LteEnbNetDevice/LteEnbRrc/";
+          Config::ConnectWithoutContext (path + "ConnectionEstablished",
+                                         MakeCallback (&LteMihLinkSap::EnbConnectionEstablished, this));
+          Config::ConnectWithoutContext (path + "HandoverStart",
+                                         MakeCallback (&LteMihLinkSap::EnbHandoverStart, this));
+          Config::ConnectWithoutContext (path + "HandoverEndOk",
+                                         MakeCallback (&LteMihLinkSap::EnbHandoverEndOk, this));
+          return true;
+        }
+      NS_LOG_WARN ("Not a LTE device: " << typeName);
+      return false;
+    }
+    Address
+    LteMihLinkSap::GetCellAddress (uint16_t cellId)
+    {
+      uint8_t buffer[2] = { static_cast<uint8_t> (cellId >> 8), static_cast<uint8_t> (cellId) };
+      Mac16Address address;
+      address.CopyFrom (buffer);
+      return address;
+    }
+    LinkIdentifier
+    LteMihLinkSap::GetCellLinkIdentifier (uint16_t cellId)
+    {
+      return LinkIdentifier (GetLinkType (), GetLinkAddress (), GetCellAddress (cellId));
+    }
+    void
+    LteMihLinkSap::ReportUeMeasurements (uint16_t rnti, uint16_t cellId,
+                                         double rsrp, double rsrq,
+                                         bool isServingCell, uint8_t componentCarrierId)
+    {
+      if (componentCarrierId != 0)
+        {
+          // Primary carrier only;
+          return;
+        }
+      if (isServingCell && cellId == m_servingCellId)
+        {
+          m_servingRsrp = rsrp;
+          NotifyLinkParameterSample (LinkThresholdEngine::LTE_PARAMETER_BASE + LinkParameterLte::RSRP, rsrp);
+          NotifyLinkParameterSample (LinkThresholdEngine::LTE_PARAMETER_BASE + LinkParameterLte::RSRQ, rsrq);
+          if (!m_rsrpTrend.Update (rsrp, m_rsrpTimeConstant, m_rsrpTrendTimeConstant))
+            {
+              return;
+            }
+          if (m_goingDownRaised)
+            {
+              if (m_rsrpTrend.GetSlope () >= 0 &&
+                  m_rsrpTrend.GetLevel () > m_goingDownThreshold + m_goingDownHysteresis)
+                {
+                  m_goingDownRaised = false;
+                }
+              return;
+            }
+          double timeToThreshold = m_rsrpTrend.GetTimeToThreshold (m_goingDownThreshold);
+          if (timeToThreshold < 0 || timeToThreshold > m_goingDownHorizon.GetSeconds ())
+            {
+              return;
+            }
+          m_goingDownRaised = true;
+          NS_LOG_INFO ("Link going down in " << timeToThreshold << "s, RSRP = " << m_rsrpTrend.GetLevel ()
+                       << " dBm, slope = " << m_rsrpTrend.GetSlope () << " dB/s, RSRQ = " << rsrq << " dB");
+          LinkGoingDown (m_mihfId, m_linkIdentifier,
+                         (uint64_t) (timeToThreshold * 1000),
+                         LinkGoingDownReason (LinkGoingDownReason::LINK_PARAMETER_DEGRADING));
+          return;
+        }
+      if (isServingCell || !IsEventSubscribed (EventList::LINK_DETECTED))
+        {
+          return;
+        }
+      Time now = Simulator::Now ();
+      std::map<uint16_t, Time>::iterator i = m_detectedCells.find (cellId);
+      if (i != m_detectedCells.end () && now < i->second + m_linkDetectedInterval)
+        {
+          return;
+        }
+      m_detectedCells[cellId] = now;
+      NS_LOG_DEBUG ("Cell " << cellId << " detected, RSRP = " << rsrp << " dBm, RSRQ = " << rsrq << " dB");
+      LinkDetectedInformation *info = new LinkDetectedInformation (GetCellLinkIdentifier (cellId),
+                                                                   NetworkIdentifier (),
+                                                                   NetworkAuxiliaryIdentifier (),
+                                                                   SignalStrength ((uint16_t) (int32_t) std::floor (rsrp)),
+                                                                   0,
+                                                                   SupportedRates (),
+                                                                   MihCapabilityFlag (),
+                                                                   NetworkCapabilities (),
+                                                                   0);
+      LinkDetectedInformationList linkDetectedInfoList;
+      linkDetectedInfoList.push_back (Ptr<LinkDetectedInformation> (info, false));
+      LinkDetected (m_mihfId, linkDetectedInfoList);
+    }
+    void
+    LteMihLinkSap::UeConnectionEstablished (uint64_t imsi, uint16_t cellId, uint16_t rnti)
+    {
+      NS_LOG_FUNCTION (this << imsi << cellId << rnti);
+      m_servingCellId = cellId;
+      m_goingDownRaised = false;
+      m_rsrpTrend.Reset ();
+      m_detectedCells.erase (cellId);
+      SetLinkIdentifier (GetCellLinkIdentifier (cellId));
+      LinkUp (m_mihfId, m_linkIdentifier, Address (), GetCellAddress (cellId), true,
+              MobilityManagementSupport (MobilityManagementSupport::MOBILE_IPV4_RFC3344));
+    }
+    void
+    LteMihLinkSap::UeConnectionTimeout (uint64_t imsi, uint16_t cellId, uint16_t rnti)
+    {
+      NS_LOG_FUNCTION (this << imsi << cellId << rnti);
+      LinkIdentifier linkIdentifier = GetCellLinkIdentifier (cellId);
+      m_servingCellId = 0;
+      LinkDown (m_mihfId, linkIdentifier, GetCellAddress (cellId),
+                LinkDownReason (LinkDownReason::PACKET_TIMEOUT));
+    }
+    void
+    LteMihLinkSap::UeHandoverStart (uint64_t imsi, uint16_t cellId, uint16_t rnti, uint16_t targetCellId)
+    {
+      NS_LOG_FUNCTION (this << imsi << cellId << rnti << targetCellId);
+      LinkHandoverImminent (m_mihfId, GetCellLinkIdentifier (cellId), GetCellLinkIdentifier (targetCellId),
+                            GetCellAddress (cellId), GetCellAddress (targetCellId));
+    }
+    void
+    LteMihLinkSap::UeHandoverEndOk (uint64_t imsi, uint16_t cellId, uint16_t rnti)
+    {
+      NS_LOG_FUNCTION (this << imsi << cellId << rnti);
+      LinkIdentifier oldLinkIdentifier = m_linkIdentifier;
+      Address oldAR = GetPoAAddress ();
+      m_servingCellId = cellId;
+      m_goingDownRaised = false;
+      m_rsrpTrend.Reset ();
+      m_detectedCells.erase (cellId);
+      SetLinkIdentifier (GetCellLinkIdentifier (cellId));
+      LinkHandoverComplete (m_mihfId, oldLinkIdentifier, m_linkIdentifier, oldAR, GetCellAddress (cellId),
+                            Status (Status::SUCCESS));
+      LinkUp (m_mihfId, m_linkIdentifier, oldAR, GetCellAddress (cellId), false,
+              MobilityManagementSupport (MobilityManagementSupport::MOBILE_IPV4_RFC3344));
+    }
+    void
+    LteMihLinkSap::UeHandoverEndError (uint64_t imsi, uint16_t cellId, uint16_t rnti)
+    {
+      NS_LOG_FUNCTION (this << imsi << cellId << rnti);
+      LinkIdentifier linkIdentifier = m_linkIdentifier;
+      Address oldAR = GetPoAAddress ();
+      m_servingCellId = 0;
+      LinkHandoverComplete (m_mihfId, linkIdentifier, GetCellLinkIdentifier (cellId), oldAR, GetCellAddress (cellId),
+                            Status (Status::UNSPECIFIED_FAILURE));
+      LinkDown (m_mihfId, linkIdentifier, oldAR, LinkDownReason (LinkDownReason::NO_RESOURCE));
+    }
+    void
+    LteMihLinkSap::EnbConnectionEstablished (uint64_t imsi, uint16_t cellId, uint16_t rnti)
+    {
+      NS_LOG_FUNCTION (this << imsi << cellId << rnti);
+      SetPoAAddress (GetCellAddress (cellId));
+      m_stationCount++;
+    }
+    void
+    LteMihLinkSap::EnbHandoverStart (uint64_t imsi, uint16_t cellId, uint16_t rnti, uint16_t targetCellId)
+    {
+      NS_LOG_FUNCTION (this << imsi << cellId << rnti << targetCellId);
+      if (m_stationCount > 0)
+        {
+          m_stationCount--;
+        }
+    }
+    void
+    LteMihLinkSap::EnbHandoverEndOk (uint64_t imsi, uint16_t cellId, uint16_t rnti)
+    {
+      NS_LOG_FUNCTION (this << imsi << cellId << rnti);
+      m_stationCount++;
+    }
+
+    LinkType
+    LteMihLinkSap::GetLinkType (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_linkIdentifier.GetType ();
+    }
+    void
+    LteMihLinkSap::SetLinkType (LinkType linkType)
+    {
+      NS_LOG_FUNCTION (this);
+      m_linkIdentifier.SetType (linkType);
+    }
+    Address
+    LteMihLinkSap::GetLinkAddress (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_linkIdentifier.GetDeviceLinkAddress ();
+    }
+    void
+    LteMihLinkSap::SetLinkAddress (Address addr)
+    {
+      NS_LOG_FUNCTION (this);
+      m_linkIdentifier.SetDeviceLinkAddress (addr);
+    }
+    LinkIdentifier
+    LteMihLinkSap::GetLinkIdentifier (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_linkIdentifier;
+    }
+    void
+    LteMihLinkSap::SetLinkIdentifier (LinkIdentifier linkIdentifier)
+    {
+      NS_LOG_FUNCTION (this);
+      m_linkIdentifier = linkIdentifier;
+    }
+    Address
+    LteMihLinkSap::GetPoAAddress (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_linkIdentifier.GetPoALinkAddress ();
+    }
+    void
+    LteMihLinkSap::SetPoAAddress (Address addr)
+    {
+      NS_LOG_FUNCTION (this);
+      m_linkIdentifier.SetPoALinkAddress (addr);
+    }
+    double
+    LteMihLinkSap::GetSignalStrength (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_servingRsrp;
+    }
+    uint32_t
+    LteMihLinkSap::GetStationCount (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_stationCount;
+    }
+    uint16_t
+    LteMihLinkSap::GetServingCellId (void) const
+    {
+      return m_servingCellId;
+    }
+    MihfId
+    LteMihLinkSap::GetMihfId ()
+    {
+      NS_LOG_FUNCTION (this);
+      return m_mihfId;
+    }
+    void
+    LteMihLinkSap::SetMihfId (MihfId mihfId)
+    {
+      NS_LOG_FUNCTION (this);
+      m_mihfId = mihfId;
+    }
+
+    LinkCapabilityDiscoverConfirm
+    LteMihLinkSap::CapabilityDiscover (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return LinkCapabilityDiscoverConfirm (Status::SUCCESS,
+                                            (EventList::LINK_DETECTED |
+                                             EventList::LINK_UP |
+                                             EventList::LINK_DOWN |
+                                             EventList::LINK_PARAMETERS_REPORT |
+                                             EventList::LINK_GOING_DOWN |
+                                             EventList::LINK_HANDOVER_IMMINENT |
+                                             EventList::LINK_HANDOVER_COMPLETE),
+                                            (MihCommandList::LINK_GET_PARAMETERS |
+                                             MihCommandList::LINK_CONFIGURE_THRESHOLDS));
+    }
+    LinkGetParametersConfirm
+    LteMihLinkSap::GetParameters (LinkParameterTypeList linkParametersRequest,
+                                  LinkStatesRequest linkStatesRequest,
+                                  LinkDescriptorsRequest descriptors)
+    {
+      NS_LOG_FUNCTION (this);
+      return LinkGetParametersConfirm ();
+    }
+    LinkConfigureThresholdsConfirm
+    LteMihLinkSap::ConfigureThresholds (LinkConfigurationParameterList configureParameters)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_thresholdEngine.Configure (configureParameters);
+    }
+    void
+    LteMihLinkSap::ReportLinkParameters (LinkParameterReportList parameters)
+    {
+      NS_LOG_FUNCTION (this);
+      LinkParametersReport (m_mihfId, m_linkIdentifier, parameters);
+    }
+    EventId
+    LteMihLinkSap::Action (LinkAction action,
+                           uint64_t executionDelay,
+                           Address poaLinkAddress,
+                           LinkActionConfirmCallback actionConfirmCb)
+    {
+      NS_LOG_FUNCTION (this << executionDelay);
+      return Simulator::Schedule (MilliSeconds (executionDelay),
+                                  &LteMihLinkSap::DoAction,
+                                  this,
+                                  action,
+                                  poaLinkAddress,
+                                  actionConfirmCb);
+    }
+    void
+    LteMihLinkSap::DoAction (LinkAction action,
+                             Address poaLinkAddress,
+                             LinkActionConfirmCallback actionConfirmCb)
+    {
+      NS_LOG_FUNCTION (this << poaLinkAddress);
+      // Handovers and the radio are driven by the LTE RRC, which takes
+      // no orders from MIH;
+      actionConfirmCb (Status (Status::SUCCESS),
+                       ScanResponseList (),
+                       LinkActionResponse::INCAPABLE,
+                       m_linkIdentifier);
+    }
+    Ptr<DeviceStatesResponse>
+    LteMihLinkSap::GetDeviceStates (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return Create<DeviceInformation> ("OEM = ns-3Team");
+    }
+  } // namespace mih
+} // namespace ns3
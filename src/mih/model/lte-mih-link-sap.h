@@ -0,0 +1,122 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef   	LTE_MIH_LINK_SAP_H
+#define   	LTE_MIH_LINK_SAP_H
+
+#include <map>
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/net-device.h"
+#include "mihf-id.h"
+#include "mih-link-sap.h"
+#include "mih-signal-trend.h"
+
+namespace ns3 {
+  namespace mih {
+    // Link SAP of a LTE UE or eNB device. The events are derived from
+    // the RRC and PHY trace sources of the device, which are hooked by
+    // configuration path so that the mih module does not depend on the
+    // lte one:
+    //
+    // - UE: neighbour cell measurements raise LinkDetected, serving
+    //   cell ones feed the RSRP/RSRQ thresholds and the RSRP trend
+    //   LinkGoingDown is raised from, with the time left before the
+    //   RSRP is predicted to reach GoingDownThreshold,
+    //   connection establishment and handover give LinkUp,
+    //   LinkHandoverImminent, LinkHandoverComplete and LinkDown;
+    // - eNB: connections and handovers keep the station count.
+    //
+    // A cell is identified by a Mac16Address holding its cell id;
+    class LteMihLinkSap : public MihLinkSap {
+    public:
+      static TypeId GetTypeId (void);
+      LteMihLinkSap (void);
+      virtual ~LteMihLinkSap (void);
+      // Hooks a LteUeNetDevice or a LteEnbNetDevice, false if the
+      // device is neither;
+      bool ConnectDevice (Ptr<NetDevice> device);
+      static Address GetCellAddress (uint16_t cellId);
+      virtual LinkType GetLinkType (void);
+      void SetLinkType (LinkType linkType);
+      virtual Address GetLinkAddress (void);
+      void SetLinkAddress (Address addr);
+      virtual LinkIdentifier GetLinkIdentifier (void);
+      virtual void SetLinkIdentifier (LinkIdentifier linkIdentifier);
+      virtual Address GetPoAAddress (void);
+      virtual void SetPoAAddress (Address addr);
+      // Serving cell RSRP (dBm);
+      virtual double GetSignalStrength (void);
+      virtual uint32_t GetStationCount (void);
+      uint16_t GetServingCellId (void) const;
+
+      virtual LinkCapabilityDiscoverConfirm CapabilityDiscover (void);
+      virtual LinkGetParametersConfirm GetParameters (LinkParameterTypeList linkParametersRequest,
+                                                      LinkStatesRequest linkStatesRequest,
+                                                      LinkDescriptorsRequest descriptors);
+      virtual LinkConfigureThresholdsConfirm ConfigureThresholds (LinkConfigurationParameterList configureParameters);
+      virtual EventId Action (LinkAction action,
+                              uint64_t executionDelay,
+                              Address poaLinkAddress,
+                              LinkActionConfirmCallback actionConfirmCb);
+      MihfId GetMihfId ();
+      void SetMihfId (MihfId mihfId);
+
+    protected:
+      virtual void DoDispose (void);
+      virtual Ptr<DeviceStatesResponse> GetDeviceStates (void);
+      void ReportLinkParameters (LinkParameterReportList parameters);
+      // Confirms every action as INCAPABLE;
+      void DoAction (LinkAction action,
+                     Address poaLinkAddress,
+                     LinkActionConfirmCallback actionConfirmCb);
+      LinkIdentifier GetCellLinkIdentifier (uint16_t cellId);
+      // LteUePhy and LteUeRrc trace sinks;
+      void ReportUeMeasurements (uint16_t rnti, uint16_t cellId,
+                                 double rsrp, double rsrq,
+                                 bool isServingCell, uint8_t componentCarrierId);
+      void UeConnectionEstablished (uint64_t imsi, uint16_t cellId, uint16_t rnti);
+      void UeConnectionTimeout (uint64_t imsi, uint16_t cellId, uint16_t rnti);
+      void UeHandoverStart (uint64_t imsi, uint16_t cellId, uint16_t rnti, uint16_t targetCellId);
+      void UeHandoverEndOk (uint64_t imsi, uint16_t cellId, uint16_t rnti);
+      void UeHandoverEndError (uint64_t imsi, uint16_t cellId, uint16_t rnti);
+      // LteEnbRrc trace sinks;
+      void EnbConnectionEstablished (uint64_t imsi, uint16_t cellId, uint16_t rnti);
+      void EnbHandoverStart (uint64_t imsi, uint16_t cellId, uint16_t rnti, uint16_t targetCellId);
+      void EnbHandoverEndOk (uint64_t imsi, uint16_t cellId, uint16_t rnti);
+
+      LinkIdentifier m_linkIdentifier;
+      MihfId m_mihfId;
+      // Zero while the UE is not connected;
+      uint16_t m_servingCellId;
+      double m_servingRsrp;
+      uint32_t m_stationCount;
+      // Last LinkDetected of each neighbour cell;
+      std::map<uint16_t, Time> m_detectedCells;
+      Time m_linkDetectedInterval;
+      // Serving cell RSRP trend, level in dBm and slope in dB/s;
+      SignalTrend m_rsrpTrend;
+      Time m_rsrpTimeConstant;
+      Time m_rsrpTrendTimeConstant;
+      double m_goingDownThreshold;
+      Time m_goingDownHorizon;
+      double m_goingDownHysteresis;
+      bool m_goingDownRaised;
+    };
+  } // namespace mih
+} // namespace ns3
+
+#endif 	    /* !LTE_MIH_LINK_SAP_H */
@@ -28,8 +28,6 @@ namespace ns3 {
       m_linkIdentifier (linkId)
     {
       NS_ASSERT_MSG (batteryLevel <= 100, "Battery level should not exceed 100%!");
-      SimulationSingleton<TlvObjectFactory<DeviceStatesResponse> >::Get ()->AddTlvTypeConstructor (TLV_BATTERY_LEVEL,
-                                                                                                   MakeCallback (&BatteryLevel::Create));
     }
     BatteryLevel::BatteryLevel (BatteryLevel const &o)
     {
@@ -37,6 +35,7 @@ namespace ns3 {
     }
     CHOICE_HELPER_IMPLEM (BatteryLevel, DeviceStatesResponse)
     TLV_TYPE_HELPER_IMPLEM (BatteryLevel, TLV_BATTERY_LEVEL)
+    TLV_OBJECT_FACTORY_REGISTER (BatteryLevel, DeviceStatesResponse, TLV_BATTERY_LEVEL)
     LinkIdentifier
     BatteryLevel::GetLinkIdentifier (void)
     {
@@ -70,44 +69,35 @@ namespace ns3 {
       os << "Battery Level = " << (int)m_batteryLevel << std::endl;
     }
     void
-    BatteryLevel::TlvSerialize (Buffer &buffer) const
+    BatteryLevel::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
       
       payloadLength = Tlv::GetSerializedSizeU8 () +
         m_linkIdentifier.GetTlvSerializedSize ();
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
 
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field +
-                                                 // Length field only;
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length
                                                        // field;
       
-      Tlv::SerializeU8 (buffer, m_batteryLevel, TLV_BATTERY_LEVEL);
-      m_linkIdentifier.TlvSerialize (buffer);
+      Tlv::SerializeU8 (i, m_batteryLevel, TLV_BATTERY_LEVEL);
+      m_linkIdentifier.TlvSerialize (i);
     }
     uint32_t
-    BatteryLevel::TlvDeserialize (Buffer &buffer)
+    BatteryLevel::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
       
-      totalBytesRead += Tlv::DeserializeU8 (buffer, m_batteryLevel, TLV_BATTERY_LEVEL);
-      totalBytesRead += m_linkIdentifier.TlvDeserialize (buffer);
+      totalBytesRead += Tlv::DeserializeU8 (i, m_batteryLevel, TLV_BATTERY_LEVEL);
+      totalBytesRead += m_linkIdentifier.TlvDeserialize (i);
       
       return totalBytesRead;
     }
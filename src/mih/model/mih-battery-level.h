@@ -40,8 +40,10 @@ namespace ns3 {
       void SetLinkIdentifier (LinkIdentifier linkIdentifier);
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
     protected:
       uint8_t m_batteryLevel;
       LinkIdentifier m_linkIdentifier;
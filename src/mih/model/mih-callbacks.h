@@ -47,6 +47,7 @@
 #include "mih-registration-code.h"
 #include "mih-event-list.h"
 #include "mih-command-list.h"
+#include "mih-poa-descriptor.h"
 
 namespace ns3 {
   namespace mih {
@@ -101,6 +102,8 @@ namespace ns3 {
     typedef Callback<void, MihfId, Status, LinkIdentifier, LinkConfigurationStatusList> MihLinkConfigureThresholdsConfirmCallback;
     // Link actions;
     typedef Callback<void, MihfId, Status, LinkActionResponseList> MihLinkActionsConfirmCallback;
+    // Get information;
+    typedef Callback<void, MihfId, Status, PoaDescriptorList> MihGetInformationConfirmCallback;
     /**
      * \param Status The status of the action.
      * \param ScanResponseList The list of discovered networks.
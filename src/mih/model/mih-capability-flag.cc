@@ -40,14 +40,14 @@ namespace ns3 {
       return Tlv::GetSerializedSizeU8 ();
     }
     void
-    MihCapabilityFlag::TlvSerialize (Buffer &buffer) const
+    MihCapabilityFlag::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU8 (buffer, m_bitmap, TLV_CAPABILITY_FLAG);
+      Tlv::SerializeU8 (i, m_bitmap, TLV_CAPABILITY_FLAG);
     }
     uint32_t
-    MihCapabilityFlag::TlvDeserialize (Buffer &buffer)
+    MihCapabilityFlag::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU8 (buffer, m_bitmap, TLV_CAPABILITY_FLAG);
+      return Tlv::DeserializeU8 (i, m_bitmap, TLV_CAPABILITY_FLAG);
     }
   } // namespace mih
 } // namespace ns3
@@ -38,8 +38,10 @@ namespace ns3 {
       MihCapabilityFlag (MihCapabilityFlag const &o);
       uint8_t GetCapabilityList (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (MihCapabilityFlag);
     protected:
       uint8_t m_bitmap;
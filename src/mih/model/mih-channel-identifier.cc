@@ -24,16 +24,14 @@ namespace ns3 {
   namespace mih {
     ChannelIdentifier::ChannelIdentifier (uint16_t channel) :
       m_channel (channel)
-    {
-      SimulationSingleton<TlvObjectFactory<LinkStatesResponse> >::Get ()->AddTlvTypeConstructor (TLV_CHANNEL_IDENTIFIER,
-                                                                                                 MakeCallback (&ChannelIdentifier::Create));
-    }
+    {}
     ChannelIdentifier::ChannelIdentifier (ChannelIdentifier const &o)
     {
       m_channel = o.m_channel;
     }
     CHOICE_HELPER_IMPLEM (ChannelIdentifier, LinkStatesResponse)
     TLV_TYPE_HELPER_IMPLEM (ChannelIdentifier, TLV_CHANNEL_IDENTIFIER)
+    TLV_OBJECT_FACTORY_REGISTER (ChannelIdentifier, LinkStatesResponse, TLV_CHANNEL_IDENTIFIER)
     uint16_t
     ChannelIdentifier::GetValue (void)
     {
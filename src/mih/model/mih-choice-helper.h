@@ -25,8 +25,6 @@
 #include <stdint.h>
 #include "ns3/ptr.h"
 #include "ns3/assert.h"
-#include "ns3/callback.h"
-#include "ns3/simulation-singleton.h"
 #include "mih-tlv-object-factory.h"
 
 #define PRINT_POSITION                            \
@@ -46,7 +44,7 @@
   Ptr<parent>                                                           \
   parent::CreateFromTlvType (uint8_t tlvTypeValue)                      \
   {                                                                     \
-    return SimulationSingleton<TlvObjectFactory<parent> >::Get ()->Create (tlvTypeValue); \
+    return TlvObjectFactory<parent>::Get ()->Create (tlvTypeValue);     \
   }                                                                     \
   uint8_t                                                               \
   parent::Register (void)                                               \
@@ -54,14 +54,14 @@ namespace ns3 {
         ;
     }
     void
-    MihCommandList::TlvSerialize (Buffer &buffer) const
+    MihCommandList::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU32 (buffer, m_bitmap, TLV_MIH_COMMAND_LIST);
+      Tlv::SerializeU32 (i, m_bitmap, TLV_MIH_COMMAND_LIST);
     }
     uint32_t 
-    MihCommandList::TlvDeserialize (Buffer &buffer)
+    MihCommandList::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU32 (buffer, m_bitmap, TLV_MIH_COMMAND_LIST);
+      return Tlv::DeserializeU32 (i, m_bitmap, TLV_MIH_COMMAND_LIST);
     }
   } // namespace mih
 } // namespace ns3
@@ -40,14 +40,14 @@ namespace ns3 {
       return Tlv::GetSerializedSizeU32 ();
     }
     void
-    DataRate::TlvSerialize (Buffer &buffer) const
+    DataRate::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU32 (buffer, m_data, TLV_DATA_RATE);
+      Tlv::SerializeU32 (i, m_data, TLV_DATA_RATE);
     }
     uint32_t
-    DataRate::TlvDeserialize (Buffer &buffer)
+    DataRate::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU32 (buffer, m_data, TLV_DATA_RATE);
+      return Tlv::DeserializeU32 (i, m_data, TLV_DATA_RATE);
     }
   } // namespace mih
 } // namespace ns3
@@ -32,8 +32,10 @@ namespace ns3 {
       DataRate (DataRate const &o);
       uint32_t GetValue (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (DataRate);
     protected:
       uint32_t m_data;
@@ -27,8 +27,6 @@ namespace ns3 {
       m_deviceInformation (deviceInformation)
     {
       NS_ASSERT_MSG (deviceInformation.length () <= 253, "Unsupported device information string");
-      SimulationSingleton<TlvObjectFactory<DeviceStatesResponse> >::Get ()->AddTlvTypeConstructor (TLV_DEVICE_INFORMATION,
-                                                                                                   MakeCallback (&DeviceInformation::Create));
     }
     DeviceInformation::DeviceInformation (DeviceInformation const &o)
     {
@@ -36,6 +34,7 @@ namespace ns3 {
     }
     CHOICE_HELPER_IMPLEM (DeviceInformation, DeviceStatesResponse)
     TLV_TYPE_HELPER_IMPLEM (DeviceInformation, TLV_DEVICE_INFORMATION)
+    TLV_OBJECT_FACTORY_REGISTER (DeviceInformation, DeviceStatesResponse, TLV_DEVICE_INFORMATION)
     const char* 
     DeviceInformation::PeekString (void)
     {
@@ -71,44 +70,34 @@ namespace ns3 {
       os << "Device Information = " << m_deviceInformation << std::endl;
     }
     void 
-    DeviceInformation::TlvSerialize (Buffer &buffer) const
+    DeviceInformation::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
 
       payloadLength = Tlv::GetSerializedSizeString (m_deviceInformation) +
         m_linkIdentifier.GetTlvSerializedSize ();
 
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field +
-                                                 // Length field only;
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length
                                                        // field;
-      Tlv::SerializeString (buffer, m_deviceInformation, GetTlvTypeValue ());
-      m_linkIdentifier.TlvSerialize (buffer);
+      Tlv::SerializeString (i, m_deviceInformation, GetTlvTypeValue ());
+      m_linkIdentifier.TlvSerialize (i);
       
     }
     uint32_t 
-    DeviceInformation::TlvDeserialize (Buffer &buffer)
+    DeviceInformation::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
-      totalBytesRead += Tlv::DeserializeString (buffer, m_deviceInformation, GetTlvTypeValue ());
-      totalBytesRead += m_linkIdentifier.TlvDeserialize (buffer);
+      totalBytesRead += Tlv::DeserializeString (i, m_deviceInformation, GetTlvTypeValue ());
+      totalBytesRead += m_linkIdentifier.TlvDeserialize (i);
       return totalBytesRead;
     }
   } // namespace mih
@@ -41,8 +41,10 @@ namespace ns3 {
       virtual void SetLinkIdentifier (LinkIdentifier linkIdentifier);
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (DeviceInformation);
     protected:
       std::string m_deviceInformation;
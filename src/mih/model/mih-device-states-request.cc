@@ -52,14 +52,14 @@ namespace ns3 {
       os << "Device State Request = " << std::hex << (int)m_deviceStatesRequest << std::endl;
     }
     void
-    DeviceStatesRequest::TlvSerialize (Buffer &buffer) const
+    DeviceStatesRequest::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU16 (buffer, m_deviceStatesRequest, TLV_DEVICE_STATES_REQUEST);
+      Tlv::SerializeU16 (i, m_deviceStatesRequest, TLV_DEVICE_STATES_REQUEST);
     }
     uint32_t 
-    DeviceStatesRequest::TlvDeserialize (Buffer &buffer) 
+    DeviceStatesRequest::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU16 (buffer, m_deviceStatesRequest, TLV_DEVICE_STATES_REQUEST);
+      return Tlv::DeserializeU16 (i, m_deviceStatesRequest, TLV_DEVICE_STATES_REQUEST);
     }
   } // namespace mih
 } // namespace ns3
@@ -40,8 +40,10 @@ namespace ns3 {
       DeviceStatesRequest operator = (DeviceStatesRequest const &o);
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (DeviceStatesRequest);
     protected:
       uint16_t m_deviceStatesRequest;
@@ -36,6 +36,13 @@ namespace ns3 {
                                             deviceStatesResponseList, 
                                             TLV_DEVICE_STATES_RESPONSE_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const DeviceStatesResponseList &deviceStatesResponseList)
+    {
+      Tlv::Serialize<DeviceStatesResponse> (i, 
+                                            deviceStatesResponseList, 
+                                            TLV_DEVICE_STATES_RESPONSE_LIST);
+    }
     uint32_t
     TlvDeserialize (Buffer &buffer, DeviceStatesResponseList &deviceStatesResponseList)
     {
@@ -43,5 +50,12 @@ namespace ns3 {
                                                    deviceStatesResponseList, 
                                                    TLV_DEVICE_STATES_RESPONSE_LIST);      
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, DeviceStatesResponseList &deviceStatesResponseList)
+    {
+      return Tlv::Deserialize<DeviceStatesResponse> (i, 
+                                                   deviceStatesResponseList, 
+                                                   TLV_DEVICE_STATES_RESPONSE_LIST);
+    }
   } // namespace mih
 } // namespace ns3
@@ -37,8 +37,10 @@ namespace ns3 {
       virtual void SetLinkIdentifier (LinkIdentifier linkIdentifier) = 0;
       virtual uint32_t GetTlvSerializedSize (void) const = 0;
       virtual void Print (std::ostream &os) const = 0;
-      virtual void TlvSerialize (Buffer &buffer) const = 0;
-      virtual uint32_t TlvDeserialize (Buffer &buffer) = 0;
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const = 0;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i) = 0;
       TLV_TYPE_HELPER_HEADER (DeviceStatesResponse);
     protected:
     };
@@ -46,7 +48,9 @@ namespace ns3 {
     typedef DeviceStatesResponseList::iterator DeviceStatesResponseListI;
     uint32_t GetTlvSerializedSize (const DeviceStatesResponseList &deviceStatesResponseList);
     void TlvSerialize (Buffer &buffer, const DeviceStatesResponseList &deviceStatesResponseList);
+    void TlvSerialize (Buffer::Iterator &i, const DeviceStatesResponseList &deviceStatesResponseList);
     uint32_t TlvDeserialize (Buffer &buffer, DeviceStatesResponseList &deviceStatesResponseList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, DeviceStatesResponseList &deviceStatesResponseList);
 
     
   } // namespace mih
@@ -63,14 +63,14 @@ namespace ns3 {
         ;
     }
     void
-    EventList::TlvSerialize (Buffer &buffer) const
+    EventList::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU32 (buffer, m_events, TLV_MIH_EVENT_LIST);
+      Tlv::SerializeU32 (i, m_events, TLV_MIH_EVENT_LIST);
     }
     uint32_t 
-    EventList::TlvDeserialize (Buffer &buffer)
+    EventList::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU32 (buffer, m_events, TLV_MIH_EVENT_LIST);
+      return Tlv::DeserializeU32 (i, m_events, TLV_MIH_EVENT_LIST);
     }
   } // namespace mih
 } // namespace ns3
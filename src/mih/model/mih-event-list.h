@@ -48,8 +48,10 @@ namespace ns3 {
       bool IsOfType (enum Type type);
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (EventList);
     protected:
       uint32_t m_events;
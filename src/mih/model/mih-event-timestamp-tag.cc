@@ -0,0 +1,91 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/assert.h"
+#include "mih-event-timestamp-tag.h"
+
+namespace ns3 {
+  namespace mih {
+    NS_OBJECT_ENSURE_REGISTERED (EventTimestampTag);
+
+    TypeId
+    EventTimestampTag::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::mih::EventTimestampTag")
+        .SetParent<Tag> ()
+        .AddConstructor<EventTimestampTag> ()
+        ;
+      return tid;
+    }
+    TypeId
+    EventTimestampTag::GetInstanceTypeId (void) const
+    {
+      return GetTypeId ();
+    }
+    EventTimestampTag::EventTimestampTag (void)
+    {
+    }
+    void
+    EventTimestampTag::AddTimestamp (Time timestamp)
+    {
+      m_timestamps.push_back (timestamp.GetTimeStep ());
+    }
+    uint32_t
+    EventTimestampTag::GetNTimestamps (void) const
+    {
+      return m_timestamps.size ();
+    }
+    Time
+    EventTimestampTag::GetTimestamp (uint32_t i) const
+    {
+      NS_ASSERT (i < m_timestamps.size ());
+      return TimeStep (m_timestamps[i]);
+    }
+    uint32_t
+    EventTimestampTag::GetSerializedSize (void) const
+    {
+      return 4 + 8 * m_timestamps.size ();
+    }
+    void
+    EventTimestampTag::Serialize (TagBuffer i) const
+    {
+      i.WriteU32 (m_timestamps.size ());
+      for (uint32_t j = 0; j < m_timestamps.size (); j++)
+        {
+          i.WriteU64 (m_timestamps[j]);
+        }
+    }
+    void
+    EventTimestampTag::Deserialize (TagBuffer i)
+    {
+      uint32_t n = i.ReadU32 ();
+      m_timestamps.resize (n);
+      for (uint32_t j = 0; j < n; j++)
+        {
+          m_timestamps[j] = i.ReadU64 ();
+        }
+    }
+    void
+    EventTimestampTag::Print (std::ostream &os) const
+    {
+      os << "Timestamps=";
+      for (uint32_t j = 0; j < m_timestamps.size (); j++)
+        {
+          os << (j == 0 ? "" : ",") << TimeStep (m_timestamps[j]);
+        }
+    }
+  } // namespace mih
+} // namespace ns3
@@ -0,0 +1,50 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef   	MIH_EVENT_TIMESTAMP_TAG_H
+#define   	MIH_EVENT_TIMESTAMP_TAG_H
+
+#include <vector>
+#include "ns3/tag.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+  namespace mih {
+    /**
+     * Byte tag of a remote event indication PDU holding the time each
+     * of its indications was raised by the link SAP, in the order they
+     * are carried. Measures the end-to-end event delay only, nothing
+     * is added to the PDU itself.
+     */
+    class EventTimestampTag : public Tag {
+    public:
+      static TypeId GetTypeId (void);
+      virtual TypeId GetInstanceTypeId (void) const;
+      EventTimestampTag (void);
+      void AddTimestamp (Time timestamp);
+      uint32_t GetNTimestamps (void) const;
+      Time GetTimestamp (uint32_t i) const;
+      virtual uint32_t GetSerializedSize (void) const;
+      virtual void Serialize (TagBuffer i) const;
+      virtual void Deserialize (TagBuffer i);
+      virtual void Print (std::ostream &os) const;
+    private:
+      std::vector<int64_t> m_timestamps;
+    };
+  } // namespace mih
+} // namespace ns3
+
+#endif 	    /* !MIH_EVENT_TIMESTAMP_TAG_H */
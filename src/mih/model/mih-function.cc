@@ -18,12 +18,19 @@
  * Author: Providence SALUMU M. <Providence.Salumu_Munga@it-sudparis.eu>
  */
 
+#include <algorithm>
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/ptr.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/mobility-model.h"
+#include "ns3/node.h"
 #include "mih-function.h"
 #include "mih-protocol.h"
+#include "mih-information-server.h"
 
 NS_LOG_COMPONENT_DEFINE ("MihFunction");
 
@@ -100,17 +107,49 @@ namespace ns3 {
                        MakeMihfIdAccessor (&MihFunction::SetMihfId,
                                            &MihFunction::GetMihfId),
                        MakeMihfIdChecker ())
+        .AddAttribute ("LinkActionsTimeout",
+                       "Time given to the link SAPs to confirm an action past its "
+                       "execution delay and duration before MIH_Link_Actions is confirmed without it.",
+                       TimeValue (MilliSeconds (100)),
+                       MakeTimeAccessor (&MihFunction::m_linkActionsTimeout),
+                       MakeTimeChecker ())
+        .AddAttribute ("InformationCacheCellSize",
+                       "Side in meters of the location cells remote MIH_Get_Information "
+                       "answers are cached for.",
+                       DoubleValue (50.0),
+                       MakeDoubleAccessor (&MihFunction::SetInformationCacheCellSize,
+                                           &MihFunction::GetInformationCacheCellSize),
+                       MakeDoubleChecker<double> (0.1))
+        .AddAttribute ("InformationCacheTimeToLive",
+                       "Time a cached MIH_Get_Information answer is reused for, zero "
+                       "disables the cache.",
+                       TimeValue (Seconds (60)),
+                       MakeTimeAccessor (&MihFunction::SetInformationCacheTimeToLive,
+                                         &MihFunction::GetInformationCacheTimeToLive),
+                       MakeTimeChecker ())
+        .AddAttribute ("InformationCacheCapacity",
+                       "Number of cells kept in the MIH_Get_Information cache, the least "
+                       "recently used is evicted first; zero disables the cache.",
+                       UintegerValue (256),
+                       MakeUintegerAccessor (&MihFunction::SetInformationCacheCapacity,
+                                             &MihFunction::GetInformationCacheCapacity),
+                       MakeUintegerChecker<uint32_t> ())
+        .AddTraceSource ("InformationCacheHit",
+                         "A remote MIH_Get_Information query was answered from the cache.",
+                         MakeTraceSourceAccessor (&MihFunction::m_informationCacheHitTrace),
+                         "ns3::mih::MihFunction::InformationCacheCallback")
+        .AddTraceSource ("InformationCacheMiss",
+                         "A remote MIH_Get_Information query was not in the cache.",
+                         MakeTraceSourceAccessor (&MihFunction::m_informationCacheMissTrace),
+                         "ns3::mih::MihFunction::InformationCacheCallback")
         ;
       return tid;
     }
     MihFunction::MihFunction (void) :
+      m_deRegisterIndicationConnected (false),
       m_registeredMihLinkSapList (),
-      m_postponedActionsConfirmCallback (MakeNullCallback<void, MihfId, Status, LinkActionResponseList> ()),
-      m_linkActionResponseList (),
-      m_linkActionConfirmEventIds (),
-      m_linkActionsCompleteEvent (),
-      m_actionRequestN (0),
-      m_linkActionsComplete (false)
+      m_pendingLinkActions (),
+      m_nextLinkActionsId (0)
     {
       NS_LOG_FUNCTION (this);
       m_mihfId = MihfId (std::to_string(CreateObject<UniformRandomVariable> ()->GetValue ())+"MIH-local@ns3");
@@ -123,25 +162,17 @@ namespace ns3 {
     MihFunction::DoDispose (void)
     {
       NS_LOG_FUNCTION (this);
-      if (!m_linkActionConfirmEventIds.empty ())
+      for (PendingLinkActionsMapI i = m_pendingLinkActions.begin (); i != m_pendingLinkActions.end (); i++)
         {
-          for (uint32_t j = 0; j < m_linkActionConfirmEventIds.size (); j++)
+          for (uint32_t j = 0; j < i->second.actionEventIds.size (); j++)
             {
-              if (m_linkActionConfirmEventIds[j].IsRunning ())
-                {
-                  m_linkActionConfirmEventIds[j].Cancel ();
-                }
+              i->second.actionEventIds[j].Cancel ();
             }
-          m_linkActionConfirmEventIds.clear ();
-        }
-      if (m_linkActionsCompleteEvent.IsRunning ())
-        {
-          m_linkActionsCompleteEvent.Cancel ();
-        }
-      if (!m_linkActionResponseList.empty ())
-        {
-          m_linkActionResponseList.clear ();
+          i->second.deadlineEvent.Cancel ();
         }
+      m_pendingLinkActions.clear ();
+      m_pendingInformationQueries.clear ();
+      m_informationCache.Clear ();
       Object::DoDispose ();
     }
     MihfId
@@ -236,6 +267,22 @@ namespace ns3 {
 	  mbbSupports.push_back (Create<MakeBeforeBreakSupport> (LinkType (LinkType::WIRELESS_802_16), 
 								 LinkType (LinkType::WIRELESS_802_16), 
 								 true));
+          mbbSupports.push_back (Create<MakeBeforeBreakSupport> (LinkType (LinkType::WIRELESS_802_11),
+                                                                 LinkType (LinkType::LTE),
+                                                                 true));
+          mbbSupports.push_back (Create<MakeBeforeBreakSupport> (LinkType (LinkType::LTE),
+                                                                 LinkType (LinkType::WIRELESS_802_11),
+                                                                 true));
+          uint64_t queryTypes = InformationServiceQueryTypeList::INVALID;
+          if (GetObject<MihInformationServer> () != 0)
+            {
+              queryTypes = (InformationServiceQueryTypeList::IE_NETWORK_TYPE |
+                            InformationServiceQueryTypeList::IE_NETWORK_ID |
+                            InformationServiceQueryTypeList::IE_COST |
+                            InformationServiceQueryTypeList::IE_NETWORK_DATA_RATE |
+                            InformationServiceQueryTypeList::IE_POA_LINK_ADDRESS |
+                            InformationServiceQueryTypeList::IE_POA_LOCATION);
+            }
 	  capabilityDiscoverConfirmCallback (GetMihfId (),
 					     Status (Status::SUCCESS),
 					     networkTypeAddressList,
@@ -258,7 +305,7 @@ namespace ns3 {
 							     MihCommandList::MN_HO_CANDIDATE_QUERY | 
 							     MihCommandList::MN_HO_COMMIT | 
 							     MihCommandList::MN_HO_COMPLETE),
-					     InformationServiceQueryTypeList (InformationServiceQueryTypeList::INVALID),
+					     InformationServiceQueryTypeList (queryTypes),
 					     TransportSupportList (TransportSupportList::UDP |
                                                                    TransportSupportList::TCP ),
 					     mbbSupports);
@@ -356,6 +403,20 @@ namespace ns3 {
     {
       NS_LOG_FUNCTION (this);
       m_mihDeRegisterIndicationTracedCallback.ConnectWithoutContext (deRegister);
+      m_deRegisterIndicationConnected = true;
+    }
+    void
+    MihFunction::DeRegisterIndication (MihfId mihfid,
+                                       MihDeRegisterResponseCallback responseCallback)
+    {
+      NS_LOG_FUNCTION (this << mihfid);
+      if (!m_deRegisterIndicationConnected)
+        {
+          // No MIH user to ask, a registrant may always leave;
+          responseCallback (GetMihfId (), Status (Status::SUCCESS));
+          return;
+        }
+      m_mihDeRegisterIndicationTracedCallback (mihfid, responseCallback);
     }
     void
     MihFunction::EventSubscribe (MihfId destinationIdentifier,
@@ -692,16 +753,16 @@ namespace ns3 {
     {
       NS_LOG_FUNCTION (this);
       NS_ASSERT (!actionsConfirmCallback.IsNull ());
-      m_postponedActionsConfirmCallback = actionsConfirmCallback;
       if (destinationIdentifier == GetMihfId ())
         {
-          uint64_t totalDelay = 0;
-          if (actionRequestList.size () == 0)
-            {
-              NS_LOG_LOGIC ("Zero Action requests were given, returning immediately...");
-              LinkActionsComplete ();
-              return;
-            }
+          uint32_t requestId = m_nextLinkActionsId++;
+          PendingLinkActions &pending = m_pendingLinkActions[requestId];
+          pending.confirmCallback = actionsConfirmCallback;
+          pending.outstanding = 0;
+          pending.dispatching = true;
+          // All actions run concurrently, so the request lasts as long as
+          // the slowest of them;
+          Time maxDuration = Seconds (0);
           for (LinkActionRequestListI i = actionRequestList.begin (); i != actionRequestList.end (); i++)
             {
               MihLinkSapListI linkSapIter;
@@ -711,26 +772,35 @@ namespace ns3 {
                                 << " was not found by Mih Function : " << GetMihfId ());
                   continue;
                 }
+              uint32_t responses = pending.responses.size ();
+              pending.outstanding++;
               EventId eventId = (*linkSapIter)->Action ((*i)->GetLinkAction (),
                                                         (*i)->GetActionExecutionDelay (),
                                                         (*i)->GetPoaAddress (),
-                                                        MakeCallback (&MihFunction::ConfirmLinkAction, this));
-              m_linkActionConfirmEventIds.push_back (eventId);
-              totalDelay += (*i)->GetActionExecutionDelay ();
-              m_actionRequestN++;
-            }
-          if (m_actionRequestN == 0)
-            {
-              m_linkActionsCompleteEvent = Simulator::Schedule (MilliSeconds (totalDelay),
-                                                                &MihFunction::LinkActionsComplete,
-                                                                this);
+                                                        MakeCallback (&MihFunction::ConfirmLinkAction, this).Bind (requestId));
+              if (eventId.IsRunning ())
+                {
+                  pending.actionEventIds.push_back (eventId);
+                  maxDuration = std::max (maxDuration,
+                                          MilliSeconds ((*i)->GetActionExecutionDelay ()) +
+                                          (*linkSapIter)->GetActionDuration ((*i)->GetLinkAction ()));
+                }
+              else if (pending.responses.size () == responses)
+                {
+                  // Refused by the link SAP, no confirm will follow;
+                  pending.outstanding--;
+                }
             }
-          else
+          pending.dispatching = false;
+          if (pending.outstanding == 0)
             {
-              m_linkActionsCompleteEvent = Simulator::Schedule (MilliSeconds (totalDelay + 5), /* safety, 5 ms*/
-                                                                &MihFunction::LinkActionsComplete,
-                                                                this);
+              LinkActionsComplete (requestId);
+              return;
             }
+          pending.deadlineEvent = Simulator::Schedule (maxDuration + m_linkActionsTimeout,
+                                                       &MihFunction::LinkActionsComplete,
+                                                       this,
+                                                       requestId);
         }
       else
         {
@@ -743,17 +813,21 @@ namespace ns3 {
         }
     }    
     void 
-    MihFunction::ConfirmLinkAction (Status status, 
+    MihFunction::ConfirmLinkAction (uint32_t requestId,
+                                    Status status, 
                                     ScanResponseList scans,
                                     LinkActionResponse::ActionResult actionResult,
                                     LinkIdentifier linkIdentifier)
     {
-      NS_LOG_FUNCTION (this);
+      NS_LOG_FUNCTION (this << requestId);
       NS_ASSERT (status.GetType () != Status::AUTHORIZATION_FAILURE);
-      if (m_linkActionsComplete)
+      PendingLinkActionsMapI i = m_pendingLinkActions.find (requestId);
+      if (i == m_pendingLinkActions.end ())
         {
+          // Confirmed after the deadline;
           return;
         }
+      PendingLinkActions &pending = i->second;
       Ptr<LinkActionResponse> actionResponse = Create<LinkActionResponse> (linkIdentifier.GetType (),
                                                                            linkIdentifier.GetDeviceLinkAddress (),
                                                                            actionResult);
@@ -761,37 +835,195 @@ namespace ns3 {
         {
           actionResponse->SetScanResponseList (scans);
         }
-      m_linkActionResponseList.push_back (actionResponse);
-      
-      if (m_linkActionResponseList.size () == m_actionRequestN)
+      pending.responses.push_back (actionResponse);
+      NS_ASSERT (pending.outstanding > 0);
+      pending.outstanding--;
+      if (pending.outstanding == 0 && !pending.dispatching)
+        {
+          LinkActionsComplete (requestId);
+        }
+    }
+    void
+    MihFunction::LinkActionsComplete (uint32_t requestId)
+    {
+      NS_LOG_FUNCTION (this << requestId);
+      PendingLinkActionsMapI i = m_pendingLinkActions.find (requestId);
+      NS_ASSERT (i != m_pendingLinkActions.end ());
+      if (i->second.outstanding > 0)
+        {
+          NS_LOG_LOGIC (i->second.outstanding << " link actions not confirmed in time");
+        }
+      for (uint32_t j = 0; j < i->second.actionEventIds.size (); j++)
         {
-          NS_ASSERT (m_linkActionsCompleteEvent.IsRunning ());
-          m_linkActionsCompleteEvent.Cancel ();
-          m_linkActionsComplete = true;
-          LinkActionsComplete ();
+          i->second.actionEventIds[j].Cancel ();
         }
+      i->second.deadlineEvent.Cancel ();
+      MihLinkActionsConfirmCallback confirmCallback = i->second.confirmCallback;
+      LinkActionResponseList responses = i->second.responses;
+      m_pendingLinkActions.erase (i);
+      confirmCallback (GetMihfId (), Status (Status::SUCCESS), responses);
     }
     void
-    MihFunction::LinkActionsComplete (void)
+    MihFunction::GetInformation (MihfId destinationIdentifier,
+                                 Vector position,
+                                 double radius,
+                                 LinkType linkType,
+                                 uint32_t maxResults,
+                                 MihGetInformationConfirmCallback getInformationConfirmCallback)
     {
       NS_LOG_FUNCTION (this);
-      NS_ASSERT (m_linkActionsCompleteEvent.IsExpired ());
-      if (!m_linkActionsComplete) // Timer timeout!
+      if (destinationIdentifier == GetMihfId ())
         {
-          m_linkActionsComplete = true;
+          Ptr<MihInformationServer> informationServer = GetObject<MihInformationServer> ();
+          if (informationServer == 0)
+            {
+              NS_LOG_WARN ("No information server on " << GetMihfId ());
+              getInformationConfirmCallback (GetMihfId (),
+                                             Status (Status::REJECTED),
+                                             PoaDescriptorList ());
+              return;
+            }
+          getInformationConfirmCallback (GetMihfId (),
+                                         Status (Status::SUCCESS),
+                                         informationServer->Query (position,
+                                                                   radius,
+                                                                   linkType,
+                                                                   maxResults));
         }
-      for (uint32_t j = 0; j < m_linkActionConfirmEventIds.size (); j++)
+      else if (!m_informationCache.IsEnabled ())
+        {
+          Ptr<MihProtocol> mihProtocol = 0;
+          mihProtocol = GetObject<MihProtocol> ();
+          NS_ASSERT (mihProtocol);
+          mihProtocol->SendGetInformationRequest (destinationIdentifier,
+                                                  position,
+                                                  radius,
+                                                  linkType,
+                                                  maxResults,
+                                                  getInformationConfirmCallback);
+        }
+      else
         {
-          if (m_linkActionConfirmEventIds[j].IsRunning ())
+          InformationCacheKey key = m_informationCache.GetKey (destinationIdentifier,
+                                                               position,
+                                                               radius,
+                                                               linkType);
+          PoaDescriptorList poas;
+          if (m_informationCache.Lookup (key, poas))
             {
-              m_linkActionConfirmEventIds[j].Cancel ();
+              m_informationCacheHitTrace (destinationIdentifier, position);
+              getInformationConfirmCallback (destinationIdentifier,
+                                             Status (Status::SUCCESS),
+                                             InformationCache::Filter (poas, position, radius, maxResults));
+              return;
+            }
+          m_informationCacheMissTrace (destinationIdentifier, position);
+          PendingInformationQuery query;
+          query.position = position;
+          query.radius = radius;
+          query.maxResults = maxResults;
+          query.confirmCallback = getInformationConfirmCallback;
+          std::vector<PendingInformationQuery> &waiting = m_pendingInformationQueries[key];
+          waiting.push_back (query);
+          if (waiting.size () > 1)
+            {
+              // The answer for this cell is on its way;
+              return;
             }
+          Ptr<MihProtocol> mihProtocol = 0;
+          mihProtocol = GetObject<MihProtocol> ();
+          NS_ASSERT (mihProtocol);
+          mihProtocol->SendGetInformationRequest (destinationIdentifier,
+                                                  m_informationCache.GetCellCenter (key),
+                                                  m_informationCache.GetCellQueryRadius (key),
+                                                  linkType,
+                                                  0,
+                                                  MakeCallback (&MihFunction::CompleteInformationQuery, this).Bind (key));
         }
-      NS_ASSERT (!m_postponedActionsConfirmCallback.IsNull ());
-      m_postponedActionsConfirmCallback (GetMihfId (), 
-                                         Status (Status::SUCCESS),
-                                         m_linkActionResponseList);
-      m_postponedActionsConfirmCallback = MakeNullCallback<void, MihfId, Status, LinkActionResponseList> ();
+    }
+    void
+    MihFunction::GetInformation (MihfId destinationIdentifier,
+                                 double radius,
+                                 LinkType linkType,
+                                 uint32_t maxResults,
+                                 MihGetInformationConfirmCallback getInformationConfirmCallback)
+    {
+      NS_LOG_FUNCTION (this);
+      Ptr<MobilityModel> mobility = GetObject<MobilityModel> ();
+      if (mobility == 0)
+        {
+          Ptr<MihProtocol> mihProtocol = GetObject<MihProtocol> ();
+          if (mihProtocol != 0 && mihProtocol->GetNode () != 0)
+            {
+              mobility = mihProtocol->GetNode ()->GetObject<MobilityModel> ();
+            }
+        }
+      NS_ASSERT_MSG (mobility != 0, "No MobilityModel to take the query position from");
+      GetInformation (destinationIdentifier,
+                      mobility->GetPosition (),
+                      radius,
+                      linkType,
+                      maxResults,
+                      getInformationConfirmCallback);
+    }
+    void
+    MihFunction::CompleteInformationQuery (InformationCacheKey key,
+                                           MihfId mihfId,
+                                           Status status,
+                                           PoaDescriptorList poaDescriptorList)
+    {
+      NS_LOG_FUNCTION (this);
+      PendingInformationQueryMap::iterator i = m_pendingInformationQueries.find (key);
+      if (i == m_pendingInformationQueries.end ())
+        {
+          return;
+        }
+      std::vector<PendingInformationQuery> waiting;
+      waiting.swap (i->second);
+      m_pendingInformationQueries.erase (i);
+      if (status.GetType () == Status::SUCCESS)
+        {
+          m_informationCache.Insert (key, poaDescriptorList);
+        }
+      for (uint32_t j = 0; j < waiting.size (); j++)
+        {
+          waiting[j].confirmCallback (mihfId,
+                                      status,
+                                      InformationCache::Filter (poaDescriptorList,
+                                                                waiting[j].position,
+                                                                waiting[j].radius,
+                                                                waiting[j].maxResults));
+        }
+    }
+    void
+    MihFunction::SetInformationCacheCellSize (double cellSize)
+    {
+      m_informationCache.SetCellSize (cellSize);
+    }
+    double
+    MihFunction::GetInformationCacheCellSize (void) const
+    {
+      return m_informationCache.GetCellSize ();
+    }
+    void
+    MihFunction::SetInformationCacheTimeToLive (Time ttl)
+    {
+      m_informationCache.SetTimeToLive (ttl);
+    }
+    Time
+    MihFunction::GetInformationCacheTimeToLive (void) const
+    {
+      return m_informationCache.GetTimeToLive ();
+    }
+    void
+    MihFunction::SetInformationCacheCapacity (uint32_t capacity)
+    {
+      m_informationCache.SetCapacity (capacity);
+    }
+    uint32_t
+    MihFunction::GetInformationCacheCapacity (void) const
+    {
+      return m_informationCache.GetCapacity ();
     }
   } // namespace mih
 } // namespace ns3
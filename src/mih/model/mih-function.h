@@ -22,12 +22,16 @@
 #define   	MIH_FUNCTION_H
 
 #include <vector>
+#include <map>
+#include <unordered_map>
 #include <stdint.h>
 #include "ns3/object.h"
+#include "ns3/nstime.h"
 #include "ns3/callback.h"
 #include "ns3/traced-callback.h"
 #include "ns3/address.h"
 #include "ns3/event-id.h"
+#include "ns3/vector.h"
 #include "mih-callbacks.h"
 #include "mihf-id.h"
 #include "mih-link-detected-information.h"
@@ -50,6 +54,7 @@
 #include "mih-network-type-address.h"
 #include "mih-event-configuration-information.h"
 #include "mih-link-sap.h"
+#include "mih-information-cache.h"
 
 namespace ns3 {
   namespace mih {
@@ -128,6 +133,21 @@ namespace ns3 {
       void LinkActions (MihfId destinationIdentifier,
                         LinkActionRequestList actionRequestList,
                         MihLinkActionsConfirmCallback actionsConfirmCallback);
+      // Answered by the MihInformationServer aggregated to the
+      // destination node;
+      void GetInformation (MihfId destinationIdentifier,
+                           Vector position,
+                           double radius,
+                           LinkType linkType,
+                           uint32_t maxResults,
+                           MihGetInformationConfirmCallback getInformationConfirmCallback);
+      // Same, around the position of the node MobilityModel;
+      void GetInformation (MihfId destinationIdentifier,
+                           double radius,
+                           LinkType linkType,
+                           uint32_t maxResults,
+                           MihGetInformationConfirmCallback getInformationConfirmCallback);
+      typedef void (* InformationCacheCallback) (MihfId server, Vector position);
       
     protected:
       virtual void DoDispose (void);
@@ -135,14 +155,37 @@ namespace ns3 {
       MihCapabilityDiscoverIndicationTracedCallback m_mihCapabilityDiscoverIndicationTracedCallback;
       MihRegisterIndicationTracedCallback m_mihRegisterIndicationTracedCallback;
       MihDeRegisterIndicationTracedCallback m_mihDeRegisterIndicationTracedCallback;
+      bool m_deRegisterIndicationConnected;
       MihLinkSapList m_registeredMihLinkSapList;
 
-      MihLinkActionsConfirmCallback m_postponedActionsConfirmCallback;
-      LinkActionResponseList m_linkActionResponseList;
-      std::vector<EventId> m_linkActionConfirmEventIds;
-      EventId m_linkActionsCompleteEvent;
-      uint32_t m_actionRequestN;
-      bool m_linkActionsComplete;
+      // One MIH_Link_Actions request, confirmed once its last action is;
+      struct PendingLinkActions {
+        MihLinkActionsConfirmCallback confirmCallback;
+        LinkActionResponseList responses;
+        std::vector<EventId> actionEventIds;
+        EventId deadlineEvent;
+        uint32_t outstanding;
+        bool dispatching;
+      };
+      typedef std::map<uint32_t, PendingLinkActions> PendingLinkActionsMap;
+      typedef PendingLinkActionsMap::iterator PendingLinkActionsMapI;
+      PendingLinkActionsMap m_pendingLinkActions;
+      uint32_t m_nextLinkActionsId;
+      Time m_linkActionsTimeout;
+
+      // Remote MIH_Get_Information answers, and the queries waiting
+      // for the answer of their cell;
+      struct PendingInformationQuery {
+        Vector position;
+        double radius;
+        uint32_t maxResults;
+        MihGetInformationConfirmCallback confirmCallback;
+      };
+      typedef std::unordered_map<InformationCacheKey, std::vector<PendingInformationQuery>, InformationCacheKeyHash> PendingInformationQueryMap;
+      InformationCache m_informationCache;
+      PendingInformationQueryMap m_pendingInformationQueries;
+      TracedCallback<MihfId, Vector> m_informationCacheHitTrace;
+      TracedCallback<MihfId, Vector> m_informationCacheMissTrace;
 
     private:
       friend class MihProtocol;
@@ -150,6 +193,17 @@ namespace ns3 {
       MihLinkSapListI GetRegisteredMihLinkSapListBegin (void);
       MihLinkSapListI GetRegisteredMihLinkSapListEnd (void);
       uint32_t GetRegisteredMihLinkSapListN (void);
+      // GetInformation;
+      void CompleteInformationQuery (InformationCacheKey key,
+                                     MihfId mihfId,
+                                     Status status,
+                                     PoaDescriptorList poaDescriptorList);
+      void SetInformationCacheCellSize (double cellSize);
+      double GetInformationCacheCellSize (void) const;
+      void SetInformationCacheTimeToLive (Time ttl);
+      Time GetInformationCacheTimeToLive (void) const;
+      void SetInformationCacheCapacity (uint32_t capacity);
+      uint32_t GetInformationCacheCapacity (void) const;
       // EventSubscribe
       void EventSubscribe (MihfId destinationIdentifier,
                           LinkIdentifier linkIdentifier,
@@ -177,6 +231,9 @@ namespace ns3 {
                                LinkIdentifierList linkIdentifierList, 
                                RegistrationCode registrationCode,
                                MihRegisterResponseCallback responseCallback);
+      // DeRegister
+      void DeRegisterIndication (MihfId mihfid,
+                                 MihDeRegisterResponseCallback responseCallback);
       // CapabilityDiscover;
       void CapabilityDiscoverIndication (MihfId mihfId,
                                          NetworkTypeAddressList networkTypeAddresses,
@@ -187,11 +244,12 @@ namespace ns3 {
                                          MakeBeforeBreakSupportList makeBeforeBreakSupports,
                                          MihCapabilityDiscoverResponseCallback capabilityDiscoverResponseCallback);
       // LinkActions;
-      void ConfirmLinkAction (Status status, 
+      void ConfirmLinkAction (uint32_t requestId,
+                              Status status, 
                               ScanResponseList scans,
                               LinkActionResponse::ActionResult actionResult, 
                               LinkIdentifier linkIdentifier);
-      void LinkActionsComplete (void);
+      void LinkActionsComplete (uint32_t requestId);
     };
   } // namespace mih
 } // namespace ns3
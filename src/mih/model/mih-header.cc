@@ -61,6 +61,26 @@ namespace ns3 {
     {
       return static_cast<enum MihHeader::VersionE> (m_version);
     }
+    void
+    MihHeader::SetAckRequest (bool ackRequest)
+    {
+      m_ackRequest = ackRequest ? 1 : 0;
+    }
+    bool
+    MihHeader::GetAckRequest (void)
+    {
+      return m_ackRequest == 1;
+    }
+    void
+    MihHeader::SetAckResponse (bool ackResponse)
+    {
+      m_ackResponse = ackResponse ? 1 : 0;
+    }
+    bool
+    MihHeader::GetAckResponse (void)
+    {
+      return m_ackResponse == 1;
+    }
     void 
     MihHeader::SetServiceId (enum MihHeader::ServiceIdE sid)
     {
@@ -56,6 +56,8 @@ namespace ns3 {
 	MIH_LINK_GOING_DOWN,
 	MIH_LINK_HANDOVER_IMMINENT,
 	MIH_LINK_HANDOVER_COMPLETE,
+	MIH_LINK_EVENT_BATCH, // Experimental, several indications
+			      // in a single PDU;
 	/* 	MIH messages for Command Service */
 	MIH_LINK_GET_PARAMETERS = 1,
 	MIH_LINK_CONFIGURE_THRESHOLDS,
@@ -76,6 +78,12 @@ namespace ns3 {
       MihHeader (void);
       void SetVersion (enum VersionE version);
       enum VersionE GetVersion (void);
+      // ACK-Req asks the peer to acknowledge a request on receipt,
+      // ACK-Rsp marks that acknowledgement;
+      void SetAckRequest (bool ackRequest);
+      bool GetAckRequest (void);
+      void SetAckResponse (bool ackResponse);
+      bool GetAckResponse (void);
       void SetServiceId (enum ServiceIdE sid);
       enum ServiceIdE GetServiceId (void);
       void SetOpCode (enum OpCodeE opcode);
@@ -0,0 +1,226 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+#include "mih-information-cache.h"
+
+namespace ns3 {
+  namespace mih {
+    bool
+    operator == (const InformationCacheKey &a, const InformationCacheKey &b)
+    {
+      return a.x == b.x && a.y == b.y && a.z == b.z &&
+        a.linkType == b.linkType && a.radius == b.radius &&
+        a.server == b.server;
+    }
+    bool
+    operator != (const InformationCacheKey &a, const InformationCacheKey &b)
+    {
+      return !(a == b);
+    }
+    std::size_t
+    InformationCacheKeyHash::operator () (const InformationCacheKey &key) const
+    {
+      std::size_t h = key.server.GetHandle ();
+      h = h * 31 + static_cast<uint32_t> (key.x);
+      h = h * 31 + static_cast<uint32_t> (key.y);
+      h = h * 31 + static_cast<uint32_t> (key.z);
+      h = h * 31 + key.linkType;
+      h = h * 31 + key.radius;
+      return h;
+    }
+
+    typedef std::pair<double, Ptr<PoaDescriptor> > PoaMatch;
+
+    static bool
+    IsCloser (const PoaMatch &a, const PoaMatch &b)
+    {
+      return a.first < b.first;
+    }
+
+    InformationCache::InformationCache (void) :
+      m_cellSize (50.0),
+      m_ttl (Seconds (60)),
+      m_capacity (256)
+    {}
+    void
+    InformationCache::SetCellSize (double cellSize)
+    {
+      NS_ASSERT (cellSize > 0);
+      m_cellSize = cellSize;
+      Clear ();
+    }
+    double
+    InformationCache::GetCellSize (void) const
+    {
+      return m_cellSize;
+    }
+    void
+    InformationCache::SetTimeToLive (Time ttl)
+    {
+      m_ttl = ttl;
+    }
+    Time
+    InformationCache::GetTimeToLive (void) const
+    {
+      return m_ttl;
+    }
+    void
+    InformationCache::SetCapacity (uint32_t capacity)
+    {
+      m_capacity = capacity;
+      while (m_entries.size () > m_capacity)
+        {
+          Evict (m_entries.find (m_lru.back ()));
+        }
+    }
+    uint32_t
+    InformationCache::GetCapacity (void) const
+    {
+      return m_capacity;
+    }
+    bool
+    InformationCache::IsEnabled (void) const
+    {
+      return m_capacity > 0 && m_ttl.IsStrictlyPositive ();
+    }
+    int32_t
+    InformationCache::GetCellCoordinate (double value) const
+    {
+      return static_cast<int32_t> (std::floor (value / m_cellSize));
+    }
+    InformationCacheKey
+    InformationCache::GetKey (MihfId server,
+                              Vector position,
+                              double radius,
+                              LinkType linkType) const
+    {
+      InformationCacheKey key;
+      key.server = server;
+      key.x = GetCellCoordinate (position.x);
+      key.y = GetCellCoordinate (position.y);
+      key.z = GetCellCoordinate (position.z);
+      key.linkType = linkType.GetType ();
+      key.radius = static_cast<uint32_t> (radius * 100 + 0.5);
+      return key;
+    }
+    Vector
+    InformationCache::GetCellCenter (const InformationCacheKey &key) const
+    {
+      return Vector ((key.x + 0.5) * m_cellSize,
+                     (key.y + 0.5) * m_cellSize,
+                     (key.z + 0.5) * m_cellSize);
+    }
+    double
+    InformationCache::GetCellQueryRadius (const InformationCacheKey &key) const
+    {
+      return key.radius / 100.0 + m_cellSize * std::sqrt (3.0) / 2;
+    }
+    bool
+    InformationCache::Lookup (const InformationCacheKey &key, PoaDescriptorList &poas)
+    {
+      EntryMap::iterator i = m_entries.find (key);
+      if (i == m_entries.end ())
+        {
+          return false;
+        }
+      if (i->second.expires <= Simulator::Now ())
+        {
+          Evict (i);
+          return false;
+        }
+      m_lru.splice (m_lru.begin (), m_lru, i->second.lru);
+      poas = i->second.poas;
+      return true;
+    }
+    void
+    InformationCache::Insert (const InformationCacheKey &key, PoaDescriptorList poas)
+    {
+      if (!IsEnabled ())
+        {
+          return;
+        }
+      EntryMap::iterator i = m_entries.find (key);
+      if (i == m_entries.end ())
+        {
+          if (m_entries.size () >= m_capacity)
+            {
+              Evict (m_entries.find (m_lru.back ()));
+            }
+          m_lru.push_front (key);
+          i = m_entries.insert (std::make_pair (key, Entry ())).first;
+          i->second.lru = m_lru.begin ();
+        }
+      else
+        {
+          m_lru.splice (m_lru.begin (), m_lru, i->second.lru);
+        }
+      i->second.poas = poas;
+      i->second.expires = Simulator::Now () + m_ttl;
+    }
+    void
+    InformationCache::Evict (EntryMap::iterator i)
+    {
+      NS_ASSERT (i != m_entries.end ());
+      m_lru.erase (i->second.lru);
+      m_entries.erase (i);
+    }
+    uint32_t
+    InformationCache::GetSize (void) const
+    {
+      return m_entries.size ();
+    }
+    void
+    InformationCache::Clear (void)
+    {
+      m_entries.clear ();
+      m_lru.clear ();
+    }
+    PoaDescriptorList
+    InformationCache::Filter (const PoaDescriptorList &poas,
+                              Vector position,
+                              double radius,
+                              uint32_t maxResults)
+    {
+      std::vector<PoaMatch> matches;
+      for (uint32_t j = 0; j < poas.size (); j++)
+        {
+          double distance = CalculateDistance (position, poas[j]->GetPosition ());
+          if (distance <= radius)
+            {
+              matches.push_back (std::make_pair (distance, poas[j]));
+            }
+        }
+      uint32_t n = matches.size ();
+      if (maxResults != 0 && maxResults < n)
+        {
+          n = maxResults;
+        }
+      std::partial_sort (matches.begin (), matches.begin () + n, matches.end (),
+                         &IsCloser);
+      PoaDescriptorList result;
+      result.reserve (n);
+      for (uint32_t j = 0; j < n; j++)
+        {
+          result.push_back (matches[j].second);
+        }
+      return result;
+    }
+  } // namespace mih
+} // namespace ns3
@@ -0,0 +1,101 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef   	MIH_INFORMATION_CACHE_H
+#define   	MIH_INFORMATION_CACHE_H
+
+#include <list>
+#include <unordered_map>
+#include <stdint.h>
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+#include "mihf-id.h"
+#include "mih-link-type.h"
+#include "mih-poa-descriptor.h"
+
+namespace ns3 {
+  namespace mih {
+    // Answers of one information server valid anywhere within one
+    // location cell, for one link type and query radius;
+    struct InformationCacheKey {
+      MihfId server;
+      int32_t x;
+      int32_t y;
+      int32_t z;
+      uint8_t linkType;
+      uint32_t radius; // Centimeters;
+    };
+    bool operator == (const InformationCacheKey &a, const InformationCacheKey &b);
+    bool operator != (const InformationCacheKey &a, const InformationCacheKey &b);
+    struct InformationCacheKeyHash {
+      std::size_t operator () (const InformationCacheKey &key) const;
+    };
+    /**
+     * Client side store of MIH_Get_Information answers, bounded in
+     * number of entries (the least recently used one is evicted first)
+     * and in age.
+     *
+     * A cell is fetched once with a radius widened by half its
+     * diagonal, around its center, so that the answer holds every PoA
+     * near any position of the cell; Filter then narrows it down to
+     * the actual query.
+     */
+    class InformationCache {
+    public:
+      InformationCache (void);
+      void SetCellSize (double cellSize);
+      double GetCellSize (void) const;
+      void SetTimeToLive (Time ttl);
+      Time GetTimeToLive (void) const;
+      void SetCapacity (uint32_t capacity);
+      uint32_t GetCapacity (void) const;
+      bool IsEnabled (void) const;
+      InformationCacheKey GetKey (MihfId server,
+                                  Vector position,
+                                  double radius,
+                                  LinkType linkType) const;
+      Vector GetCellCenter (const InformationCacheKey &key) const;
+      double GetCellQueryRadius (const InformationCacheKey &key) const;
+      // Fresh answers only, the entry becomes the most recently used;
+      bool Lookup (const InformationCacheKey &key, PoaDescriptorList &poas);
+      void Insert (const InformationCacheKey &key, PoaDescriptorList poas);
+      uint32_t GetSize (void) const;
+      void Clear (void);
+      // PoAs within radius of position, nearest first;
+      static PoaDescriptorList Filter (const PoaDescriptorList &poas,
+                                       Vector position,
+                                       double radius,
+                                       uint32_t maxResults);
+    private:
+      typedef std::list<InformationCacheKey> LruList;
+      struct Entry {
+        PoaDescriptorList poas;
+        Time expires;
+        LruList::iterator lru;
+      };
+      typedef std::unordered_map<InformationCacheKey, Entry, InformationCacheKeyHash> EntryMap;
+      int32_t GetCellCoordinate (double value) const;
+      void Evict (EntryMap::iterator i);
+      double m_cellSize;
+      Time m_ttl;
+      uint32_t m_capacity;
+      EntryMap m_entries;
+      LruList m_lru; // Most recently used first;
+    };
+  } // namespace mih
+} // namespace ns3
+
+#endif 	    /* !MIH_INFORMATION_CACHE_H */
@@ -0,0 +1,226 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/double.h"
+#include "mih-information-server.h"
+
+NS_LOG_COMPONENT_DEFINE ("MihInformationServer");
+
+namespace ns3 {
+  namespace mih {
+    NS_OBJECT_ENSURE_REGISTERED (MihInformationServer);
+
+    typedef std::pair<double, Ptr<PoaDescriptor> > PoaMatch;
+
+    static bool
+    IsCloser (const PoaMatch &a, const PoaMatch &b)
+    {
+      return a.first < b.first;
+    }
+
+    TypeId
+    MihInformationServer::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::mih::MihInformationServer")
+        .SetParent<Object> ()
+        .AddConstructor<MihInformationServer> ()
+        .AddAttribute ("CellSize",
+                       "Side in meters of the grid cells the PoAs are indexed by; "
+                       "about the typical query radius works best.",
+                       DoubleValue (100.0),
+                       MakeDoubleAccessor (&MihInformationServer::SetCellSize,
+                                           &MihInformationServer::GetCellSize),
+                       MakeDoubleChecker<double> (1.0))
+        .AddTraceSource ("Query", "A PoA query was answered.",
+                         MakeTraceSourceAccessor (&MihInformationServer::m_queryTrace),
+                         "ns3::mih::MihInformationServer::QueryCallback")
+        ;
+      return tid;
+    }
+    MihInformationServer::MihInformationServer (void) :
+      m_cellSize (100.0)
+    {
+      NS_LOG_FUNCTION (this);
+    }
+    MihInformationServer::~MihInformationServer (void)
+    {
+      NS_LOG_FUNCTION (this);
+    }
+    void
+    MihInformationServer::DoDispose (void)
+    {
+      NS_LOG_FUNCTION (this);
+      m_grid.clear ();
+      m_poaCells.clear ();
+      Object::DoDispose ();
+    }
+    void
+    MihInformationServer::SetCellSize (double cellSize)
+    {
+      NS_LOG_FUNCTION (this << cellSize);
+      m_cellSize = cellSize;
+      // Bucket the known PoAs again;
+      Grid grid;
+      grid.swap (m_grid);
+      m_poaCells.clear ();
+      for (Grid::iterator i = grid.begin (); i != grid.end (); i++)
+        {
+          for (uint32_t j = 0; j < i->second.size (); j++)
+            {
+              InsertPoa (i->second[j]);
+            }
+        }
+    }
+    double
+    MihInformationServer::GetCellSize (void) const
+    {
+      return m_cellSize;
+    }
+    int32_t
+    MihInformationServer::GetCellCoordinate (double value) const
+    {
+      return static_cast<int32_t> (std::floor (value / m_cellSize));
+    }
+    uint64_t
+    MihInformationServer::GetCellKey (int32_t x, int32_t y)
+    {
+      return (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) | static_cast<uint32_t> (y);
+    }
+    void
+    MihInformationServer::InsertPoa (Ptr<PoaDescriptor> poa)
+    {
+      Vector position = poa->GetPosition ();
+      uint64_t key = GetCellKey (GetCellCoordinate (position.x),
+                                 GetCellCoordinate (position.y));
+      m_grid[key].push_back (poa);
+      m_poaCells[poa->GetPoALinkAddress ()] = key;
+    }
+    void
+    MihInformationServer::AddPoa (Ptr<PoaDescriptor> poa)
+    {
+      NS_LOG_FUNCTION (this << poa);
+      NS_ASSERT (poa != 0);
+      RemovePoa (poa->GetPoALinkAddress ());
+      InsertPoa (poa);
+    }
+    bool
+    MihInformationServer::RemovePoa (Address poaLinkAddress)
+    {
+      NS_LOG_FUNCTION (this);
+      PoaCellIndex::iterator i = m_poaCells.find (poaLinkAddress);
+      if (i == m_poaCells.end ())
+        {
+          return false;
+        }
+      Grid::iterator cell = m_grid.find (i->second);
+      NS_ASSERT (cell != m_grid.end ());
+      for (Cell::iterator j = cell->second.begin (); j != cell->second.end (); j++)
+        {
+          if ((*j)->GetPoALinkAddress () == poaLinkAddress)
+            {
+              cell->second.erase (j);
+              break;
+            }
+        }
+      if (cell->second.empty ())
+        {
+          m_grid.erase (cell);
+        }
+      m_poaCells.erase (i);
+      return true;
+    }
+    uint32_t
+    MihInformationServer::GetNPoas (void) const
+    {
+      return m_poaCells.size ();
+    }
+    PoaDescriptorList
+    MihInformationServer::Query (Vector position,
+                                 double radius,
+                                 LinkType linkType,
+                                 uint32_t maxResults)
+    {
+      NS_LOG_FUNCTION (this << position << radius << linkType << maxResults);
+      std::vector<PoaMatch> matches;
+      std::vector<const Cell *> cells;
+      uint32_t visited = 0;
+
+      int32_t xMin = GetCellCoordinate (position.x - radius);
+      int32_t xMax = GetCellCoordinate (position.x + radius);
+      int32_t yMin = GetCellCoordinate (position.y - radius);
+      int32_t yMax = GetCellCoordinate (position.y + radius);
+      double window = (static_cast<double> (xMax) - xMin + 1) * (static_cast<double> (yMax) - yMin + 1);
+      if (window > m_grid.size ())
+        {
+          // Fewer occupied cells than cells under the disc;
+          for (Grid::const_iterator i = m_grid.begin (); i != m_grid.end (); i++)
+            {
+              cells.push_back (&i->second);
+            }
+        }
+      else
+        {
+          for (int32_t x = xMin; x <= xMax; x++)
+            {
+              for (int32_t y = yMin; y <= yMax; y++)
+                {
+                  Grid::const_iterator i = m_grid.find (GetCellKey (x, y));
+                  if (i != m_grid.end ())
+                    {
+                      cells.push_back (&i->second);
+                    }
+                }
+            }
+        }
+      for (uint32_t j = 0; j < cells.size (); j++)
+        {
+          const Cell &cell = *cells[j];
+          for (uint32_t k = 0; k < cell.size (); k++)
+            {
+              visited++;
+              if (linkType != LinkType (LinkType::INVALID) && cell[k]->GetLinkType () != linkType)
+                {
+                  continue;
+                }
+              double distance = CalculateDistance (position, cell[k]->GetPosition ());
+              if (distance <= radius)
+                {
+                  matches.push_back (std::make_pair (distance, cell[k]));
+                }
+            }
+        }
+      uint32_t n = matches.size ();
+      if (maxResults != 0 && maxResults < n)
+        {
+          n = maxResults;
+        }
+      std::partial_sort (matches.begin (), matches.begin () + n, matches.end (),
+                         &IsCloser);
+      PoaDescriptorList poas;
+      poas.reserve (n);
+      for (uint32_t j = 0; j < n; j++)
+        {
+          poas.push_back (matches[j].second);
+        }
+      m_queryTrace (position, radius, visited, n);
+      return poas;
+    }
+  } // namespace mih
+} // namespace ns3
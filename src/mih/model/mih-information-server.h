@@ -0,0 +1,76 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef   	MIH_INFORMATION_SERVER_H
+#define   	MIH_INFORMATION_SERVER_H
+
+#include <map>
+#include <vector>
+#include <unordered_map>
+#include "ns3/object.h"
+#include "ns3/vector.h"
+#include "ns3/traced-callback.h"
+#include "mih-link-type.h"
+#include "mih-poa-descriptor.h"
+
+namespace ns3 {
+  namespace mih {
+    /**
+     * Media Independent Information Service database, aggregated to
+     * the node next to the MihFunction which serves MIH_Get_Information
+     * requests from it.
+     *
+     * The PoA descriptors are bucketed in a uniform grid of square
+     * cells, so that a query only visits the cells overlapping its
+     * disc instead of every known PoA.
+     */
+    class MihInformationServer : public Object {
+    public:
+      static TypeId GetTypeId (void);
+      MihInformationServer (void);
+      virtual ~MihInformationServer (void);
+      // Replaces the descriptor of the same PoA link address, if any;
+      void AddPoa (Ptr<PoaDescriptor> poa);
+      bool RemovePoa (Address poaLinkAddress);
+      uint32_t GetNPoas (void) const;
+      // PoAs of linkType, or of any type for LinkType::INVALID, within
+      // radius of position, nearest first; maxResults 0 is unbounded;
+      PoaDescriptorList Query (Vector position,
+                               double radius,
+                               LinkType linkType,
+                               uint32_t maxResults);
+      typedef void (* QueryCallback) (Vector position, double radius,
+                                      uint32_t visited, uint32_t results);
+    protected:
+      virtual void DoDispose (void);
+    private:
+      typedef std::vector<Ptr<PoaDescriptor> > Cell;
+      typedef std::unordered_map<uint64_t, Cell> Grid;
+      typedef std::map<Address, uint64_t> PoaCellIndex;
+      void SetCellSize (double cellSize);
+      double GetCellSize (void) const;
+      int32_t GetCellCoordinate (double value) const;
+      static uint64_t GetCellKey (int32_t x, int32_t y);
+      void InsertPoa (Ptr<PoaDescriptor> poa);
+      double m_cellSize;
+      Grid m_grid;
+      PoaCellIndex m_poaCells;
+      TracedCallback<Vector, double, uint32_t, uint32_t> m_queryTrace;
+    };
+  } // namespace mih
+} // namespace ns3
+
+#endif 	    /* !MIH_INFORMATION_SERVER_H */
@@ -55,14 +55,14 @@ namespace ns3 {
         ;
     }
     void
-    InformationServiceQueryTypeList::TlvSerialize (Buffer &buffer) const
+    InformationServiceQueryTypeList::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU64 (buffer, m_bitmap, TLV_MIIS_QUERY_TYPE_LIST);
+      Tlv::SerializeU64 (i, m_bitmap, TLV_MIIS_QUERY_TYPE_LIST);
     }
     uint32_t 
-    InformationServiceQueryTypeList::TlvDeserialize (Buffer &buffer)
+    InformationServiceQueryTypeList::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU64 (buffer, m_bitmap, TLV_MIIS_QUERY_TYPE_LIST);
+      return Tlv::DeserializeU64 (i, m_bitmap, TLV_MIIS_QUERY_TYPE_LIST);
     }
   } // namespace mih
 } // namespace ns3
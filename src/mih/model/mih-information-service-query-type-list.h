@@ -27,7 +27,7 @@
 
 namespace ns3 {
   namespace mih {
-    class InformationServiceQueryTypeList {
+    class InformationServiceQueryTypeList : public Tlv {
     public:
       enum Type {
         INVALID = 0x0000000000000000,
@@ -68,8 +68,10 @@ namespace ns3 {
       void SetInformationServiceQueryTypes (uint64_t queryTypes);
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (InformationServiceQueryTypeList);
     protected:
       uint64_t m_bitmap;
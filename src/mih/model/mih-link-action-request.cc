@@ -80,10 +80,8 @@ namespace ns3 {
       return 1 + lengthOfLengthField + payloadLength;
     }
     void 
-    LinkActionRequest::TlvSerialize (Buffer &buffer) const
+    LinkActionRequest::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
       
       payloadLength = m_linkIdentifier.GetTlvSerializedSize () +
@@ -91,38 +89,30 @@ namespace ns3 {
         m_linkAction.GetTlvSerializedSize () +
         Tlv::GetSerializedSizeU64 ();
 
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-      
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field + Length field only;
-      
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length field;
 
-      m_linkIdentifier.TlvSerialize (buffer);
-      Tlv::Serialize (buffer, m_poaAddress, TLV_POA_LINK_IDENTIFIER);
-      m_linkAction.TlvSerialize (buffer);
-      Tlv::SerializeU64 (buffer, m_linkActionExecutionDelay, TLV_TIME_INTERVAL);
+      m_linkIdentifier.TlvSerialize (i);
+      Tlv::Serialize (i, m_poaAddress, TLV_POA_LINK_IDENTIFIER);
+      m_linkAction.TlvSerialize (i);
+      Tlv::SerializeU64 (i, m_linkActionExecutionDelay, TLV_TIME_INTERVAL);
     }
     uint32_t 
-    LinkActionRequest::TlvDeserialize (Buffer &buffer)
+    LinkActionRequest::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
-      totalBytesRead += m_linkIdentifier.TlvDeserialize (buffer);
-      Tlv::Deserialize (buffer, m_poaAddress, TLV_POA_LINK_IDENTIFIER);
-      totalBytesRead += m_linkAction.TlvDeserialize (buffer);
-      totalBytesRead += Tlv::DeserializeU64 (buffer, m_linkActionExecutionDelay, TLV_TIME_INTERVAL);
+      totalBytesRead += m_linkIdentifier.TlvDeserialize (i);
+      totalBytesRead += Tlv::Deserialize (i, m_poaAddress, TLV_POA_LINK_IDENTIFIER);
+      totalBytesRead += m_linkAction.TlvDeserialize (i);
+      totalBytesRead += Tlv::DeserializeU64 (i, m_linkActionExecutionDelay, TLV_TIME_INTERVAL);
 
       return totalBytesRead;
     }
@@ -136,10 +126,20 @@ namespace ns3 {
     {
       Tlv::Serialize<LinkActionRequest> (buffer, linkActionRequestList, TLV_LINK_ACTION_REQUEST_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const LinkActionRequestList &linkActionRequestList)
+    {
+      Tlv::Serialize<LinkActionRequest> (i, linkActionRequestList, TLV_LINK_ACTION_REQUEST_LIST);
+    }
     uint32_t
     TlvDeserialize (Buffer &buffer, LinkActionRequestList &linkActionRequestList)
     {
       return Tlv::Deserialize<LinkActionRequest> (buffer, linkActionRequestList, TLV_LINK_ACTION_REQUEST_LIST);    
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, LinkActionRequestList &linkActionRequestList)
+    {
+      return Tlv::Deserialize<LinkActionRequest> (i, linkActionRequestList, TLV_LINK_ACTION_REQUEST_LIST);
+    }
   } // namespace mih
 } // namespace ns3
@@ -42,8 +42,10 @@ namespace ns3 {
       LinkAction GetLinkAction (void);
       uint64_t GetActionExecutionDelay (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (LinkActionRequest);
       static Ptr<LinkActionRequest> CreateFromTlvType (uint8_t val);
     protected:
@@ -56,7 +58,9 @@ namespace ns3 {
     typedef LinkActionRequestList::iterator LinkActionRequestListI;
     uint32_t GetTlvSerializedSize (const LinkActionRequestList &linkActionRequestList);
     void TlvSerialize (Buffer &buffer, const LinkActionRequestList &linkActionRequestList);
+    void TlvSerialize (Buffer::Iterator &i, const LinkActionRequestList &linkActionRequestList);
     uint32_t TlvDeserialize (Buffer &buffer, LinkActionRequestList &linkActionRequestList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, LinkActionRequestList &linkActionRequestList);
   } // namespace mih
 } // namespace ns3
 
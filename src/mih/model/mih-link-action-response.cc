@@ -106,10 +106,8 @@ namespace ns3 {
       
     }
     void 
-    LinkActionResponse::TlvSerialize (Buffer &buffer) const
+    LinkActionResponse::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
 
       payloadLength = m_linkType.GetTlvSerializedSize () +
@@ -117,40 +115,33 @@ namespace ns3 {
         Tlv::GetSerializedSizeU8 () +
         ns3::mih::GetTlvSerializedSize (m_scanResponseList);
 
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field + Length field only;
-      
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length field;
 
-      m_linkType.TlvSerialize (buffer);
-      Tlv::Serialize (buffer, m_mobileNodeAddress, TLV_MN_LINK_IDENTIFIER);
-      Tlv::SerializeU8 (buffer, static_cast<uint8_t> (m_linkActionResult), TLV_LINK_ACTION_RESULT);
-      ns3::mih::TlvSerialize (buffer, m_scanResponseList);
+      m_linkType.TlvSerialize (i);
+      Tlv::Serialize (i, m_mobileNodeAddress, TLV_MN_LINK_IDENTIFIER);
+      Tlv::SerializeU8 (i, static_cast<uint8_t> (m_linkActionResult), TLV_LINK_ACTION_RESULT);
+      ns3::mih::TlvSerialize (i, m_scanResponseList);
     }
     uint32_t
-    LinkActionResponse::TlvDeserialize (Buffer &buffer)
+    LinkActionResponse::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
 
-      totalBytesRead += m_linkType.TlvDeserialize (buffer);
-      totalBytesRead += Tlv::Deserialize (buffer, m_mobileNodeAddress, TLV_MN_LINK_IDENTIFIER);
+      totalBytesRead += m_linkType.TlvDeserialize (i);
+      totalBytesRead += Tlv::Deserialize (i, m_mobileNodeAddress, TLV_MN_LINK_IDENTIFIER);
       uint8_t actionResult = 0;
-      totalBytesRead += Tlv::DeserializeU8 (buffer, actionResult, TLV_LINK_ACTION_RESULT);
+      totalBytesRead += Tlv::DeserializeU8 (i, actionResult, TLV_LINK_ACTION_RESULT);
       m_linkActionResult = static_cast<enum LinkActionResponse::ActionResult> (actionResult);
-      totalBytesRead += ns3::mih::TlvDeserialize (buffer, m_scanResponseList);
+      totalBytesRead += ns3::mih::TlvDeserialize (i, m_scanResponseList);
 
       return totalBytesRead;
     }      
@@ -164,11 +155,21 @@ namespace ns3 {
     {
       Tlv::Serialize<LinkActionResponse> (buffer, linkActionResponseList, TLV_LINK_ACTION_RESPONSE_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const LinkActionResponseList &linkActionResponseList)
+    {
+      Tlv::Serialize<LinkActionResponse> (i, linkActionResponseList, TLV_LINK_ACTION_RESPONSE_LIST);
+    }
     uint32_t
     TlvDeserialize (Buffer &buffer, LinkActionResponseList &linkActionResponseList)
     {
       return Tlv::Deserialize<LinkActionResponse> (buffer, linkActionResponseList, TLV_LINK_ACTION_RESPONSE_LIST);    
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, LinkActionResponseList &linkActionResponseList)
+    {
+      return Tlv::Deserialize<LinkActionResponse> (i, linkActionResponseList, TLV_LINK_ACTION_RESPONSE_LIST);
+    }
     std::ostream&
     operator << (std::ostream &os, const LinkActionResponse &rhs)
     {
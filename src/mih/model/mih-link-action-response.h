@@ -52,8 +52,10 @@ namespace ns3 {
       void SetScanResponseList (ScanResponseList scanResponseList);
       ScanResponseList GetScanResponseList (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (LinkActionResponse);
       static Ptr<LinkActionResponse> CreateFromTlvType (uint8_t val);
     protected:
@@ -67,7 +69,9 @@ namespace ns3 {
     typedef LinkActionResponseList::iterator LinkActionResponseListI;
     uint32_t GetTlvSerializedSize (const LinkActionResponseList &linkActionResponseList);
     void TlvSerialize (Buffer &buffer, const LinkActionResponseList &linkActionResponseList);
+    void TlvSerialize (Buffer::Iterator &i, const LinkActionResponseList &linkActionResponseList);
     uint32_t TlvDeserialize (Buffer &buffer, LinkActionResponseList &linkActionResponseList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, LinkActionResponseList &linkActionResponseList);
 
     std::ostream& operator << (std::ostream &os, const LinkActionResponse &rhs);
     std::ostream& operator << (std::ostream &os, const LinkActionResponseList &rhs);
@@ -72,46 +72,36 @@ namespace ns3 {
       return 1 + lengthOfLengthField + payloadLength;
     }
     void 
-    LinkAction::TlvSerialize (Buffer &buffer) const
+    LinkAction::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
       
       payloadLength = Tlv::GetSerializedSizeU8 () + 
         Tlv::GetSerializedSizeU8 ();
 
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field + Length field only;
-      
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length field;
 
-      Tlv::SerializeU8 (buffer, static_cast<uint8_t> (m_type), TLV_LINK_ACTION);
-      Tlv::SerializeU8 (buffer, m_actionAttribute, TLV_LINK_ACTION_ATTRIBUTE);
+      Tlv::SerializeU8 (i, static_cast<uint8_t> (m_type), TLV_LINK_ACTION);
+      Tlv::SerializeU8 (i, m_actionAttribute, TLV_LINK_ACTION_ATTRIBUTE);
     }
     uint32_t 
-    LinkAction::TlvDeserialize (Buffer &buffer)
+    LinkAction::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
 
       uint8_t typ = 0;
-      totalBytesRead += Tlv::DeserializeU8 (buffer, typ, TLV_LINK_ACTION);
+      totalBytesRead += Tlv::DeserializeU8 (i, typ, TLV_LINK_ACTION);
       m_type = static_cast<enum LinkAction::Type> (typ);
-      totalBytesRead += Tlv::DeserializeU8 (buffer, m_actionAttribute, TLV_LINK_ACTION_ATTRIBUTE);
+      totalBytesRead += Tlv::DeserializeU8 (i, m_actionAttribute, TLV_LINK_ACTION_ATTRIBUTE);
 
       return totalBytesRead;
     }
@@ -51,8 +51,10 @@ namespace ns3 {
       void SetType (enum Type code);
       enum Type GetType (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (LinkAction);
     protected:
       enum Type m_type;
@@ -71,10 +71,8 @@ namespace ns3 {
       return 1 + lengthOfLengthField + payloadLength;
     }
     void 
-    LinkConfigurationParameter::TlvSerialize (Buffer &buffer) const
+    LinkConfigurationParameter::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
 
       payloadLength = m_linkParameterType->GetTlvSerializedSize () +
@@ -82,45 +80,35 @@ namespace ns3 {
         Tlv::GetSerializedSizeU8 () +
         Tlv::GetSerializedSize (m_thresholdList);
       
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field +
-                                                 // Length field only;
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length
                                                        // field;
       
-      m_linkParameterType->TlvSerialize (buffer);
-      Tlv::SerializeU64 (buffer, m_timerInterval, TLV_LINK_CONFIGURATION_TIME_INTERVAL);
-      Tlv::SerializeU8 (buffer, static_cast<uint8_t> (m_thresholdAction), TLV_LINK_CONFIGURATION_THRESHOLD_ACTION);
-      ns3::mih::TlvSerialize (buffer, m_thresholdList);
+      m_linkParameterType->TlvSerialize (i);
+      Tlv::SerializeU64 (i, m_timerInterval, TLV_LINK_CONFIGURATION_TIME_INTERVAL);
+      Tlv::SerializeU8 (i, static_cast<uint8_t> (m_thresholdAction), TLV_LINK_CONFIGURATION_THRESHOLD_ACTION);
+      ns3::mih::TlvSerialize (i, m_thresholdList);
     }
     uint32_t 
-    LinkConfigurationParameter::TlvDeserialize (Buffer &buffer)
+    LinkConfigurationParameter::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
       
-      i = buffer.Begin ();
-
-      m_linkParameterType = LinkParameterType::CreateFromTlvType (i.ReadU8 ());
-      totalBytesRead += m_linkParameterType->TlvDeserialize (buffer);
-      totalBytesRead += Tlv::DeserializeU64 (buffer, m_timerInterval, TLV_LINK_CONFIGURATION_TIME_INTERVAL);
+      m_linkParameterType = LinkParameterType::CreateFromTlvType (i.PeekU8 ());
+      totalBytesRead += m_linkParameterType->TlvDeserialize (i);
+      totalBytesRead += Tlv::DeserializeU64 (i, m_timerInterval, TLV_LINK_CONFIGURATION_TIME_INTERVAL);
       uint8_t thresholdAction = 0;
-      totalBytesRead += Tlv::DeserializeU8 (buffer, thresholdAction, TLV_LINK_CONFIGURATION_THRESHOLD_ACTION);
+      totalBytesRead += Tlv::DeserializeU8 (i, thresholdAction, TLV_LINK_CONFIGURATION_THRESHOLD_ACTION);
       m_thresholdAction = static_cast<enum ThresholdAction> (thresholdAction);
-      totalBytesRead += ns3::mih::TlvDeserialize (buffer, m_thresholdList);
+      totalBytesRead += ns3::mih::TlvDeserialize (i, m_thresholdList);
 
       return totalBytesRead;
     }
@@ -170,10 +158,20 @@ namespace ns3 {
     {
       Tlv::Serialize<LinkConfigurationParameter> (buffer, linkConfigurationParameterList, TLV_LINK_CONFIGURATION_PARAMETER_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const LinkConfigurationParameterList &linkConfigurationParameterList)
+    {
+      Tlv::Serialize<LinkConfigurationParameter> (i, linkConfigurationParameterList, TLV_LINK_CONFIGURATION_PARAMETER_LIST);
+    }
     uint32_t
     TlvDeserialize (Buffer &buffer, LinkConfigurationParameterList &linkConfigurationParameterList)
     {
       return Tlv::Deserialize<LinkConfigurationParameter> (buffer, linkConfigurationParameterList, TLV_LINK_CONFIGURATION_PARAMETER_LIST);      
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, LinkConfigurationParameterList &linkConfigurationParameterList)
+    {
+      return Tlv::Deserialize<LinkConfigurationParameter> (i, linkConfigurationParameterList, TLV_LINK_CONFIGURATION_PARAMETER_LIST);
+    }
   } // namespace mih
 } // namespace ns3
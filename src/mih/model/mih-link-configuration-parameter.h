@@ -45,8 +45,10 @@ namespace ns3 {
       LinkConfigurationParameter (LinkConfigurationParameter const &o);
       static Ptr<LinkConfigurationParameter> CreateFromTlvType (uint8_t val);
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (LinkConfigurationParameter);
       Ptr<LinkParameterType> GetLinkParameterType (void);
       uint64_t GetTimerInterval (void);
@@ -65,7 +67,9 @@ namespace ns3 {
     typedef LinkConfigurationParameterList::iterator LinkConfigurationParameterListI;
     uint32_t GetTlvSerializedSize (const LinkConfigurationParameterList &linkConfigurationParameterList);
     void TlvSerialize (Buffer &buffer, const LinkConfigurationParameterList &linkConfigurationParameterList);
+    void TlvSerialize (Buffer::Iterator &i, const LinkConfigurationParameterList &linkConfigurationParameterList);
     uint32_t TlvDeserialize (Buffer &buffer, LinkConfigurationParameterList &linkConfigurationParameterList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, LinkConfigurationParameterList &linkConfigurationParameterList);
   } // namespace mih
 } // namespace ns3
 
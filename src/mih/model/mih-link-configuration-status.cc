@@ -90,51 +90,40 @@ namespace ns3 {
       
     }
     void
-    LinkConfigurationStatus::TlvSerialize (Buffer &buffer) const
+    LinkConfigurationStatus::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
       
       payloadLength = m_linkParameterType->GetTlvSerializedSize () +
         m_threshold.GetTlvSerializedSize () +
         Tlv::GetSerializedSizeBool ();
 
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field +
-                                                 // Length field only;
-
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length field;
 
-      m_linkParameterType->TlvSerialize (buffer);
-      m_threshold.TlvSerialize (buffer);
-      Tlv::SerializeBool (buffer, 
+      m_linkParameterType->TlvSerialize (i);
+      m_threshold.TlvSerialize (i);
+      Tlv::SerializeBool (i, 
                           m_configurationStatus, 
                           TLV_LINK_CONFIGURATION_STATUS);
     }
     uint32_t 
-    LinkConfigurationStatus::TlvDeserialize (Buffer &buffer)
+    LinkConfigurationStatus::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
 
-      i = buffer.Begin ();
-      Ptr<LinkParameterType> linkParamType = LinkParameterType::CreateFromTlvType (i.ReadU8 ());
-      totalBytesRead += linkParamType->TlvDeserialize (buffer);
-      totalBytesRead += m_threshold.TlvDeserialize (buffer);
-      totalBytesRead += Tlv::DeserializeBool (buffer, 
+      Ptr<LinkParameterType> linkParamType = LinkParameterType::CreateFromTlvType (i.PeekU8 ());
+      totalBytesRead += linkParamType->TlvDeserialize (i);
+      totalBytesRead += m_threshold.TlvDeserialize (i);
+      totalBytesRead += Tlv::DeserializeBool (i, 
                                               m_configurationStatus, 
                                               TLV_LINK_CONFIGURATION_STATUS);
       
@@ -150,10 +139,20 @@ namespace ns3 {
     {
       Tlv::Serialize<LinkConfigurationStatus> (buffer, linkConfigurationStatusList, TLV_LINK_CONFIGURATION_STATUS_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const LinkConfigurationStatusList &linkConfigurationStatusList)
+    {
+      Tlv::Serialize<LinkConfigurationStatus> (i, linkConfigurationStatusList, TLV_LINK_CONFIGURATION_STATUS_LIST);
+    }
     uint32_t
     TlvDeserialize (Buffer &buffer, LinkConfigurationStatusList &linkConfigurationStatusList)
     {
       return Tlv::Deserialize<LinkConfigurationStatus> (buffer, linkConfigurationStatusList, TLV_LINK_CONFIGURATION_STATUS_LIST);      
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, LinkConfigurationStatusList &linkConfigurationStatusList)
+    {
+      return Tlv::Deserialize<LinkConfigurationStatus> (i, linkConfigurationStatusList, TLV_LINK_CONFIGURATION_STATUS_LIST);
+    }
   } // namespace mih
 } // namespace ns3
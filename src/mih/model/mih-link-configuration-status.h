@@ -41,8 +41,10 @@ namespace ns3 {
       Threshold GetThreshold (void);
       bool IsSuccess (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (LinkConfigurationStatus);
       static Ptr<LinkConfigurationStatus> CreateFromTlvType (uint8_t val);
     protected:
@@ -54,7 +56,9 @@ namespace ns3 {
     typedef LinkConfigurationStatusList::iterator LinkConfigurationStatusListI;
     uint32_t GetTlvSerializedSize (const LinkConfigurationStatusList &linkConfigurationStatusList);
     void TlvSerialize (Buffer &buffer, const LinkConfigurationStatusList &linkConfigurationStatusList);
+    void TlvSerialize (Buffer::Iterator &i, const LinkConfigurationStatusList &linkConfigurationStatusList);
     uint32_t TlvDeserialize (Buffer &buffer, LinkConfigurationStatusList &linkConfigurationStatusList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, LinkConfigurationStatusList &linkConfigurationStatusList);
   } // namespace mih
 } // namespace ns3
 
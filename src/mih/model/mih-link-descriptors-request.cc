@@ -56,14 +56,14 @@ namespace ns3 {
       os << "Link Descriptors Request = " << std::hex << (int)m_descriptors << std::endl;
     }
     void 
-    LinkDescriptorsRequest::TlvSerialize (Buffer &buffer) const 
+    LinkDescriptorsRequest::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU16 (buffer, m_descriptors, TLV_LINK_DESCRIPTORS_REQUEST);
+      Tlv::SerializeU16 (i, m_descriptors, TLV_LINK_DESCRIPTORS_REQUEST);
     }
     uint32_t 
-    LinkDescriptorsRequest::TlvDeserialize (Buffer &buffer)
+    LinkDescriptorsRequest::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU16 (buffer, m_descriptors, TLV_LINK_DESCRIPTORS_REQUEST);
+      return Tlv::DeserializeU16 (i, m_descriptors, TLV_LINK_DESCRIPTORS_REQUEST);
     }
   } // namespace mih
 } // namespace ns3
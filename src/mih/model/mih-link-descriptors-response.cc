@@ -36,12 +36,12 @@ namespace ns3 {
       NS_ASSERT (0);
     }
     void 
-    LinkDescriptorsResponse::TlvSerialize (Buffer &buffer) const
+    LinkDescriptorsResponse::TlvSerialize (Buffer::Iterator &i) const
     {
       NS_ASSERT (0);
     }
     uint32_t 
-    LinkDescriptorsResponse::TlvDeserialize (Buffer &buffer)
+    LinkDescriptorsResponse::TlvDeserialize (Buffer::Iterator &i)
     {
           NS_ASSERT (0);
           return 0;
@@ -58,6 +58,13 @@ namespace ns3 {
                                                linkDescriptorsResponseList, 
                                                TLV_LINK_DESCRIPTORS_RESPONSE_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const LinkDescriptorsResponseList &linkDescriptorsResponseList)
+    {
+      Tlv::Serialize<LinkDescriptorsResponse> (i, 
+                                               linkDescriptorsResponseList, 
+                                               TLV_LINK_DESCRIPTORS_RESPONSE_LIST);
+    }
     uint32_t
     TlvDeserialize (Buffer &buffer, LinkDescriptorsResponseList &linkDescriptorsResponseList)
     {
@@ -65,5 +72,12 @@ namespace ns3 {
                                                         linkDescriptorsResponseList, 
                                                         TLV_LINK_DESCRIPTORS_RESPONSE_LIST);      
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, LinkDescriptorsResponseList &linkDescriptorsResponseList)
+    {
+      return Tlv::Deserialize<LinkDescriptorsResponse> (i, 
+                                                        linkDescriptorsResponseList, 
+                                                        TLV_LINK_DESCRIPTORS_RESPONSE_LIST);
+    }
   } // namespace mih
 } // namespace ns3
@@ -35,15 +35,19 @@ namespace ns3 {
       CHOICE_HELPER_PURE_VIRTUAL_HEADER (LinkDescriptorsResponse);
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
     protected:
     };
     typedef std::vector<Ptr<LinkDescriptorsResponse> > LinkDescriptorsResponseList;
     typedef LinkDescriptorsResponseList::iterator LinkDescriptorsResponseListI;
     uint32_t GetTlvSerializedSize (const LinkDescriptorsResponseList &linkDescriptorsResponseList);
     void TlvSerialize (Buffer &buffer, const LinkDescriptorsResponseList &linkDescriptorsResponseList);
+    void TlvSerialize (Buffer::Iterator &i, const LinkDescriptorsResponseList &linkDescriptorsResponseList);
     uint32_t TlvDeserialize (Buffer &buffer, LinkDescriptorsResponseList &linkDescriptorsResponseList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, LinkDescriptorsResponseList &linkDescriptorsResponseList);
   } // namespace mih
 } // namespace ns3
 
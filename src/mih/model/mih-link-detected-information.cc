@@ -125,10 +125,8 @@ namespace ns3 {
       return 1 + lengthOfLengthField + payloadLength;
     }
     void
-    LinkDetectedInformation::TlvSerialize (Buffer &buffer) const
+    LinkDetectedInformation::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
       
       payloadLength = m_linkIdentifier.GetTlvSerializedSize () +
@@ -140,47 +138,39 @@ namespace ns3 {
         m_mihCapabilityFlag.GetTlvSerializedSize () +
         m_networkCapabilities.GetTlvSerializedSize ();
 
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field + Length field only;
-      
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length field;
 
-      m_linkIdentifier.TlvSerialize (buffer);
-      m_networkIdentifier.TlvSerialize (buffer);
-      m_networkAuxiliaryIdentifier.TlvSerialize (buffer);
-      m_signalStrength.TlvSerialize (buffer);
-      Tlv::SerializeU16 (buffer, m_sinr, TLV_SINR);
-      //m_dataRate.TlvSerialize (buffer);
-      m_mihCapabilityFlag.TlvSerialize (buffer);
-      m_networkCapabilities.TlvSerialize (buffer);
+      m_linkIdentifier.TlvSerialize (i);
+      m_networkIdentifier.TlvSerialize (i);
+      m_networkAuxiliaryIdentifier.TlvSerialize (i);
+      m_signalStrength.TlvSerialize (i);
+      Tlv::SerializeU16 (i, m_sinr, TLV_SINR);
+      //m_dataRate.TlvSerialize (i);
+      m_mihCapabilityFlag.TlvSerialize (i);
+      m_networkCapabilities.TlvSerialize (i);
     }
     uint32_t 
-    LinkDetectedInformation::TlvDeserialize (Buffer &buffer) 
+    LinkDetectedInformation::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
 
-      totalBytesRead += m_linkIdentifier.TlvDeserialize (buffer);
-      totalBytesRead += m_networkIdentifier.TlvDeserialize (buffer);
-      totalBytesRead += m_networkAuxiliaryIdentifier.TlvDeserialize (buffer);
-      totalBytesRead += m_signalStrength.TlvDeserialize (buffer);
-      totalBytesRead += Tlv::DeserializeU16 (buffer, m_sinr, TLV_SINR);
-      //totalBytesRead += m_dataRate.TlvDeserialize (buffer);
-      totalBytesRead += m_mihCapabilityFlag.TlvDeserialize (buffer);
-      totalBytesRead += m_networkCapabilities.TlvDeserialize (buffer);
+      totalBytesRead += m_linkIdentifier.TlvDeserialize (i);
+      totalBytesRead += m_networkIdentifier.TlvDeserialize (i);
+      totalBytesRead += m_networkAuxiliaryIdentifier.TlvDeserialize (i);
+      totalBytesRead += m_signalStrength.TlvDeserialize (i);
+      totalBytesRead += Tlv::DeserializeU16 (i, m_sinr, TLV_SINR);
+      //totalBytesRead += m_dataRate.TlvDeserialize (i);
+      totalBytesRead += m_mihCapabilityFlag.TlvDeserialize (i);
+      totalBytesRead += m_networkCapabilities.TlvDeserialize (i);
       return totalBytesRead;
     }
     TLV_TYPE_HELPER_IMPLEM (LinkDetectedInformation, TLV_LINK_DETECTED_INFORMATION)
@@ -200,11 +190,21 @@ namespace ns3 {
     {
       Tlv::Serialize<LinkDetectedInformation> (buffer, linkDetectedInformationList, TLV_LINK_DETECTED_INFORMATION_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const LinkDetectedInformationList &linkDetectedInformationList)
+    {
+      Tlv::Serialize<LinkDetectedInformation> (i, linkDetectedInformationList, TLV_LINK_DETECTED_INFORMATION_LIST);
+    }
     uint32_t
     TlvDeserialize (Buffer &buffer, LinkDetectedInformationList &linkDetectedInformationList)
     {
       return Tlv::Deserialize<LinkDetectedInformation> (buffer, linkDetectedInformationList, TLV_LINK_DETECTED_INFORMATION_LIST);      
     }    
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, LinkDetectedInformationList &linkDetectedInformationList)
+    {
+      return Tlv::Deserialize<LinkDetectedInformation> (i, linkDetectedInformationList, TLV_LINK_DETECTED_INFORMATION_LIST);
+    }
     std::ostream&
     operator << (std::ostream &os, LinkDetectedInformation &a)
     {
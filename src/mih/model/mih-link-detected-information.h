@@ -62,8 +62,10 @@ namespace ns3 {
       NetworkCapabilities GetNetworkCapabilities (void);
       uint32_t GetStationCount (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (LinkDetectedInformation);
       static Ptr<LinkDetectedInformation> CreateFromTlvType (uint8_t val);
     protected:
@@ -82,7 +84,9 @@ namespace ns3 {
     typedef LinkDetectedInformationList::iterator LinkDetectedInformationI;
     uint32_t GetTlvSerializedSize (const LinkDetectedInformationList &linkDetectedInformationList);
     void TlvSerialize (Buffer &buffer, const LinkDetectedInformationList &linkDetectedInformationList);
+    void TlvSerialize (Buffer::Iterator &i, const LinkDetectedInformationList &linkDetectedInformationList);
     uint32_t TlvDeserialize (Buffer &buffer, LinkDetectedInformationList &linkDetectedInformationList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, LinkDetectedInformationList &linkDetectedInformationList);
     std::ostream& operator << (std::ostream &os, LinkDetectedInformation &a);
     std::ostream& operator << (std::ostream&os, LinkDetectedInformationList &a);
   } // namespace mih
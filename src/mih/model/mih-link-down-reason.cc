@@ -45,16 +45,16 @@ namespace ns3 {
       os << "LinkDownReason = " << static_cast<int> (m_reason) << std::endl;
     }
     void
-    LinkDownReason::TlvSerialize (Buffer &buffer) const
+    LinkDownReason::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU8 (buffer, static_cast<uint8_t> (m_reason), TLV_LINK_DOWN_REASON);
+      Tlv::SerializeU8 (i, static_cast<uint8_t> (m_reason), TLV_LINK_DOWN_REASON);
     }
     uint32_t
-    LinkDownReason::TlvDeserialize (Buffer &buffer)
+    LinkDownReason::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t bytesRead = 0;
       uint8_t typ = 0;
-      bytesRead += Tlv::DeserializeU8 (buffer, typ, TLV_LINK_DOWN_REASON);
+      bytesRead += Tlv::DeserializeU8 (i, typ, TLV_LINK_DOWN_REASON);
       m_reason = static_cast<enum LinkDownReason::Type> (typ);
       return bytesRead;
     }
@@ -45,16 +45,16 @@ namespace ns3 {
       os << "LinkGoingDownReason = " << static_cast<int> (m_reason) << std::endl;
     }
     void
-    LinkGoingDownReason::TlvSerialize (Buffer &buffer) const
+    LinkGoingDownReason::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU8 (buffer, static_cast<uint8_t> (m_reason), TLV_LINK_GOING_DOWN_REASON);
+      Tlv::SerializeU8 (i, static_cast<uint8_t> (m_reason), TLV_LINK_GOING_DOWN_REASON);
     }
     uint32_t
-    LinkGoingDownReason::TlvDeserialize (Buffer &buffer)
+    LinkGoingDownReason::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t bytesRead = 0;
       uint8_t typ = 0;
-      bytesRead += Tlv::DeserializeU8 (buffer, typ, TLV_LINK_GOING_DOWN_REASON);
+      bytesRead += Tlv::DeserializeU8 (i, typ, TLV_LINK_GOING_DOWN_REASON);
       m_reason = static_cast<enum LinkGoingDownReason::Type> (typ);
       return bytesRead;
     }
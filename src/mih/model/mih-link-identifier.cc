@@ -107,28 +107,23 @@ namespace ns3 {
         ;
     }
     void
-    LinkIdentifier::TlvSerialize (Buffer &buffer) const
+    LinkIdentifier::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      buffer.AddAtEnd (2); // Type + Length room space;
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ());
       i.WriteU8 (GetTlvSerializedSize () - 2);
-      m_type.TlvSerialize (buffer);
-      Tlv::Serialize (buffer, m_mobileNodeAddress, TLV_MN_LINK_IDENTIFIER);
-      Tlv::Serialize (buffer, m_poaAddress, TLV_POA_LINK_IDENTIFIER);
+      m_type.TlvSerialize (i);
+      Tlv::Serialize (i, m_mobileNodeAddress, TLV_MN_LINK_IDENTIFIER);
+      Tlv::Serialize (i, m_poaAddress, TLV_POA_LINK_IDENTIFIER);
     }
     uint32_t 
-    LinkIdentifier::TlvDeserialize (Buffer &buffer)
+    LinkIdentifier::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t size = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
-      buffer.RemoveAtStart (2); // Type + Length;
-      size  += m_type.TlvDeserialize (buffer);
-      size  += Tlv::Deserialize (buffer, m_mobileNodeAddress, TLV_MN_LINK_IDENTIFIER);
-      size  += Tlv::Deserialize (buffer, m_poaAddress, TLV_POA_LINK_IDENTIFIER);
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
+      i.Next (); // Length;
+      size  += m_type.TlvDeserialize (i);
+      size  += Tlv::Deserialize (i, m_mobileNodeAddress, TLV_MN_LINK_IDENTIFIER);
+      size  += Tlv::Deserialize (i, m_poaAddress, TLV_POA_LINK_IDENTIFIER);
       return size + 2; // + Type + Length;
     }
     std::ostream &
@@ -157,10 +152,20 @@ namespace ns3 {
     {
       return Tlv::Serialize<LinkIdentifier> (buffer, linkIdentifierList, TLV_LINK_IDENTIFIER_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const LinkIdentifierList &linkIdentifierList)
+    {
+      Tlv::Serialize<LinkIdentifier> (i, linkIdentifierList, TLV_LINK_IDENTIFIER_LIST);
+    }
     uint32_t 
     TlvDeserialize (Buffer &buffer, LinkIdentifierList &linkIdentifierList)
     {
       return Tlv::Deserialize<LinkIdentifier> (buffer, linkIdentifierList, TLV_LINK_IDENTIFIER_LIST);
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, LinkIdentifierList &linkIdentifierList)
+    {
+      return Tlv::Deserialize<LinkIdentifier> (i, linkIdentifierList, TLV_LINK_IDENTIFIER_LIST);
+    }
   } // namespace mih
 } // namespace ns3
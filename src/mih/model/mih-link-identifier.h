@@ -47,8 +47,10 @@ namespace ns3 {
       bool IsEqual (LinkIdentifier const &o) const;
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (LinkIdentifier);
       static Ptr<LinkIdentifier> CreateFromTlvType (uint8_t tlvTypeValue);
     protected:
@@ -63,7 +65,9 @@ namespace ns3 {
     std::ostream &operator << (std::ostream &os, LinkIdentifierList &a);
     uint32_t GetTlvSerializedSize (LinkIdentifierList &linkIdentifierList);
     void TlvSerialize (Buffer &buffer, LinkIdentifierList &linkIdentifierList);
+    void TlvSerialize (Buffer::Iterator &i, const LinkIdentifierList &linkIdentifierList);
     uint32_t TlvDeserialize (Buffer &buffer, LinkIdentifierList &inkIdentifierList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, LinkIdentifierList &linkIdentifierList);
   }
 }
 
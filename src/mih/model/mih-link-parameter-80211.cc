@@ -24,10 +24,7 @@ namespace ns3 {
   namespace mih {
     LinkParameter80211::LinkParameter80211 (uint8_t paramterCode) :
       m_parameterCode (paramterCode)
-    {
-      SimulationSingleton<TlvObjectFactory<LinkParameterType> >::Get ()->AddTlvTypeConstructor (TLV_LINK_PARAMETER_802_11,
-                                                                                                MakeCallback (&LinkParameter80211::Create));
-    }
+    {}
     LinkParameter80211::LinkParameter80211 (LinkParameter80211 const &o) :
       m_parameterCode (o.m_parameterCode)
     {}
@@ -38,6 +35,7 @@ namespace ns3 {
     }
     CHOICE_HELPER_IMPLEM (LinkParameter80211, LinkParameterType)
     TLV_TYPE_HELPER_IMPLEM (LinkParameter80211, TLV_LINK_PARAMETER_802_11)
+    TLV_OBJECT_FACTORY_REGISTER (LinkParameter80211, LinkParameterType, TLV_LINK_PARAMETER_802_11)
     uint32_t
     LinkParameter80211::GetTlvSerializedSize (void) const 
     {
@@ -74,14 +72,14 @@ namespace ns3 {
          << std::hex << (int)m_parameterCode << codestr;
     }
     void 
-    LinkParameter80211::TlvSerialize (Buffer &buffer) const
+    LinkParameter80211::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU8 (buffer, m_parameterCode, TLV_LINK_PARAMETER_802_11);
+      Tlv::SerializeU8 (i, m_parameterCode, TLV_LINK_PARAMETER_802_11);
     }
     uint32_t
-    LinkParameter80211::TlvDeserialize (Buffer &buffer) 
+    LinkParameter80211::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU8 (buffer, m_parameterCode, TLV_LINK_PARAMETER_802_11);
+      return Tlv::DeserializeU8 (i, m_parameterCode, TLV_LINK_PARAMETER_802_11);
     }    
   } // namespace mih
 } // namespace ns3
@@ -0,0 +1,71 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mih-link-parameter-80216.h"
+
+namespace ns3 {
+  namespace mih {
+    LinkParameter80216::LinkParameter80216 (uint8_t parameterCode) :
+      m_parameterCode (parameterCode)
+    {}
+    LinkParameter80216::LinkParameter80216 (LinkParameter80216 const &o) :
+      m_parameterCode (o.m_parameterCode)
+    {}
+    uint8_t
+    LinkParameter80216::GetParameterCode (void)
+    {
+      return m_parameterCode;
+    }
+    CHOICE_HELPER_IMPLEM (LinkParameter80216, LinkParameterType)
+    TLV_TYPE_HELPER_IMPLEM (LinkParameter80216, TLV_LINK_PARAMETER_80216)
+    TLV_OBJECT_FACTORY_REGISTER (LinkParameter80216, LinkParameterType, TLV_LINK_PARAMETER_80216)
+    uint32_t
+    LinkParameter80216::GetTlvSerializedSize (void) const
+    {
+      return Tlv::GetSerializedSizeU8 ();
+    }
+    void
+    LinkParameter80216::Print (std::ostream &os) const
+    {
+      std::string codestr = " (INVALID) ";
+      switch (m_parameterCode)
+        {
+        case LinkParameter80216::CINR :
+          {
+            codestr = " (CINR) ";
+            break;
+          }
+        default:
+          {
+            codestr = " (INVALID) ";
+            break;
+          }
+        }
+      os << "Link Parameter 802.16 = "
+         << std::hex << (int)m_parameterCode << codestr;
+    }
+    void
+    LinkParameter80216::TlvSerialize (Buffer::Iterator &i) const
+    {
+      Tlv::SerializeU8 (i, m_parameterCode, TLV_LINK_PARAMETER_80216);
+    }
+    uint32_t
+    LinkParameter80216::TlvDeserialize (Buffer::Iterator &i)
+    {
+      return Tlv::DeserializeU8 (i, m_parameterCode, TLV_LINK_PARAMETER_80216);
+    }
+  } // namespace mih
+} // namespace ns3
@@ -0,0 +1,76 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mih-link-parameter-lte.h"
+
+namespace ns3 {
+  namespace mih {
+    LinkParameterLte::LinkParameterLte (uint8_t parameterCode) :
+      m_parameterCode (parameterCode)
+    {}
+    LinkParameterLte::LinkParameterLte (LinkParameterLte const &o) :
+      m_parameterCode (o.m_parameterCode)
+    {}
+    uint8_t
+    LinkParameterLte::GetParameterCode (void)
+    {
+      return m_parameterCode;
+    }
+    CHOICE_HELPER_IMPLEM (LinkParameterLte, LinkParameterType)
+    TLV_TYPE_HELPER_IMPLEM (LinkParameterLte, TLV_LINK_PARAMETER_LTE)
+    TLV_OBJECT_FACTORY_REGISTER (LinkParameterLte, LinkParameterType, TLV_LINK_PARAMETER_LTE)
+    uint32_t
+    LinkParameterLte::GetTlvSerializedSize (void) const
+    {
+      return Tlv::GetSerializedSizeU8 ();
+    }
+    void
+    LinkParameterLte::Print (std::ostream &os) const
+    {
+      std::string codestr = " (INVALID) ";
+      switch (m_parameterCode)
+        {
+        case LinkParameterLte::RSRP :
+          {
+            codestr = " (RSRP) ";
+            break;
+          }
+        case LinkParameterLte::RSRQ :
+          {
+            codestr = " (RSRQ) ";
+            break;
+          }
+        default:
+          {
+            codestr = " (INVALID) ";
+            break;
+          }
+        }
+      os << "Link Parameter LTE = "
+         << std::hex << (int)m_parameterCode << codestr;
+    }
+    void
+    LinkParameterLte::TlvSerialize (Buffer::Iterator &i) const
+    {
+      Tlv::SerializeU8 (i, m_parameterCode, TLV_LINK_PARAMETER_LTE);
+    }
+    uint32_t
+    LinkParameterLte::TlvDeserialize (Buffer::Iterator &i)
+    {
+      return Tlv::DeserializeU8 (i, m_parameterCode, TLV_LINK_PARAMETER_LTE);
+    }
+  } // namespace mih
+} // namespace ns3
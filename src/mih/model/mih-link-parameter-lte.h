@@ -0,0 +1,52 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef   	MIH_LINK_PARAMETER_LTE_H
+#define   	MIH_LINK_PARAMETER_LTE_H
+
+#include <stdint.h>
+#include "mih-choice-helper.h"
+#include "mih-link-parameter-type.h"
+
+namespace ns3 {
+  namespace mih {
+    // Reference signal measurements of a LTE cell, RSRP in dBm and
+    // RSRQ in dB;
+    class LinkParameterLte : public LinkParameterType {
+    public:
+      enum Type {
+        INVALID = 0xff,
+        RSRP = 0,
+        RSRQ = 1,
+      };
+      LinkParameterLte (uint8_t parameterCode = LinkParameterLte::INVALID);
+      LinkParameterLte (LinkParameterLte const &o);
+      uint8_t GetParameterCode (void);
+      CHOICE_HELPER_HEADER (LinkParameterLte, LinkParameterType);
+      virtual uint32_t GetTlvSerializedSize (void) const;
+      virtual void Print (std::ostream &os) const;
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
+      TLV_TYPE_HELPER_HEADER (LinkParameterLte);
+    protected:
+      uint8_t m_parameterCode;
+    };
+  } // namespace mih
+} // namespace ns3
+
+#endif 	    /* !MIH_LINK_PARAMETER_LTE_H */
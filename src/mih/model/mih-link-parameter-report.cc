@@ -69,47 +69,37 @@ namespace ns3 {
       
     }
     void
-    LinkParameterReport::TlvSerialize (Buffer &buffer) const
+    LinkParameterReport::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
       
       NS_ASSERT (m_linkParameter != 0);
       payloadLength = m_linkParameter->GetTlvSerializedSize () +
         m_threshold.GetTlvSerializedSize ();
 
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field + Length field only;
-      
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length field;
 
-      m_linkParameter->TlvSerialize (buffer);
-      m_threshold.TlvSerialize (buffer);
+      m_linkParameter->TlvSerialize (i);
+      m_threshold.TlvSerialize (i);
       
     }
     uint32_t
-    LinkParameterReport::TlvDeserialize (Buffer &buffer)
+    LinkParameterReport::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
       
-      i = buffer.Begin ();
-      m_linkParameter = LinkParameter::CreateFromTlvType (i.ReadU8 ());
-      totalBytesRead += m_linkParameter->TlvDeserialize (buffer);
-      totalBytesRead += m_threshold.TlvDeserialize (buffer);
+      m_linkParameter = LinkParameter::CreateFromTlvType (i.PeekU8 ());
+      totalBytesRead += m_linkParameter->TlvDeserialize (i);
+      totalBytesRead += m_threshold.TlvDeserialize (i);
 
       return totalBytesRead;
       
@@ -130,10 +120,20 @@ namespace ns3 {
     {
       Tlv::Serialize<LinkParameterReport> (buffer, linkParameterReportList, TLV_LINK_PARAMETER_REPORT_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const LinkParameterReportList &linkParameterReportList)
+    {
+      Tlv::Serialize<LinkParameterReport> (i, linkParameterReportList, TLV_LINK_PARAMETER_REPORT_LIST);
+    }
     uint32_t
     TlvDeserialize (Buffer &buffer, LinkParameterReportList &linkParameterReportList)
     {
       return Tlv::Deserialize<LinkParameterReport> (buffer, linkParameterReportList, TLV_LINK_PARAMETER_REPORT_LIST);    
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, LinkParameterReportList &linkParameterReportList)
+    {
+      return Tlv::Deserialize<LinkParameterReport> (i, linkParameterReportList, TLV_LINK_PARAMETER_REPORT_LIST);
+    }
   } // namespace mih
 } // namespace ns3
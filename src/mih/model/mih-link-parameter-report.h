@@ -39,8 +39,10 @@ namespace ns3 {
       Threshold GetThreshold (void);
       void Print (std::ostream &os) const;
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (LinkParameterReport);
       static Ptr<LinkParameterReport> CreateFromTlvType (uint8_t val);
     protected:
@@ -51,7 +53,9 @@ namespace ns3 {
     typedef LinkParameterReportList::iterator LinkParameterReportListI;
     uint32_t GetTlvSerializedSize (const LinkParameterReportList &linkParameterReportList);
     void TlvSerialize (Buffer &buffer, const LinkParameterReportList &linkParameterReportList);
+    void TlvSerialize (Buffer::Iterator &i, const LinkParameterReportList &linkParameterReportList);
     uint32_t TlvDeserialize (Buffer &buffer, LinkParameterReportList &linkParameterReportList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, LinkParameterReportList &linkParameterReportList);
   } // namespace mih
 } // namespace ns3
 
@@ -34,10 +34,20 @@ namespace ns3 {
     {
       return Tlv::Serialize<LinkParameterType> (buffer, linkParameterTypeList, TLV_LINK_PARAMETER_TYPE_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const LinkParameterTypeList &linkParameterTypeList)
+    {
+      Tlv::Serialize<LinkParameterType> (i, linkParameterTypeList, TLV_LINK_PARAMETER_TYPE_LIST);
+    }
     uint32_t 
     TlvDeserialize (Buffer &buffer, LinkParameterTypeList &linkParameterTypeList)
     {
       return Tlv::Deserialize<LinkParameterType> (buffer, linkParameterTypeList, TLV_LINK_PARAMETER_TYPE_LIST);
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, LinkParameterTypeList &linkParameterTypeList)
+    {
+      return Tlv::Deserialize<LinkParameterType> (i, linkParameterTypeList, TLV_LINK_PARAMETER_TYPE_LIST);
+    }
   } // namespace mih
 } // namespace ns3
@@ -35,8 +35,10 @@ namespace ns3 {
       CHOICE_HELPER_PURE_VIRTUAL_HEADER (LinkParameterType);
       virtual uint32_t GetTlvSerializedSize (void) const = 0;
       virtual void Print (std::ostream &os) const = 0;
-      virtual void TlvSerialize (Buffer &buffer) const = 0;
-      virtual uint32_t TlvDeserialize (Buffer &buffer) = 0;
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const = 0;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i) = 0;
       TLV_TYPE_HELPER_HEADER (LinkParameterType);
     protected:
     };
@@ -44,7 +46,9 @@ namespace ns3 {
     typedef LinkParameterTypeList::iterator LinkParameterTypeListI;
     uint32_t GetTlvSerializedSize (const LinkParameterTypeList &linkParameterTypeList);
     void TlvSerialize (Buffer &buffer, const LinkParameterTypeList &linkParameterTypeList);
+    void TlvSerialize (Buffer::Iterator &i, const LinkParameterTypeList &linkParameterTypeList);
     uint32_t TlvDeserialize (Buffer &buffer, LinkParameterTypeList &linkParameterTypeList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, LinkParameterTypeList &linkParameterTypeList);
   } // namespace mih
 } // namespace ns3
 
@@ -24,10 +24,7 @@ namespace ns3 {
   namespace mih {
     LinkParameterValue::LinkParameterValue (uint16_t value) :
       m_value (value)
-    {
-      SimulationSingleton<TlvObjectFactory<ParameterValue> >::Get ()->AddTlvTypeConstructor (TLV_LINK_PARAMETER_VALUE,
-                                                                                             MakeCallback (&LinkParameterValue::Create));
-    }
+    {}
     LinkParameterValue::LinkParameterValue (LinkParameterValue const &o) :
       m_value (o.m_value)
     {}
@@ -38,6 +35,7 @@ namespace ns3 {
     }
     CHOICE_HELPER_IMPLEM (LinkParameterValue, ParameterValue);
     TLV_TYPE_HELPER_IMPLEM (LinkParameterValue, TLV_LINK_PARAMETER_VALUE);
+    TLV_OBJECT_FACTORY_REGISTER (LinkParameterValue, ParameterValue, TLV_LINK_PARAMETER_VALUE)
     uint32_t
     LinkParameterValue::GetTlvSerializedSize (void) const
     {
@@ -49,14 +47,14 @@ namespace ns3 {
       os << "Link Parameter Value = " << std::dec << (int) m_value << std::endl;
     }
     void
-    LinkParameterValue::TlvSerialize (Buffer &buffer) const
+    LinkParameterValue::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU16 (buffer, m_value, TLV_LINK_PARAMETER_VALUE);
+      Tlv::SerializeU16 (i, m_value, TLV_LINK_PARAMETER_VALUE);
     }
     uint32_t
-    LinkParameterValue::TlvDeserialize (Buffer &buffer)
+    LinkParameterValue::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU16 (buffer, m_value, TLV_LINK_PARAMETER_VALUE);
+      return Tlv::DeserializeU16 (i, m_value, TLV_LINK_PARAMETER_VALUE);
     }
   } // namespace mih
 } // namespace ns3
@@ -36,8 +36,10 @@ namespace ns3 {
       CHOICE_HELPER_HEADER (LinkParameterValue, ParameterValue);
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);    
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);    
       TLV_TYPE_HELPER_HEADER (LinkParameterValue);
     protected:
       uint16_t m_value;
@@ -83,10 +83,8 @@ namespace ns3 {
       os << ")";
     }
     void
-    LinkParameter::TlvSerialize (Buffer &buffer) const
+    LinkParameter::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
 
       NS_ASSERT (m_linkParameterType != 0);
@@ -95,38 +93,30 @@ namespace ns3 {
       payloadLength = m_linkParameterType->GetTlvSerializedSize () +
         m_parameterValue->GetTlvSerializedSize ();
       
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field + Length field only;
-      
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length field;
       
-      m_linkParameterType->TlvSerialize (buffer);
-      m_parameterValue->TlvSerialize (buffer);
+      m_linkParameterType->TlvSerialize (i);
+      m_parameterValue->TlvSerialize (i);
     }
     uint32_t
-    LinkParameter::TlvDeserialize (Buffer &buffer)
+    LinkParameter::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
 
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      m_linkParameterType = LinkParameterType::CreateFromTlvType (i.ReadU8 ());
-      buffer.RemoveAtStart (totalBytesRead);
+      m_linkParameterType = LinkParameterType::CreateFromTlvType (i.PeekU8 ());
 
-      totalBytesRead += m_linkParameterType->TlvDeserialize (buffer);
-      i = buffer.Begin ();
-      m_parameterValue = ParameterValue::CreateFromTlvType (i.ReadU8 ());
-      totalBytesRead += m_parameterValue->TlvDeserialize (buffer);
+      totalBytesRead += m_linkParameterType->TlvDeserialize (i);
+      m_parameterValue = ParameterValue::CreateFromTlvType (i.PeekU8 ());
+      totalBytesRead += m_parameterValue->TlvDeserialize (i);
       return totalBytesRead;
     }
     uint32_t
@@ -139,10 +129,20 @@ namespace ns3 {
     {
       Tlv::Serialize<LinkParameter> (buffer, linkParameterList, TLV_LINK_PARAMETER_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const LinkParameterList &linkParameterList)
+    {
+      Tlv::Serialize<LinkParameter> (i, linkParameterList, TLV_LINK_PARAMETER_LIST);
+    }
     uint32_t
     TlvDeserialize (Buffer &buffer, LinkParameterList &linkParameterList)
     {
       return Tlv::Deserialize<LinkParameter> (buffer, linkParameterList, TLV_LINK_PARAMETER_LIST);
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, LinkParameterList &linkParameterList)
+    {
+      return Tlv::Deserialize<LinkParameter> (i, linkParameterList, TLV_LINK_PARAMETER_LIST);
+    }
   } // namespace mih
 } // namespace ns3
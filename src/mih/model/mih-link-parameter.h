@@ -40,8 +40,10 @@ namespace ns3 {
       virtual ~LinkParameter (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);    
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);    
       TLV_TYPE_HELPER_HEADER (LinkParameter);
       static Ptr<LinkParameter> CreateFromTlvType (uint8_t tlvTypeValue);
     protected:
@@ -52,7 +54,9 @@ namespace ns3 {
     typedef LinkParameterList::iterator LinkParameterListI;
     uint32_t GetTlvSerializedSize (const LinkParameterList &linkParameterList);
     void TlvSerialize (Buffer &buffer, const LinkParameterList &linkParameterList);
+    void TlvSerialize (Buffer::Iterator &i, const LinkParameterList &linkParameterList);
     uint32_t TlvDeserialize (Buffer &buffer, LinkParameterList &linkParameterList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, LinkParameterList &linkParameterList);
   } // namespace mih
 } // namespace ns3
 
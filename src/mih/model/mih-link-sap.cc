@@ -26,20 +26,95 @@ NS_LOG_COMPONENT_DEFINE ("MihLinkSap");
 
 namespace ns3 {
   namespace mih {
+    template <typename C>
+    static void
+    AddSubscriber (std::vector<C> &subscribers, C callback)
+    {
+      for (uint32_t j = 0; j < subscribers.size (); j++)
+        {
+          if (subscribers[j].IsEqual (callback))
+            {
+              return;
+            }
+        }
+      subscribers.push_back (callback);
+    }
+    // Returns true once the last subscriber is gone;
+    template <typename C>
+    static bool
+    RemoveSubscriber (std::vector<C> &subscribers, C callback)
+    {
+      for (uint32_t j = 0; j < subscribers.size (); j++)
+        {
+          if (subscribers[j].IsEqual (callback))
+            {
+              subscribers.erase (subscribers.begin () + j);
+              break;
+            }
+        }
+      return subscribers.empty ();
+    }
     TypeId
     MihLinkSap::GetTypeId (void) {
       static TypeId tid = TypeId ("ns3::mih::MihLinkSap")
 	.SetParent<Object> ();
       return tid;
     }
+    MihLinkSap::MihLinkSap (void) :
+      m_subscribedEvents (0)
+    {}
     MihLinkSap::~MihLinkSap (void)
     {}
+    bool
+    MihLinkSap::IsEventSubscribed (EventList::Type eventType) const
+    {
+      return (m_subscribedEvents & eventType) != 0;
+    }
+    uint32_t
+    MihLinkSap::GetSubscriberCount (EventList::Type eventType) const
+    {
+      switch (eventType)
+        {
+        case EventList::LINK_DETECTED:
+          return m_linkDetectedSubscribers.size ();
+        case EventList::LINK_UP:
+          return m_linkUpSubscribers.size ();
+        case EventList::LINK_DOWN:
+          return m_linkDownSubscribers.size ();
+        case EventList::LINK_PARAMETERS_REPORT:
+          return m_linkParametersReportSubscribers.size ();
+        case EventList::LINK_GOING_DOWN:
+          return m_linkGoingDownSubscribers.size ();
+        case EventList::LINK_HANDOVER_IMMINENT:
+          return m_linkHOImminentSubscribers.size ();
+        case EventList::LINK_HANDOVER_COMPLETE:
+          return m_linkHOCompleteSubscribers.size ();
+        case EventList::LINK_PDU_TRANSMIT_STATUS:
+          return m_linkPduTxStatusSubscribers.size ();
+        default:
+          return 0;
+        }
+    }
+    Time
+    MihLinkSap::GetActionDuration (LinkAction action)
+    {
+      return Seconds (0);
+    }
+    void
+    MihLinkSap::NotifyLinkParameterSample (uint8_t parameterIndex, double value)
+    {
+      m_thresholdEngine.NotifySample (parameterIndex, value);
+    }
     // Event Service
     void
     MihLinkSap::LinkDetected (MihfId sourceMihfId, 
                               LinkDetectedInformationList linkDetectedInfoList) 
     {
       NS_LOG_FUNCTION (this);
+      if ((m_subscribedEvents & EventList::LINK_DETECTED) == 0)
+        {
+          return;
+        }
       NS_LOG_DEBUG ("MIH LinkDetected Event");
       NS_LOG_DEBUG ("Source Mihf Identifier = " << sourceMihfId);
       for (std::vector<Ptr<LinkDetectedInformation>>::iterator i = linkDetectedInfoList.begin (); i != linkDetectedInfoList.end (); ++i)
@@ -54,8 +129,11 @@ namespace ns3 {
               NS_LOG_DEBUG (rates.GetRate (j)<<", ");
             }
         }
-      m_linkDetectedTraceCallback (sourceMihfId,
-                                   linkDetectedInfoList);
+      for (uint32_t j = 0; j < m_linkDetectedSubscribers.size (); j++)
+        {
+          m_linkDetectedSubscribers[j] (sourceMihfId,
+                                        linkDetectedInfoList);
+        }
     }
     void
     MihLinkSap::LinkUp (MihfId sourceMihfId,
@@ -66,14 +144,21 @@ namespace ns3 {
                         MobilityManagementSupport mobilitySupport) 
     {
       NS_LOG_FUNCTION (this);
+      if ((m_subscribedEvents & EventList::LINK_UP) == 0)
+        {
+          return;
+        }
       NS_LOG_DEBUG ("MIH LinkUp Event");
       NS_LOG_DEBUG ("Source Mihf Identifier = " << sourceMihfId << ", from Link Identifier = " << linkIdentifier << ", Old AR = " << oldAR << ", New AR = " << newAR);
-      m_linkUpTracedCallback (sourceMihfId,
-                              linkIdentifier,
-                              oldAR,
-                              newAR,
-                              ipRenewal,
-                              mobilitySupport);
+      for (uint32_t j = 0; j < m_linkUpSubscribers.size (); j++)
+        {
+          m_linkUpSubscribers[j] (sourceMihfId,
+                                  linkIdentifier,
+                                  oldAR,
+                                  newAR,
+                                  ipRenewal,
+                                  mobilitySupport);
+        }
     }
     void 
     MihLinkSap::LinkDown (MihfId sourceMihfId, 
@@ -82,12 +167,19 @@ namespace ns3 {
                           LinkDownReason reason) 
     {
       NS_LOG_FUNCTION (this);
+      if ((m_subscribedEvents & EventList::LINK_DOWN) == 0)
+        {
+          return;
+        }
       NS_LOG_DEBUG ("MIH LinkDown Event");
       NS_LOG_DEBUG ("Source Mihf Identifier = " << sourceMihfId << ", from Link Identifier = " << linkIdentifier << ", Old AR = " << oldAR << ", Reason = " << reason);
-      m_linkDownTracedCallback (sourceMihfId,
-                                linkIdentifier,
-                                oldAR,
-                                reason);
+      for (uint32_t j = 0; j < m_linkDownSubscribers.size (); j++)
+        {
+          m_linkDownSubscribers[j] (sourceMihfId,
+                                    linkIdentifier,
+                                    oldAR,
+                                    reason);
+        }
     }
     void 
     MihLinkSap::LinkParametersReport (MihfId sourceMihfId, 
@@ -95,9 +187,16 @@ namespace ns3 {
                                       LinkParameterReportList parameters) 
     {
       NS_LOG_FUNCTION (this);
-      m_linkParametersReportTracedCallback (sourceMihfId,
-                                            linkIdentifier,
-                                            parameters);
+      if ((m_subscribedEvents & EventList::LINK_PARAMETERS_REPORT) == 0)
+        {
+          return;
+        }
+      for (uint32_t j = 0; j < m_linkParametersReportSubscribers.size (); j++)
+        {
+          m_linkParametersReportSubscribers[j] (sourceMihfId,
+                                                linkIdentifier,
+                                                parameters);
+        }
     }
     void 
     MihLinkSap::LinkGoingDown (MihfId sourceMihfId, 
@@ -106,10 +205,17 @@ namespace ns3 {
                                LinkGoingDownReason reason) 
     {
       NS_LOG_FUNCTION (this);
-      m_linkGoingDownTracedCallback (sourceMihfId,
-                                     linkIdentifier,
-                                     timeInterval,
-                                     reason);
+      if ((m_subscribedEvents & EventList::LINK_GOING_DOWN) == 0)
+        {
+          return;
+        }
+      for (uint32_t j = 0; j < m_linkGoingDownSubscribers.size (); j++)
+        {
+          m_linkGoingDownSubscribers[j] (sourceMihfId,
+                                         linkIdentifier,
+                                         timeInterval,
+                                         reason);
+        }
     }
     void
     MihLinkSap::LinkHandoverImminent (MihfId sourceMihfId, 
@@ -119,11 +225,18 @@ namespace ns3 {
                                       Address newAR) 
     {
       NS_LOG_FUNCTION (this);
-      m_linkHOImminentTracedCallback (sourceMihfId,
-                                      oldLinkIdentifier,
-                                      newLinkIdentifier,
-                                      oldAR,
-                                      newAR);
+      if ((m_subscribedEvents & EventList::LINK_HANDOVER_IMMINENT) == 0)
+        {
+          return;
+        }
+      for (uint32_t j = 0; j < m_linkHOImminentSubscribers.size (); j++)
+        {
+          m_linkHOImminentSubscribers[j] (sourceMihfId,
+                                          oldLinkIdentifier,
+                                          newLinkIdentifier,
+                                          oldAR,
+                                          newAR);
+        }
     }
     void 
     MihLinkSap::LinkHandoverComplete (MihfId sourceMihfId, 
@@ -134,12 +247,19 @@ namespace ns3 {
                                       Status handoverStatus)
     {
       NS_LOG_FUNCTION (this);
-      m_linkHOCompleteTracedCallback (sourceMihfId,
-                                      oldLinkIdentifier,
-                                      newLinkIdentifier,
-                                      oldAR,
-                                      newAR,
-                                      handoverStatus);
+      if ((m_subscribedEvents & EventList::LINK_HANDOVER_COMPLETE) == 0)
+        {
+          return;
+        }
+      for (uint32_t j = 0; j < m_linkHOCompleteSubscribers.size (); j++)
+        {
+          m_linkHOCompleteSubscribers[j] (sourceMihfId,
+                                          oldLinkIdentifier,
+                                          newLinkIdentifier,
+                                          oldAR,
+                                          newAR,
+                                          handoverStatus);
+        }
     }
     void 
     MihLinkSap::LinkPduTransmitStatus (MihfId sourceMihfId, 
@@ -148,10 +268,17 @@ namespace ns3 {
                                        bool transmissionStatus) 
     {
       NS_LOG_FUNCTION (this);
-      m_linkPduTxStatusTracedCallback (sourceMihfId,
-                                       linkIdentifier,
-                                       packetIdentifier,
-                                       transmissionStatus);
+      if ((m_subscribedEvents & EventList::LINK_PDU_TRANSMIT_STATUS) == 0)
+        {
+          return;
+        }
+      for (uint32_t j = 0; j < m_linkPduTxStatusSubscribers.size (); j++)
+        {
+          m_linkPduTxStatusSubscribers[j] (sourceMihfId,
+                                           linkIdentifier,
+                                           packetIdentifier,
+                                           transmissionStatus);
+        }
     }
 
     // Command Service
@@ -180,49 +307,57 @@ namespace ns3 {
       if (linkDetectedEventType1 == EventList::LINK_DETECTED)
         {
           NS_ASSERT (!linkDetectedEventCallback1.IsNull ());
-          m_linkDetectedTraceCallback.ConnectWithoutContext (linkDetectedEventCallback1);
+          AddSubscriber (m_linkDetectedSubscribers, linkDetectedEventCallback1);
+          m_subscribedEvents |= EventList::LINK_DETECTED;
           events.SetEventList (events.GetEventList () | linkDetectedEventType1);
         }
       if (linkUpEventType2 == EventList::LINK_UP)
         {
           NS_ASSERT (!linkUpEventCallback2.IsNull ());
-          m_linkUpTracedCallback.ConnectWithoutContext (linkUpEventCallback2);
+          AddSubscriber (m_linkUpSubscribers, linkUpEventCallback2);
+          m_subscribedEvents |= EventList::LINK_UP;
           events.SetEventList (events.GetEventList () | linkUpEventType2);
         }
       if (linkDownEventType3 == EventList::LINK_DOWN)
         {
           NS_ASSERT (!linkDownEventCallback3.IsNull ());
-          m_linkDownTracedCallback.ConnectWithoutContext (linkDownEventCallback3);
+          AddSubscriber (m_linkDownSubscribers, linkDownEventCallback3);
+          m_subscribedEvents |= EventList::LINK_DOWN;
           events.SetEventList (events.GetEventList () | linkDownEventType3);
         }
       if (linkParamReportEventType4 == EventList::LINK_PARAMETERS_REPORT)
         {
           NS_ASSERT (!linkParamReportEventCallback4.IsNull ());
-          m_linkParametersReportTracedCallback.ConnectWithoutContext (linkParamReportEventCallback4);
+          AddSubscriber (m_linkParametersReportSubscribers, linkParamReportEventCallback4);
+          m_subscribedEvents |= EventList::LINK_PARAMETERS_REPORT;
           events.SetEventList (events.GetEventList () | linkParamReportEventType4);
         }
       if (linkGoingDownEventType5 == EventList::LINK_GOING_DOWN)
         {
           NS_ASSERT (!linkGoingDownEventCallback5.IsNull ());
-          m_linkGoingDownTracedCallback.ConnectWithoutContext (linkGoingDownEventCallback5);
+          AddSubscriber (m_linkGoingDownSubscribers, linkGoingDownEventCallback5);
+          m_subscribedEvents |= EventList::LINK_GOING_DOWN;
           events.SetEventList (events.GetEventList () | linkGoingDownEventType5);
         }
       if (linkHOImminentEventType6 == EventList::LINK_HANDOVER_IMMINENT)
         {
           NS_ASSERT (!linkHOImminentEventCallback6.IsNull ());
-          m_linkHOImminentTracedCallback.ConnectWithoutContext (linkHOImminentEventCallback6);
+          AddSubscriber (m_linkHOImminentSubscribers, linkHOImminentEventCallback6);
+          m_subscribedEvents |= EventList::LINK_HANDOVER_IMMINENT;
           events.SetEventList (events.GetEventList () | linkHOImminentEventType6);
         }
       if (linkHOCompleteEventType7 == EventList::LINK_HANDOVER_COMPLETE)
         {
           NS_ASSERT (!linkHOCompleteEventCallback7.IsNull ());
-          m_linkHOCompleteTracedCallback.ConnectWithoutContext (linkHOCompleteEventCallback7);
+          AddSubscriber (m_linkHOCompleteSubscribers, linkHOCompleteEventCallback7);
+          m_subscribedEvents |= EventList::LINK_HANDOVER_COMPLETE;
           events.SetEventList (events.GetEventList () | linkHOCompleteEventType7);
         }
       if (linkPduTxStatusEventType8 == EventList::LINK_PDU_TRANSMIT_STATUS)
         {
           NS_ASSERT (!linkPduTxStatusEventCallback8.IsNull ());
-          m_linkPduTxStatusTracedCallback.ConnectWithoutContext (linkPduTxStatusEventCallback8);
+          AddSubscriber (m_linkPduTxStatusSubscribers, linkPduTxStatusEventCallback8);
+          m_subscribedEvents |= EventList::LINK_PDU_TRANSMIT_STATUS;
           events.SetEventList (events.GetEventList () | linkPduTxStatusEventType8);
         }
       
@@ -254,49 +389,73 @@ namespace ns3 {
       if (linkDetectedEventType1 == EventList::LINK_DETECTED)
         {
           NS_ASSERT (!linkDetectedEventCallback1.IsNull ());
-          m_linkDetectedTraceCallback.DisconnectWithoutContext (linkDetectedEventCallback1);
+          if (RemoveSubscriber (m_linkDetectedSubscribers, linkDetectedEventCallback1))
+            {
+              m_subscribedEvents &= ~EventList::LINK_DETECTED;
+            }
           events.SetEventList (events.GetEventList () | linkDetectedEventType1);
         }
       if (linkUpEventType2 == EventList::LINK_UP)
         {
           NS_ASSERT (!linkUpEventCallback2.IsNull ());
-          m_linkUpTracedCallback.DisconnectWithoutContext (linkUpEventCallback2);
+          if (RemoveSubscriber (m_linkUpSubscribers, linkUpEventCallback2))
+            {
+              m_subscribedEvents &= ~EventList::LINK_UP;
+            }
           events.SetEventList (events.GetEventList () | linkUpEventType2);
         }
       if (linkDownEventType3 == EventList::LINK_DOWN)
         {
           NS_ASSERT (!linkDownEventCallback3.IsNull ());
-          m_linkDownTracedCallback.DisconnectWithoutContext (linkDownEventCallback3);
+          if (RemoveSubscriber (m_linkDownSubscribers, linkDownEventCallback3))
+            {
+              m_subscribedEvents &= ~EventList::LINK_DOWN;
+            }
           events.SetEventList (events.GetEventList () | linkDownEventType3);
         }
       if (linkParamReportEventType4 == EventList::LINK_PARAMETERS_REPORT)
         {
           NS_ASSERT (!linkParamReportEventCallback4.IsNull ());
-          m_linkParametersReportTracedCallback.DisconnectWithoutContext (linkParamReportEventCallback4);
+          if (RemoveSubscriber (m_linkParametersReportSubscribers, linkParamReportEventCallback4))
+            {
+              m_subscribedEvents &= ~EventList::LINK_PARAMETERS_REPORT;
+            }
           events.SetEventList (events.GetEventList () | linkParamReportEventType4);
         }
       if (linkGoingDownEventType5 == EventList::LINK_GOING_DOWN)
         {
           NS_ASSERT (!linkGoingDownEventCallback5.IsNull ());
-          m_linkGoingDownTracedCallback.DisconnectWithoutContext (linkGoingDownEventCallback5);
+          if (RemoveSubscriber (m_linkGoingDownSubscribers, linkGoingDownEventCallback5))
+            {
+              m_subscribedEvents &= ~EventList::LINK_GOING_DOWN;
+            }
           events.SetEventList (events.GetEventList () | linkGoingDownEventType5);
         }
       if (linkHOImminentEventType6 == EventList::LINK_HANDOVER_IMMINENT)
         {
           NS_ASSERT (!linkHOImminentEventCallback6.IsNull ());
-          m_linkHOImminentTracedCallback.DisconnectWithoutContext (linkHOImminentEventCallback6);
+          if (RemoveSubscriber (m_linkHOImminentSubscribers, linkHOImminentEventCallback6))
+            {
+              m_subscribedEvents &= ~EventList::LINK_HANDOVER_IMMINENT;
+            }
           events.SetEventList (events.GetEventList () | linkHOImminentEventType6);
         }
       if (linkHOCompleteEventType7 == EventList::LINK_HANDOVER_COMPLETE)
         {
           NS_ASSERT (!linkHOCompleteEventCallback7.IsNull ());
-          m_linkHOCompleteTracedCallback.DisconnectWithoutContext (linkHOCompleteEventCallback7);
+          if (RemoveSubscriber (m_linkHOCompleteSubscribers, linkHOCompleteEventCallback7))
+            {
+              m_subscribedEvents &= ~EventList::LINK_HANDOVER_COMPLETE;
+            }
           events.SetEventList (events.GetEventList () | linkHOCompleteEventType7);
         }
       if (linkPduTxStatusEventType8 == EventList::LINK_PDU_TRANSMIT_STATUS)
         {
           NS_ASSERT (!linkPduTxStatusEventCallback8.IsNull ());
-          m_linkPduTxStatusTracedCallback.DisconnectWithoutContext (linkPduTxStatusEventCallback8);
+          if (RemoveSubscriber (m_linkPduTxStatusSubscribers, linkPduTxStatusEventCallback8))
+            {
+              m_subscribedEvents &= ~EventList::LINK_PDU_TRANSMIT_STATUS;
+            }
           events.SetEventList (events.GetEventList () | linkPduTxStatusEventType8);
         }
       
@@ -23,9 +23,9 @@
 
 #include <vector>
 #include "ns3/callback.h"
-#include "ns3/traced-callback.h"
 #include "ns3/object.h"
 #include "ns3/event-id.h"
+#include "ns3/nstime.h"
 #include "mih-callbacks.h"
 #include "mih-event-list.h"
 #include "mih-link-configuration-parameter.h"
@@ -35,6 +35,7 @@
 #include "mih-link-configure-thresholds.h"
 #include "mih-link-action.h"
 #include "mih-link-capability-discover.h"
+#include "mih-link-threshold-engine.h"
 
 namespace ns3 {
   namespace mih {
@@ -43,6 +44,7 @@ namespace ns3 {
     class MihLinkSap : public Object {
     public:
       static TypeId GetTypeId (void);
+      MihLinkSap (void);
       virtual ~MihLinkSap (void);
       virtual LinkType GetLinkType (void) = 0;
       virtual void SetLinkType (LinkType linkType) = 0;
@@ -128,21 +130,35 @@ namespace ns3 {
                               uint64_t executionDelay, 
                               Address poaLinkAddress,
                               LinkActionConfirmCallback actionConfirmCb) = 0;
+      // How long an action takes past its execution delay before it is
+      // confirmed, e.g. a scan of several channels;
+      virtual Time GetActionDuration (LinkAction action);
+      // Measurements, checked against the configured thresholds; see
+      // LinkThresholdEngine for the parameter index;
+      void NotifyLinkParameterSample (uint8_t parameterIndex, double value);
+      // Whether some MIH user subscribed to this event on this link,
+      // so that the link layer may skip building the indication;
+      bool IsEventSubscribed (EventList::Type eventType) const;
+      uint32_t GetSubscriberCount (EventList::Type eventType) const;
       
     protected:
       friend class MihFunction;
       // Device states;
       virtual Ptr<DeviceStatesResponse> GetDeviceStates (void) = 0;
       
-      // MIES TracedCallback;
-      MihLinkDetectedIndicationTracedCallback m_linkDetectedTraceCallback;
-      MihLinkUpIndicationTracedCallback m_linkUpTracedCallback;
-      MihLinkDownIndicationTracedCallback m_linkDownTracedCallback;
-      MihLinkParametersReportIndicationTracedCallback m_linkParametersReportTracedCallback;
-      MihLinkGoingDownIndicationTracedCallback m_linkGoingDownTracedCallback;
-      MihLinkHandoverImminentIndicationTracedCallback m_linkHOImminentTracedCallback;
-      MihLinkHandoverCompleteIndicationTracedCallback m_linkHOCompleteTracedCallback;
-      MihLinkPduTransmitStatusIndicationTracedCallback m_linkPduTxStatusTracedCallback;
+      // MIES subscribers of this link, one list per event type: an
+      // event is only dispatched to its own subscribers, and costs a
+      // single bit test of m_subscribedEvents when it has none;
+      std::vector<MihLinkDetectedIndicationCallback> m_linkDetectedSubscribers;
+      std::vector<MihLinkUpIndicationCallback> m_linkUpSubscribers;
+      std::vector<MihLinkDownIndicationCallback> m_linkDownSubscribers;
+      std::vector<MihLinkParametersReportIndicationCallback> m_linkParametersReportSubscribers;
+      std::vector<MihLinkGoingDownIndicationCallback> m_linkGoingDownSubscribers;
+      std::vector<MihLinkHandoverImminentIndicationCallback> m_linkHOImminentSubscribers;
+      std::vector<MihLinkHandoverCompleteIndicationCallback> m_linkHOCompleteSubscribers;
+      std::vector<MihLinkPduTransmitStatusIndicationCallback> m_linkPduTxStatusSubscribers;
+      uint32_t m_subscribedEvents;
+      LinkThresholdEngine m_thresholdEngine;
     };
     typedef std::vector<Ptr<MihLinkSap> > MihLinkSapList;
     typedef MihLinkSapList::iterator MihLinkSapListI;
@@ -56,14 +56,14 @@ namespace ns3 {
       os << "Link State Request = " << std::hex << (int)m_states << std::endl;
     }
     void 
-    LinkStatesRequest::TlvSerialize (Buffer &buffer) const
+    LinkStatesRequest::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU16 (buffer, m_states, TLV_LINK_STATES_REQUEST);
+      Tlv::SerializeU16 (i, m_states, TLV_LINK_STATES_REQUEST);
     }
     uint32_t
-    LinkStatesRequest::TlvDeserialize (Buffer &buffer)
+    LinkStatesRequest::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU16 (buffer, m_states, TLV_LINK_STATES_REQUEST);
+      return Tlv::DeserializeU16 (i, m_states, TLV_LINK_STATES_REQUEST);
     }
     
   } // namespace mih
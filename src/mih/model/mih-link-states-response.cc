@@ -36,12 +36,12 @@ namespace ns3 {
       NS_ASSERT (0);
     }
     void 
-    LinkStatesResponse::TlvSerialize (Buffer &buffer) const
+    LinkStatesResponse::TlvSerialize (Buffer::Iterator &i) const
     {
       NS_ASSERT (0);
     }
     uint32_t 
-    LinkStatesResponse::TlvDeserialize (Buffer &buffer)
+    LinkStatesResponse::TlvDeserialize (Buffer::Iterator &i)
     {
           NS_ASSERT (0);
           return 0;
@@ -56,10 +56,20 @@ namespace ns3 {
     {
       Tlv::Serialize<LinkStatesResponse> (buffer, linkStatesResponseList, TLV_LINK_STATES_RESPONSE_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const LinkStatesResponseList &linkStatesResponseList)
+    {
+      Tlv::Serialize<LinkStatesResponse> (i, linkStatesResponseList, TLV_LINK_STATES_RESPONSE_LIST);
+    }
     uint32_t
     TlvDeserialize (Buffer &buffer, LinkStatesResponseList &linkStatesResponseList)
     {
       return Tlv::Deserialize<LinkStatesResponse> (buffer, linkStatesResponseList, TLV_LINK_STATES_RESPONSE_LIST);      
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, LinkStatesResponseList &linkStatesResponseList)
+    {
+      return Tlv::Deserialize<LinkStatesResponse> (i, linkStatesResponseList, TLV_LINK_STATES_RESPONSE_LIST);
+    }
   } // namespace mih
 } // namespace ns3
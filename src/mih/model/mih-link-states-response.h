@@ -35,15 +35,19 @@ namespace ns3 {
       CHOICE_HELPER_PURE_VIRTUAL_HEADER (LinkStatesResponse);
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
     protected:
     };
     typedef std::vector<Ptr<LinkStatesResponse> > LinkStatesResponseList;
     typedef LinkStatesResponseList::iterator LinkStatesResponseListI;
     uint32_t GetTlvSerializedSize (const LinkStatesResponseList &linkStatesResponseList);
     void TlvSerialize (Buffer &buffer, const LinkStatesResponseList &linkStatesResponseList);
+    void TlvSerialize (Buffer::Iterator &i, const LinkStatesResponseList &linkStatesResponseList);
     uint32_t TlvDeserialize (Buffer &buffer, LinkStatesResponseList &linkStatesResponseList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, LinkStatesResponseList &linkStatesResponseList);
   } // namespace mih
 } // namespace ns3
 
@@ -131,38 +131,30 @@ namespace ns3 {
       os << "]" << std::endl;
     }
     void
-    LinkStatusRequest::TlvSerialize (Buffer &buffer) const
+    LinkStatusRequest::TlvSerialize (Buffer::Iterator &i) const
     {
       // Modify this ...
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
 
       payloadLength += m_linkStatesRequest.GetTlvSerializedSize ();
       payloadLength += m_linkDescriptorsRequest.GetTlvSerializedSize ();
       payloadLength += ns3::mih::GetTlvSerializedSize (m_linkParameterList);
 
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field + Length field only;
-      
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length field;
 
-      m_linkStatesRequest.TlvSerialize (buffer);
-      m_linkDescriptorsRequest.TlvSerialize (buffer);
-      ns3::mih::TlvSerialize (buffer, m_linkParameterList);
+      m_linkStatesRequest.TlvSerialize (i);
+      m_linkDescriptorsRequest.TlvSerialize (i);
+      ns3::mih::TlvSerialize (i, m_linkParameterList);
     }
     uint32_t 
-    LinkStatusRequest::TlvDeserialize (Buffer &buffer)
+    LinkStatusRequest::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t lengthOfLengthField = 0;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT_MSG (i.ReadU8 () == GetTlvTypeValue (), "List TLV type values mismatch!");
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
@@ -181,10 +173,9 @@ namespace ns3 {
             }
           payloadLengthValue += 128;
         }
-      buffer.RemoveAtStart (totalBytesRead); // Type + Length;
-      totalBytesRead += m_linkStatesRequest.TlvDeserialize (buffer);
-      totalBytesRead += m_linkDescriptorsRequest.TlvDeserialize (buffer);
-      totalBytesRead += ns3::mih::TlvDeserialize (buffer, m_linkParameterList);
+      totalBytesRead += m_linkStatesRequest.TlvDeserialize (i);
+      totalBytesRead += m_linkDescriptorsRequest.TlvDeserialize (i);
+      totalBytesRead += ns3::mih::TlvDeserialize (i, m_linkParameterList);
       return totalBytesRead;
     }
   } // namespace mih
@@ -141,10 +141,8 @@ namespace ns3 {
       
     }
     void 
-    LinkStatusResponse::TlvSerialize (Buffer &buffer) const
+    LinkStatusResponse::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
       
       payloadLength = m_linkIdentifier.GetTlvSerializedSize () +
@@ -152,37 +150,30 @@ namespace ns3 {
         ns3::mih::GetTlvSerializedSize (m_linkParameterList) +
         ns3::mih::GetTlvSerializedSize (m_linkDescriptorsResponseList);
 
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field + Length field only;
-      
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length field;
 
-      m_linkIdentifier.TlvSerialize (buffer);
-      ns3::mih::TlvSerialize (buffer, m_linkStatesResponseList);
-      ns3::mih::TlvSerialize (buffer, m_linkParameterList);
-      ns3::mih::TlvSerialize (buffer, m_linkDescriptorsResponseList);
+      m_linkIdentifier.TlvSerialize (i);
+      ns3::mih::TlvSerialize (i, m_linkStatesResponseList);
+      ns3::mih::TlvSerialize (i, m_linkParameterList);
+      ns3::mih::TlvSerialize (i, m_linkDescriptorsResponseList);
     }
     uint32_t
-    LinkStatusResponse::TlvDeserialize (Buffer &buffer)
+    LinkStatusResponse::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
-      totalBytesRead += m_linkIdentifier.TlvDeserialize (buffer);
-      totalBytesRead += ns3::mih::TlvDeserialize (buffer, m_linkStatesResponseList);
-      totalBytesRead += ns3::mih::TlvDeserialize (buffer, m_linkParameterList);
-      totalBytesRead += ns3::mih::TlvDeserialize (buffer, m_linkDescriptorsResponseList);
+      totalBytesRead += m_linkIdentifier.TlvDeserialize (i);
+      totalBytesRead += ns3::mih::TlvDeserialize (i, m_linkStatesResponseList);
+      totalBytesRead += ns3::mih::TlvDeserialize (i, m_linkParameterList);
+      totalBytesRead += ns3::mih::TlvDeserialize (i, m_linkDescriptorsResponseList);
       return totalBytesRead;
     }      
     uint32_t
@@ -195,10 +186,20 @@ namespace ns3 {
     {
       Tlv::Serialize<LinkStatusResponse> (buffer, linkStatusResponseList, TLV_LINK_STATUS_RESPONSE_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const LinkStatusResponseList &linkStatusResponseList)
+    {
+      Tlv::Serialize<LinkStatusResponse> (i, linkStatusResponseList, TLV_LINK_STATUS_RESPONSE_LIST);
+    }
     uint32_t
     TlvDeserialize (Buffer &buffer, LinkStatusResponseList &linkStatusResponseList)
     {
       return Tlv::Deserialize<LinkStatusResponse> (buffer, linkStatusResponseList, TLV_LINK_STATUS_RESPONSE_LIST);    
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, LinkStatusResponseList &linkStatusResponseList)
+    {
+      return Tlv::Deserialize<LinkStatusResponse> (i, linkStatusResponseList, TLV_LINK_STATUS_RESPONSE_LIST);
+    }
   } // namespace mih
 } // namespace ns3
@@ -54,8 +54,10 @@ namespace ns3 {
       uint32_t GetLinkDescriptorsResponseN (void);
       void SetLinkDescriptorsResponseList (LinkDescriptorsResponseList linkDescriptorsResponseList);
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (LinkStatusResponse);
       static Ptr<LinkStatusResponse> CreateFromTlvType (uint8_t val);
     protected:
@@ -68,7 +70,9 @@ namespace ns3 {
     typedef LinkStatusResponseList::iterator LinkStatusResponseI;
     uint32_t GetTlvSerializedSize (const LinkStatusResponseList &linkStatusResponseList);
     void TlvSerialize (Buffer &buffer, const LinkStatusResponseList &linkStatusResponseList);
+    void TlvSerialize (Buffer::Iterator &i, const LinkStatusResponseList &linkStatusResponseList);
     uint32_t TlvDeserialize (Buffer &buffer, LinkStatusResponseList &linkStatusResponseList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, LinkStatusResponseList &linkStatusResponseList);
   } // namespace mih
 } // namespace ns3
 
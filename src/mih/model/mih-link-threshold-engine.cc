@@ -0,0 +1,259 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */            
+/*
+ * Copyright (c) 2008 IT-SUDPARIS
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as 
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Providence SALUMU M. <Providence.Salumu_Munga@it-sudparis.eu>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+#include "mih-link-parameter-value.h"
+#include "mih-link-threshold-engine.h"
+
+NS_LOG_COMPONENT_DEFINE ("LinkThresholdEngine");
+
+namespace ns3 {
+  namespace mih {
+    LinkThresholdEngine::ParameterState::ParameterState (void) :
+      linkParameterType (0),
+      band (0),
+      hasSample (false),
+      lastSample (0),
+      interval (Seconds (0)),
+      nextReport (Seconds (0))
+    {}
+    LinkThresholdEngine::LinkThresholdEngine (void) :
+      m_parameters (PARAMETER_COUNT)
+    {
+      NS_LOG_FUNCTION (this);
+    }
+    void
+    LinkThresholdEngine::SetReportCallback (ReportCallback reportCallback)
+    {
+      NS_LOG_FUNCTION (this);
+      m_reportCallback = reportCallback;
+    }
+    bool
+    LinkThresholdEngine::CompareEntries (const ThresholdEntry &a, const ThresholdEntry &b)
+    {
+      return a.value < b.value;
+    }
+    uint8_t
+    LinkThresholdEngine::GetParameterIndex (Ptr<LinkParameterType> linkParameterType)
+    {
+      Ptr<LinkParameter80211> parameter80211 = DynamicCast<LinkParameter80211> (linkParameterType);
+      if (parameter80211 != 0 && parameter80211->GetParameterCode () < LTE_PARAMETER_BASE)
+        {
+          return parameter80211->GetParameterCode ();
+        }
+      Ptr<LinkParameterLte> parameterLte = DynamicCast<LinkParameterLte> (linkParameterType);
+      if (parameterLte != 0 && LTE_PARAMETER_BASE + parameterLte->GetParameterCode () < WIMAX_PARAMETER_BASE)
+        {
+          return LTE_PARAMETER_BASE + parameterLte->GetParameterCode ();
+        }
+      Ptr<LinkParameter80216> parameter80216 = DynamicCast<LinkParameter80216> (linkParameterType);
+      if (parameter80216 != 0 && WIMAX_PARAMETER_BASE + parameter80216->GetParameterCode () < PARAMETER_COUNT)
+        {
+          return WIMAX_PARAMETER_BASE + parameter80216->GetParameterCode ();
+        }
+      return PARAMETER_COUNT;
+    }
+    uint32_t
+    LinkThresholdEngine::FindBand (const ParameterState &state, int16_t value) const
+    {
+      uint32_t band = 0;
+      while (band < state.thresholds.size () && value >= state.thresholds[band].value)
+        {
+          band++;
+        }
+      return band;
+    }
+    LinkConfigureThresholdsConfirm
+    LinkThresholdEngine::Configure (LinkConfigurationParameterList configureParameters)
+    {
+      NS_LOG_FUNCTION (this << configureParameters.size ());
+      LinkConfigureThresholdsConfirm confirm (Status::SUCCESS);
+      for (LinkConfigurationParameterListI i = configureParameters.begin ();
+           i != configureParameters.end (); i++)
+        {
+          Ptr<LinkParameterType> linkParameterType = (*i)->GetLinkParameterType ();
+          uint8_t parameterIndex = GetParameterIndex (linkParameterType);
+          if (parameterIndex >= m_parameters.size ())
+            {
+              NS_LOG_DEBUG ("Link parameter type not supported by the threshold engine");
+              if ((*i)->GetThresholdsN () == 0)
+                {
+                  confirm.AddLinkConfigurationStatusItem (Create<LinkConfigurationStatus> (linkParameterType,
+                                                                                           Threshold (),
+                                                                                           false));
+                }
+              for (ThresholdListI j = (*i)->GetThresholdsListBegin ();
+                   j != (*i)->GetThresholdsListEnd (); j++)
+                {
+                  confirm.AddLinkConfigurationStatusItem (Create<LinkConfigurationStatus> (linkParameterType,
+                                                                                           **j,
+                                                                                           false));
+                }
+              continue;
+            }
+          ParameterState &state = m_parameters[parameterIndex];
+          bool hasSample = state.hasSample;
+          int16_t lastSample = state.lastSample;
+          // A new configuration replaces the previous one;
+          state = ParameterState ();
+          if ((*i)->GetThresholdAction () != LinkConfigurationParameter::CANCEL_SHOT_THRESHOLD)
+            {
+              state.linkParameterType = linkParameterType;
+              state.interval = MilliSeconds ((*i)->GetTimerInterval ());
+              state.nextReport = Simulator::Now () + state.interval;
+              for (ThresholdListI j = (*i)->GetThresholdsListBegin ();
+                   j != (*i)->GetThresholdsListEnd (); j++)
+                {
+                  ThresholdEntry entry;
+                  entry.value = static_cast<int16_t> ((*j)->GetThresholdValue ());
+                  entry.threshold = **j;
+                  entry.oneShot = (*i)->GetThresholdAction () == LinkConfigurationParameter::ONE_SHOT_THRESHOLD;
+                  state.thresholds.push_back (entry);
+                }
+              std::stable_sort (state.thresholds.begin (), state.thresholds.end (), &LinkThresholdEngine::CompareEntries);
+            }
+          if (hasSample)
+            {
+              state.hasSample = true;
+              state.lastSample = lastSample;
+              state.band = FindBand (state, lastSample);
+            }
+          if ((*i)->GetThresholdsN () == 0)
+            {
+              confirm.AddLinkConfigurationStatusItem (Create<LinkConfigurationStatus> (linkParameterType,
+                                                                                       Threshold (),
+                                                                                       true));
+            }
+          for (ThresholdListI j = (*i)->GetThresholdsListBegin ();
+               j != (*i)->GetThresholdsListEnd (); j++)
+            {
+              confirm.AddLinkConfigurationStatusItem (Create<LinkConfigurationStatus> (linkParameterType,
+                                                                                       **j,
+                                                                                       true));
+            }
+        }
+      return confirm;
+    }
+    bool
+    LinkThresholdEngine::IsConfigured (uint8_t parameterIndex) const
+    {
+      return parameterIndex < m_parameters.size () &&
+        m_parameters[parameterIndex].linkParameterType != 0;
+    }
+    void
+    LinkThresholdEngine::Clear (void)
+    {
+      NS_LOG_FUNCTION (this);
+      for (std::vector<ParameterState>::iterator i = m_parameters.begin (); i != m_parameters.end (); i++)
+        {
+          *i = ParameterState ();
+        }
+      m_reportCallback = ReportCallback ();
+    }
+    Ptr<LinkParameterReport>
+    LinkThresholdEngine::CreateReport (Ptr<LinkParameterType> linkParameterType,
+                                       Threshold threshold,
+                                       int16_t value)
+    {
+      Ptr<LinkParameter> parameter = Create<LinkParameter> (linkParameterType,
+                                                            Create<LinkParameterValue> (static_cast<uint16_t> (value)));
+      return Create<LinkParameterReport> (threshold, parameter);
+    }
+    void
+    LinkThresholdEngine::NotifySample (uint8_t parameterIndex, double value)
+    {
+      if (parameterIndex >= m_parameters.size ())
+        {
+          return;
+        }
+      ParameterState &state = m_parameters[parameterIndex];
+      int16_t sample = static_cast<int16_t> (std::floor (value + 0.5));
+      if (!state.hasSample)
+        {
+          // Nothing was crossed yet;
+          state.band = FindBand (state, sample);
+          state.hasSample = true;
+        }
+      state.lastSample = sample;
+      if (state.linkParameterType == 0)
+        {
+          return;
+        }
+      NS_LOG_FUNCTION (this << (uint32_t) parameterIndex << sample);
+      LinkParameterReportList reports;
+      // Going up;
+      while (state.band < state.thresholds.size () &&
+             sample >= state.thresholds[state.band].value)
+        {
+          ThresholdEntry &entry = state.thresholds[state.band];
+          if (entry.threshold.GetCrossDirection () == Threshold::ABOVE_THRESHOLD)
+            {
+              reports.push_back (CreateReport (state.linkParameterType, entry.threshold, sample));
+              if (entry.oneShot)
+                {
+                  state.thresholds.erase (state.thresholds.begin () + state.band);
+                  continue;
+                }
+            }
+          state.band++;
+        }
+      // Going down;
+      while (state.band > 0 &&
+             sample < state.thresholds[state.band - 1].value)
+        {
+          state.band--;
+          ThresholdEntry &entry = state.thresholds[state.band];
+          if (entry.threshold.GetCrossDirection () == Threshold::BELOW_THRESHOLD)
+            {
+              reports.push_back (CreateReport (state.linkParameterType, entry.threshold, sample));
+              if (entry.oneShot)
+                {
+                  state.thresholds.erase (state.thresholds.begin () + state.band);
+                }
+            }
+        }
+      if (!state.interval.IsZero () && Simulator::Now () >= state.nextReport)
+        {
+          if (reports.empty ())
+            {
+              reports.push_back (CreateReport (state.linkParameterType, Threshold (), sample));
+            }
+          state.nextReport = Simulator::Now () + state.interval;
+        }
+      if (reports.empty ())
+        {
+          return;
+        }
+      if (state.thresholds.empty () && state.interval.IsZero ())
+        {
+          // All one shot thresholds fired;
+          state.linkParameterType = 0;
+        }
+      if (!m_reportCallback.IsNull ())
+        {
+          m_reportCallback (reports);
+        }
+    }
+  } // namespace mih
+} // namespace ns3
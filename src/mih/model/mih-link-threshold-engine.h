@@ -0,0 +1,97 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */            
+/*
+ * Copyright (c) 2008 IT-SUDPARIS
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as 
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Providence SALUMU M. <Providence.Salumu_Munga@it-sudparis.eu>
+ */
+
+#ifndef   	MIH_LINK_THRESHOLD_ENGINE_H
+#define   	MIH_LINK_THRESHOLD_ENGINE_H
+
+#include <vector>
+#include <stdint.h>
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "mih-link-configuration-parameter.h"
+#include "mih-link-configure-thresholds.h"
+#include "mih-link-parameter-report.h"
+#include "mih-link-parameter-80211.h"
+#include "mih-link-parameter-lte.h"
+#include "mih-link-parameter-80216.h"
+
+namespace ns3 {
+  namespace mih {
+    // Evaluates the thresholds set by MIH_Link_Configure_Thresholds
+    // against link parameter samples as they are measured. The
+    // thresholds of a parameter are kept sorted together with the
+    // band the last sample fell in, so a sample only walks over the
+    // thresholds it actually crossed. Periodic reports are checked
+    // when a sample comes in rather than from a timer, hence they go
+    // out with the first sample after the interval expired.
+    //
+    // Threshold and reported values are 16 bit signed integers
+    // carried in the unsigned MIH fields, e.g. dBm for
+    // BEACON_CHANNEL_RSSI.
+    //
+    // Samples are identified by a flat index over the parameter types
+    // the engine supports: the LinkParameter80211 codes, then the
+    // LinkParameterLte ones from LTE_PARAMETER_BASE and the
+    // LinkParameter80216 ones from WIMAX_PARAMETER_BASE;
+    class LinkThresholdEngine {
+    public:
+      enum {
+        LTE_PARAMETER_BASE = LinkParameter80211::MULTICAST_PACKET_LOSS_RATE + 1,
+        WIMAX_PARAMETER_BASE = LTE_PARAMETER_BASE + LinkParameterLte::RSRQ + 1,
+        PARAMETER_COUNT = WIMAX_PARAMETER_BASE + LinkParameter80216::CINR + 1,
+      };
+      typedef Callback<void, LinkParameterReportList> ReportCallback;
+      LinkThresholdEngine (void);
+      void SetReportCallback (ReportCallback reportCallback);
+      LinkConfigureThresholdsConfirm Configure (LinkConfigurationParameterList configureParameters);
+      void NotifySample (uint8_t parameterIndex, double value);
+      bool IsConfigured (uint8_t parameterIndex) const;
+      // PARAMETER_COUNT for the types the engine does not support;
+      static uint8_t GetParameterIndex (Ptr<LinkParameterType> linkParameterType);
+      void Clear (void);
+    protected:
+      struct ThresholdEntry {
+        int16_t value;
+        Threshold threshold;
+        bool oneShot;
+      };
+      typedef std::vector<ThresholdEntry> ThresholdEntryList;
+      struct ParameterState {
+        ParameterState (void);
+        Ptr<LinkParameterType> linkParameterType;
+        ThresholdEntryList thresholds;
+        uint32_t band;
+        bool hasSample;
+        int16_t lastSample;
+        Time interval;
+        Time nextReport;
+      };
+      static bool CompareEntries (const ThresholdEntry &a, const ThresholdEntry &b);
+      static Ptr<LinkParameterReport> CreateReport (Ptr<LinkParameterType> linkParameterType,
+                                                    Threshold threshold,
+                                                    int16_t value);
+      uint32_t FindBand (const ParameterState &state, int16_t value) const;
+      std::vector<ParameterState> m_parameters;
+      ReportCallback m_reportCallback;
+    };
+  } // namespace mih
+} // namespace ns3
+
+#endif 	    /* !MIH_LINK_THRESHOLD_ENGINE_H */
@@ -56,16 +56,16 @@ namespace ns3 {
       return Tlv::GetSerializedSizeU8 ();
     }
     void
-    LinkType::TlvSerialize (Buffer &buffer) const
+    LinkType::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU8 (buffer, static_cast<uint8_t> (m_type), TLV_LINK_TYPE);
+      Tlv::SerializeU8 (i, static_cast<uint8_t> (m_type), TLV_LINK_TYPE);
     }
     uint32_t
-    LinkType::TlvDeserialize (Buffer &buffer)
+    LinkType::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t bytesRead = 0;
       uint8_t typ = 0;
-      bytesRead += Tlv::DeserializeU8 (buffer, typ, TLV_LINK_TYPE);
+      bytesRead += Tlv::DeserializeU8 (i, typ, TLV_LINK_TYPE);
       m_type = static_cast<enum LinkType::Type> (typ);
       return bytesRead;
     }
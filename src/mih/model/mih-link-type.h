@@ -42,6 +42,7 @@ namespace ns3 {
         WIRELESS_802_16 = 27,
         WIRELESS_802_20 = 28,
         WIRELESS_802_22 = 29,
+        LTE = 30,
         INVALID = 0xff,
       };
       LinkType (enum Type typ = LinkType::INVALID);
@@ -51,8 +52,10 @@ namespace ns3 {
       enum Type GetType (void);
       bool IsEqual (LinkType const &o) const;
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (LinkType);
     protected:
       friend bool operator == (LinkType const &a, LinkType const &b);
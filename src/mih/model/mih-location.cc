@@ -0,0 +1,97 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include "mih-location.h"
+
+namespace ns3 {
+  namespace mih {
+    static const uint32_t LOCATION_PAYLOAD_LENGTH = 3 * 4;
+
+    static uint32_t
+    ToCentimeters (double meters)
+    {
+      return static_cast<uint32_t> (static_cast<int32_t> (std::floor (meters * 100 + 0.5)));
+    }
+    static double
+    FromCentimeters (uint32_t centimeters)
+    {
+      return static_cast<int32_t> (centimeters) / 100.0;
+    }
+    Location::Location (Vector position) :
+      m_position (position)
+    {}
+    Location::Location (Location const &o) :
+      m_position (o.m_position)
+    {}
+    TLV_TYPE_HELPER_IMPLEM (Location, TLV_POA_LOCATION)
+    Vector
+    Location::GetPosition (void) const
+    {
+      return m_position;
+    }
+    void
+    Location::SetPosition (Vector position)
+    {
+      m_position = position;
+    }
+    uint32_t
+    Location::GetTlvSerializedSize (void) const
+    {
+      return 1 + Tlv::ComputeLengthOfLengthField (LOCATION_PAYLOAD_LENGTH) + LOCATION_PAYLOAD_LENGTH;
+    }
+    void
+    Location::Print (std::ostream &os) const
+    {
+      os << m_position;
+    }
+    void
+    Location::TlvSerialize (Buffer::Iterator &i) const
+    {
+      i.WriteU8 (GetTlvTypeValue ()); // Type field;
+      Tlv::WritePayloadLengthField (i, LOCATION_PAYLOAD_LENGTH); // Length field;
+      i.WriteHtonU32 (ToCentimeters (m_position.x));
+      i.WriteHtonU32 (ToCentimeters (m_position.y));
+      i.WriteHtonU32 (ToCentimeters (m_position.z));
+    }
+    uint32_t
+    Location::TlvDeserialize (Buffer::Iterator &i)
+    {
+      uint32_t totalBytesRead = 0;
+      uint32_t roomSize;
+      uint32_t payloadLengthValue = 0;
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
+      totalBytesRead++;
+      roomSize = i.ReadU8 ();
+      totalBytesRead++;
+
+      totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
+      NS_ASSERT (payloadLengthValue == LOCATION_PAYLOAD_LENGTH);
+      m_position.x = FromCentimeters (i.ReadNtohU32 ());
+      m_position.y = FromCentimeters (i.ReadNtohU32 ());
+      m_position.z = FromCentimeters (i.ReadNtohU32 ());
+      totalBytesRead += payloadLengthValue;
+
+      return totalBytesRead;
+    }
+    std::ostream&
+    operator << (std::ostream &os, const Location &a)
+    {
+      a.Print (os);
+      return os;
+    }
+  } // namespace mih
+} // namespace ns3
@@ -0,0 +1,48 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef   	MIH_LOCATION_H
+#define   	MIH_LOCATION_H
+
+#include <ostream>
+#include "ns3/vector.h"
+#include "mih-tlv.h"
+
+namespace ns3 {
+  namespace mih {
+    // Cartesian position of a PoA or of a mobile node, carried with a
+    // centimeter resolution;
+    class Location : public Tlv {
+    public:
+      Location (Vector position = Vector ());
+      Location (Location const &o);
+      Vector GetPosition (void) const;
+      void SetPosition (Vector position);
+      virtual uint32_t GetTlvSerializedSize (void) const;
+      virtual void Print (std::ostream &os) const;
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
+      TLV_TYPE_HELPER_HEADER (Location);
+    protected:
+      Vector m_position;
+    };
+    std::ostream& operator << (std::ostream &os, const Location &a);
+  } // namespace mih
+} // namespace ns3
+
+#endif 	    /* !MIH_LOCATION_H */
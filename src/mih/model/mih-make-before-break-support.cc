@@ -83,49 +83,38 @@ namespace ns3 {
         ;
     }
     void
-    MakeBeforeBreakSupport::TlvSerialize (Buffer &buffer) const
+    MakeBeforeBreakSupport::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
 
       payloadLength = m_sourceLinkType.GetTlvSerializedSize () +
         m_destinationLinkType.GetTlvSerializedSize () +
         Tlv::GetSerializedSizeBool ();
 
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field +
-                                                 // Length field only;
-      
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length
                                                        // field;
 
-      m_sourceLinkType.TlvSerialize (buffer);
-      m_destinationLinkType.TlvSerialize (buffer);
-      Tlv::SerializeBool (buffer, m_supported, TLV_MBB_HO_SUPPORT);
+      m_sourceLinkType.TlvSerialize (i);
+      m_destinationLinkType.TlvSerialize (i);
+      Tlv::SerializeBool (i, m_supported, TLV_MBB_HO_SUPPORT);
     }
     uint32_t 
-    MakeBeforeBreakSupport::TlvDeserialize (Buffer &buffer)
+    MakeBeforeBreakSupport::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
       
-      totalBytesRead += m_sourceLinkType.TlvDeserialize (buffer);
-      totalBytesRead += m_destinationLinkType.TlvDeserialize (buffer);
-      totalBytesRead += Tlv::DeserializeBool (buffer, m_supported, TLV_MBB_HO_SUPPORT);
+      totalBytesRead += m_sourceLinkType.TlvDeserialize (i);
+      totalBytesRead += m_destinationLinkType.TlvDeserialize (i);
+      totalBytesRead += Tlv::DeserializeBool (i, m_supported, TLV_MBB_HO_SUPPORT);
       
       return totalBytesRead;
     }
@@ -159,10 +148,20 @@ namespace ns3 {
     {
       return Tlv::Serialize<MakeBeforeBreakSupport> (buffer, mbbHoSupportList, TLV_MBB_HO_SUPPORT_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const MakeBeforeBreakSupportList &mbbHoSupportList)
+    {
+      Tlv::Serialize<MakeBeforeBreakSupport> (i, mbbHoSupportList, TLV_MBB_HO_SUPPORT_LIST);
+    }
     uint32_t 
     TlvDeserialize (Buffer &buffer, MakeBeforeBreakSupportList &mbbHoSupportList)
     {
       return Tlv::Deserialize<MakeBeforeBreakSupport> (buffer, mbbHoSupportList, TLV_MBB_HO_SUPPORT_LIST);
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, MakeBeforeBreakSupportList &mbbHoSupportList)
+    {
+      return Tlv::Deserialize<MakeBeforeBreakSupport> (i, mbbHoSupportList, TLV_MBB_HO_SUPPORT_LIST);
+    }
   } // namespace mih
 } // namespace ns3
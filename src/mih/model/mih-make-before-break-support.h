@@ -41,8 +41,10 @@ namespace ns3 {
       bool IsSupported (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (MakeBeforeBreakSupport);
       static Ptr<MakeBeforeBreakSupport> CreateFromTlvType (uint8_t val);
     protected:
@@ -57,7 +59,9 @@ namespace ns3 {
     std::ostream & operator << (std::ostream &os, MakeBeforeBreakSupportList &a);
     uint32_t GetTlvSerializedSize (MakeBeforeBreakSupportList &mbbHoSupportList);
     void TlvSerialize (Buffer &buffer, MakeBeforeBreakSupportList &mbbHoSupportList);
+    void TlvSerialize (Buffer::Iterator &i, const MakeBeforeBreakSupportList &mbbHoSupportList);
     uint32_t TlvDeserialize (Buffer &buffer, MakeBeforeBreakSupportList &mbbHoSupportList);    
+    uint32_t TlvDeserialize (Buffer::Iterator &i, MakeBeforeBreakSupportList &mbbHoSupportList);
   } // namespace mih
 } // namespace ns3
 
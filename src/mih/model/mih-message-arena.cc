@@ -0,0 +1,263 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <new>
+#include <unordered_map>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "mih-message-arena.h"
+
+NS_LOG_COMPONENT_DEFINE ("MihMessageArena");
+
+namespace ns3 {
+  namespace mih {
+    // Objects carry no header: every block starts with a BlockHeader
+    // naming its pool, the first one of a pool with the Pool itself,
+    // and is indexed by the ARENA_BLOCK_SIZE slot of the address space
+    // it starts in. An object lies in the block starting in its own
+    // slot or in the one before, anything else is handed back to the
+    // global operator delete;
+    static const size_t ARENA_ALIGNMENT = 16;
+    static const size_t ARENA_BLOCK_SIZE = 4096;
+    static const uint32_t ARENA_SPARE_BLOCKS = 16;
+
+    struct MihMessageArena::BlockHeader {
+      uint8_t *next;
+      Pool *pool;
+    };
+
+    struct MihMessageArena::Pool {
+      BlockHeader header;
+      uint8_t *next;
+      size_t left;
+      uint32_t live;
+      bool closed;
+      uint8_t *blocks; // Blocks added once the first one was full;
+    };
+
+    typedef std::unordered_map<uintptr_t, uint8_t *> BlockMap;
+
+    MihMessageArena *MihMessageArena::m_current = 0;
+    // Created with the first block, deleted with the last one so that
+    // objects released by static destructors find it;
+    static BlockMap *g_blocks = 0;
+    // Blocks of the released pools, kept indexed for the next messages
+    // until SpareBlocksDestructor runs;
+    static uint8_t *g_spareBlocks = 0;
+    static uint32_t g_spareBlockCount = 0;
+    static bool g_spareBlocksDestroyed = false;
+
+    static uintptr_t
+    GetSlot (void const *p)
+    {
+      return reinterpret_cast<uintptr_t> (p) / ARENA_BLOCK_SIZE;
+    }
+
+    static void
+    UnindexBlock (uint8_t *block)
+    {
+      g_blocks->erase (GetSlot (block));
+      if (g_blocks->empty ())
+        {
+          delete g_blocks;
+          g_blocks = 0;
+        }
+    }
+
+    static size_t
+    AlignSize (size_t size)
+    {
+      return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+    }
+
+    MihMessageArena::SpareBlocksDestructor::~SpareBlocksDestructor (void)
+    {
+      while (g_spareBlocks != 0)
+        {
+          uint8_t *next = reinterpret_cast<BlockHeader *> (g_spareBlocks)->next;
+          UnindexBlock (g_spareBlocks);
+          ::operator delete (g_spareBlocks);
+          g_spareBlocks = next;
+        }
+      g_spareBlockCount = 0;
+      g_spareBlocksDestroyed = true;
+    }
+    MihMessageArena::SpareBlocksDestructor MihMessageArena::m_spareBlocksDestructor;
+
+    MihMessageArena::MihMessageArena (bool enabled) :
+      m_enabled (enabled),
+      m_pool (0),
+      m_previous (0)
+    {
+      if (m_enabled)
+        {
+          m_previous = m_current;
+          m_current = this;
+        }
+    }
+    MihMessageArena::~MihMessageArena (void)
+    {
+      if (!m_enabled)
+        {
+          return;
+        }
+      NS_ASSERT (m_current == this);
+      m_current = m_previous;
+      if (m_pool == 0)
+        {
+          return;
+        }
+      m_pool->closed = true;
+      if (m_pool->live == 0)
+        {
+          ReleasePool (m_pool);
+        }
+      else
+        {
+          NS_LOG_LOGIC (m_pool->live << " objects outlive their message arena");
+        }
+      m_pool = 0;
+    }
+    uint8_t *
+    MihMessageArena::CreateBlock (Pool *pool)
+    {
+      uint8_t *block = g_spareBlocks;
+      if (block != 0)
+        {
+          g_spareBlocks = reinterpret_cast<BlockHeader *> (block)->next;
+          g_spareBlockCount--;
+        }
+      else
+        {
+          block = static_cast<uint8_t *> (::operator new (ARENA_BLOCK_SIZE));
+          if (g_blocks == 0)
+            {
+              g_blocks = new BlockMap;
+            }
+          (*g_blocks)[GetSlot (block)] = block;
+        }
+      BlockHeader *header = reinterpret_cast<BlockHeader *> (block);
+      header->next = 0;
+      header->pool = pool;
+      return block;
+    }
+    void
+    MihMessageArena::ReleaseBlock (uint8_t *block)
+    {
+      BlockHeader *header = reinterpret_cast<BlockHeader *> (block);
+      if (g_spareBlockCount < ARENA_SPARE_BLOCKS && !g_spareBlocksDestroyed)
+        {
+          header->next = g_spareBlocks;
+          header->pool = 0;
+          g_spareBlocks = block;
+          g_spareBlockCount++;
+          return;
+        }
+      UnindexBlock (block);
+      ::operator delete (block);
+    }
+    MihMessageArena::Pool *
+    MihMessageArena::CreatePool (void)
+    {
+      uint8_t *block = CreateBlock (0);
+      Pool *pool = new (block) Pool;
+      pool->header.next = 0;
+      pool->header.pool = pool;
+      pool->next = block + AlignSize (sizeof (Pool));
+      pool->left = ARENA_BLOCK_SIZE - AlignSize (sizeof (Pool));
+      pool->live = 0;
+      pool->closed = false;
+      pool->blocks = 0;
+      return pool;
+    }
+    void
+    MihMessageArena::ReleasePool (Pool *pool)
+    {
+      uint8_t *block = pool->blocks;
+      while (block != 0)
+        {
+          uint8_t *next = reinterpret_cast<BlockHeader *> (block)->next;
+          ReleaseBlock (block);
+          block = next;
+        }
+      ReleaseBlock (reinterpret_cast<uint8_t *> (pool));
+    }
+    MihMessageArena::Pool *
+    MihMessageArena::FindPool (void *p)
+    {
+      uintptr_t slot = GetSlot (p);
+      uint8_t *object = static_cast<uint8_t *> (p);
+      for (uintptr_t k = 0; k < 2 && k <= slot; k++)
+        {
+          BlockMap::const_iterator i = g_blocks->find (slot - k);
+          if (i != g_blocks->end () &&
+              object >= i->second && object < i->second + ARENA_BLOCK_SIZE)
+            {
+              return reinterpret_cast<BlockHeader *> (i->second)->pool;
+            }
+        }
+      return 0;
+    }
+    void *
+    MihMessageArena::Allocate (size_t size)
+    {
+      size_t blockHeaderSize = AlignSize (sizeof (BlockHeader));
+      size_t needed = AlignSize (size);
+      if (m_current == 0 || needed > ARENA_BLOCK_SIZE - blockHeaderSize)
+        {
+          return ::operator new (size);
+        }
+      if (m_current->m_pool == 0)
+        {
+          m_current->m_pool = CreatePool ();
+        }
+      Pool *pool = m_current->m_pool;
+      if (needed > pool->left)
+        {
+          uint8_t *block = CreateBlock (pool);
+          reinterpret_cast<BlockHeader *> (block)->next = pool->blocks;
+          pool->blocks = block;
+          pool->next = block + blockHeaderSize;
+          pool->left = ARENA_BLOCK_SIZE - blockHeaderSize;
+        }
+      uint8_t *p = pool->next;
+      pool->next += needed;
+      pool->left -= needed;
+      pool->live++;
+      return p;
+    }
+    void
+    MihMessageArena::Deallocate (void *p)
+    {
+      if (p == 0)
+        {
+          return;
+        }
+      Pool *pool = g_blocks == 0 ? 0 : FindPool (p);
+      if (pool == 0)
+        {
+          ::operator delete (p);
+          return;
+        }
+      NS_ASSERT (pool->live > 0);
+      pool->live--;
+      if (pool->closed && pool->live == 0)
+        {
+          ReleasePool (pool);
+        }
+    }
+  } // namespace mih
+} // namespace ns3
@@ -0,0 +1,70 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef   	MIH_MESSAGE_ARENA_H
+#define   	MIH_MESSAGE_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace ns3 {
+  namespace mih {
+    /**
+     * Scope within which the TLV objects created on the heap, such as
+     * the elements of the decoded MIH lists, are carved out of a few
+     * large blocks instead of being allocated one by one.
+     *
+     * The blocks are released at once when the scope ends and the
+     * last object allocated within it was unreferenced; objects still
+     * referenced past the scope keep their blocks alive. Scopes nest,
+     * the innermost enabled one is used. Objects larger than a block
+     * always come from the global operator new.
+     *
+     * Outside of any scope Allocate is the global operator new.
+     * Deallocate finds the pool of an object, if any, with at most two
+     * lookups in a table of the live blocks indexed by address, however
+     * many pools objects kept past their scope hold alive.
+     */
+    class MihMessageArena {
+    public:
+      MihMessageArena (bool enabled = true);
+      ~MihMessageArena (void);
+      static void *Allocate (size_t size);
+      static void Deallocate (void *p);
+    private:
+      MihMessageArena (MihMessageArena const &o);
+      MihMessageArena &operator = (MihMessageArena const &o);
+      struct Pool;
+      struct BlockHeader;
+      static Pool *CreatePool (void);
+      static void ReleasePool (Pool *pool);
+      static uint8_t *CreateBlock (Pool *pool);
+      static void ReleaseBlock (uint8_t *block);
+      static Pool *FindPool (void *p);
+      bool m_enabled;
+      Pool *m_pool;
+      MihMessageArena *m_previous;
+      static MihMessageArena *m_current;
+      // Frees the spare blocks at exit;
+      struct SpareBlocksDestructor {
+        ~SpareBlocksDestructor (void);
+      };
+      static SpareBlocksDestructor m_spareBlocksDestructor;
+    };
+  } // namespace mih
+} // namespace ns3
+
+#endif 	    /* !MIH_MESSAGE_ARENA_H */
@@ -40,14 +40,14 @@ namespace ns3 {
       return Tlv::GetSerializedSizeU16 ();
     }
     void
-    MobilityManagementSupport::TlvSerialize (Buffer &buffer) const
+    MobilityManagementSupport::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU16 (buffer, m_bitmap, TLV_MOBILITY_MANAGEMENT_SUPPORT);
+      Tlv::SerializeU16 (i, m_bitmap, TLV_MOBILITY_MANAGEMENT_SUPPORT);
     }
     uint32_t
-    MobilityManagementSupport::TlvDeserialize (Buffer &buffer)
+    MobilityManagementSupport::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU16 (buffer, m_bitmap, TLV_MOBILITY_MANAGEMENT_SUPPORT);
+      return Tlv::DeserializeU16 (i, m_bitmap, TLV_MOBILITY_MANAGEMENT_SUPPORT);
     }
   } // namespace mih
 } // namespace ns3
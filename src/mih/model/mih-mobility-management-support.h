@@ -42,8 +42,10 @@ namespace ns3 {
       MobilityManagementSupport (MobilityManagementSupport const &o);
       uint16_t GetSupportedProtocols (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (MobilityManagementSupport);
     protected:
       uint16_t m_bitmap;
@@ -49,14 +49,14 @@ namespace ns3 {
       os << "NetworkAuxiliaryIdentifier = " << m_networkAuxiliaryIdentifier << std::endl;
     }
     void 
-    NetworkAuxiliaryIdentifier::TlvSerialize (Buffer &buffer) const
+    NetworkAuxiliaryIdentifier::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeString (buffer, m_networkAuxiliaryIdentifier, GetTlvTypeValue ());
+      Tlv::SerializeString (i, m_networkAuxiliaryIdentifier, GetTlvTypeValue ());
     }
     uint32_t 
-    NetworkAuxiliaryIdentifier::TlvDeserialize (Buffer &buffer)
+    NetworkAuxiliaryIdentifier::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeString (buffer, m_networkAuxiliaryIdentifier, GetTlvTypeValue ());
+      return Tlv::DeserializeString (i, m_networkAuxiliaryIdentifier, GetTlvTypeValue ());
     }
   } // namespace mih
 } // namespace ns3
@@ -36,8 +36,10 @@ namespace ns3 {
       const char* PeekString (void);
       void Print (std::ostream &os) const;
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (NetworkAuxiliaryIdentifier);
     protected:
       std::string m_networkAuxiliaryIdentifier;
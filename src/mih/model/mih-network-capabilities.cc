@@ -40,14 +40,14 @@ namespace ns3 {
       return Tlv::GetSerializedSizeU32 ();
     }
     void
-    NetworkCapabilities::TlvSerialize (Buffer &buffer) const
+    NetworkCapabilities::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU32 (buffer, m_bitmap, TLV_NETWORK_CAPABILITIES);
+      Tlv::SerializeU32 (i, m_bitmap, TLV_NETWORK_CAPABILITIES);
     }
     uint32_t
-    NetworkCapabilities::TlvDeserialize (Buffer &buffer)
+    NetworkCapabilities::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU32 (buffer, m_bitmap, TLV_NETWORK_CAPABILITIES);
+      return Tlv::DeserializeU32 (i, m_bitmap, TLV_NETWORK_CAPABILITIES);
     }
   } // namespace mih
 } // namespace ns3
@@ -45,8 +45,10 @@ namespace ns3 {
       NetworkCapabilities (NetworkCapabilities const &o);
       uint32_t GetNetworkCapabilities (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (NetworkCapabilities);
     protected:
       uint32_t m_bitmap;
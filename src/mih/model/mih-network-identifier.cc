@@ -50,14 +50,14 @@ namespace ns3 {
       os << "NetworkIdentifier = " << m_networkIdentifier << std::endl;
     }
     void 
-    NetworkIdentifier::TlvSerialize (Buffer &buffer) const
+    NetworkIdentifier::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeString (buffer, m_networkIdentifier, GetTlvTypeValue ());
+      Tlv::SerializeString (i, m_networkIdentifier, GetTlvTypeValue ());
     }
     uint32_t 
-    NetworkIdentifier::TlvDeserialize (Buffer &buffer)
+    NetworkIdentifier::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeString (buffer, m_networkIdentifier, GetTlvTypeValue ());
+      return Tlv::DeserializeString (i, m_networkIdentifier, GetTlvTypeValue ());
     }
   } // namespace mih
 } // namespace ns3
@@ -69,26 +69,21 @@ namespace ns3 {
         ;
     }
     void
-    NetworkTypeAddress::TlvSerialize (Buffer &buffer) const
+    NetworkTypeAddress::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      buffer.AddAtEnd (2); // Type + Length room space;
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ());
       i.WriteU8 (GetTlvSerializedSize () - 2);
-      m_linkType.TlvSerialize (buffer);
-      Tlv::Serialize (buffer, m_linkAddress, TLV_LINK_ADDRESS);
+      m_linkType.TlvSerialize (i);
+      Tlv::Serialize (i, m_linkAddress, TLV_LINK_ADDRESS);
     }
     uint32_t 
-    NetworkTypeAddress::TlvDeserialize (Buffer &buffer)
+    NetworkTypeAddress::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t size = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
-      buffer.RemoveAtStart (2); // Type + Length;
-      size  += m_linkType.TlvDeserialize (buffer);
-      size  += Tlv::Deserialize (buffer, m_linkAddress, TLV_LINK_ADDRESS);
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
+      i.Next (); // Length;
+      size  += m_linkType.TlvDeserialize (i);
+      size  += Tlv::Deserialize (i, m_linkAddress, TLV_LINK_ADDRESS);
       return size + 2; // + Type + Length;
     }
     std::ostream &
@@ -120,10 +115,20 @@ namespace ns3 {
     {
       return Tlv::Serialize<NetworkTypeAddress> (buffer, networkTypeAddressList, TLV_NETWORK_TYPE_ADDRESS_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const NetworkTypeAddressList &networkTypeAddressList)
+    {
+      Tlv::Serialize<NetworkTypeAddress> (i, networkTypeAddressList, TLV_NETWORK_TYPE_ADDRESS_LIST);
+    }
     uint32_t 
     TlvDeserialize (Buffer &buffer, NetworkTypeAddressList &networkTypeAddressList)
     {
       return Tlv::Deserialize<NetworkTypeAddress> (buffer, networkTypeAddressList, TLV_NETWORK_TYPE_ADDRESS_LIST);
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, NetworkTypeAddressList &networkTypeAddressList)
+    {
+      return Tlv::Deserialize<NetworkTypeAddress> (i, networkTypeAddressList, TLV_NETWORK_TYPE_ADDRESS_LIST);
+    }
   } // namespace mih
 } // namespace ns3
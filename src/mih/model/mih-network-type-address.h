@@ -39,8 +39,10 @@ namespace ns3 {
       Address GetLinkAddress (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (NetworkTypeAddress);
       static Ptr<NetworkTypeAddress> CreateFromTlvType (uint8_t tlvTypeValue);
     protected:
@@ -54,7 +56,9 @@ namespace ns3 {
     std::ostream &operator << (std::ostream &os, NetworkTypeAddressList &a);
     uint32_t GetTlvSerializedSize (NetworkTypeAddressList &networkTypeAddressList);
     void TlvSerialize (Buffer &buffer, NetworkTypeAddressList &networkTypeAddressList);
+    void TlvSerialize (Buffer::Iterator &i, const NetworkTypeAddressList &networkTypeAddressList);
     uint32_t TlvDeserialize (Buffer &buffer, NetworkTypeAddressList &networkTypeAddressList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, NetworkTypeAddressList &networkTypeAddressList);
     
   } // namespace mih
 } // namespace ns3
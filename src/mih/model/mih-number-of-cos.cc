@@ -24,10 +24,7 @@ namespace ns3 {
   namespace mih {
     NumberOfCoS::NumberOfCoS (uint8_t numberOfCoS) :
       m_numberOfCoS (numberOfCoS)
-    {
-      SimulationSingleton<TlvObjectFactory<LinkDescriptorsResponse> >::Get ()->AddTlvTypeConstructor (TLV_NUMBER_OF_COS,
-                                                                                                   MakeCallback (&NumberOfCoS::Create));
-    }
+    {}
     NumberOfCoS::NumberOfCoS (NumberOfCoS const &o) :
       m_numberOfCoS (o.m_numberOfCoS)
     {}
@@ -38,5 +35,6 @@ namespace ns3 {
     }
       CHOICE_HELPER_IMPLEM (NumberOfCoS, LinkDescriptorsResponse)
       TLV_TYPE_HELPER_IMPLEM (NumberOfCoS, TLV_NUMBER_OF_COS)
+      TLV_OBJECT_FACTORY_REGISTER (NumberOfCoS, LinkDescriptorsResponse, TLV_NUMBER_OF_COS)
   } // namespace mih
 } // namespace ns3
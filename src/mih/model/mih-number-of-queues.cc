@@ -24,9 +24,7 @@ namespace ns3 {
   namespace mih {
     NumberOfQueues::NumberOfQueues (uint8_t numberOfQueues) :
       m_numberOfQueues (numberOfQueues)
-    {
-      SimulationSingleton<TlvObjectFactory<LinkDescriptorsResponse> >::Get ()->AddTlvTypeConstructor (TLV_NUMBER_OF_QUEUES, MakeCallback (&NumberOfQueues::Create));
-    }
+    {}
     NumberOfQueues::NumberOfQueues (NumberOfQueues const &o) :
       m_numberOfQueues (o.m_numberOfQueues)
     {}
@@ -37,5 +35,6 @@ namespace ns3 {
     }
     CHOICE_HELPER_IMPLEM (NumberOfQueues, LinkDescriptorsResponse)
     TLV_TYPE_HELPER_IMPLEM (NumberOfQueues, TLV_NUMBER_OF_QUEUES);
+    TLV_OBJECT_FACTORY_REGISTER (NumberOfQueues, LinkDescriptorsResponse, TLV_NUMBER_OF_QUEUES)
   } // namespace mih
 } // namespace ns3
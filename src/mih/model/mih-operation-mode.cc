@@ -24,10 +24,7 @@ namespace ns3 {
   namespace mih {
     OperationMode::OperationMode (enum OperationMode::Type mode) :
       m_powerOperationMode (mode)
-    {
-      SimulationSingleton<TlvObjectFactory<LinkStatesResponse> >::Get ()->AddTlvTypeConstructor (TLV_OPERATION_MODE,
-                                                                                            MakeCallback (&OperationMode::Create));
-    }
+    {}
     OperationMode::OperationMode (OperationMode const &o) :
       m_powerOperationMode (o.m_powerOperationMode)
     {}
@@ -38,5 +35,6 @@ namespace ns3 {
     }
     CHOICE_HELPER_IMPLEM (OperationMode, LinkStatesResponse)
     TLV_TYPE_HELPER_IMPLEM (OperationMode, TLV_OPERATION_MODE)
+    TLV_OBJECT_FACTORY_REGISTER (OperationMode, LinkStatesResponse, TLV_OPERATION_MODE)
   } // namespace mih
 } // namespace ns3
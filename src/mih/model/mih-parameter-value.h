@@ -33,8 +33,10 @@ namespace ns3 {
       TLV_TYPE_HELPER_HEADER (ParameterValue);
       virtual uint32_t GetTlvSerializedSize (void) const = 0;
       virtual void Print (std::ostream &os) const = 0;
-      virtual void TlvSerialize (Buffer &buffer) const = 0;
-      virtual uint32_t TlvDeserialize (Buffer &buffer) = 0;
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const = 0;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i) = 0;
     protected:
     };
   } // namespace mih
@@ -0,0 +1,402 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "mih-payload.h"
+
+NS_LOG_COMPONENT_DEFINE ("MihPayload");
+
+namespace ns3 {
+  namespace mih {
+    LinkEventIndication::LinkEventIndication (void) :
+      m_actionId (MihHeader::MIH_LINK_EVENT_BATCH),
+      m_ipRenewalFlag (false),
+      m_timeInterval (0)
+    {}
+    void
+    LinkEventIndication::TlvDeserialize (Buffer::Iterator &i, enum MihHeader::ActionIdE actionId)
+    {
+      m_actionId = actionId;
+      switch (actionId)
+        {
+        case MihHeader::MIH_LINK_DETECTED :
+          mih::TlvDeserialize (i, m_linkDetectedInformationList);
+          break;
+        case MihHeader::MIH_LINK_UP :
+          m_linkIdentifier.TlvDeserialize (i);
+          Tlv::Deserialize (i, m_oldAR, TLV_OLD_ACCESS_ROUTER);
+          Tlv::Deserialize (i, m_newAR, TLV_NEW_ACCESS_ROUTER);
+          Tlv::DeserializeBool (i, m_ipRenewalFlag, TLV_IP_RENEWAL_FLAG);
+          m_mobilitySupport.TlvDeserialize (i);
+          break;
+        case MihHeader::MIH_LINK_DOWN :
+          m_linkIdentifier.TlvDeserialize (i);
+          Tlv::Deserialize (i, m_oldAR, TLV_OLD_ACCESS_ROUTER);
+          m_linkDownReason.TlvDeserialize (i);
+          break;
+        case MihHeader::MIH_LINK_PARAMETERS_REPORT :
+          m_linkIdentifier.TlvDeserialize (i);
+          mih::TlvDeserialize (i, m_parameters);
+          break;
+        case MihHeader::MIH_LINK_GOING_DOWN :
+          m_linkIdentifier.TlvDeserialize (i);
+          Tlv::DeserializeU64 (i, m_timeInterval, TLV_TIME_INTERVAL);
+          m_linkGoingDownReason.TlvDeserialize (i);
+          break;
+        case MihHeader::MIH_LINK_HANDOVER_IMMINENT :
+          m_linkIdentifier.TlvDeserialize (i);
+          m_newLinkIdentifier.TlvDeserialize (i);
+          Tlv::Deserialize (i, m_oldAR, TLV_OLD_ACCESS_ROUTER);
+          Tlv::Deserialize (i, m_newAR, TLV_NEW_ACCESS_ROUTER);
+          break;
+        case MihHeader::MIH_LINK_HANDOVER_COMPLETE :
+          m_linkIdentifier.TlvDeserialize (i);
+          m_newLinkIdentifier.TlvDeserialize (i);
+          Tlv::Deserialize (i, m_oldAR, TLV_OLD_ACCESS_ROUTER);
+          Tlv::Deserialize (i, m_newAR, TLV_NEW_ACCESS_ROUTER);
+          m_handoverStatus.TlvDeserialize (i);
+          break;
+        default:
+          NS_LOG_DEBUG ("Specified event type is not suported");
+          NS_ASSERT (0);
+          break;
+        }
+    }
+    TypeId
+    MihPayload::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::mih::MihPayload")
+        .SetParent<Header> ()
+        .AddConstructor<MihPayload> ();
+      return tid;
+    }
+    TypeId
+    MihPayload::GetInstanceTypeId (void) const
+    {
+      return GetTypeId ();
+    }
+    MihPayload::MihPayload (void) :
+      m_serviceId (0),
+      m_opCode (0),
+      m_actionId (0),
+      m_size (0),
+      m_validLifeTime (0),
+      m_radius (0),
+      m_maxResults (0)
+    {}
+    MihPayload::MihPayload (MihHeader mihHeader) :
+      m_serviceId (mihHeader.GetServiceId ()),
+      m_opCode (mihHeader.GetOpCode ()),
+      m_actionId (mihHeader.GetActionId ()),
+      m_size (0),
+      m_validLifeTime (0),
+      m_radius (0),
+      m_maxResults (0)
+    {}
+    MihfId
+    MihPayload::GetSourceMihfId (void) const
+    {
+      return m_source;
+    }
+    MihfId
+    MihPayload::GetDestinationMihfId (void) const
+    {
+      return m_destination;
+    }
+    Status const &
+    MihPayload::GetStatus (void) const
+    {
+      return m_status;
+    }
+    LinkIdentifierList const &
+    MihPayload::GetLinkIdentifierList (void) const
+    {
+      return m_linkIdentifierList;
+    }
+    RegistrationCode const &
+    MihPayload::GetRegistrationCode (void) const
+    {
+      return m_registrationCode;
+    }
+    uint32_t
+    MihPayload::GetValidLifeTime (void) const
+    {
+      return m_validLifeTime;
+    }
+    LinkIdentifier const &
+    MihPayload::GetLinkIdentifier (void) const
+    {
+      return m_linkIdentifier;
+    }
+    EventList const &
+    MihPayload::GetEventList (void) const
+    {
+      return m_events;
+    }
+    NetworkTypeAddressList const &
+    MihPayload::GetNetworkTypeAddressList (void) const
+    {
+      return m_networkTypeAddresses;
+    }
+    MihCommandList const &
+    MihPayload::GetCommandList (void) const
+    {
+      return m_commands;
+    }
+    InformationServiceQueryTypeList const &
+    MihPayload::GetInformationServiceQueryTypeList (void) const
+    {
+      return m_informationServiceQueryTypes;
+    }
+    TransportSupportList const &
+    MihPayload::GetTransportSupportList (void) const
+    {
+      return m_transportSupports;
+    }
+    MakeBeforeBreakSupportList const &
+    MihPayload::GetMakeBeforeBreakSupportList (void) const
+    {
+      return m_makeBeforeBreakSupports;
+    }
+    DeviceStatesRequest const &
+    MihPayload::GetDeviceStatesRequest (void) const
+    {
+      return m_deviceStatesRequest;
+    }
+    LinkStatusRequest const &
+    MihPayload::GetLinkStatusRequest (void) const
+    {
+      return m_linkStatusRequest;
+    }
+    DeviceStatesResponseList const &
+    MihPayload::GetDeviceStatesResponseList (void) const
+    {
+      return m_deviceStatesResponses;
+    }
+    LinkStatusResponseList const &
+    MihPayload::GetLinkStatusResponseList (void) const
+    {
+      return m_linkStatusResponses;
+    }
+    LinkConfigurationParameterList const &
+    MihPayload::GetLinkConfigurationParameterList (void) const
+    {
+      return m_linkConfigurationParameters;
+    }
+    LinkConfigurationStatusList const &
+    MihPayload::GetLinkConfigurationStatusList (void) const
+    {
+      return m_linkConfigurationStatuses;
+    }
+    LinkType const &
+    MihPayload::GetLinkType (void) const
+    {
+      return m_linkType;
+    }
+    Location const &
+    MihPayload::GetLocation (void) const
+    {
+      return m_location;
+    }
+    uint32_t
+    MihPayload::GetRadius (void) const
+    {
+      return m_radius;
+    }
+    uint32_t
+    MihPayload::GetMaxResults (void) const
+    {
+      return m_maxResults;
+    }
+    PoaDescriptorList const &
+    MihPayload::GetPoaDescriptorList (void) const
+    {
+      return m_poaDescriptors;
+    }
+    LinkEventIndicationList const &
+    MihPayload::GetLinkEventIndicationList (void) const
+    {
+      return m_indications;
+    }
+    uint32_t
+    MihPayload::GetSerializedSize (void) const
+    {
+      return m_size;
+    }
+    void
+    MihPayload::Print (std::ostream &os) const
+    {
+      os << "SID=" << m_serviceId
+         << " Opcode=" << m_opCode
+         << " AID=" << m_actionId
+         << " from=" << m_source
+         << " to=" << m_destination;
+    }
+    void
+    MihPayload::Serialize (Buffer::Iterator start) const
+    {
+      NS_FATAL_ERROR ("MihPayload is only used to decode received PDUs");
+    }
+    uint32_t
+    MihPayload::Deserialize (Buffer::Iterator start)
+    {
+      NS_LOG_FUNCTION (this << m_serviceId << m_opCode << m_actionId);
+      // The iterator is only valid during this call, everything the
+      // dispatch needs is decoded here;
+      Buffer::Iterator i = start;
+      m_source.TlvDeserialize (i);
+      m_destination.TlvDeserialize (i);
+      switch (m_serviceId)
+        {
+        case MihHeader::MANAGEMENT :
+          DeserializeManagement (i);
+          break;
+        case MihHeader::EVENT :
+          if (m_actionId == MihHeader::MIH_LINK_EVENT_BATCH)
+            {
+              while (!i.IsEnd ())
+                {
+                  uint8_t actionId;
+                  Tlv::DeserializeU8 (i, actionId, TLV_EVENT_BATCH_ENTRY);
+                  NS_ASSERT (actionId != MihHeader::MIH_LINK_EVENT_BATCH);
+                  m_indications.push_back (LinkEventIndication ());
+                  m_indications.back ().TlvDeserialize (i, static_cast<enum MihHeader::ActionIdE> (actionId));
+                }
+            }
+          else
+            {
+              m_indications.push_back (LinkEventIndication ());
+              m_indications.back ().TlvDeserialize (i, static_cast<enum MihHeader::ActionIdE> (m_actionId));
+            }
+          break;
+        case MihHeader::COMMAND :
+          DeserializeCommand (i);
+          break;
+        case MihHeader::INFORMATION :
+          DeserializeInformation (i);
+          break;
+        default:
+          NS_ASSERT (0);
+        }
+      m_size = i.GetDistanceFrom (start);
+      return m_size;
+    }
+    void
+    MihPayload::DeserializeManagement (Buffer::Iterator &i)
+    {
+      switch (m_actionId)
+        {
+        case MihHeader::MIH_REGISTER :
+          if (m_opCode == MihHeader::REQUEST)
+            {
+              TlvDeserialize (i, m_linkIdentifierList);
+              m_registrationCode.TlvDeserialize (i);
+            }
+          else if (m_opCode == MihHeader::RESPONSE)
+            {
+              m_status.TlvDeserialize (i);
+              if (m_status.GetType () == Status::SUCCESS)
+                {
+                  Tlv::DeserializeU32 (i, m_validLifeTime, TLV_VALID_TIME_INTERVAL);
+                }
+            }
+          break;
+        case MihHeader::MIH_DEREGISTER :
+          if (m_opCode == MihHeader::RESPONSE)
+            {
+              m_status.TlvDeserialize (i);
+            }
+          break;
+        case MihHeader::MIH_EVENT_SUBSCRIBE :
+          if (m_opCode == MihHeader::RESPONSE)
+            {
+              m_status.TlvDeserialize (i);
+            }
+          m_linkIdentifier.TlvDeserialize (i);
+          m_events.TlvDeserialize (i);
+          break;
+        case MihHeader::MIH_CAPABILITY_DISCOVER :
+          if (m_opCode == MihHeader::RESPONSE)
+            {
+              m_status.TlvDeserialize (i);
+            }
+          TlvDeserialize (i, m_networkTypeAddresses);
+          m_events.TlvDeserialize (i);
+          m_commands.TlvDeserialize (i);
+          m_informationServiceQueryTypes.TlvDeserialize (i);
+          m_transportSupports.TlvDeserialize (i);
+          TlvDeserialize (i, m_makeBeforeBreakSupports);
+          break;
+        default:
+          NS_ASSERT (0);
+        }
+    }
+    void
+    MihPayload::DeserializeCommand (Buffer::Iterator &i)
+    {
+      switch (m_actionId)
+        {
+        case MihHeader::MIH_LINK_GET_PARAMETERS :
+          if (m_opCode == MihHeader::REQUEST)
+            {
+              m_deviceStatesRequest.TlvDeserialize (i);
+              TlvDeserialize (i, m_linkIdentifierList);
+              m_linkStatusRequest.TlvDeserialize (i);
+            }
+          else if (m_opCode == MihHeader::RESPONSE)
+            {
+              m_status.TlvDeserialize (i);
+              TlvDeserialize (i, m_deviceStatesResponses);
+              TlvDeserialize (i, m_linkStatusResponses);
+            }
+          break;
+        case MihHeader::MIH_LINK_CONFIGURE_THRESHOLDS :
+          if (m_opCode == MihHeader::REQUEST)
+            {
+              m_linkIdentifier.TlvDeserialize (i);
+              TlvDeserialize (i, m_linkConfigurationParameters);
+            }
+          else if (m_opCode == MihHeader::RESPONSE)
+            {
+              m_status.TlvDeserialize (i);
+              m_linkIdentifier.TlvDeserialize (i);
+              TlvDeserialize (i, m_linkConfigurationStatuses);
+            }
+          break;
+        default:
+          NS_ASSERT (0);
+        }
+    }
+    void
+    MihPayload::DeserializeInformation (Buffer::Iterator &i)
+    {
+      NS_ASSERT (m_actionId == MihHeader::MIH_GET_INFORMATION);
+      if (m_opCode == MihHeader::REQUEST)
+        {
+          m_linkType.TlvDeserialize (i);
+          m_location.TlvDeserialize (i);
+          Tlv::DeserializeU32 (i, m_radius, TLV_QUERY_RADIUS);
+          Tlv::DeserializeU32 (i, m_maxResults, TLV_QUERY_MAX_RESULTS);
+        }
+      else if (m_opCode == MihHeader::RESPONSE)
+        {
+          m_status.TlvDeserialize (i);
+          TlvDeserialize (i, m_poaDescriptors);
+        }
+    }
+  } // namespace mih
+} // namespace ns3
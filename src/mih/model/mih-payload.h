@@ -0,0 +1,136 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef   	MIH_PAYLOAD_H
+#define   	MIH_PAYLOAD_H
+
+#include <vector>
+#include "ns3/header.h"
+#include "ns3/address.h"
+#include "mih-header.h"
+#include "mih-callbacks.h"
+#include "mih-link-type.h"
+#include "mih-location.h"
+
+namespace ns3 {
+  namespace mih {
+    /**
+     * One remote link event indication, as carried on its own or as
+     * an entry of a MIH_LINK_EVENT_BATCH payload. Only the fields of
+     * its action are decoded.
+     */
+    class LinkEventIndication {
+    public:
+      LinkEventIndication (void);
+      void TlvDeserialize (Buffer::Iterator &i, enum MihHeader::ActionIdE actionId);
+      enum MihHeader::ActionIdE m_actionId;
+      LinkDetectedInformationList m_linkDetectedInformationList;
+      LinkIdentifier m_linkIdentifier;
+      LinkIdentifier m_newLinkIdentifier;
+      Address m_oldAR;
+      Address m_newAR;
+      bool m_ipRenewalFlag;
+      MobilityManagementSupport m_mobilitySupport;
+      LinkDownReason m_linkDownReason;
+      LinkParameterReportList m_parameters;
+      uint64_t m_timeInterval;
+      LinkGoingDownReason m_linkGoingDownReason;
+      Status m_handoverStatus;
+    };
+    typedef std::vector<LinkEventIndication> LinkEventIndicationList;
+
+    /**
+     * Payload of a received MIH PDU, read through Packet::PeekHeader
+     * once its MihHeader was removed: Deserialize decodes the MIHF
+     * identifiers and the fields of the action given by that header
+     * straight from the packet buffer, into the members below. Fields
+     * of other actions are left to their default values.
+     *
+     * Decoding only, Serialize is not supported.
+     */
+    class MihPayload : public Header {
+    public:
+      static TypeId GetTypeId (void);
+      virtual TypeId GetInstanceTypeId (void) const;
+      MihPayload (void);
+      MihPayload (MihHeader mihHeader);
+      MihfId GetSourceMihfId (void) const;
+      MihfId GetDestinationMihfId (void) const;
+      Status const &GetStatus (void) const;
+      LinkIdentifierList const &GetLinkIdentifierList (void) const;
+      RegistrationCode const &GetRegistrationCode (void) const;
+      uint32_t GetValidLifeTime (void) const;
+      LinkIdentifier const &GetLinkIdentifier (void) const;
+      EventList const &GetEventList (void) const;
+      NetworkTypeAddressList const &GetNetworkTypeAddressList (void) const;
+      MihCommandList const &GetCommandList (void) const;
+      InformationServiceQueryTypeList const &GetInformationServiceQueryTypeList (void) const;
+      TransportSupportList const &GetTransportSupportList (void) const;
+      MakeBeforeBreakSupportList const &GetMakeBeforeBreakSupportList (void) const;
+      DeviceStatesRequest const &GetDeviceStatesRequest (void) const;
+      LinkStatusRequest const &GetLinkStatusRequest (void) const;
+      DeviceStatesResponseList const &GetDeviceStatesResponseList (void) const;
+      LinkStatusResponseList const &GetLinkStatusResponseList (void) const;
+      LinkConfigurationParameterList const &GetLinkConfigurationParameterList (void) const;
+      LinkConfigurationStatusList const &GetLinkConfigurationStatusList (void) const;
+      LinkType const &GetLinkType (void) const;
+      Location const &GetLocation (void) const;
+      uint32_t GetRadius (void) const;
+      uint32_t GetMaxResults (void) const;
+      PoaDescriptorList const &GetPoaDescriptorList (void) const;
+      LinkEventIndicationList const &GetLinkEventIndicationList (void) const;
+      virtual uint32_t GetSerializedSize (void) const;
+      virtual void Print (std::ostream &os) const;
+      virtual void Serialize (Buffer::Iterator start) const;
+      virtual uint32_t Deserialize (Buffer::Iterator start);
+    private:
+      void DeserializeManagement (Buffer::Iterator &i);
+      void DeserializeCommand (Buffer::Iterator &i);
+      void DeserializeInformation (Buffer::Iterator &i);
+      uint16_t m_serviceId;
+      uint16_t m_opCode;
+      uint16_t m_actionId;
+      uint32_t m_size;
+      MihfId m_source;
+      MihfId m_destination;
+      Status m_status;
+      LinkIdentifierList m_linkIdentifierList;
+      RegistrationCode m_registrationCode;
+      uint32_t m_validLifeTime;
+      LinkIdentifier m_linkIdentifier;
+      EventList m_events;
+      NetworkTypeAddressList m_networkTypeAddresses;
+      MihCommandList m_commands;
+      InformationServiceQueryTypeList m_informationServiceQueryTypes;
+      TransportSupportList m_transportSupports;
+      MakeBeforeBreakSupportList m_makeBeforeBreakSupports;
+      DeviceStatesRequest m_deviceStatesRequest;
+      LinkStatusRequest m_linkStatusRequest;
+      DeviceStatesResponseList m_deviceStatesResponses;
+      LinkStatusResponseList m_linkStatusResponses;
+      LinkConfigurationParameterList m_linkConfigurationParameters;
+      LinkConfigurationStatusList m_linkConfigurationStatuses;
+      LinkType m_linkType;
+      Location m_location;
+      uint32_t m_radius;
+      uint32_t m_maxResults;
+      PoaDescriptorList m_poaDescriptors;
+      LinkEventIndicationList m_indications;
+    };
+  } // namespace mih
+} // namespace ns3
+
+#endif 	    /* !MIH_PAYLOAD_H */
@@ -0,0 +1,156 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mih-poa-descriptor.h"
+
+namespace ns3 {
+  namespace mih {
+    PoaDescriptor::PoaDescriptor (LinkType linkType,
+                                  Address poaLinkAddress,
+                                  NetworkIdentifier networkIdentifier,
+                                  Location location,
+                                  DataRate dataRate,
+                                  uint32_t cost) :
+      m_linkType (linkType),
+      m_poaLinkAddress (poaLinkAddress),
+      m_networkIdentifier (networkIdentifier),
+      m_location (location),
+      m_dataRate (dataRate),
+      m_cost (cost)
+    {}
+    PoaDescriptor::PoaDescriptor (PoaDescriptor const &o) :
+      m_linkType (o.m_linkType),
+      m_poaLinkAddress (o.m_poaLinkAddress),
+      m_networkIdentifier (o.m_networkIdentifier),
+      m_location (o.m_location),
+      m_dataRate (o.m_dataRate),
+      m_cost (o.m_cost)
+    {}
+    TLV_TYPE_HELPER_IMPLEM (PoaDescriptor, TLV_POA_DESCRIPTOR);
+    Ptr<PoaDescriptor>
+    PoaDescriptor::CreateFromTlvType (uint8_t val)
+    {
+      NS_ASSERT (val == TLV_POA_DESCRIPTOR);
+      return Create<PoaDescriptor> ();
+    }
+    LinkType
+    PoaDescriptor::GetLinkType (void) const
+    {
+      return m_linkType;
+    }
+    Address
+    PoaDescriptor::GetPoALinkAddress (void) const
+    {
+      return m_poaLinkAddress;
+    }
+    NetworkIdentifier
+    PoaDescriptor::GetNetworkIdentifier (void) const
+    {
+      return m_networkIdentifier;
+    }
+    Vector
+    PoaDescriptor::GetPosition (void) const
+    {
+      return m_location.GetPosition ();
+    }
+    DataRate
+    PoaDescriptor::GetDataRate (void) const
+    {
+      return m_dataRate;
+    }
+    uint32_t
+    PoaDescriptor::GetCost (void) const
+    {
+      return m_cost;
+    }
+    uint32_t
+    PoaDescriptor::GetTlvPayloadLength (void) const
+    {
+      return m_linkType.GetTlvSerializedSize () +
+        Tlv::GetSerializedSize (m_poaLinkAddress) +
+        m_networkIdentifier.GetTlvSerializedSize () +
+        m_location.GetTlvSerializedSize () +
+        m_dataRate.GetTlvSerializedSize () +
+        Tlv::GetSerializedSizeU32 ();
+    }
+    uint32_t
+    PoaDescriptor::GetTlvSerializedSize (void) const
+    {
+      uint32_t payloadLength = GetTlvPayloadLength ();
+      return 1 + Tlv::ComputeLengthOfLengthField (payloadLength) + payloadLength;
+    }
+    void
+    PoaDescriptor::TlvSerialize (Buffer::Iterator &i) const
+    {
+      i.WriteU8 (GetTlvTypeValue ()); // Type field;
+      Tlv::WritePayloadLengthField (i, GetTlvPayloadLength ()); // Length field;
+
+      m_linkType.TlvSerialize (i);
+      Tlv::Serialize (i, m_poaLinkAddress, TLV_POA_LINK_IDENTIFIER);
+      m_networkIdentifier.TlvSerialize (i);
+      m_location.TlvSerialize (i);
+      m_dataRate.TlvSerialize (i);
+      Tlv::SerializeU32 (i, m_cost, TLV_NETWORK_COST);
+    }
+    uint32_t
+    PoaDescriptor::TlvDeserialize (Buffer::Iterator &i)
+    {
+      uint32_t totalBytesRead = 0;
+      uint32_t roomSize;
+      uint32_t payloadLengthValue = 0;
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
+      totalBytesRead++;
+      roomSize = i.ReadU8 ();
+      totalBytesRead++;
+
+      totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
+
+      totalBytesRead += m_linkType.TlvDeserialize (i);
+      totalBytesRead += Tlv::Deserialize (i, m_poaLinkAddress, TLV_POA_LINK_IDENTIFIER);
+      totalBytesRead += m_networkIdentifier.TlvDeserialize (i);
+      totalBytesRead += m_location.TlvDeserialize (i);
+      totalBytesRead += m_dataRate.TlvDeserialize (i);
+      totalBytesRead += Tlv::DeserializeU32 (i, m_cost, TLV_NETWORK_COST);
+
+      return totalBytesRead;
+    }
+    uint32_t
+    GetTlvSerializedSize (const PoaDescriptorList &poaDescriptorList)
+    {
+      return Tlv::GetSerializedSize<PoaDescriptor> (poaDescriptorList);
+    }
+    void
+    TlvSerialize (Buffer &buffer, const PoaDescriptorList &poaDescriptorList)
+    {
+      Tlv::Serialize<PoaDescriptor> (buffer, poaDescriptorList, TLV_POA_DESCRIPTOR_LIST);
+    }
+    void
+    TlvSerialize (Buffer::Iterator &i, const PoaDescriptorList &poaDescriptorList)
+    {
+      Tlv::Serialize<PoaDescriptor> (i, poaDescriptorList, TLV_POA_DESCRIPTOR_LIST);
+    }
+    uint32_t
+    TlvDeserialize (Buffer &buffer, PoaDescriptorList &poaDescriptorList)
+    {
+      return Tlv::Deserialize<PoaDescriptor> (buffer, poaDescriptorList, TLV_POA_DESCRIPTOR_LIST);
+    }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, PoaDescriptorList &poaDescriptorList)
+    {
+      return Tlv::Deserialize<PoaDescriptor> (i, poaDescriptorList, TLV_POA_DESCRIPTOR_LIST);
+    }
+  } // namespace mih
+} // namespace ns3
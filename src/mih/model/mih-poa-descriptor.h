@@ -0,0 +1,73 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef   	MIH_POA_DESCRIPTOR_H
+#define   	MIH_POA_DESCRIPTOR_H
+
+#include <vector>
+#include "ns3/ref-count-base.h"
+#include "ns3/address.h"
+#include "mih-link-type.h"
+#include "mih-network-identifier.h"
+#include "mih-location.h"
+#include "mih-data-rate.h"
+
+namespace ns3 {
+  namespace mih {
+    // Information elements kept by the information server for one
+    // point of attachment;
+    class PoaDescriptor : public RefCountBase, public Tlv {
+    public:
+      PoaDescriptor (LinkType linkType = LinkType (),
+                     Address poaLinkAddress = Address (),
+                     NetworkIdentifier networkIdentifier = NetworkIdentifier (),
+                     Location location = Location (),
+                     DataRate dataRate = DataRate (),
+                     uint32_t cost = 0);
+      PoaDescriptor (PoaDescriptor const &o);
+      LinkType GetLinkType (void) const;
+      Address GetPoALinkAddress (void) const;
+      NetworkIdentifier GetNetworkIdentifier (void) const;
+      Vector GetPosition (void) const;
+      DataRate GetDataRate (void) const;
+      uint32_t GetCost (void) const;
+      virtual uint32_t GetTlvSerializedSize (void) const;
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
+      TLV_TYPE_HELPER_HEADER (PoaDescriptor);
+      static Ptr<PoaDescriptor> CreateFromTlvType (uint8_t val);
+    protected:
+      uint32_t GetTlvPayloadLength (void) const;
+      LinkType m_linkType;
+      Address m_poaLinkAddress;
+      NetworkIdentifier m_networkIdentifier;
+      Location m_location;
+      DataRate m_dataRate;
+      uint32_t m_cost;
+    };
+    typedef std::vector<Ptr<PoaDescriptor> > PoaDescriptorList;
+    typedef PoaDescriptorList::iterator PoaDescriptorListI;
+    uint32_t GetTlvSerializedSize (const PoaDescriptorList &poaDescriptorList);
+    void TlvSerialize (Buffer &buffer, const PoaDescriptorList &poaDescriptorList);
+    void TlvSerialize (Buffer::Iterator &i, const PoaDescriptorList &poaDescriptorList);
+    uint32_t TlvDeserialize (Buffer &buffer, PoaDescriptorList &poaDescriptorList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, PoaDescriptorList &poaDescriptorList);
+  } // namespace mih
+} // namespace ns3
+
+#endif 	    /* !MIH_POA_DESCRIPTOR_H */
@@ -18,8 +18,14 @@
  * Author: Providence SALUMU M. <Providence.Salumu_Munga@it-sudparis.eu>
  */
 
+#include <algorithm>
 #include "ns3/log.h"
+#include "ns3/hash.h"
 #include "ns3/pointer.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
 #include "ns3/assert.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
@@ -31,7 +37,10 @@
 #include "mih-function.h"
 #include "mih-protocol.h"
 #include "mih-header.h"
+#include "mih-payload.h"
 #include "mih-remote-event-source-trap.h"
+#include "mih-message-arena.h"
+#include "mih-event-timestamp-tag.h"
 
 NS_LOG_COMPONENT_DEFINE ("MihProtocol");
 
@@ -39,6 +48,10 @@ namespace ns3 {
   namespace mih {
 
     NS_OBJECT_ENSURE_REGISTERED (MihProtocol);
+
+    // Timers further away than this many ticks stay in their slot for
+    // as many turns of the wheel as needed;
+    static const uint32_t REGISTRATION_WHEEL_SLOTS = 256;
     
     TypeId 
     MihProtocol::GetTypeId (void)
@@ -58,10 +71,135 @@ namespace ns3 {
                        PointerValue (),
                        MakePointerAccessor (&MihProtocol::m_node),
                        MakePointerChecker<Node> ())
+        .AddAttribute ("SessionWindowSize",
+                       "The maximum number of requests a session keeps outstanding at once.",
+                       UintegerValue (16),
+                       MakeUintegerAccessor (&MihProtocol::m_sessionWindowSize),
+                       MakeUintegerChecker<uint16_t> (1, 4095))
+        .AddAttribute ("EventAggregationWindow",
+                       "How long a remote link event indication may wait to be sent "
+                       "in a batch with the following ones. Zero disables batching.",
+                       TimeValue (Seconds (0)),
+                       MakeTimeAccessor (&MihProtocol::m_eventAggregationWindow),
+                       MakeTimeChecker ())
+        .AddAttribute ("EventAggregationMaxCount",
+                       "The number of indications after which a batch is sent without "
+                       "waiting for the end of the aggregation window.",
+                       UintegerValue (16),
+                       MakeUintegerAccessor (&MihProtocol::m_eventAggregationMaxCount),
+                       MakeUintegerChecker<uint32_t> (1))
+        .AddAttribute ("TransactionRetransmissions",
+                       "How many times a request without response is sent again over "
+                       "UDP before it is confirmed with a failure status.",
+                       UintegerValue (3),
+                       MakeUintegerAccessor (&MihProtocol::m_transactionRetransmissions),
+                       MakeUintegerChecker<uint32_t> ())
+        .AddAttribute ("TransactionInitialRto",
+                       "The retransmission timeout of a request sent before any round trip "
+                       "time was measured on its session.",
+                       TimeValue (Seconds (1)),
+                       MakeTimeAccessor (&MihProtocol::m_transactionInitialRto),
+                       MakeTimeChecker ())
+        .AddAttribute ("TransactionMinRto", "The lower bound of the retransmission timeout.",
+                       TimeValue (MilliSeconds (100)),
+                       MakeTimeAccessor (&MihProtocol::m_transactionMinRto),
+                       MakeTimeChecker ())
+        .AddAttribute ("TransactionMaxRto", 
+                       "The upper bound of the retransmission timeout, also used to wait "
+                       "for the response of an acknowledged request.",
+                       TimeValue (Seconds (4)),
+                       MakeTimeAccessor (&MihProtocol::m_transactionMaxRto),
+                       MakeTimeChecker ())
+        .AddAttribute ("AckRequested",
+                       "Set the ACK-Req bit of requests sent over UDP so that the peer "
+                       "acknowledges them before its MIH user answers.",
+                       BooleanValue (false),
+                       MakeBooleanAccessor (&MihProtocol::m_ackRequested),
+                       MakeBooleanChecker ())
+        .AddAttribute ("MessageArena",
+                       "Allocate the TLV objects decoded from a received message in a "
+                       "single arena, released once the last of them is unreferenced.",
+                       BooleanValue (false),
+                       MakeBooleanAccessor (&MihProtocol::m_messageArena),
+                       MakeBooleanChecker ())
+        .AddAttribute ("EventTimestamps",
+                       "Tag the remote event indications sent by the sessions opened from "
+                       "now on with the time they were raised, for the EventDelay trace "
+                       "source of their destination.",
+                       BooleanValue (false),
+                       MakeBooleanAccessor (&MihProtocol::m_eventTimestamps),
+                       MakeBooleanChecker ())
+        .AddAttribute ("RegistrationTimerResolution",
+                       "The granularity of the timer wheel on which registrations "
+                       "expire and are refreshed.",
+                       TimeValue (Seconds (1)),
+                       MakeTimeAccessor (&MihProtocol::m_registrationTimerResolution),
+                       MakeTimeChecker (NanoSeconds (1)))
+        .AddAttribute ("RegistrationRefresh",
+                       "Register again with the peers we registered with, once three "
+                       "quarters of the valid lifetime they granted went by.",
+                       BooleanValue (true),
+                       MakeBooleanAccessor (&MihProtocol::m_registrationRefresh),
+                       MakeBooleanChecker ())
+        .AddAttribute ("SessionCount", "The number of sessions currently open.",
+                       TypeId::ATTR_GET,
+                       UintegerValue (0),
+                       MakeUintegerAccessor (&MihProtocol::GetSessionCount),
+                       MakeUintegerChecker<uint32_t> ())
+        .AddTraceSource ("SessionCountChanged", "The number of open sessions changed.",
+                         MakeTraceSourceAccessor (&MihProtocol::m_sessionCount),
+                         "ns3::TracedValueCallback::Uint32")
+        .AddTraceSource ("TransactionRetransmit", "A request was sent again after a timeout.",
+                         MakeTraceSourceAccessor (&MihProtocol::m_transactionRetransmitTrace),
+                         "ns3::mih::MihProtocol::TransactionRetransmitCallback")
+        .AddTraceSource ("TransactionTimeout", "A request was given up after its last retransmission.",
+                         MakeTraceSourceAccessor (&MihProtocol::m_transactionTimeoutTrace),
+                         "ns3::mih::MihProtocol::TransactionTimeoutCallback")
+        .AddTraceSource ("PduTx", "A PDU was sent to a peer, retransmissions included.",
+                         MakeTraceSourceAccessor (&MihProtocol::m_pduTxTrace),
+                         "ns3::mih::MihProtocol::PduCallback")
+        .AddTraceSource ("PduRx", "A PDU was received from a peer.",
+                         MakeTraceSourceAccessor (&MihProtocol::m_pduRxTrace),
+                         "ns3::mih::MihProtocol::PduCallback")
+        .AddTraceSource ("TransactionLatency",
+                         "The response to a request was received, that long after the "
+                         "request was issued.",
+                         MakeTraceSourceAccessor (&MihProtocol::m_transactionLatencyTrace),
+                         "ns3::mih::MihProtocol::TransactionLatencyCallback")
+        .AddTraceSource ("PendingRequestQueueDepth",
+                         "The number of requests of a session waiting for a window slot.",
+                         MakeTraceSourceAccessor (&MihProtocol::m_queueDepthTrace),
+                         "ns3::mih::MihProtocol::QueueDepthCallback")
+        .AddTraceSource ("EventDelay",
+                         "A remote event indication was passed to the MIH user, that long "
+                         "after the link SAP raised it. Needs EventTimestamps at the source.",
+                         MakeTraceSourceAccessor (&MihProtocol::m_eventDelayTrace),
+                         "ns3::mih::MihProtocol::EventDelayCallback")
+        .AddTraceSource ("RegistrationExpired",
+                         "The registration of a peer lapsed, or could not be refreshed, "
+                         "and its session was closed.",
+                         MakeTraceSourceAccessor (&MihProtocol::m_registrationExpiredTrace),
+                         "ns3::mih::MihProtocol::RegistrationExpiredCallback")
         ;
       return tid;
     }
-    MihProtocol::MihProtocol (void)
+    MihProtocol::MihProtocol (void) :
+      m_sessionCount (0),
+      m_sessionWindowSize (16),
+      m_eventAggregationWindow (Seconds (0)),
+      m_eventAggregationMaxCount (16),
+      m_transactionRetransmissions (3),
+      m_transactionInitialRto (Seconds (1)),
+      m_transactionMinRto (MilliSeconds (100)),
+      m_transactionMaxRto (Seconds (4)),
+      m_ackRequested (false),
+      m_messageArena (false),
+      m_eventTimestamps (false),
+      m_registrationTimerResolution (Seconds (1)),
+      m_registrationRefresh (true),
+      m_registrationWheel (REGISTRATION_WHEEL_SLOTS),
+      m_registrationTick (0),
+      m_registrationTimerCount (0)
     {
       NS_LOG_FUNCTION (this);
       m_serverSocket = 0;
@@ -76,6 +214,14 @@ namespace ns3 {
     MihProtocol::DoDispose (void)
     {
       NS_LOG_FUNCTION (this);
+      m_registrationTickEvent.Cancel ();
+      m_registrationWheel.clear ();
+      m_registrationTimerCount = 0;
+      m_sessionsByMihfId.clear ();
+      m_sessionsByAddress.clear ();
+      m_sessionsBySocket.clear ();
+      m_streamBuffers.clear ();
+      m_sessions.clear ();
       m_serverSocket = 0;
       m_node = 0;
     }
@@ -108,56 +254,358 @@ namespace ns3 {
       NS_LOG_FUNCTION (this);
       m_node = node;
     }    
-    bool
-    MihProtocol::FindSessionByMihfId (MihfId toMihfId, SessionListI &i)
+    std::size_t
+    MihfIdHash::operator () (const MihfId &mihfId) const
+    {
+      return mihfId.GetHandle ();
+    }
+    std::size_t
+    AddressHash::operator () (const Address &address) const
+    {
+      uint8_t buf[Address::MAX_SIZE];
+      uint32_t len = address.CopyAllTo (buf, Address::MAX_SIZE);
+      return Hash32 (reinterpret_cast<char *> (buf), len);
+    }
+    Ptr<Session>
+    MihProtocol::FindSessionByMihfId (MihfId toMihfId)
     {
       NS_LOG_FUNCTION (this);
-      bool found = false;
-      i = m_sessions.begin ();
-      while (i != m_sessions.end ())
+      MihfIdSessionIndex::iterator i = m_sessionsByMihfId.find (toMihfId);
+      if (i == m_sessionsByMihfId.end ())
         {
-          if ((*i)->GetToMihfId () == toMihfId)
-            {
-              found = true;
-              return found;
-            }
-          i++;
+          return 0;
+        }
+      return i->second;
+    }
+    Ptr<Session>
+    MihProtocol::FindSessionByToAddress (Address toAddress)
+    {
+      NS_LOG_FUNCTION (this);
+      AddressSessionIndex::iterator i = m_sessionsByAddress.find (toAddress);
+      if (i == m_sessionsByAddress.end ())
+        {
+          return 0;
+        }
+      return i->second;
+    }
+    Ptr<Session>
+    MihProtocol::FindSessionBySocket (Ptr<Socket> s)
+    {
+      NS_LOG_FUNCTION (this);
+      SocketSessionIndex::iterator i = m_sessionsBySocket.find (s);
+      if (i == m_sessionsBySocket.end ())
+        {
+          return 0;
         }
-      return found;
+      return i->second;
     }
-    bool
-    MihProtocol::FindSessionByToAddress (Address toAddress, SessionListI &i)
+    Ptr<Session>
+    MihProtocol::AcceptSession (MihfId fromMihfId,
+                                MihfId toMihfId,
+                                Address to,
+                                Ptr<Socket> socket)
     {
       NS_LOG_FUNCTION (this);
-      bool found = false;
-      i = m_sessions.begin ();
-      while (i != m_sessions.end ())
+      Ptr<Session> session = FindSessionByToAddress (to);
+      if (session == 0)
+        {
+          session = Create<Session> ();
+          ConfigureSession (session);
+          session->SetSocket (socket);
+          session->SetToAddress (to);
+          AddSession (session);
+        }
+      if (!session->IsInitComplete ())
+        {
+          session->SetToMihfId (toMihfId);
+          session->SetFromMihfId (fromMihfId);
+          session->SetFromAddress (Address ());
+          session->SetInitComplete ();
+          IndexSession (session);
+        }
+      return session;
+    }
+    void
+    MihProtocol::AddSession (Ptr<Session> session)
+    {
+      NS_LOG_FUNCTION (this << session);
+      m_sessions.insert (session);
+      m_sessionCount = m_sessions.size ();
+      IndexSession (session);
+    }
+    void
+    MihProtocol::IndexSession (Ptr<Session> session)
+    {
+      NS_LOG_FUNCTION (this << session);
+      if (session->GetToMihfId () != MihfId ())
+        {
+          m_sessionsByMihfId[session->GetToMihfId ()] = session;
+        }
+      if (!session->GetToAddress ().IsInvalid ())
+        {
+          m_sessionsByAddress[session->GetToAddress ()] = session;
+        }
+      // Sessions served through the listening UDP socket share it;
+      if (session->GetSocket () != 0 && session->GetSocket () != m_serverSocket)
+        {
+          m_sessionsBySocket[session->GetSocket ()] = session;
+        }
+    }
+    void
+    MihProtocol::RemoveSession (Ptr<Session> session)
+    {
+      NS_LOG_FUNCTION (this << session);
+      MihfIdSessionIndex::iterator i = m_sessionsByMihfId.find (session->GetToMihfId ());
+      if (i != m_sessionsByMihfId.end () && i->second == session)
+        {
+          m_sessionsByMihfId.erase (i);
+        }
+      AddressSessionIndex::iterator j = m_sessionsByAddress.find (session->GetToAddress ());
+      if (j != m_sessionsByAddress.end () && j->second == session)
+        {
+          m_sessionsByAddress.erase (j);
+        }
+      SocketSessionIndex::iterator k = m_sessionsBySocket.find (session->GetSocket ());
+      if (k != m_sessionsBySocket.end () && k->second == session)
+        {
+          m_sessionsBySocket.erase (k);
+        }
+      m_sessions.erase (session);
+      m_sessionCount = m_sessions.size ();
+    }
+    void
+    MihProtocol::HandleSessionClose (Ptr<Socket> socket)
+    {
+      NS_LOG_FUNCTION (this << socket);
+      Ptr<Session> session = FindSessionBySocket (socket);
+      if (session != 0)
+        {
+          CloseSession (session);
+        }
+      m_streamBuffers.erase (socket);
+    }
+    void
+    MihProtocol::HandleSend (Ptr<Socket> socket, uint32_t available)
+    {
+      NS_LOG_FUNCTION (this << socket << available);
+      Ptr<Session> session = FindSessionBySocket (socket);
+      if (session != 0)
+        {
+          session->DrainSendBacklog ();
+        }
+    }
+    void
+    MihProtocol::CloseSession (Ptr<Session> session)
+    {
+      NS_LOG_FUNCTION (this << session);
+      if (session->IsClosed ())
+        {
+          return;
+        }
+      CancelRegistrationTimer (session);
+      UnsubscribeRemoteEvents (session);
+      RemoveSession (session);
+      // Sessions served through the listening UDP socket share it;
+      Ptr<Socket> socket = session->GetSocket ();
+      if (socket != 0 && socket != m_serverSocket)
+        {
+          m_streamBuffers.erase (socket);
+          socket->SetRecvCallback (MakeNullCallback<void, Ptr<Socket> > ());
+          socket->SetSendCallback (MakeNullCallback<void, Ptr<Socket>, uint32_t> ());
+          socket->SetCloseCallbacks (MakeNullCallback<void, Ptr<Socket> > (),
+                                     MakeNullCallback<void, Ptr<Socket> > ());
+          socket->Close ();
+        }
+      session->Close ();
+    }
+    void
+    MihProtocol::UnsubscribeRemoteEvents (Ptr<Session> session)
+    {
+      NS_LOG_FUNCTION (this << session);
+      Ptr<MihFunction> mihFunction = GetObject<MihFunction> ();
+      if (mihFunction == 0)
+        {
+          return;
+        }
+      // The link SAPs call the remote event source of the session
+      // directly, whichever events it subscribed to on each of them;
+      RemoteEventSourceTrap &remoteEventSourceTrap = session->GetRemoteEventSourceTrap ();
+      for (MihLinkSapListI i = mihFunction->GetRegisteredMihLinkSapListBegin ();
+           i != mihFunction->GetRegisteredMihLinkSapListEnd (); i++)
+        {
+          (*i)->EventUnsubscribe (EventList::LINK_DETECTED,
+                                  MakeCallback (&RemoteEventSourceTrap::LinkDetected, &remoteEventSourceTrap),
+                                  EventList::LINK_UP,
+                                  MakeCallback (&RemoteEventSourceTrap::LinkUp, &remoteEventSourceTrap),
+                                  EventList::LINK_DOWN,
+                                  MakeCallback (&RemoteEventSourceTrap::LinkDown, &remoteEventSourceTrap),
+                                  EventList::LINK_PARAMETERS_REPORT,
+                                  MakeCallback (&RemoteEventSourceTrap::LinkParametersReport, &remoteEventSourceTrap),
+                                  EventList::LINK_GOING_DOWN,
+                                  MakeCallback (&RemoteEventSourceTrap::LinkGoingDown, &remoteEventSourceTrap),
+                                  EventList::LINK_HANDOVER_IMMINENT,
+                                  MakeCallback (&RemoteEventSourceTrap::LinkHandoverImminent, &remoteEventSourceTrap),
+                                  EventList::LINK_HANDOVER_COMPLETE,
+                                  MakeCallback (&RemoteEventSourceTrap::LinkHandoverComplete, &remoteEventSourceTrap),
+                                  EventList::INVALID,
+                                  MakeNullCallback<void, MihfId, LinkIdentifier, uint16_t, bool> ());
+        }
+    }
+    void
+    MihProtocol::NotifyRegistered (Ptr<Session> session, uint32_t validLifeTime)
+    {
+      NS_LOG_FUNCTION (this << session << validLifeTime);
+      CancelRegistrationTimer (session);
+      if (validLifeTime == 0)
         {
-          if ((*i)->GetToAddress () == toAddress)
+          // Granted without limit;
+          return;
+        }
+      Time lifetime = Seconds (validLifeTime);
+      if (session->IsRegistrant () && m_registrationRefresh)
+        {
+          // Leave the refresh a quarter of the lifetime to complete;
+          ArmRegistrationTimer (session, lifetime * 3 / 4);
+        }
+      else
+        {
+          ArmRegistrationTimer (session, lifetime);
+        }
+    }
+    void
+    MihProtocol::NotifyDeRegistered (Ptr<Session> session)
+    {
+      NS_LOG_FUNCTION (this << session);
+      // Once the transaction which told us is done with the session;
+      Simulator::ScheduleNow (&MihProtocol::CloseSession, this, session);
+    }
+    uint64_t
+    MihProtocol::GetRegistrationTick (Time time) const
+    {
+      return time.GetTimeStep () / m_registrationTimerResolution.GetTimeStep ();
+    }
+    void
+    MihProtocol::ArmRegistrationTimer (Ptr<Session> session, Time delay)
+    {
+      NS_LOG_FUNCTION (this << session << delay);
+      NS_ASSERT (session->GetRegistrationTimer () == 0);
+      if (m_registrationTimerCount == 0)
+        {
+          m_registrationTick = GetRegistrationTick (Simulator::Now ());
+        }
+      // Rounded up to the next tick, a registration never expires early;
+      int64_t resolution = m_registrationTimerResolution.GetTimeStep ();
+      uint64_t tick = ((Simulator::Now () + delay).GetTimeStep () + resolution - 1) / resolution;
+      tick = std::max (tick, m_registrationTick + 1);
+      RegistrationTimer timer;
+      timer.session = session;
+      timer.tick = tick;
+      m_registrationWheel[tick % REGISTRATION_WHEEL_SLOTS].push_back (timer);
+      session->SetRegistrationTimer (tick);
+      m_registrationTimerCount++;
+      if (!m_registrationTickEvent.IsRunning ())
+        {
+          m_registrationTickEvent = Simulator::Schedule (m_registrationTimerResolution * (m_registrationTick + 1) - Simulator::Now (),
+                                                         &MihProtocol::RegistrationTimerTick, this);
+        }
+    }
+    void
+    MihProtocol::CancelRegistrationTimer (Ptr<Session> session)
+    {
+      NS_LOG_FUNCTION (this << session);
+      uint64_t tick = session->GetRegistrationTimer ();
+      if (tick == 0)
+        {
+          return;
+        }
+      RegistrationTimerSlot &slot = m_registrationWheel[tick % REGISTRATION_WHEEL_SLOTS];
+      for (uint32_t j = 0; j < slot.size (); j++)
+        {
+          if (slot[j].session == session)
             {
-              found = true;
-              return found;
+              slot[j] = slot.back ();
+              slot.pop_back ();
+              m_registrationTimerCount--;
+              break;
             }
-          i++;
         }
-      return found;
+      session->SetRegistrationTimer (0);
     }
-    bool
-    MihProtocol::FindSessionBySocket (Ptr<Socket> s, SessionListI &i)
+    void
+    MihProtocol::RegistrationTimerTick (void)
     {
-      NS_LOG_FUNCTION (this);
-      bool found = false;
-      i = m_sessions.begin ();
-      while (i != m_sessions.end ())
+      m_registrationTick++;
+      NS_LOG_FUNCTION (this << m_registrationTick);
+      RegistrationTimerSlot due;
+      due.swap (m_registrationWheel[m_registrationTick % REGISTRATION_WHEEL_SLOTS]);
+      std::vector<Ptr<Session> > expired;
+      for (uint32_t j = 0; j < due.size (); j++)
         {
-          if ((*i)->GetSocket () == s)
+          if (due[j].tick > m_registrationTick)
             {
-              found = true;
-              return found;
+              // Due on a later turn of the wheel;
+              m_registrationWheel[m_registrationTick % REGISTRATION_WHEEL_SLOTS].push_back (due[j]);
+              continue;
             }
-          i++;
+          m_registrationTimerCount--;
+          due[j].session->SetRegistrationTimer (0);
+          expired.push_back (due[j].session);
+        }
+      if (m_registrationTimerCount > 0)
+        {
+          m_registrationTickEvent = Simulator::Schedule (m_registrationTimerResolution,
+                                                         &MihProtocol::RegistrationTimerTick, this);
+        }
+      for (uint32_t j = 0; j < expired.size (); j++)
+        {
+          RegistrationTimerExpired (expired[j]);
         }
-      return found;
+    }
+    void
+    MihProtocol::RegistrationTimerExpired (Ptr<Session> session)
+    {
+      NS_LOG_FUNCTION (this << session);
+      if (session->IsRegistrant () && m_registrationRefresh)
+        {
+          NS_LOG_LOGIC ("Refreshing the registration with " << session->GetToMihfId ());
+          SendRegisterRequest (session->GetToMihfId (),
+                               session->GetRegistrationLinks (),
+                               RegistrationCode (RegistrationCode::RE_REGISTRATION),
+                               MakeCallback (&MihProtocol::RegistrationRefreshConfirm, this));
+          return;
+        }
+      if (!session->IsRegistered ())
+        {
+          NS_LOG_LOGIC ("Unregistered session with " << session->GetToMihfId () << " idle");
+          CloseSession (session);
+          return;
+        }
+      NS_LOG_LOGIC ("Registration with " << session->GetToMihfId () << " expired");
+      m_registrationExpiredTrace (session->GetToMihfId ());
+      CloseSession (session);
+    }
+    void
+    MihProtocol::RegistrationRefreshConfirm (MihfId mihfId, Status status, uint32_t validLifeTime)
+    {
+      NS_LOG_FUNCTION (this << mihfId << validLifeTime);
+      if (status.GetType () == Status::SUCCESS)
+        {
+          // The session armed its next refresh already;
+          return;
+        }
+      Ptr<Session> session = FindSessionByMihfId (mihfId);
+      if (session == 0)
+        {
+          return;
+        }
+      NS_LOG_LOGIC ("Registration with " << mihfId << " could not be refreshed");
+      m_registrationExpiredTrace (mihfId);
+      Simulator::ScheduleNow (&MihProtocol::CloseSession, this, session);
+    }
+    uint32_t
+    MihProtocol::GetSessionCount (void) const
+    {
+      return m_sessions.size ();
     }
     void 
     MihProtocol::AddDestinationEntry (MihfId mihfId, Address dest)
@@ -175,43 +623,30 @@ namespace ns3 {
     {
       NS_LOG_FUNCTION (this);
 
-      SessionListI i;
+      Ptr<Session> session;
 
       if (m_tid == UdpSocketFactory::GetTypeId ())
         {
-          if (FindSessionByToAddress (to, i))
-            {
-              return (*i);
-            }
-          return 0;
-          NS_ASSERT (0);
-          Ptr<Session> session = Create<Session> ();
-          session->GetRemoteEventSourceTrap ().SetSession (session);
-          session->SetSocket (s);
-          session->SetToMihfId (toMihfId);
-          session->SetFromMihfId (fromMihfid);
-          session->SetToAddress (to);
-          session->SetFromAddress (from);
-          session->SetInitComplete ();
-          m_sessions.push_back (session);
-          return session;
+          return FindSessionByToAddress (to);
         }
       else if (m_tid == TcpSocketFactory::GetTypeId ())
         {
-          if (!FindSessionBySocket (s, i))
+          session = FindSessionBySocket (s);
+          if (session == 0)
             {
               NS_LOG_DEBUG ("You need first to create a connection  before a session can be searched for.");
               NS_ASSERT (0);
             }
-          if (!(*i)->IsInitComplete ())
+          if (!session->IsInitComplete ())
             {
-              (*i)->SetFromMihfId (fromMihfid);
-              (*i)->SetToMihfId (toMihfId);
-              (*i)->SetFromAddress (from);
-              (*i)->SetInitComplete ();
+              session->SetFromMihfId (fromMihfid);
+              session->SetToMihfId (toMihfId);
+              session->SetFromAddress (from);
+              session->SetInitComplete ();
+              IndexSession (session);
             }
           
-          return *i;
+          return session;
         }
       else
         {
@@ -227,18 +662,29 @@ namespace ns3 {
                                Address to)
     {
       NS_LOG_FUNCTION (this);
-      SessionListI i;
-      if (FindSessionByToAddress (to, i))
+      Ptr<Session> session = FindSessionByToAddress (to);
+      if (session != 0)
         {
-          return (*i);
+          return session;
+        }
+      // Keep a single session per peer, whichever side opened it: the
+      // one accepted from a peer is bound to the port it sent from,
+      // not to the one its MIHF identifier resolves to;
+      session = FindSessionByMihfId (toMihfId);
+      if (session != 0 && session->GetSocket () != 0)
+        {
+          return session;
         }
       
-      Ptr<Session> session = Create<Session> ();
-      session->GetRemoteEventSourceTrap ().SetSession (session);
+      session = Create<Session> ();
+      ConfigureSession (session);
       Ptr<Socket> socket = Socket::CreateSocket (GetNode(), m_tid);
       socket->Bind (from);
       socket->Connect (to);
       socket->SetRecvCallback (MakeCallback (&MihProtocol::HandleRead, this));
+      socket->SetSendCallback (MakeCallback (&MihProtocol::HandleSend, this));
+      socket->SetCloseCallbacks (MakeCallback (&MihProtocol::HandleSessionClose, this),
+                                 MakeCallback (&MihProtocol::HandleSessionClose, this));
       session->SetSocket (socket);
       session->SetToMihfId (toMihfId);
       session->SetFromMihfId (fromMihfId);
@@ -246,9 +692,92 @@ namespace ns3 {
       session->SetFromAddress (from);
       session->SetInitComplete ();
 
-      m_sessions.push_back (session);
+      AddSession (session);
       return session;
     }
+    void
+    MihProtocol::ConfigureSession (Ptr<Session> session)
+    {
+      NS_LOG_FUNCTION (this);
+      session->GetRemoteEventSourceTrap ().SetSession (session);
+      session->SetWindowSize (GetSessionWindowSize ());
+      session->GetRemoteEventSourceTrap ().SetAggregation (m_eventAggregationWindow,
+                                                           m_eventAggregationMaxCount);
+      session->GetRemoteEventSourceTrap ().SetTimestamps (m_eventTimestamps);
+      session->SetRegistrationCallbacks (MakeCallback (&MihProtocol::NotifyRegistered, this),
+                                         MakeCallback (&MihProtocol::NotifyDeRegistered, this));
+      session->SetStreamTransport (m_tid == TcpSocketFactory::GetTypeId ());
+      session->SetTrafficTraceCallbacks (MakeCallback (&MihProtocol::NotifyPduSent, this),
+                                         MakeCallback (&MihProtocol::NotifyTransactionLatency, this),
+                                         MakeCallback (&MihProtocol::NotifyQueueDepth, this));
+      // A stream socket already retransmits what it lost;
+      if (m_tid == UdpSocketFactory::GetTypeId ())
+        {
+          session->SetRetransmission (m_transactionInitialRto,
+                                      m_transactionMinRto,
+                                      m_transactionMaxRto,
+                                      m_transactionRetransmissions,
+                                      m_ackRequested);
+          session->SetTransactionTraceCallbacks (MakeCallback (&MihProtocol::NotifyTransactionRetransmit, this),
+                                                 MakeCallback (&MihProtocol::NotifyTransactionTimeout, this));
+        }
+    }
+    void
+    MihProtocol::NotifyTransactionRetransmit (MihfId peer, uint16_t transactionId, uint32_t transmissions)
+    {
+      NS_LOG_FUNCTION (this << peer << transactionId << transmissions);
+      m_transactionRetransmitTrace (peer, transactionId, transmissions);
+    }
+    void
+    MihProtocol::NotifyTransactionTimeout (MihfId peer, uint16_t transactionId)
+    {
+      NS_LOG_FUNCTION (this << peer << transactionId);
+      m_transactionTimeoutTrace (peer, transactionId);
+    }
+    void
+    MihProtocol::NotifyPduSent (MihfId peer, Ptr<const Packet> packet)
+    {
+      MihHeader mihHeader;
+      packet->PeekHeader (mihHeader);
+      m_pduTxTrace (peer, mihHeader.GetServiceId (), mihHeader.GetOpCode (),
+                    mihHeader.GetActionId (), packet->GetSize ());
+    }
+    void
+    MihProtocol::NotifyPduReceived (MihfId peer, MihHeader &header, uint32_t size)
+    {
+      m_pduRxTrace (peer, header.GetServiceId (), header.GetOpCode (),
+                    header.GetActionId (), size);
+    }
+    void
+    MihProtocol::NotifyTransactionLatency (MihfId peer, uint16_t transactionId, Time latency)
+    {
+      NS_LOG_FUNCTION (this << peer << transactionId << latency);
+      m_transactionLatencyTrace (peer, transactionId, latency);
+    }
+    void
+    MihProtocol::NotifyQueueDepth (MihfId peer, uint32_t depth)
+    {
+      m_queueDepthTrace (peer, depth);
+    }
+    void
+    MihProtocol::NotifyEventDelay (MihfId source, Ptr<const Packet> packet)
+    {
+      EventTimestampTag timestamps;
+      if (!packet->FindFirstMatchingByteTag (timestamps))
+        {
+          return;
+        }
+      // One per indication of a batch;
+      for (uint32_t j = 0; j < timestamps.GetNTimestamps (); j++)
+        {
+          m_eventDelayTrace (source, Simulator::Now () - timestamps.GetTimestamp (j));
+        }
+    }
+    uint16_t
+    MihProtocol::GetSessionWindowSize (void) const
+    {
+      return m_sessionWindowSize;
+    }
     Address
     MihProtocol::ResolveMihfIdToAddress (MihfId mihfid)
     {
@@ -261,57 +790,148 @@ namespace ns3 {
     MihProtocol::ReceiveNewSessionRequest (Ptr<Socket> s, const Address& from)
     {
       NS_LOG_FUNCTION (this);
-      SessionListI i;
-      if (FindSessionBySocket (s, i))
+      if (FindSessionBySocket (s) != 0)
         {
           return;
         }
       Ptr<Session> session = Create<Session> ();
-      session->GetRemoteEventSourceTrap ().SetSession (session);
+      ConfigureSession (session);
       NS_LOG_DEBUG ("Arm a destructor event for this session!");
       s->SetRecvCallback (MakeCallback(&MihProtocol::HandleRead, this));
+      s->SetSendCallback (MakeCallback (&MihProtocol::HandleSend, this));
+      s->SetCloseCallbacks (MakeCallback (&MihProtocol::HandleSessionClose, this),
+                            MakeCallback (&MihProtocol::HandleSessionClose, this));
       session->SetToAddress (from);
       session->SetSocket (s);
       session->SetRegistered ();
-      m_sessions.push_back (session);
+      AddSession (session);
       return;
     }
     void
+    MihProtocol::ReadPdus (Ptr<Socket> socket, PduList &pdus)
+    {
+      NS_LOG_FUNCTION (this << socket);
+      Ptr<Packet> packet = 0;
+      Address from;
+
+      while (packet = socket->RecvFrom (from))
+        {
+          if (m_tid != TcpSocketFactory::GetTypeId ())
+            {
+              pdus.push_back (std::make_pair (packet, from));
+              continue;
+            }
+          // A stream read may carry several PDUs as well as a part of
+          // one only, the MIH header tells where each of them ends;
+          Ptr<Packet> pending = m_streamBuffers[socket];
+          if (pending == 0)
+            {
+              pending = packet;
+              m_streamBuffers[socket] = pending;
+            }
+          else
+            {
+              pending->AddAtEnd (packet);
+            }
+          MihHeader mihHeader;
+          while (pending->GetSize () >= mihHeader.GetSerializedSize ())
+            {
+              pending->PeekHeader (mihHeader);
+              uint32_t pduSize = mihHeader.GetSerializedSize () + mihHeader.GetPayloadLength ();
+              if (pending->GetSize () < pduSize)
+                {
+                  break;
+                }
+              pdus.push_back (std::make_pair (pending->CreateFragment (0, pduSize), from));
+              pending->RemoveAtStart (pduSize);
+            }
+        }
+    }
+    void
     MihProtocol::HandleRead (Ptr<Socket> socket)
     {
       NS_LOG_FUNCTION (this << socket);
       Ptr<Packet> packet = 0;
       Ptr<Session> session = 0;
       Address from;
+      PduList pdus;
 
-      while (packet = socket->RecvFrom (from))
+      ReadPdus (socket, pdus);
+      for (PduListI pdu = pdus.begin (); pdu != pdus.end (); pdu++)
         {
+          packet = pdu->first;
+          from = pdu->second;
           MihHeader mihHeader;
           MihfId fromMihfId;
           MihfId toMihfId;
-          uint8_t *packetData;
-          uint32_t payloadSize;
-          Buffer buffer;
           Ptr<MihFunction> mihFunction = GetObject<MihFunction> ();
           
           NS_ASSERT (mihFunction != 0);
           
+          uint32_t pduSize = packet->GetSize ();
           // Remove header before  accessing the payload
           packet->RemoveHeader (mihHeader);
-          payloadSize = packet->GetSize ();
-          packet->CopyData (packetData, payloadSize);
-          buffer.AddAtStart (payloadSize);
-          // Start removal of the payload;
-          Buffer::Iterator i = buffer.Begin ();
-          for (uint32_t j = 0; j < payloadSize; j++, packetData++)
+          session = 0;
+          if (mihHeader.GetAckResponse () && packet->GetSize () == 0)
             {
-              i.WriteU8 (*packetData);
+              // Header-only acknowledgement of one of our requests;
+              session = FindSessionByToAddress (from);
+              if (session != 0)
+                {
+                  NotifyPduReceived (session->GetToMihfId (), mihHeader, pduSize);
+                  session->ReceiveAck (mihHeader.GetTransactionId ());
+                }
+              continue;
             }
-
-          fromMihfId.TlvDeserialize (buffer);
-          toMihfId.TlvDeserialize (buffer);
+          if (mihHeader.GetOpCode () == MihHeader::REQUEST)
+            {
+              // Retransmitted requests are answered by the session
+              // without reaching the MIH user again;
+              session = FindSessionByToAddress (from);
+              if (session != 0 && session->ReceiveDuplicateRequest (mihHeader))
+                {
+                  NotifyPduReceived (session->GetToMihfId (), mihHeader, pduSize);
+                  continue;
+                }
+            }
+          // The payload is decoded straight from the packet buffer,
+          // which keeps its bytes and tags for the session;
+          MihPayload payload (mihHeader);
+          {
+            // Only the decoding allocates from the arena, the objects
+            // the MIH user creates from its callbacks do not;
+            MihMessageArena arena (m_messageArena);
+            packet->PeekHeader (payload);
+          }
+          fromMihfId = payload.GetSourceMihfId ();
+          toMihfId = payload.GetDestinationMihfId ();
 
           NS_ASSERT (toMihfId == mihFunction->GetMihfId ());
+          NotifyPduReceived (fromMihfId, mihHeader, pduSize);
+
+          // Only registrations and information queries open a session,
+          // anything else may come from a peer whose session was closed
+          // while the PDU was on its way;
+          bool opensSession = mihHeader.GetOpCode () == MihHeader::REQUEST &&
+            ((mihHeader.GetServiceId () == MihHeader::MANAGEMENT &&
+              mihHeader.GetActionId () == MihHeader::MIH_REGISTER) ||
+             (mihHeader.GetServiceId () == MihHeader::INFORMATION &&
+              mihHeader.GetActionId () == MihHeader::MIH_GET_INFORMATION));
+          if (!opensSession && m_tid == UdpSocketFactory::GetTypeId () &&
+              FindSessionByToAddress (from) == 0)
+            {
+              if (mihHeader.GetOpCode () != MihHeader::REQUEST)
+                {
+                  NS_LOG_LOGIC ("No session with " << fromMihfId << ", PDU dropped");
+                  continue;
+                }
+              // Answered on an unregistered session of its own, rather
+              // than letting the peer retransmit until it gives up,
+              // closed once the response is sent;
+              NS_LOG_LOGIC ("No session with " << fromMihfId << ", request answered");
+              session = AcceptSession (toMihfId, fromMihfId, from, socket);
+              Simulator::ScheduleNow (&MihProtocol::CloseSession, this, session);
+            }
 
           if (mihHeader.GetServiceId () == MihHeader::MANAGEMENT)
             {
@@ -320,45 +940,23 @@ namespace ns3 {
                 case MihHeader::MIH_REGISTER :
                   if (mihHeader.GetOpCode () == MihHeader::REQUEST)
                     {
-                      LinkIdentifierList linkIdentifierList;
-                      RegistrationCode registrationCode;
-                      TlvDeserialize (buffer, linkIdentifierList);
-                      registrationCode.TlvDeserialize (buffer);
-//                       session = GetSession (toMihfId, Address (), fromMihfId, from, socket);
-                      if (session == 0)
-                        {
-                          session = Create<Session> ();
-                          session->GetRemoteEventSourceTrap ().SetSession (session);
-                          session->SetSocket (socket);
-                          session->SetToMihfId (fromMihfId);
-                          session->SetFromMihfId (toMihfId);
-                          session->SetToAddress (from);
-                          session->SetFromAddress (Address ());
-                          session->SetInitComplete ();
-                          m_sessions.push_back (session);
-                        }
-                      NS_ASSERT (session != 0);
+                      session = AcceptSession (toMihfId, fromMihfId, from, socket);
                       session->SetRegistered ();
                       mihFunction->RegisterIndication (fromMihfId, 
-                                                       linkIdentifierList, 
-                                                       registrationCode, 
+                                                       payload.GetLinkIdentifierList (), 
+                                                       payload.GetRegistrationCode (), 
                                                        session->ReceiveRegisterRequest (packet,
                                                                                         mihHeader.GetTransactionId ()));
                     }
                   else if (mihHeader.GetOpCode () == MihHeader::RESPONSE)
                     {
-                      Status status;
-                      uint32_t validLifeTime = 0;
-                      status.TlvDeserialize (buffer);
-                      status.GetType () == Status::SUCCESS ?
-                        Tlv::DeserializeU32 (buffer, validLifeTime, TLV_VALID_TIME_INTERVAL) :
-                        validLifeTime = 0;
                       session = GetSession (toMihfId, Address (), fromMihfId, from, socket);
                       NS_ASSERT (session != 0);
                       session->SetRegistered ();
-                      status.GetType () == Status::SUCCESS ? 
-                        session->ReceiveRegisterResponse (fromMihfId, status, validLifeTime) : 
-                        session->ReceiveRegisterResponse (fromMihfId, status);
+                      session->ReceiveRegisterResponse (fromMihfId, 
+                                                        payload.GetStatus (), 
+                                                        payload.GetValidLifeTime (),
+                                                        mihHeader.GetTransactionId ());
                     }
                   else
                     {
@@ -366,19 +964,49 @@ namespace ns3 {
                     }
                   break;
                 case MihHeader::MIH_DEREGISTER :
-                  NS_ASSERT (0);
+                  if (mihHeader.GetOpCode () == MihHeader::REQUEST)
+                    {
+                      session = GetSession (toMihfId, Address (), fromMihfId, from, socket);
+                      NS_ASSERT (session != 0);
+                      MihDeRegisterResponseCallback deRegisterResponseCallback =
+                        session->ReceiveDeRegisterRequest (packet, mihHeader.GetTransactionId ());
+                      if (!session->IsRegistered ())
+                        {
+                          // Its registration expired, or this is a
+                          // retransmission whose response was lost;
+                          NS_LOG_LOGIC ("Deregistration of " << fromMihfId << " which is not registered");
+                          deRegisterResponseCallback (toMihfId, Status (Status::SUCCESS));
+                          break;
+                        }
+                      mihFunction->DeRegisterIndication (fromMihfId, deRegisterResponseCallback);
+                    }
+                  else if (mihHeader.GetOpCode () == MihHeader::RESPONSE)
+                    {
+                      session = GetSession (toMihfId, Address (), fromMihfId, from, socket);
+                      NS_ASSERT (session != 0);
+                      session->ReceiveDeRegisterResponse (fromMihfId, 
+                                                          payload.GetStatus (), 
+                                                          mihHeader.GetTransactionId ());
+                    }
+                  else
+                    {
+                      NS_ASSERT (0);
+                    }
                   break;
                 case MihHeader::MIH_EVENT_SUBSCRIBE :
                   if (mihHeader.GetOpCode () == MihHeader::REQUEST)
                     {
-                      LinkIdentifier linkIdentifier;
-                      EventList events;
-                      linkIdentifier.TlvDeserialize (buffer);
-                      events.TlvDeserialize (buffer);
+                      LinkIdentifier linkIdentifier = payload.GetLinkIdentifier ();
+                      EventList events = payload.GetEventList ();
 
                       session = GetSession (toMihfId, Address (), fromMihfId, from, socket);
                       NS_ASSERT (session != 0);
-                      NS_ASSERT (session->IsRegistered ());
+                      if (!session->IsRegistered ())
+                        {
+                          session->ReceiveEventSubscribeRequest (packet, mihHeader.GetTransactionId ())
+                            (toMihfId, Status (Status::REJECTED), linkIdentifier, events);
+                          break;
+                        }
 
                       RemoteEventSourceTrap &remoteEventSourceTrap = session->GetRemoteEventSourceTrap ();
                       
@@ -489,14 +1117,6 @@ namespace ns3 {
                     }
                   else if (mihHeader.GetOpCode () == MihHeader::RESPONSE)
                     {
-                      Status status;
-                      LinkIdentifier linkIdentifier;
-                      EventList events;
-
-                      status.TlvDeserialize (buffer);
-                      linkIdentifier.TlvDeserialize (buffer);
-                      events.TlvDeserialize (buffer);
-
                       session = GetSession (toMihfId, 
                                             Address (), 
                                             fromMihfId,
@@ -505,9 +1125,10 @@ namespace ns3 {
                       NS_ASSERT (session != 0);
                       NS_ASSERT (session->IsRegistered ());
                       session->ReceiveEventSubscribeResponse (fromMihfId,
-                                                              status,
-                                                              linkIdentifier,
-                                                              events);
+                                                              payload.GetStatus (),
+                                                              payload.GetLinkIdentifier (),
+                                                              payload.GetEventList (),
+                                                              mihHeader.GetTransactionId ());
                     }
                   else
                     {
@@ -520,50 +1141,29 @@ namespace ns3 {
                 case MihHeader::MIH_CAPABILITY_DISCOVER :
                   if (mihHeader.GetOpCode () == MihHeader::REQUEST)
                     {
-                      NetworkTypeAddressList networkTypeAddresses;
-                      EventList events;
-                      MihCommandList commands;
-                      InformationServiceQueryTypeList informationServiceQueryTypes;
-                      TransportSupportList transportSupports;
-                      MakeBeforeBreakSupportList makeBeforeBreakSupports;
-                      TlvDeserialize (buffer, networkTypeAddresses);
-                      events.TlvDeserialize (buffer);
-                      commands.TlvDeserialize (buffer);
-                      informationServiceQueryTypes.TlvDeserialize (buffer);
-                      transportSupports.TlvDeserialize (buffer);
-                      TlvDeserialize (buffer, makeBeforeBreakSupports);
                       session = GetSession (toMihfId, Address (), fromMihfId, from, socket);
                       NS_ASSERT (session != 0);
-                      NS_ASSERT (session->IsRegistered ());
+                      if (!session->IsRegistered ())
+                        {
+                          session->ReceiveCapabilityDiscoverRequest (packet, mihHeader.GetTransactionId ())
+                            (toMihfId, Status (Status::REJECTED), NetworkTypeAddressList (), EventList (),
+                             MihCommandList (), InformationServiceQueryTypeList (), TransportSupportList (),
+                             MakeBeforeBreakSupportList ());
+                          break;
+                        }
                       
                       mihFunction->CapabilityDiscoverIndication (fromMihfId,
-                                                                 networkTypeAddresses,
-                                                                 events,
-                                                                 commands,
-                                                                 informationServiceQueryTypes,
-                                                                 transportSupports,
-                                                                 makeBeforeBreakSupports,
+                                                                 payload.GetNetworkTypeAddressList (),
+                                                                 payload.GetEventList (),
+                                                                 payload.GetCommandList (),
+                                                                 payload.GetInformationServiceQueryTypeList (),
+                                                                 payload.GetTransportSupportList (),
+                                                                 payload.GetMakeBeforeBreakSupportList (),
                                                                  session->ReceiveCapabilityDiscoverRequest (packet,
                                                                                                             mihHeader.GetTransactionId ()));
                     }
                   else if (mihHeader.GetOpCode () == MihHeader::RESPONSE)
                     {
-                      Status status;
-                      NetworkTypeAddressList networkTypeAddresses;
-                      EventList events;
-                      MihCommandList commands;
-                      InformationServiceQueryTypeList miisQueries;
-                      TransportSupportList transportOptions;
-                      MakeBeforeBreakSupportList mbbSupportList;
-                      
-                      status.TlvDeserialize (buffer);
-                      TlvDeserialize (buffer, networkTypeAddresses);
-                      events.TlvDeserialize (buffer);
-                      commands.TlvDeserialize (buffer);
-                      miisQueries.TlvDeserialize (buffer);
-                      transportOptions.TlvDeserialize (buffer);
-                      TlvDeserialize (buffer, mbbSupportList);
-
                       session = GetSession (toMihfId, 
                                             Address (), 
                                             fromMihfId,
@@ -573,13 +1173,14 @@ namespace ns3 {
                       NS_ASSERT (session->IsRegistered ());
 
                       session->ReceiveCapabilityDiscoverResponse (fromMihfId,
-                                                                  status,
-                                                                  networkTypeAddresses,
-                                                                  events,
-                                                                  commands,
-                                                                  miisQueries,
-                                                                  transportOptions,
-                                                                  mbbSupportList);
+                                                                  payload.GetStatus (),
+                                                                  payload.GetNetworkTypeAddressList (),
+                                                                  payload.GetEventList (),
+                                                                  payload.GetCommandList (),
+                                                                  payload.GetInformationServiceQueryTypeList (),
+                                                                  payload.GetTransportSupportList (),
+                                                                  payload.GetMakeBeforeBreakSupportList (),
+                                                                  mihHeader.GetTransactionId ());
                     }
                   else
                     {
@@ -592,7 +1193,6 @@ namespace ns3 {
             }
           else if (mihHeader.GetServiceId () == MihHeader::EVENT)
             {
-              RemoteEventDestinationTrap remoteEventDestinationTrap;
               session = GetSession (toMihfId, 
                                     Address (), 
                                     fromMihfId,
@@ -601,127 +1201,10 @@ namespace ns3 {
               NS_ASSERT (session != 0);
               NS_ASSERT (session->IsRegistered ());
                       
-              remoteEventDestinationTrap = session->GetRemoteEventDestinationTrap ();
+              RemoteEventDestinationTrap &remoteEventDestinationTrap = session->GetRemoteEventDestinationTrap ();
               
-              switch (mihHeader.GetActionId ())
-                {
-                case MihHeader::MIH_LINK_DETECTED :
-                  {
-                    LinkDetectedInformationList linkDetectedInformationList;
-                    TlvDeserialize (buffer, linkDetectedInformationList);
-                    remoteEventDestinationTrap.LinkDetected (fromMihfId,
-                                                             linkDetectedInformationList);
-                    break;
-                  }
-                case MihHeader::MIH_LINK_UP :
-                  {
-                    LinkIdentifier linkIdentifier; 
-                    Address oldAR;
-                    Address newAR; 
-                    bool ipRenewalFlag; 
-                    MobilityManagementSupport mbbSupport;
-                    linkIdentifier.TlvDeserialize (buffer);
-                    Tlv::Deserialize (buffer, oldAR, TLV_OLD_ACCESS_ROUTER);
-                    Tlv::Deserialize (buffer, newAR, TLV_NEW_ACCESS_ROUTER);
-                    Tlv::DeserializeBool (buffer, ipRenewalFlag, TLV_IP_RENEWAL_FLAG);
-                    mbbSupport.TlvDeserialize (buffer);
-                    remoteEventDestinationTrap.LinkUp (fromMihfId,
-                                                       linkIdentifier,
-                                                       oldAR,
-                                                       newAR,
-                                                       ipRenewalFlag,
-                                                       mbbSupport);
-                    break;
-                  }
-                case MihHeader::MIH_LINK_DOWN :
-                  {
-                    LinkIdentifier linkIdentifier;
-                    Address oldAR;
-                    LinkDownReason reasonCode;
-                    
-                    linkIdentifier.TlvDeserialize (buffer);
-                    Tlv::Deserialize (buffer, oldAR, TLV_OLD_ACCESS_ROUTER);
-                    reasonCode.TlvDeserialize (buffer);
-                    remoteEventDestinationTrap.LinkDown (fromMihfId,
-                                                         linkIdentifier,
-                                                         oldAR,
-                                                         reasonCode);
-                    break;
-                  }
-                case MihHeader::MIH_LINK_PARAMETERS_REPORT :
-                  {
-                    LinkIdentifier linkIdentifier;
-                    LinkParameterReportList parameters;
-                    
-                    linkIdentifier.TlvDeserialize (buffer);
-                    TlvDeserialize (buffer, parameters);
-                    remoteEventDestinationTrap.LinkParametersReport (fromMihfId,
-                                                                     linkIdentifier,
-                                                                     parameters);
-                    break;
-                  }
-                case MihHeader::MIH_LINK_GOING_DOWN :
-                  {
-                    LinkIdentifier linkIdentifier;
-                    uint64_t timeInterval;
-                    LinkGoingDownReason reasonCode;
-                    
-                    linkIdentifier.TlvDeserialize (buffer);
-                    Tlv::DeserializeU64 (buffer, timeInterval, TLV_TIME_INTERVAL);
-                    reasonCode.TlvDeserialize (buffer);
-                    
-                    remoteEventDestinationTrap.LinkGoingDown (fromMihfId,
-                                                              linkIdentifier,
-                                                              timeInterval,
-                                                              reasonCode);
-                    break;
-                  }
-                case MihHeader::MIH_LINK_HANDOVER_IMMINENT :
-                  {
-                    LinkIdentifier oldLinkIdentifier;
-                    LinkIdentifier newLinkIdentifier;
-                    Address oldAR;
-                    Address newAR;
-                    
-                    oldLinkIdentifier.TlvDeserialize (buffer);
-                    newLinkIdentifier.TlvDeserialize (buffer);
-                    Tlv::Deserialize (buffer, oldAR, TLV_OLD_ACCESS_ROUTER);
-                    Tlv::Deserialize (buffer, newAR, TLV_NEW_ACCESS_ROUTER);
-                    
-                    remoteEventDestinationTrap.LinkHandoverImminent (fromMihfId,
-                                                                     oldLinkIdentifier,
-                                                                     newLinkIdentifier,
-                                                                     oldAR,
-                                                                     newAR);
-                    break;
-                  }
-                case MihHeader::MIH_LINK_HANDOVER_COMPLETE :
-                  {
-                    LinkIdentifier oldLinkIdentifier;
-                    LinkIdentifier newLinkIdentifier;
-                    Address oldAR;
-                    Address newAR;
-                    Status handoverStatus;
-                    
-                    oldLinkIdentifier.TlvDeserialize (buffer);
-                    newLinkIdentifier.TlvDeserialize (buffer);
-                    Tlv::Deserialize (buffer, oldAR, TLV_OLD_ACCESS_ROUTER);
-                    Tlv::Deserialize (buffer, newAR, TLV_NEW_ACCESS_ROUTER);
-                    handoverStatus.TlvDeserialize (buffer);
-                    
-                    remoteEventDestinationTrap.LinkHandoverComplete (fromMihfId,
-                                                                     oldLinkIdentifier,
-                                                                     newLinkIdentifier,
-                                                                     oldAR,
-                                                                     newAR,
-                                                                     handoverStatus);
-                    break;
-                  }
-                default:
-                  NS_LOG_DEBUG ("Specified event type is not suported");
-                  NS_ASSERT (0);
-                  break;
-                }
+              remoteEventDestinationTrap.ReceiveIndications (fromMihfId, payload.GetLinkEventIndicationList ());
+              NotifyEventDelay (fromMihfId, packet);
             }
           else if (mihHeader.GetServiceId () == MihHeader::COMMAND)
             {
@@ -729,40 +1212,29 @@ namespace ns3 {
                 {
                 case MihHeader::MIH_LINK_GET_PARAMETERS :
                   if (mihHeader.GetOpCode () == MihHeader::REQUEST) {
-                    DeviceStatesRequest deviceStatesRequest;
-                    LinkIdentifierList linkIdentifierList;
-                    LinkStatusRequest linkStatusRequest;
-                    
-                    deviceStatesRequest.TlvDeserialize (buffer);
-                    TlvDeserialize (buffer, linkIdentifierList);
-                    linkStatusRequest.TlvDeserialize (buffer);
-
                     session = GetSession (toMihfId,
                                           Address (),
                                           fromMihfId, 
                                           from,
                                           socket);
                     NS_ASSERT (session != 0);
-                    NS_ASSERT (session->IsRegistered ());
+                    if (!session->IsRegistered ())
+                      {
+                        session->ReceiveLinkGetParametersRequest (packet, mihHeader.GetTransactionId ())
+                          (toMihfId, Status (Status::REJECTED), DeviceStatesResponseList (), LinkStatusResponseList ());
+                        break;
+                      }
                       
                     // Call local LinkGetParamters;
                     mihFunction->LinkGetParameters (toMihfId,
-                                                    deviceStatesRequest,
-                                                    linkIdentifierList,
-                                                    linkStatusRequest,
+                                                    payload.GetDeviceStatesRequest (),
+                                                    payload.GetLinkIdentifierList (),
+                                                    payload.GetLinkStatusRequest (),
                                                     session->ReceiveLinkGetParametersRequest (packet, 
                                                                                               mihHeader.GetTransactionId ()));
                   }
                   else if (mihHeader.GetOpCode () == MihHeader::RESPONSE)
                     {
-                      Status status;
-                      DeviceStatesResponseList deviceStatesResponseList;
-                      LinkStatusResponseList linkStatusResponseList;
-                      
-                      status.TlvDeserialize (buffer);
-                      TlvDeserialize (buffer, deviceStatesResponseList);
-                      TlvDeserialize (buffer, linkStatusResponseList);
-
                       session = GetSession (toMihfId,
                                             Address (),
                                             fromMihfId, 
@@ -772,9 +1244,10 @@ namespace ns3 {
                       NS_ASSERT (session->IsRegistered ());
                       
                       session->ReceiveLinkGetParametersResponse (fromMihfId,
-                                                                 status,
-                                                                 deviceStatesResponseList,
-                                                                 linkStatusResponseList);
+                                                                 payload.GetStatus (),
+                                                                 payload.GetDeviceStatesResponseList (),
+                                                                 payload.GetLinkStatusResponseList (),
+                                                                 mihHeader.GetTransactionId ());
                     }
                   else
                     {
@@ -784,38 +1257,28 @@ namespace ns3 {
                 case MihHeader::MIH_LINK_CONFIGURE_THRESHOLDS :
                   if (mihHeader.GetOpCode () == MihHeader::REQUEST)
                     {
-                      LinkIdentifier linkIdentifier;
-                      LinkConfigurationParameterList linkConfigurationParameters;
-
-                      linkIdentifier.TlvDeserialize (buffer);
-                      TlvDeserialize (buffer, linkConfigurationParameters);
-                      
-
                       session = GetSession (toMihfId,
                                             Address (),
                                             fromMihfId, 
                                             from,
                                             socket);
                       NS_ASSERT (session != 0);
-                      NS_ASSERT (session->IsRegistered ());
+                      if (!session->IsRegistered ())
+                        {
+                          session->ReceiveLinkConfigureThresholdsRequest (packet, mihHeader.GetTransactionId ())
+                            (toMihfId, Status (Status::REJECTED), payload.GetLinkIdentifier (), LinkConfigurationStatusList ());
+                          break;
+                        }
                       
                       // Call local LinkConfigureThresholds;
                       mihFunction->LinkConfigureThresholds (toMihfId,
-                                                            linkIdentifier,
-                                                            linkConfigurationParameters,
+                                                            payload.GetLinkIdentifier (),
+                                                            payload.GetLinkConfigurationParameterList (),
                                                             session->ReceiveLinkConfigureThresholdsRequest (packet, 
                                                                                                             mihHeader.GetTransactionId ()));
                     }
                   else if (mihHeader.GetOpCode () == MihHeader::RESPONSE)
                     {
-                      Status status;
-                      LinkIdentifier linkIdentifier;
-                      LinkConfigurationStatusList linkConfigurationStatusList;
-                      
-                      status.TlvDeserialize (buffer);
-                      linkIdentifier.TlvDeserialize (buffer);
-                      TlvDeserialize (buffer, linkConfigurationStatusList);
-                      
                       session = GetSession (toMihfId,
                                             Address (),
                                             fromMihfId, 
@@ -825,9 +1288,10 @@ namespace ns3 {
                       NS_ASSERT (session->IsRegistered ());
                       
                       session->ReceiveLinkConfigureThresholdsResponse (fromMihfId,
-                                                                       status,
-                                                                       linkIdentifier,
-                                                                       linkConfigurationStatusList);
+                                                                       payload.GetStatus (),
+                                                                       payload.GetLinkIdentifier (),
+                                                                       payload.GetLinkConfigurationStatusList (),
+                                                                       mihHeader.GetTransactionId ());
                     }
                   else
                     {
@@ -870,7 +1334,46 @@ namespace ns3 {
               switch (mihHeader.GetActionId ())
                 {
                 case MihHeader::MIH_GET_INFORMATION :
-                  NS_ASSERT (0);
+                  if (mihHeader.GetOpCode () == MihHeader::REQUEST)
+                    {
+                      Location location = payload.GetLocation ();
+                      // The information service is open to unregistered
+                      // peers, their session is closed once they could no
+                      // longer retransmit this query unless they register;
+                      session = AcceptSession (toMihfId, fromMihfId, from, socket);
+                      if (!session->IsRegistered ())
+                        {
+                          CancelRegistrationTimer (session);
+                          ArmRegistrationTimer (session, m_transactionMaxRto * (m_transactionRetransmissions + 1));
+                        }
+
+                      // Call local GetInformation;
+                      mihFunction->GetInformation (toMihfId,
+                                                   location.GetPosition (),
+                                                   payload.GetRadius () / 100.0,
+                                                   payload.GetLinkType (),
+                                                   payload.GetMaxResults (),
+                                                   session->ReceiveGetInformationRequest (packet,
+                                                                                          mihHeader.GetTransactionId ()));
+                    }
+                  else if (mihHeader.GetOpCode () == MihHeader::RESPONSE)
+                    {
+                      session = GetSession (toMihfId,
+                                            Address (),
+                                            fromMihfId,
+                                            from,
+                                            socket);
+                      NS_ASSERT (session != 0);
+
+                      session->ReceiveGetInformationResponse (fromMihfId,
+                                                              payload.GetStatus (),
+                                                              payload.GetPoaDescriptorList (),
+                                                              mihHeader.GetTransactionId ());
+                    }
+                  else
+                    {
+                      NS_ASSERT (0);
+                    }
                   break;
                 default:
                   NS_ASSERT (0);
@@ -880,6 +1383,10 @@ namespace ns3 {
             {
               NS_ASSERT (0);
             }
+          if (mihHeader.GetOpCode () == MihHeader::REQUEST && session != 0)
+            {
+              session->AcknowledgeRequest (mihHeader);
+            }
         }
     }
     void 
@@ -900,14 +1407,23 @@ namespace ns3 {
       Ptr<Packet> packet;
       Ptr<Session> session;
       // TLV-Serialize in buffer;
-      selfMihfid.TlvSerialize (buffer);
-      destinationIdentifier.TlvSerialize (buffer);
-      TlvSerialize (buffer, networkTypeAddresses);
-      events.TlvSerialize (buffer);
-      commands.TlvSerialize (buffer);
-      informationServiceQueryTypes.TlvSerialize (buffer);
-      transportSupports.TlvSerialize (buffer);
-      TlvSerialize (buffer, makeBeforeBreakSupports);
+      buffer.AddAtEnd (selfMihfid.GetTlvSerializedSize () +
+                       destinationIdentifier.GetTlvSerializedSize () +
+                       GetTlvSerializedSize (networkTypeAddresses) +
+                       events.GetTlvSerializedSize () +
+                       commands.GetTlvSerializedSize () +
+                       informationServiceQueryTypes.GetTlvSerializedSize () +
+                       transportSupports.GetTlvSerializedSize () +
+                       GetTlvSerializedSize (makeBeforeBreakSupports));
+      Buffer::Iterator i = buffer.Begin ();
+      selfMihfid.TlvSerialize (i);
+      destinationIdentifier.TlvSerialize (i);
+      TlvSerialize (i, networkTypeAddresses);
+      events.TlvSerialize (i);
+      commands.TlvSerialize (i);
+      informationServiceQueryTypes.TlvSerialize (i);
+      transportSupports.TlvSerialize (i);
+      TlvSerialize (i, makeBeforeBreakSupports);
       // Fill the packet with payload from buffer;
       packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
       session = StartSession (selfMihfid, from, destinationIdentifier, to);
@@ -928,13 +1444,19 @@ namespace ns3 {
       Ptr<Packet> packet;
       Ptr<Session> session;
       // TLV-Serialize in buffer;
-      selfMihfid.TlvSerialize (buffer);
-      destinationIdentifier.TlvSerialize (buffer);
-      TlvSerialize (buffer, linkIdentifierList);
-      registrationCode.TlvSerialize (buffer);
+      buffer.AddAtEnd (selfMihfid.GetTlvSerializedSize () +
+                       destinationIdentifier.GetTlvSerializedSize () +
+                       GetTlvSerializedSize (linkIdentifierList) +
+                       registrationCode.GetTlvSerializedSize ());
+      Buffer::Iterator i = buffer.Begin ();
+      selfMihfid.TlvSerialize (i);
+      destinationIdentifier.TlvSerialize (i);
+      TlvSerialize (i, linkIdentifierList);
+      registrationCode.TlvSerialize (i);
       // Fill the packet with payload from buffer;
       packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
       session = StartSession (selfMihfid, from, destinationIdentifier, to);
+      session->SetRegistrationLinks (linkIdentifierList);
       session->SendRegisterRequest (packet,
                                     registerConfirmCallback);
     }
@@ -943,7 +1465,26 @@ namespace ns3 {
                                         MihDeRegisterConfirmCallback deRegisterConfirmCallback)
     {
       NS_LOG_FUNCTION (this);
-      NS_ASSERT (0);
+      MihfId selfMihfid = GetObject<MihFunction> ()->GetMihfId ();
+      Buffer buffer;
+      Ptr<Packet> packet;
+      Ptr<Session> session = FindSessionByMihfId (destinationIdentifier);
+      if (session == 0 || !session->IsRegistered ())
+        {
+          NS_LOG_DEBUG ("Not registered with " << destinationIdentifier);
+          deRegisterConfirmCallback (destinationIdentifier, Status (Status::REJECTED));
+          return;
+        }
+      // TLV-Serialize in buffer;
+      buffer.AddAtEnd (selfMihfid.GetTlvSerializedSize () +
+                       destinationIdentifier.GetTlvSerializedSize ());
+      Buffer::Iterator i = buffer.Begin ();
+      selfMihfid.TlvSerialize (i);
+      destinationIdentifier.TlvSerialize (i);
+      // Fill the packet with payload from buffer;
+      packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
+      session->SendDeRegisterRequest (packet,
+                                      deRegisterConfirmCallback);
     }
     void
     MihProtocol::SendEventSubscribeRequest (MihfId destinationIdentifier,
@@ -988,11 +1529,16 @@ namespace ns3 {
       events.SetEventList (events.GetEventList () | linkHOCompleteEventType7);
       events.SetEventList (events.GetEventList () | linkPduTxStatusEventType8);
       // TLV-Serialize in buffer;
-      selfMihfid.TlvSerialize (buffer);
-      destinationIdentifier.TlvSerialize (buffer);
-      linkIdentifier.TlvSerialize (buffer);
+      buffer.AddAtEnd (selfMihfid.GetTlvSerializedSize () +
+                       destinationIdentifier.GetTlvSerializedSize () +
+                       linkIdentifier.GetTlvSerializedSize () +
+                       events.GetTlvSerializedSize ());
+      Buffer::Iterator i = buffer.Begin ();
+      selfMihfid.TlvSerialize (i);
+      destinationIdentifier.TlvSerialize (i);
+      linkIdentifier.TlvSerialize (i);
       // Extra configuration information is not supported yet!
-      events.TlvSerialize (buffer);
+      events.TlvSerialize (i);
       // Fill the packet with payload from buffer;
       packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
       NS_LOG_LOGIC ("Packet Size = " << buffer.GetSize ());
@@ -1024,11 +1570,17 @@ namespace ns3 {
       Ptr<Packet> packet;
       Ptr<Session> session;
       // TLV-Serialize in buffer;
-      selfMihfid.TlvSerialize (buffer);
-      destinationIdentifier.TlvSerialize (buffer);
-      deviceStatesRequest.TlvSerialize (buffer);
-      TlvSerialize (buffer, linkIdentifierList);
-      linkStatusRequest.TlvSerialize (buffer);
+      buffer.AddAtEnd (selfMihfid.GetTlvSerializedSize () +
+                       destinationIdentifier.GetTlvSerializedSize () +
+                       deviceStatesRequest.GetTlvSerializedSize () +
+                       GetTlvSerializedSize (linkIdentifierList) +
+                       linkStatusRequest.GetTlvSerializedSize ());
+      Buffer::Iterator i = buffer.Begin ();
+      selfMihfid.TlvSerialize (i);
+      destinationIdentifier.TlvSerialize (i);
+      deviceStatesRequest.TlvSerialize (i);
+      TlvSerialize (i, linkIdentifierList);
+      linkStatusRequest.TlvSerialize (i);
       // Fill the packet with payload from buffer;
       packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
       session = StartSession (selfMihfid, from, destinationIdentifier, to);
@@ -1049,15 +1601,58 @@ namespace ns3 {
       Ptr<Packet> packet;
       Ptr<Session> session;
       // TLV-Serialize in buffer;
-      selfMihfid.TlvSerialize (buffer);
-      destinationIdentifier.TlvSerialize (buffer);
-      linkIdentifier.TlvSerialize (buffer);
-      TlvSerialize (buffer, linkConfigurationParameters);
+      buffer.AddAtEnd (selfMihfid.GetTlvSerializedSize () +
+                       destinationIdentifier.GetTlvSerializedSize () +
+                       linkIdentifier.GetTlvSerializedSize () +
+                       GetTlvSerializedSize (linkConfigurationParameters));
+      Buffer::Iterator i = buffer.Begin ();
+      selfMihfid.TlvSerialize (i);
+      destinationIdentifier.TlvSerialize (i);
+      linkIdentifier.TlvSerialize (i);
+      TlvSerialize (i, linkConfigurationParameters);
       // Fill the packet with payload from buffer;
       packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
       session = StartSession (selfMihfid, from, destinationIdentifier, to);
       session->SendLinkConfigureThresholdsRequest (packet,
                                                    configureThresholdsConfiirmCallback);
     }
+    void
+    MihProtocol::SendGetInformationRequest (MihfId destinationIdentifier,
+                                            Vector position,
+                                            double radius,
+                                            LinkType linkType,
+                                            uint32_t maxResults,
+                                            MihGetInformationConfirmCallback getInformationConfirmCallback)
+    {
+      NS_LOG_FUNCTION (this);
+      MihfId selfMihfid = GetObject<MihFunction> ()->GetMihfId ();
+      Buffer buffer;
+      Address to = ResolveMihfIdToAddress (destinationIdentifier);
+      Address from = ResolveMihfIdToAddress (selfMihfid);
+      Ptr<Packet> packet;
+      Ptr<Session> session;
+      Location location (position);
+      // Radius on the wire in centimeters;
+      uint32_t radiusCm = static_cast<uint32_t> (radius * 100 + 0.5);
+      // TLV-Serialize in buffer;
+      buffer.AddAtEnd (selfMihfid.GetTlvSerializedSize () +
+                       destinationIdentifier.GetTlvSerializedSize () +
+                       linkType.GetTlvSerializedSize () +
+                       location.GetTlvSerializedSize () +
+                       Tlv::GetSerializedSizeU32 () +
+                       Tlv::GetSerializedSizeU32 ());
+      Buffer::Iterator i = buffer.Begin ();
+      selfMihfid.TlvSerialize (i);
+      destinationIdentifier.TlvSerialize (i);
+      linkType.TlvSerialize (i);
+      location.TlvSerialize (i);
+      Tlv::SerializeU32 (i, radiusCm, TLV_QUERY_RADIUS);
+      Tlv::SerializeU32 (i, maxResults, TLV_QUERY_MAX_RESULTS);
+      // Fill the packet with payload from buffer;
+      packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
+      session = StartSession (selfMihfid, from, destinationIdentifier, to);
+      session->SendGetInformationRequest (packet,
+                                          getInformationConfirmCallback);
+    }
   } // namespace mih
 } // namespace ns3
@@ -22,8 +22,16 @@
 #define   	MIH_PROTOCOL_H
 
 #include <map>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
 #include "ns3/object.h"
 #include "ns3/address.h"
+#include "ns3/traced-value.h"
+#include "ns3/traced-callback.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/vector.h"
 #include "mihf-id.h"
 #include "mih-network-type-address.h"
 #include "mih-event-list.h"
@@ -38,9 +46,39 @@
 namespace ns3 {
   class Node;
   namespace mih {
+    // Hash functors for the session indexes;
+    struct MihfIdHash {
+      std::size_t operator () (const MihfId &mihfId) const;
+    };
+    struct AddressHash {
+      std::size_t operator () (const Address &address) const;
+    };
+    struct PtrHash {
+      template <typename T>
+      std::size_t operator () (const Ptr<T> &p) const
+      {
+        return std::hash<T *> () (PeekPointer (p));
+      }
+    };
     class MihProtocol : public Object {
     public:
       static TypeId GetTypeId (void);
+      // Signatures of the TransactionRetransmit and TransactionTimeout
+      // trace sources;
+      typedef void (* TransactionRetransmitCallback) (MihfId peer, uint16_t transactionId,
+                                                      uint32_t transmissions);
+      typedef void (* TransactionTimeoutCallback) (MihfId peer, uint16_t transactionId);
+      // Signatures of the PduTx and PduRx, TransactionLatency,
+      // PendingRequestQueueDepth and EventDelay trace sources;
+      typedef void (* PduCallback) (MihfId peer, MihHeader::ServiceIdE serviceId,
+                                    MihHeader::OpCodeE opCode, MihHeader::ActionIdE actionId,
+                                    uint32_t size);
+      typedef void (* TransactionLatencyCallback) (MihfId peer, uint16_t transactionId,
+                                                   Time latency);
+      typedef void (* QueueDepthCallback) (MihfId peer, uint32_t depth);
+      typedef void (* EventDelayCallback) (MihfId source, Time delay);
+      // Signature of the RegistrationExpired trace source;
+      typedef void (* RegistrationExpiredCallback) (MihfId peer);
       MihProtocol (void);
       virtual ~MihProtocol (void);
       void Init (void);
@@ -90,6 +128,13 @@ namespace ns3 {
                                                LinkIdentifier linkIdentifier,
                                                LinkConfigurationParameterList linkConfigurationParameters,
                                                MihLinkConfigureThresholdsConfirmCallback configureThresholdsConfiirmCallback);
+      void SendGetInformationRequest (MihfId destinationIdentifier,
+                                      Vector position,
+                                      double radius,
+                                      LinkType linkType,
+                                      uint32_t maxResults,
+                                      MihGetInformationConfirmCallback getInformationConfirmCallback);
+      uint32_t GetSessionCount (void) const;
     protected:
       virtual void DoDispose (void);
     protected:
@@ -102,21 +147,96 @@ namespace ns3 {
                                  Address from, 
                                  MihfId toMihfId, 
                                  Address to);
-      bool FindSessionByMihfId (MihfId toMihfId, SessionListI &iter);
-      bool FindSessionByToAddress (Address to, SessionListI &iter);
-      bool FindSessionBySocket (Ptr<Socket> s, SessionListI &i);
+      Ptr<Session> FindSessionByMihfId (MihfId toMihfId);
+      Ptr<Session> FindSessionByToAddress (Address to);
+      Ptr<Session> FindSessionBySocket (Ptr<Socket> s);
+      // Session of a peer which sent us a request first;
+      Ptr<Session> AcceptSession (MihfId fromMihfId,
+                                  MihfId toMihfId,
+                                  Address to,
+                                  Ptr<Socket> socket);
+      void AddSession (Ptr<Session> session);
+      void ConfigureSession (Ptr<Session> session);
+      void NotifyTransactionRetransmit (MihfId peer, uint16_t transactionId, uint32_t transmissions);
+      void NotifyTransactionTimeout (MihfId peer, uint16_t transactionId);
+      void NotifyPduSent (MihfId peer, Ptr<const Packet> packet);
+      void NotifyPduReceived (MihfId peer, MihHeader &header, uint32_t size);
+      void NotifyTransactionLatency (MihfId peer, uint16_t transactionId, Time latency);
+      void NotifyQueueDepth (MihfId peer, uint32_t depth);
+      void NotifyEventDelay (MihfId source, Ptr<const Packet> packet);
+      void IndexSession (Ptr<Session> session);
+      void RemoveSession (Ptr<Session> session);
+      void HandleSessionClose (Ptr<Socket> socket);
+      void HandleSend (Ptr<Socket> socket, uint32_t available);
+      // Drops a session with everything it holds: its link event
+      // subscriptions, transactions, registration timer and socket;
+      void CloseSession (Ptr<Session> session);
+      void UnsubscribeRemoteEvents (Ptr<Session> session);
+      // Registration lifetimes, kept on a single hashed timer wheel
+      // which only ticks while some timer is armed;
+      void NotifyRegistered (Ptr<Session> session, uint32_t validLifeTime);
+      void NotifyDeRegistered (Ptr<Session> session);
+      uint64_t GetRegistrationTick (Time time) const;
+      void ArmRegistrationTimer (Ptr<Session> session, Time delay);
+      void CancelRegistrationTimer (Ptr<Session> session);
+      void RegistrationTimerTick (void);
+      void RegistrationTimerExpired (Ptr<Session> session);
+      void RegistrationRefreshConfirm (MihfId mihfId, Status status, uint32_t validLifeTime);
+      uint16_t GetSessionWindowSize (void) const;
       Address ResolveMihfIdToAddress (MihfId mihfid);
+      typedef std::list<std::pair<Ptr<Packet>, Address> > PduList;
+      typedef PduList::iterator PduListI;
+      void ReadPdus (Ptr<Socket> socket, PduList &pdus);
       void HandleRead (Ptr<Socket> socket);
       void ReceiveNewSessionRequest (Ptr<Socket> s, const Address& from);
     private:
-      typedef std::map<MihfId, Address> MihfIdAddressTable;
+      typedef std::unordered_map<MihfId, Address, MihfIdHash> MihfIdAddressTable;
       typedef MihfIdAddressTable::iterator MihfIdAddressTableI;
       MihfIdAddressTable m_mihfIdTable;
       Ptr<Socket> m_serverSocket;
       Ptr<Node> m_node;
       Address m_local;
-      SessionList m_sessions;
+      typedef std::unordered_set<Ptr<Session>, PtrHash> SessionSet;
+      typedef std::unordered_map<MihfId, Ptr<Session>, MihfIdHash> MihfIdSessionIndex;
+      typedef std::unordered_map<Address, Ptr<Session>, AddressHash> AddressSessionIndex;
+      typedef std::unordered_map<Ptr<Socket>, Ptr<Session>, PtrHash> SocketSessionIndex;
+      SessionSet m_sessions;
+      MihfIdSessionIndex m_sessionsByMihfId;
+      AddressSessionIndex m_sessionsByAddress;
+      SocketSessionIndex m_sessionsBySocket;
+      // Bytes of a partly received PDU, per stream socket;
+      std::unordered_map<Ptr<Socket>, Ptr<Packet>, PtrHash> m_streamBuffers;
+      TracedValue<uint32_t> m_sessionCount;
       TypeId m_tid; // Protocol TypeId
+      uint16_t m_sessionWindowSize;
+      Time m_eventAggregationWindow;
+      uint32_t m_eventAggregationMaxCount;
+      uint32_t m_transactionRetransmissions;
+      Time m_transactionInitialRto;
+      Time m_transactionMinRto;
+      Time m_transactionMaxRto;
+      bool m_ackRequested;
+      bool m_messageArena;
+      bool m_eventTimestamps;
+      Time m_registrationTimerResolution;
+      bool m_registrationRefresh;
+      struct RegistrationTimer {
+        Ptr<Session> session;
+        uint64_t tick;
+      };
+      typedef std::vector<RegistrationTimer> RegistrationTimerSlot;
+      std::vector<RegistrationTimerSlot> m_registrationWheel;
+      uint64_t m_registrationTick; // Last tick processed;
+      uint32_t m_registrationTimerCount;
+      EventId m_registrationTickEvent;
+      TracedCallback<MihfId, uint16_t, uint32_t> m_transactionRetransmitTrace;
+      TracedCallback<MihfId, uint16_t> m_transactionTimeoutTrace;
+      TracedCallback<MihfId, MihHeader::ServiceIdE, MihHeader::OpCodeE, MihHeader::ActionIdE, uint32_t> m_pduTxTrace;
+      TracedCallback<MihfId, MihHeader::ServiceIdE, MihHeader::OpCodeE, MihHeader::ActionIdE, uint32_t> m_pduRxTrace;
+      TracedCallback<MihfId, uint16_t, Time> m_transactionLatencyTrace;
+      TracedCallback<MihfId, uint32_t> m_queueDepthTrace;
+      TracedCallback<MihfId, Time> m_eventDelayTrace;
+      TracedCallback<MihfId> m_registrationExpiredTrace;
     };
   } // namespace mih
 } // namespace ns3
@@ -23,13 +23,11 @@
 namespace ns3 {
   namespace mih {
     QoSParameterValue::QoSParameterValue (void)
-    {
-      SimulationSingleton<TlvObjectFactory<ParameterValue> >::Get ()->AddTlvTypeConstructor (TLV_QOS_PARAMETER_VALUE,
-                                                                                             MakeCallback (&QoSParameterValue::Create));
-    }
+    {}
     QoSParameterValue::~QoSParameterValue (void)
     {}
     CHOICE_HELPER_IMPLEM (QoSParameterValue, ParameterValue)
+    TLV_OBJECT_FACTORY_REGISTER (QoSParameterValue, ParameterValue, TLV_QOS_PARAMETER_VALUE)
     uint32_t 
     QoSParameterValue::GetTlvSerializedSize (void) const
     {
@@ -42,12 +40,12 @@ namespace ns3 {
       NS_ASSERT (0);      
     }
     void
-    QoSParameterValue::TlvSerialize (Buffer &buffer) const
+    QoSParameterValue::TlvSerialize (Buffer::Iterator &i) const
     {
       NS_ASSERT (0);
     }
     uint32_t 
-    QoSParameterValue::TlvDeserialize (Buffer &buffer)
+    QoSParameterValue::TlvDeserialize (Buffer::Iterator &i)
     {
       NS_ASSERT (0);
       return 0;
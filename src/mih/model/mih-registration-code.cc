@@ -48,16 +48,16 @@ namespace ns3 {
       os << "Register Code = " << std::dec << static_cast<int> (m_code);
     }
     void
-    RegistrationCode::TlvSerialize (Buffer &buffer) const
+    RegistrationCode::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU8 (buffer, static_cast<uint8_t> (m_code), TLV_REGISTRATION_CODE);
+      Tlv::SerializeU8 (i, static_cast<uint8_t> (m_code), TLV_REGISTRATION_CODE);
     }
     uint32_t 
-    RegistrationCode::TlvDeserialize (Buffer &buffer)
+    RegistrationCode::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t bytesRead = 0;
       uint8_t code = 0;
-      bytesRead += Tlv::DeserializeU8 (buffer, code, TLV_REGISTRATION_CODE);
+      bytesRead += Tlv::DeserializeU8 (i, code, TLV_REGISTRATION_CODE);
       m_code = static_cast<enum RegistrationCode::Type> (code);
       return bytesRead;
     }
@@ -36,8 +36,10 @@ namespace ns3 {
       enum Type GetCode (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       RegistrationCode& operator = (RegistrationCode const &a);
       TLV_TYPE_HELPER_HEADER (RegistrationCode);
     protected:
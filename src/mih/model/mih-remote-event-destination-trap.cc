@@ -18,8 +18,12 @@
  * Author: Providence SALUMU M. <Providence.Salumu_Munga@it-sudparis.eu>
  */
 
+#include "ns3/log.h"
+#include "ns3/assert.h"
 #include "mih-remote-event-destination-trap.h"
 
+NS_LOG_COMPONENT_DEFINE ("RemoteEventDestinationTrap");
+
 namespace ns3 {
   namespace mih {
     RemoteEventDestinationTrap::RemoteEventDestinationTrap (void)
@@ -140,6 +144,66 @@ namespace ns3 {
     }
     // Callback accessors;
     void
+    RemoteEventDestinationTrap::ReceiveIndications (MihfId mihfId,
+                                                    LinkEventIndicationList const &indications)
+    {
+      NS_LOG_FUNCTION (this << indications.size ());
+      for (LinkEventIndicationList::const_iterator i = indications.begin (); i != indications.end (); i++)
+        {
+          switch (i->m_actionId)
+            {
+            case MihHeader::MIH_LINK_DETECTED :
+              LinkDetected (mihfId,
+                            i->m_linkDetectedInformationList);
+              break;
+            case MihHeader::MIH_LINK_UP :
+              LinkUp (mihfId,
+                      i->m_linkIdentifier,
+                      i->m_oldAR,
+                      i->m_newAR,
+                      i->m_ipRenewalFlag,
+                      i->m_mobilitySupport);
+              break;
+            case MihHeader::MIH_LINK_DOWN :
+              LinkDown (mihfId,
+                        i->m_linkIdentifier,
+                        i->m_oldAR,
+                        i->m_linkDownReason);
+              break;
+            case MihHeader::MIH_LINK_PARAMETERS_REPORT :
+              LinkParametersReport (mihfId,
+                                    i->m_linkIdentifier,
+                                    i->m_parameters);
+              break;
+            case MihHeader::MIH_LINK_GOING_DOWN :
+              LinkGoingDown (mihfId,
+                             i->m_linkIdentifier,
+                             i->m_timeInterval,
+                             i->m_linkGoingDownReason);
+              break;
+            case MihHeader::MIH_LINK_HANDOVER_IMMINENT :
+              LinkHandoverImminent (mihfId,
+                                    i->m_linkIdentifier,
+                                    i->m_newLinkIdentifier,
+                                    i->m_oldAR,
+                                    i->m_newAR);
+              break;
+            case MihHeader::MIH_LINK_HANDOVER_COMPLETE :
+              LinkHandoverComplete (mihfId,
+                                    i->m_linkIdentifier,
+                                    i->m_newLinkIdentifier,
+                                    i->m_oldAR,
+                                    i->m_newAR,
+                                    i->m_handoverStatus);
+              break;
+            default:
+              NS_LOG_DEBUG ("Specified event type is not suported");
+              NS_ASSERT (0);
+              break;
+            }
+        }
+    }
+    void
     RemoteEventDestinationTrap::LinkDetected (MihfId mihfId,
 					      LinkDetectedInformationList linkDetectedInfoList)
     {
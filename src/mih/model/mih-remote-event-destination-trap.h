@@ -23,6 +23,7 @@
 
 #include "ns3/ref-count-base.h"
 #include "mih-callbacks.h"
+#include "mih-payload.h"
 
 namespace ns3 {
   namespace mih {
@@ -46,6 +47,10 @@ namespace ns3 {
       void RemoveLinkHandoverCompleteCallback (MihLinkHandoverCompleteIndicationCallback linkHOCompleteCb);
       void AddLinkPduTxStatusCallback (MihLinkPduTransmitStatusIndicationCallback linkPduTxStatusCb);
       void RemoveLinkPduTxStatusCallback (MihLinkPduTransmitStatusIndicationCallback linkPduTxStatusCb);
+      // Fire the callbacks matching each of the decoded indications,
+      // in their original order;
+      void ReceiveIndications (MihfId mihfId,
+                               LinkEventIndicationList const &indications);
       // Callback accessors;
       void LinkDetected (MihfId mihfId, 
 			 LinkDetectedInformationList linkDetectedInfoList);
@@ -18,7 +18,9 @@
  * Author: Providence SALUMU M. <Providence.Salumu_Munga@it-sudparis.eu>
  */
 
+#include <algorithm>
 #include "ns3/log.h"
+#include "ns3/simulator.h"
 #include "mih-session.h"
 #include "mih-header.h"
 #include "mih-remote-event-source-trap.h"
@@ -27,50 +29,198 @@ NS_LOG_COMPONENT_DEFINE ("RemoteEventSourceTrap");
 
 namespace ns3 {
   namespace mih {
-    RemoteEventSourceTrap::RemoteEventSourceTrap (void)
+    RemoteEventSourceTrap::RemoteEventSourceTrap (void) :
+      m_aggregationWindow (Seconds (0)),
+      m_aggregationMaxCount (1),
+      m_batchCount (0),
+      m_batchSize (0),
+      m_actionId (MihHeader::MIH_LINK_EVENT_BATCH),
+      m_inBatch (false),
+      m_timestamps (false)
     {
       NS_LOG_FUNCTION (this);
     }
     RemoteEventSourceTrap::~RemoteEventSourceTrap (void)
     {
       NS_LOG_FUNCTION (this);
+      Simulator::Cancel (m_batchTimer);
       m_session = 0;
     }
     void 
     RemoteEventSourceTrap::SetSession (Ptr<Session> session)
     {
       NS_LOG_FUNCTION (this << session);
+      if (session == 0)
+        {
+          // The session was closed, its pending indications go nowhere;
+          Simulator::Cancel (m_batchTimer);
+          m_batch = Buffer ();
+          m_batchTimestamps = EventTimestampTag ();
+          m_batchCount = 0;
+          m_batchSize = 0;
+        }
       m_session = session;
     }
-    // Callback accessors;
-    void 
-    RemoteEventSourceTrap::LinkDetected (MihfId mihfId, 
-					 LinkDetectedInformationList linkDetectedInformationList)
+    void
+    RemoteEventSourceTrap::SetAggregation (Time window, uint32_t maxCount)
+    {
+      NS_LOG_FUNCTION (this << window << maxCount);
+      NS_ASSERT (maxCount > 0);
+      Flush ();
+      m_aggregationWindow = window;
+      m_aggregationMaxCount = maxCount;
+    }
+    void
+    RemoteEventSourceTrap::SetTimestamps (bool timestamps)
+    {
+      NS_LOG_FUNCTION (this << timestamps);
+      m_timestamps = timestamps;
+    }
+    void
+    RemoteEventSourceTrap::Flush (void)
+    {
+      NS_LOG_FUNCTION (this << m_batchCount);
+      Simulator::Cancel (m_batchTimer);
+      if (m_batchCount == 0)
+        {
+          return;
+        }
+      m_batch.RemoveAtEnd (m_batch.GetSize () - m_batchSize);
+      SendPdu (m_batch, MihHeader::MIH_LINK_EVENT_BATCH, m_batchTimestamps);
+      m_batch = Buffer ();
+      m_batchTimestamps = EventTimestampTag ();
+      m_batchCount = 0;
+      m_batchSize = 0;
+    }
+    Buffer::Iterator
+    RemoteEventSourceTrap::BeginIndication (enum MihHeader::ActionIdE actionId,
+                                            uint32_t bodySize,
+                                            bool batchable)
+    {
+      NS_LOG_FUNCTION (this << actionId << bodySize << batchable);
+      if (m_session == 0)
+        {
+          // No session to send it on, the indication is written to a
+          // scratch buffer EndIndication drops;
+          m_single = Buffer ();
+          m_single.AddAtEnd (bodySize);
+          m_inBatch = false;
+          return m_single.Begin ();
+        }
+      MihfId from = m_session->GetFromMihfId ();
+      MihfId to = m_session->GetToMihfId ();
+      uint32_t headerSize = from.GetTlvSerializedSize () + to.GetTlvSerializedSize ();
+      if (batchable && !m_aggregationWindow.IsZero ())
+        {
+          uint32_t entrySize = Tlv::GetSerializedSizeU8 () + bodySize;
+          if (m_batchCount > 0 &&
+              m_batchSize + entrySize > 0xffff)
+            {
+              // Would overflow the payload length field;
+              Flush ();
+            }
+          if (m_batchCount == 0)
+            {
+              m_batch = Buffer ();
+              m_batch.AddAtEnd (headerSize);
+              m_batchSize = headerSize;
+              Buffer::Iterator i = m_batch.Begin ();
+              from.TlvSerialize (i);
+              to.TlvSerialize (i);
+              m_batchTimer = Simulator::Schedule (m_aggregationWindow,
+                                                  &RemoteEventSourceTrap::Flush, this);
+            }
+          // The buffer grows by doubling, up to the payload length
+          // limit, and is trimmed to m_batchSize by Flush;
+          if (m_batchSize + entrySize > m_batch.GetSize ())
+            {
+              uint32_t size = std::max (m_batchSize + entrySize, 2 * m_batch.GetSize ());
+              m_batch.AddAtEnd (std::min<uint32_t> (size, 0xffff) - m_batch.GetSize ());
+            }
+          Buffer::Iterator i = m_batch.Begin ();
+          i.Next (m_batchSize);
+          m_batchSize += entrySize;
+          Tlv::SerializeU8 (i, actionId, TLV_EVENT_BATCH_ENTRY);
+          if (m_timestamps)
+            {
+              m_batchTimestamps.AddTimestamp (Simulator::Now ());
+            }
+          m_inBatch = true;
+          return i;
+        }
+      // Keep indications in the order they were raised;
+      Flush ();
+      m_single = Buffer ();
+      m_single.AddAtEnd (headerSize + bodySize);
+      Buffer::Iterator i = m_single.Begin ();
+      from.TlvSerialize (i);
+      to.TlvSerialize (i);
+      m_actionId = actionId;
+      m_inBatch = false;
+      m_singleTimestamps = EventTimestampTag ();
+      if (m_timestamps)
+        {
+          m_singleTimestamps.AddTimestamp (Simulator::Now ());
+        }
+      return i;
+    }
+    void
+    RemoteEventSourceTrap::EndIndication (void)
     {
       NS_LOG_FUNCTION (this);
-      Buffer buffer;
-      Ptr<Packet> packet;
-      // Fill the buffer;
-      NS_ASSERT (mihfId == m_session->GetFromMihfId ());
-      mihfId.TlvSerialize (buffer);
-      m_session->GetToMihfId ().TlvSerialize (buffer);
-      TlvSerialize (buffer, linkDetectedInformationList);
+      if (!m_inBatch)
+        {
+          if (m_session != 0)
+            {
+              SendPdu (m_single, m_actionId, m_singleTimestamps);
+            }
+          m_single = Buffer ();
+          return;
+        }
+      m_batchCount++;
+      if (m_batchCount >= m_aggregationMaxCount)
+        {
+          Flush ();
+        }
+    }
+    void
+    RemoteEventSourceTrap::SendPdu (Buffer &buffer, enum MihHeader::ActionIdE actionId,
+                                    EventTimestampTag const &timestamps)
+    {
+      NS_LOG_FUNCTION (this << actionId << buffer.GetSize ());
+      NS_ASSERT (buffer.GetSize () <= 0xffff);
       // Fill in packet to send;
-      packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
+      Ptr<Packet> packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
       // Add Mih Header;
       MihHeader mihHeader;
-      uint16_t transactionId = m_session->m_nextTransactionId;
-      m_session->m_nextTransactionId++;
       mihHeader.SetVersion (MihHeader::VERSION_ONE);
       mihHeader.SetServiceId (MihHeader::EVENT);
       mihHeader.SetOpCode (MihHeader::INDICATION);
-      mihHeader.SetActionId (MihHeader::MIH_LINK_DETECTED);
-      mihHeader.SetTransactionId (transactionId);
+      mihHeader.SetActionId (actionId);
+      mihHeader.SetTransactionId (m_session->AllocateTransactionId ());
       mihHeader.SetPayloadLength (packet->GetSize ());
       packet->AddHeader (mihHeader);
+      if (timestamps.GetNTimestamps () > 0)
+        {
+          packet->AddByteTag (timestamps);
+        }
       // Send packet;
       m_session->SendEvent (packet);
     }
+    // Callback accessors;
+    void 
+    RemoteEventSourceTrap::LinkDetected (MihfId mihfId, 
+					 LinkDetectedInformationList linkDetectedInformationList)
+    {
+      NS_LOG_FUNCTION (this);
+      NS_ASSERT (m_session == 0 || mihfId == m_session->GetFromMihfId ());
+      // Fill the buffer;
+      Buffer::Iterator i = BeginIndication (MihHeader::MIH_LINK_DETECTED,
+                                            GetTlvSerializedSize (linkDetectedInformationList),
+                                            true);
+      TlvSerialize (i, linkDetectedInformationList);
+      EndIndication ();
+    }
     void 
     RemoteEventSourceTrap::LinkUp (MihfId mihfId,
 				   LinkIdentifier linkIdentifier, 
@@ -80,32 +230,21 @@ namespace ns3 {
 				   MobilityManagementSupport mbbSupport)
     {
       NS_LOG_FUNCTION (this);
-      Buffer buffer;
-      Ptr<Packet> packet;
+      NS_ASSERT (m_session == 0 || mihfId == m_session->GetFromMihfId ());
       // Fill the buffer;
-      NS_ASSERT (mihfId == m_session->GetFromMihfId ());
-      mihfId.TlvSerialize (buffer);
-      m_session->GetToMihfId ().TlvSerialize (buffer);
-      linkIdentifier.TlvSerialize (buffer);
-      Tlv::Serialize (buffer, oldAR, TLV_OLD_ACCESS_ROUTER);
-      Tlv::Serialize (buffer, newAR, TLV_NEW_ACCESS_ROUTER);
-      Tlv::SerializeBool (buffer, ipRenewalFlag, TLV_IP_RENEWAL_FLAG);
-      mbbSupport.TlvSerialize (buffer);
-      // Fill in packet to send;
-      packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
-      // Add Mih Header;
-      MihHeader mihHeader;
-      uint16_t transactionId = m_session->m_nextTransactionId;
-      m_session->m_nextTransactionId++;
-      mihHeader.SetVersion (MihHeader::VERSION_ONE);
-      mihHeader.SetServiceId (MihHeader::EVENT);
-      mihHeader.SetOpCode (MihHeader::INDICATION);
-      mihHeader.SetActionId (MihHeader::MIH_LINK_UP);
-      mihHeader.SetTransactionId (transactionId);
-      mihHeader.SetPayloadLength (packet->GetSize ());
-      packet->AddHeader (mihHeader);
-      // Send packet;
-      m_session->SendEvent (packet);
+      Buffer::Iterator i = BeginIndication (MihHeader::MIH_LINK_UP,
+                                            linkIdentifier.GetTlvSerializedSize () +
+                                            Tlv::GetSerializedSize (oldAR) +
+                                            Tlv::GetSerializedSize (newAR) +
+                                            Tlv::GetSerializedSizeBool () +
+                                            mbbSupport.GetTlvSerializedSize (),
+                                            true);
+      linkIdentifier.TlvSerialize (i);
+      Tlv::Serialize (i, oldAR, TLV_OLD_ACCESS_ROUTER);
+      Tlv::Serialize (i, newAR, TLV_NEW_ACCESS_ROUTER);
+      Tlv::SerializeBool (i, ipRenewalFlag, TLV_IP_RENEWAL_FLAG);
+      mbbSupport.TlvSerialize (i);
+      EndIndication ();
     }
     void
     RemoteEventSourceTrap::LinkDown (MihfId mihfId, 
@@ -114,31 +253,17 @@ namespace ns3 {
                                      LinkDownReason reasonCode)
     {
       NS_LOG_FUNCTION (this);
-      Buffer buffer;
-      Ptr<Packet> packet;
+      NS_ASSERT (m_session == 0 || mihfId == m_session->GetFromMihfId ());
       // Fill the buffer;
-      NS_ASSERT (mihfId == m_session->GetFromMihfId ());
-      mihfId.TlvSerialize (buffer);
-      m_session->GetToMihfId ().TlvSerialize (buffer);
-      linkIdentifier.TlvSerialize (buffer);
-      Tlv::Serialize (buffer, oldAR, TLV_OLD_ACCESS_ROUTER);
-      reasonCode.TlvSerialize (buffer);
-      // Fill in packet to send;
-      packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
-      // Add Mih Header;
-      MihHeader mihHeader;
-      uint16_t transactionId = m_session->m_nextTransactionId;
-      m_session->m_nextTransactionId++;
-      mihHeader.SetVersion (MihHeader::VERSION_ONE);
-      mihHeader.SetServiceId (MihHeader::EVENT);
-      mihHeader.SetOpCode (MihHeader::INDICATION);
-      mihHeader.SetActionId (MihHeader::MIH_LINK_DOWN);
-      mihHeader.SetTransactionId (transactionId);
-      mihHeader.SetPayloadLength (packet->GetSize ());
-      packet->AddHeader (mihHeader);
-      // Send packet;
-      m_session->SendEvent (packet);
-      
+      Buffer::Iterator i = BeginIndication (MihHeader::MIH_LINK_DOWN,
+                                            linkIdentifier.GetTlvSerializedSize () +
+                                            Tlv::GetSerializedSize (oldAR) +
+                                            reasonCode.GetTlvSerializedSize (),
+                                            true);
+      linkIdentifier.TlvSerialize (i);
+      Tlv::Serialize (i, oldAR, TLV_OLD_ACCESS_ROUTER);
+      reasonCode.TlvSerialize (i);
+      EndIndication ();
     }
     void
     RemoteEventSourceTrap::LinkParametersReport (MihfId mihfId, 
@@ -146,30 +271,15 @@ namespace ns3 {
                                                  LinkParameterReportList parameters)
     {
       NS_LOG_FUNCTION (this);
-      Buffer buffer;
-      Ptr<Packet> packet;
+      NS_ASSERT (m_session == 0 || mihfId == m_session->GetFromMihfId ());
       // Fill the buffer;
-      NS_ASSERT (mihfId == m_session->GetFromMihfId ());
-      mihfId.TlvSerialize (buffer);
-      m_session->GetToMihfId ().TlvSerialize (buffer);
-      linkIdentifier.TlvSerialize (buffer);
-      TlvSerialize (buffer, parameters);
-      // Fill in packet to send;
-      packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
-      // Add Mih Header;
-      MihHeader mihHeader;
-      uint16_t transactionId = m_session->m_nextTransactionId;
-      m_session->m_nextTransactionId++;
-      mihHeader.SetVersion (MihHeader::VERSION_ONE);
-      mihHeader.SetServiceId (MihHeader::EVENT);
-      mihHeader.SetOpCode (MihHeader::INDICATION);
-      mihHeader.SetActionId (MihHeader::MIH_LINK_PARAMETERS_REPORT);
-      mihHeader.SetTransactionId (transactionId);
-      mihHeader.SetPayloadLength (packet->GetSize ());
-      packet->AddHeader (mihHeader);
-      // Send packet;
-      m_session->SendEvent (packet);
-      
+      Buffer::Iterator i = BeginIndication (MihHeader::MIH_LINK_PARAMETERS_REPORT,
+                                            linkIdentifier.GetTlvSerializedSize () +
+                                            GetTlvSerializedSize (parameters),
+                                            true);
+      linkIdentifier.TlvSerialize (i);
+      TlvSerialize (i, parameters);
+      EndIndication ();
     }
     void
     RemoteEventSourceTrap::LinkGoingDown (MihfId mihfId, 
@@ -178,31 +288,17 @@ namespace ns3 {
                                           LinkGoingDownReason reasonCode)
     {
       NS_LOG_FUNCTION (this);
-      Buffer buffer;
-      Ptr<Packet> packet;
+      NS_ASSERT (m_session == 0 || mihfId == m_session->GetFromMihfId ());
       // Fill the buffer;
-      NS_ASSERT (mihfId == m_session->GetFromMihfId ());
-      mihfId.TlvSerialize (buffer);
-      m_session->GetToMihfId ().TlvSerialize (buffer);
-      linkIdentifier.TlvSerialize (buffer);
-      Tlv::SerializeU64 (buffer, timeInterval, TLV_TIME_INTERVAL);
-      reasonCode.TlvSerialize (buffer);
-      // Fill in packet to send;
-      packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
-      // Add Mih Header;
-      MihHeader mihHeader;
-      uint16_t transactionId = m_session->m_nextTransactionId;
-      m_session->m_nextTransactionId++;
-      mihHeader.SetVersion (MihHeader::VERSION_ONE);
-      mihHeader.SetServiceId (MihHeader::EVENT);
-      mihHeader.SetOpCode (MihHeader::INDICATION);
-      mihHeader.SetActionId (MihHeader::MIH_LINK_GOING_DOWN);
-      mihHeader.SetTransactionId (transactionId);
-      mihHeader.SetPayloadLength (packet->GetSize ());
-      packet->AddHeader (mihHeader);
-      // Send packet;
-      m_session->SendEvent (packet);
-      
+      Buffer::Iterator i = BeginIndication (MihHeader::MIH_LINK_GOING_DOWN,
+                                            linkIdentifier.GetTlvSerializedSize () +
+                                            Tlv::GetSerializedSizeU64 () +
+                                            reasonCode.GetTlvSerializedSize (),
+                                            false);
+      linkIdentifier.TlvSerialize (i);
+      Tlv::SerializeU64 (i, timeInterval, TLV_TIME_INTERVAL);
+      reasonCode.TlvSerialize (i);
+      EndIndication ();
     }
     void 
     RemoteEventSourceTrap::LinkHandoverImminent (MihfId mihfId,
@@ -212,32 +308,19 @@ namespace ns3 {
                                                  Address newAR)
     {
       NS_LOG_FUNCTION (this);
-      Buffer buffer;
-      Ptr<Packet> packet;
+      NS_ASSERT (m_session == 0 || mihfId == m_session->GetFromMihfId ());
       // Fill the buffer;
-      NS_ASSERT (mihfId == m_session->GetFromMihfId ());
-      mihfId.TlvSerialize (buffer);
-      m_session->GetToMihfId ().TlvSerialize (buffer);
-      oldLinkId.TlvSerialize (buffer);
-      newLinkId.TlvSerialize (buffer);
-      Tlv::Serialize (buffer, oldAR, TLV_OLD_ACCESS_ROUTER);
-      Tlv::Serialize (buffer, newAR, TLV_NEW_ACCESS_ROUTER);
-      // Fill in packet to send;
-      packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
-      // Add Mih Header;
-      MihHeader mihHeader;
-      uint16_t transactionId = m_session->m_nextTransactionId;
-      m_session->m_nextTransactionId++;
-      mihHeader.SetVersion (MihHeader::VERSION_ONE);
-      mihHeader.SetServiceId (MihHeader::EVENT);
-      mihHeader.SetOpCode (MihHeader::INDICATION);
-      mihHeader.SetActionId (MihHeader::MIH_LINK_HANDOVER_IMMINENT);
-      mihHeader.SetTransactionId (transactionId);
-      mihHeader.SetPayloadLength (packet->GetSize ());
-      packet->AddHeader (mihHeader);
-      // Send packet;
-      m_session->SendEvent (packet);
-      
+      Buffer::Iterator i = BeginIndication (MihHeader::MIH_LINK_HANDOVER_IMMINENT,
+                                            oldLinkId.GetTlvSerializedSize () +
+                                            newLinkId.GetTlvSerializedSize () +
+                                            Tlv::GetSerializedSize (oldAR) +
+                                            Tlv::GetSerializedSize (newAR),
+                                            false);
+      oldLinkId.TlvSerialize (i);
+      newLinkId.TlvSerialize (i);
+      Tlv::Serialize (i, oldAR, TLV_OLD_ACCESS_ROUTER);
+      Tlv::Serialize (i, newAR, TLV_NEW_ACCESS_ROUTER);
+      EndIndication ();
     }
     void
     RemoteEventSourceTrap::LinkHandoverComplete (MihfId mihfId, 
@@ -248,32 +331,21 @@ namespace ns3 {
                                                  Status handoverStatus)
     {
       NS_LOG_FUNCTION (this);
-      Buffer buffer;
-      Ptr<Packet> packet;
+      NS_ASSERT (m_session == 0 || mihfId == m_session->GetFromMihfId ());
       // Fill the buffer;
-      NS_ASSERT (mihfId == m_session->GetFromMihfId ());
-      mihfId.TlvSerialize (buffer);
-      m_session->GetToMihfId ().TlvSerialize (buffer);
-      oldLinkId.TlvSerialize (buffer);
-      newLinkId.TlvSerialize (buffer);
-      Tlv::Serialize (buffer, oldAR, TLV_OLD_ACCESS_ROUTER);
-      Tlv::Serialize (buffer, newAR, TLV_NEW_ACCESS_ROUTER);
-      handoverStatus.TlvSerialize (buffer);
-      // Fill in packet to send;
-      packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
-      // Add Mih Header;
-      MihHeader mihHeader;
-      uint16_t transactionId = m_session->m_nextTransactionId;
-      m_session->m_nextTransactionId++;
-      mihHeader.SetVersion (MihHeader::VERSION_ONE);
-      mihHeader.SetServiceId (MihHeader::EVENT);
-      mihHeader.SetOpCode (MihHeader::INDICATION);
-      mihHeader.SetActionId (MihHeader::MIH_LINK_HANDOVER_COMPLETE);
-      mihHeader.SetTransactionId (transactionId);
-      mihHeader.SetPayloadLength (packet->GetSize ());
-      packet->AddHeader (mihHeader);
-      // Send packet;
-      m_session->SendEvent (packet);
+      Buffer::Iterator i = BeginIndication (MihHeader::MIH_LINK_HANDOVER_COMPLETE,
+                                            oldLinkId.GetTlvSerializedSize () +
+                                            newLinkId.GetTlvSerializedSize () +
+                                            Tlv::GetSerializedSize (oldAR) +
+                                            Tlv::GetSerializedSize (newAR) +
+                                            handoverStatus.GetTlvSerializedSize (),
+                                            false);
+      oldLinkId.TlvSerialize (i);
+      newLinkId.TlvSerialize (i);
+      Tlv::Serialize (i, oldAR, TLV_OLD_ACCESS_ROUTER);
+      Tlv::Serialize (i, newAR, TLV_NEW_ACCESS_ROUTER);
+      handoverStatus.TlvSerialize (i);
+      EndIndication ();
     }
   }
 }
@@ -23,7 +23,12 @@
 
 #include "ns3/ptr.h"
 #include "ns3/ref-count-base.h"
+#include "ns3/buffer.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
 #include "mih-callbacks.h"
+#include "mih-header.h"
+#include "mih-event-timestamp-tag.h"
 
 namespace ns3 {
   namespace mih {
@@ -35,6 +40,14 @@ namespace ns3 {
       RemoteEventSourceTrap (void);
       virtual ~RemoteEventSourceTrap (void);
       void SetSession (Ptr<Session> session);
+      // Hold link detected, up, down and parameters report
+      // indications for up to window and send them together as a
+      // single MIH_LINK_EVENT_BATCH PDU, flushed early once maxCount
+      // of them are pending. A zero window sends each on its own;
+      void SetAggregation (Time window, uint32_t maxCount);
+      // Tag the PDUs with the time their indications were raised;
+      void SetTimestamps (bool timestamps);
+      void Flush (void);
       // Callback accessors;
       void LinkDetected (MihfId mihfId, 
 			 LinkDetectedInformationList linkDetectedInformationList);
@@ -67,7 +80,25 @@ namespace ns3 {
 				 Address newAR, 
 				 Status handoverStatus);
     protected:
+      Buffer::Iterator BeginIndication (enum MihHeader::ActionIdE actionId,
+                                        uint32_t bodySize,
+                                        bool batchable);
+      void EndIndication (void);
+      void SendPdu (Buffer &buffer, enum MihHeader::ActionIdE actionId,
+                    EventTimestampTag const &timestamps);
       Ptr<Session> m_session;
+      Time m_aggregationWindow;
+      uint32_t m_aggregationMaxCount;
+      Buffer m_batch;
+      uint32_t m_batchCount;
+      uint32_t m_batchSize;
+      EventId m_batchTimer;
+      Buffer m_single;
+      enum MihHeader::ActionIdE m_actionId;
+      bool m_inBatch;
+      bool m_timestamps;
+      EventTimestampTag m_batchTimestamps;
+      EventTimestampTag m_singleTimestamps;
     };
   }
 }
@@ -70,46 +70,37 @@ namespace ns3 {
       return 1 + lengthOfLengthField + payloadLength;
     }
     void 
-    ScanResponse::TlvSerialize (Buffer &buffer) const
+    ScanResponse::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
 
       payloadLength = Tlv::GetSerializedSize (m_poaLinkAddress) +
         m_networkIdentifier.GetTlvSerializedSize () +
         m_signalStrength.GetTlvSerializedSize ();
 
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field + Length field only;
-      
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length field;
 
-      Tlv::Serialize (buffer, m_poaLinkAddress, TLV_POA_LINK_IDENTIFIER);
-      m_networkIdentifier.TlvSerialize (buffer);
-      m_signalStrength.TlvSerialize (buffer);
+      Tlv::Serialize (i, m_poaLinkAddress, TLV_POA_LINK_IDENTIFIER);
+      m_networkIdentifier.TlvSerialize (i);
+      m_signalStrength.TlvSerialize (i);
     }
     uint32_t 
-    ScanResponse::TlvDeserialize (Buffer &buffer)
+    ScanResponse::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == GetTlvTypeValue ());
+      Tlv::ReadTypeField (i, GetTlvTypeValue ());
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
 
-      totalBytesRead += Tlv::Deserialize (buffer, m_poaLinkAddress, TLV_POA_LINK_IDENTIFIER);
-      totalBytesRead += m_networkIdentifier.TlvDeserialize (buffer);
-      totalBytesRead += m_signalStrength.TlvDeserialize (buffer);
+      totalBytesRead += Tlv::Deserialize (i, m_poaLinkAddress, TLV_POA_LINK_IDENTIFIER);
+      totalBytesRead += m_networkIdentifier.TlvDeserialize (i);
+      totalBytesRead += m_signalStrength.TlvDeserialize (i);
       
       return totalBytesRead;
     }
@@ -123,10 +114,20 @@ namespace ns3 {
     {
       Tlv::Serialize<ScanResponse> (buffer, scanResponseList, TLV_SCAN_RESPONSE_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const ScanResponseList &scanResponseList)
+    {
+      Tlv::Serialize<ScanResponse> (i, scanResponseList, TLV_SCAN_RESPONSE_LIST);
+    }
     uint32_t
     TlvDeserialize (Buffer &buffer, ScanResponseList &scanResponseList)
     {
       return Tlv::Deserialize<ScanResponse> (buffer, scanResponseList, TLV_SCAN_RESPONSE_LIST);    
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, ScanResponseList &scanResponseList)
+    {
+      return Tlv::Deserialize<ScanResponse> (i, scanResponseList, TLV_SCAN_RESPONSE_LIST);
+    }
   } // namespace mih
 } // namespace ns3
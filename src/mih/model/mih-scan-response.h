@@ -29,7 +29,7 @@
 
 namespace ns3 {
   namespace mih {
-    class ScanResponse : public RefCountBase {
+    class ScanResponse : public RefCountBase, public Tlv {
     public:
       ScanResponse (Address poaL2Address = Address (),
 		    NetworkIdentifier networkIdentifier = NetworkIdentifier (), 
@@ -39,8 +39,10 @@ namespace ns3 {
       NetworkIdentifier GetNetworkIdentifier (void);
       SignalStrength GetSignalStrength (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (ScanResponse);
       static Ptr<ScanResponse> CreateFromTlvType (uint8_t val);
     protected:
@@ -52,7 +54,9 @@ namespace ns3 {
     typedef ScanResponseList::iterator ScanResponseListI;
     uint32_t GetTlvSerializedSize (const ScanResponseList &scanResponseList);
     void TlvSerialize (Buffer &buffer, const ScanResponseList &scanResponseList);
+    void TlvSerialize (Buffer::Iterator &i, const ScanResponseList &scanResponseList);
     uint32_t TlvDeserialize (Buffer &buffer, ScanResponseList &scanResponseList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, ScanResponseList &scanResponseList);
   } // namespace mih
 } // namespace ns3
 
@@ -36,11 +36,23 @@ namespace ns3 {
       m_socket (0),
       m_initComplete (false),
       m_isRegistered (false),
+      m_closed (false),
+      m_registrant (false),
+      m_registrationLifetime (0),
+      m_registrationTimer (0),
       m_nextTransactionId (0),
       m_delay (0),
-      m_maxSize (0),
+      m_windowSize (1),
       m_remoteEventDestinationTrap (),
-      m_remoteEventSourceTrap ()
+      m_remoteEventSourceTrap (),
+      m_stream (false),
+      m_retransmit (false),
+      m_rtt (CreateObject<RttMeanDeviation> ()),
+      m_initialRto (Seconds (1)),
+      m_minRto (MilliSeconds (100)),
+      m_maxRto (Seconds (4)),
+      m_maxRetransmissions (0),
+      m_ackRequested (false)
     {
       NS_LOG_FUNCTION (this);
     }
@@ -53,11 +65,24 @@ namespace ns3 {
       m_destinationInetSocketAddress (destinationIp),
       m_socket (socket),
       m_initComplete (false),
+      m_isRegistered (false),
+      m_closed (false),
+      m_registrant (false),
+      m_registrationLifetime (0),
+      m_registrationTimer (0),
       m_nextTransactionId (0),
       m_delay (0),
-      m_maxSize (0),
+      m_windowSize (1),
       m_remoteEventDestinationTrap (),
-      m_remoteEventSourceTrap ()
+      m_remoteEventSourceTrap (),
+      m_stream (false),
+      m_retransmit (false),
+      m_rtt (CreateObject<RttMeanDeviation> ()),
+      m_initialRto (Seconds (1)),
+      m_minRto (MilliSeconds (100)),
+      m_maxRto (Seconds (4)),
+      m_maxRetransmissions (0),
+      m_ackRequested (false)
     {
       NS_LOG_FUNCTION (this);
       m_remoteEventSourceTrap.SetSession (Ptr<Session>(this, false));
@@ -65,6 +90,10 @@ namespace ns3 {
     Session::~Session (void)
     {
       NS_LOG_FUNCTION (this);
+      for (TransactionTableI i = m_outstandingRequests.begin (); i != m_outstandingRequests.end (); i++)
+        {
+          i->second->CancelRetransmitEvent ();
+        }
       m_socket = 0;
     }
     MihfId
@@ -150,54 +179,528 @@ namespace ns3 {
       m_isRegistered = true;
     }
     void
-    Session::NotifyNewPendingRequest (void)
+    Session::SetRegistrationCallbacks (Callback<void, Ptr<Session>, uint32_t> registeredCallback,
+                                       Callback<void, Ptr<Session> > deRegisteredCallback)
+    {
+      NS_LOG_FUNCTION (this);
+      m_registeredCallback = registeredCallback;
+      m_deRegisteredCallback = deRegisteredCallback;
+    }
+    bool
+    Session::IsRegistrant (void)
+    {
+      return m_registrant;
+    }
+    LinkIdentifierList
+    Session::GetRegistrationLinks (void)
+    {
+      return m_registrationLinks;
+    }
+    void
+    Session::SetRegistrationLinks (LinkIdentifierList linkIdentifierList)
     {
       NS_LOG_FUNCTION (this);
-      if (m_currentTransaction)
+      m_registrationLinks = linkIdentifierList;
+    }
+    uint32_t
+    Session::GetRegistrationLifetime (void)
+    {
+      return m_registrationLifetime;
+    }
+    uint64_t
+    Session::GetRegistrationTimer (void)
+    {
+      return m_registrationTimer;
+    }
+    void
+    Session::SetRegistrationTimer (uint64_t tick)
+    {
+      NS_LOG_FUNCTION (this << tick);
+      m_registrationTimer = tick;
+    }
+    void
+    Session::Close (void)
+    {
+      NS_LOG_FUNCTION (this);
+      if (m_closed)
         {
-          NS_ASSERT (m_currentTransaction->GetState () == Transaction::WAIT_RESPONSE_MSG);
           return;
         }
-      m_currentTransaction = m_pendingRequestQueue.front ();
-      m_currentTransaction->SetState (Transaction::WAIT_RESPONSE_MSG);
-      m_pendingRequestQueue.pop_front ();
-      m_socket->Send (m_currentTransaction->GetPacket ());
-      //      m_socket->SendTo (m_currentTransaction->GetPacket (), 0, m_destinationInetSocketAddress);
+      m_closed = true;
+      m_registrationTimer = 0;
+      // Taken out first, the confirm callbacks may issue new requests
+      // on the session which replaces this one;
+      TransactionQueue requests;
+      requests.swap (m_pendingRequestQueue);
+      for (TransactionTableI i = m_outstandingRequests.begin (); i != m_outstandingRequests.end (); i++)
+        {
+          if (!i->second->IsToBeDeleted ())
+            {
+              requests.push_back (i->second);
+            }
+        }
+      m_outstandingRequests.clear ();
+      for (TransactionTableI i = m_pendingResponses.begin (); i != m_pendingResponses.end (); i++)
+        {
+          i->second->Abandon ();
+        }
+      m_pendingResponses.clear ();
+      m_sentResponses.clear ();
+      m_sentResponseExpiries.clear ();
+      m_sendBacklog.clear ();
+      m_remoteEventSourceTrap.SetSession (0);
+      m_registeredCallback = MakeNullCallback<void, Ptr<Session>, uint32_t> ();
+      m_deRegisteredCallback = MakeNullCallback<void, Ptr<Session> > ();
+      for (TransactionQueueI i = requests.begin (); i != requests.end (); i++)
+        {
+          (*i)->Abandon ();
+          (*i)->SetState (Transaction::FAILURE);
+          (*i)->Fail ();
+        }
+    }
+    bool
+    Session::IsClosed (void)
+    {
+      return m_closed;
+    }
+    void
+    Session::NotifyRegistrationGranted (uint32_t validLifeTime)
+    {
+      NS_LOG_FUNCTION (this << validLifeTime);
+      m_registrant = false;
+      m_registrationLifetime = validLifeTime;
+      if (!m_registeredCallback.IsNull ())
+        {
+          m_registeredCallback (Ptr<Session> (this), validLifeTime);
+        }
     }
     void
-    Session::NotifyPendingResponseDone (void)
+    Session::NotifyDeRegistrationAccepted (void)
     {
       NS_LOG_FUNCTION (this);
-      // DisposePendingResponse ();
-      Simulator::ScheduleNow(&Session::DisposePendingResponse, this);
+      if (!m_deRegisteredCallback.IsNull ())
+        {
+          m_deRegisteredCallback (Ptr<Session> (this));
+        }
+    }
+    void
+    Session::SetWindowSize (uint16_t windowSize)
+    {
+      NS_LOG_FUNCTION (this << windowSize);
+      NS_ASSERT (windowSize > 0);
+      m_windowSize = windowSize;
+    }
+    uint16_t
+    Session::GetWindowSize (void)
+    {
+      return m_windowSize;
     }
     void
-    Session::NotifyPendingCurrentRequestDone (void)
+    Session::SetStreamTransport (bool stream)
+    {
+      NS_LOG_FUNCTION (this << stream);
+      m_stream = stream;
+    }
+    void
+    Session::SetRetransmission (Time initialRto, Time minRto, Time maxRto,
+                                uint32_t maxRetransmissions, bool ackRequested)
+    {
+      NS_LOG_FUNCTION (this << initialRto << minRto << maxRto << maxRetransmissions << ackRequested);
+      NS_ASSERT (minRto <= maxRto);
+      m_retransmit = true;
+      m_initialRto = initialRto;
+      m_minRto = minRto;
+      m_maxRto = maxRto;
+      m_maxRetransmissions = maxRetransmissions;
+      m_ackRequested = ackRequested;
+    }
+    void
+    Session::SetTransactionTraceCallbacks (Callback<void, MihfId, uint16_t, uint32_t> retransmitCallback,
+                                           Callback<void, MihfId, uint16_t> timeoutCallback)
     {
       NS_LOG_FUNCTION (this);
-      Simulator::ScheduleNow(&Session::DisposePendingCurrentRequest, this);
+      m_retransmitCallback = retransmitCallback;
+      m_timeoutCallback = timeoutCallback;
     }
     void
-    Session::DisposePendingResponse (void)
+    Session::SetTrafficTraceCallbacks (Callback<void, MihfId, Ptr<const Packet> > pduSentCallback,
+                                       Callback<void, MihfId, uint16_t, Time> transactionLatencyCallback,
+                                       Callback<void, MihfId, uint32_t> queueDepthCallback)
     {
       NS_LOG_FUNCTION (this);
-      NS_ASSERT (m_pendingResponseTransaction->IsToBeDeleted ());
-      m_pendingResponseTransaction = 0;
+      m_pduSentCallback = pduSentCallback;
+      m_transactionLatencyCallback = transactionLatencyCallback;
+      m_queueDepthCallback = queueDepthCallback;
     }
     void
-    Session::DisposePendingCurrentRequest (void)
+    Session::NotifyPduSent (Ptr<const Packet> packet)
+    {
+      if (!m_pduSentCallback.IsNull ())
+        {
+          m_pduSentCallback (GetToMihfId (), packet);
+        }
+    }
+    Time
+    Session::GetRetransmissionTimeout (uint32_t backoff)
+    {
+      NS_LOG_FUNCTION (this << backoff);
+      // Same estimator as TCP, doubled on each retransmission of the
+      // same request;
+      Time rto = m_initialRto;
+      if (m_rtt->GetNSamples () > 0)
+        {
+          rto = Max (m_rtt->GetEstimate () + Max (MilliSeconds (1), m_rtt->GetVariation () * 4),
+                     m_minRto);
+        }
+      for (uint32_t i = 0; i < backoff && rto < m_maxRto; i++)
+        {
+          rto = rto * 2;
+        }
+      return Min (rto, m_maxRto);
+    }
+    uint16_t
+    Session::AllocateTransactionId (void)
+    {
+      NS_LOG_FUNCTION (this);
+      // The MIH header carries a 12-bit transaction identifier. Skip
+      // the ones of the requests in the window and of the responses
+      // kept for replay; the latter give way once every identifier is
+      // taken, the window being smaller than the identifier space;
+      ExpireSentResponses ();
+      uint16_t replayed = 0x1000;
+      for (uint16_t n = 0; n < 0x1000; n++)
+        {
+          uint16_t transactionId = (m_nextTransactionId + n) & 0x0fff;
+          if (m_outstandingRequests.find (transactionId) != m_outstandingRequests.end ())
+            {
+              continue;
+            }
+          if (m_sentResponses.find (transactionId) == m_sentResponses.end ())
+            {
+              m_nextTransactionId = (transactionId + 1) & 0x0fff;
+              return transactionId;
+            }
+          if (replayed == 0x1000)
+            {
+              replayed = transactionId;
+            }
+        }
+      NS_ASSERT (replayed < 0x1000);
+      m_nextTransactionId = (replayed + 1) & 0x0fff;
+      return replayed;
+    }
+    void
+    Session::NotifyNewPendingRequest (void)
     {
       NS_LOG_FUNCTION (this);
-      NS_ASSERT (m_currentTransaction->IsToBeDeleted ());
-      m_currentTransaction = 0;
-      if (m_pendingRequestQueue.size () != 0)
+      if (m_closed)
         {
-          m_currentTransaction = m_pendingRequestQueue.front ();
-          m_currentTransaction->SetState (Transaction::WAIT_RESPONSE_MSG);
+          return;
+        }
+      Ptr<Packet> burst = 0;
+      while (m_pendingRequestQueue.size () != 0 &&
+             m_outstandingRequests.size () < m_windowSize)
+        {
+          Ptr<Transaction> transaction = m_pendingRequestQueue.front ();
           m_pendingRequestQueue.pop_front ();
-          m_socket->Send (m_currentTransaction->GetPacket ());
-          //          m_socket->SendTo (m_currentTransaction->GetPacket (), 0, m_destinationInetSocketAddress);
+          // Requests get their transaction identifier as they enter
+          // the window, the queued ones hold none;
+          uint16_t transactionId = AllocateTransactionId ();
+          MihHeader mihHeader;
+          transaction->GetPacket ()->RemoveHeader (mihHeader);
+          mihHeader.SetTransactionId (transactionId);
+          transaction->GetPacket ()->AddHeader (mihHeader);
+          transaction->SetTransactionId (transactionId);
+          transaction->SetState (m_ackRequested ? Transaction::WAIT_ACK : Transaction::WAIT_RESPONSE_MSG);
+          m_outstandingRequests[transactionId] = transaction;
+          if (!m_stream)
+            {
+              SendRequest (transaction);
+              continue;
+            }
+          transaction->NotifySent (EventId ());
+          NotifyPduSent (transaction->GetPacket ());
+          if (burst == 0)
+            {
+              burst = transaction->GetPacket ()->Copy ();
+            }
+          else
+            {
+              burst->AddAtEnd (transaction->GetPacket ());
+            }
+        }
+      if (burst != 0)
+        {
+          SendPdu (burst);
+        }
+      if (!m_queueDepthCallback.IsNull ())
+        {
+          m_queueDepthCallback (GetToMihfId (), m_pendingRequestQueue.size ());
+        }
+    }
+    void
+    Session::SendRequest (Ptr<Transaction> transaction)
+    {
+      NS_LOG_FUNCTION (this << transaction->GetTransactionId ());
+      EventId retransmitEvent;
+      if (m_retransmit)
+        {
+          retransmitEvent = Simulator::Schedule (GetRetransmissionTimeout (transaction->GetTransmissionCount ()),
+                                                 &Session::RetransmitTimeout, this,
+                                                 transaction->GetTransactionId ());
+        }
+      transaction->NotifySent (retransmitEvent);
+      NotifyPduSent (transaction->GetPacket ());
+      SendPdu (transaction->GetPacket ()->Copy ());
+    }
+    void
+    Session::SendResponse (Ptr<Packet> packet)
+    {
+      NS_LOG_FUNCTION (this);
+      NotifyPduSent (packet);
+      SendPdu (packet);
+    }
+    void
+    Session::SendPdu (Ptr<Packet> packet)
+    {
+      NS_LOG_FUNCTION (this << packet->GetSize ());
+      if (!m_stream)
+        {
+          // The socket of a session accepted from the peer is not connected;
+          m_socket->SendTo (packet, 0, m_destinationInetSocketAddress);
+          return;
         }
+      // Nothing is retransmitted over a stream, what the socket has no
+      // room for waits behind what it refused already;
+      m_sendBacklog.push_back (packet);
+      DrainSendBacklog ();
+    }
+    void
+    Session::DrainSendBacklog (void)
+    {
+      NS_LOG_FUNCTION (this << m_sendBacklog.size ());
+      while (!m_sendBacklog.empty () && !m_closed)
+        {
+          uint32_t available = m_socket->GetTxAvailable ();
+          if (available == 0)
+            {
+              return;
+            }
+          Ptr<Packet> packet = m_sendBacklog.front ();
+          if (packet->GetSize () <= available)
+            {
+              if (m_socket->Send (packet) < 0)
+                {
+                  return;
+                }
+              m_sendBacklog.pop_front ();
+              continue;
+            }
+          // A PDU larger than the room left goes in pieces, the peer
+          // reassembles it from the stream;
+          if (m_socket->Send (packet->CreateFragment (0, available)) < 0)
+            {
+              return;
+            }
+          m_sendBacklog.front () = packet->CreateFragment (available, packet->GetSize () - available);
+        }
+    }
+    void
+    Session::RetransmitTimeout (uint16_t transactionId)
+    {
+      NS_LOG_FUNCTION (this << transactionId);
+      TransactionTableI i = m_outstandingRequests.find (transactionId);
+      if (i == m_outstandingRequests.end () || i->second->IsToBeDeleted ())
+        {
+          return;
+        }
+      Ptr<Transaction> transaction = i->second;
+      if (transaction->GetTransmissionCount () > m_maxRetransmissions)
+        {
+          NS_LOG_LOGIC ("Transaction " << transactionId << " to " << GetToMihfId () << " timed out");
+          m_timeoutCallback (GetToMihfId (), transactionId);
+          transaction->SetState (Transaction::FAILURE);
+          transaction->Fail ();
+          transaction->SetToBeDeleted ();
+          return;
+        }
+      m_retransmitCallback (GetToMihfId (), transactionId, transaction->GetTransmissionCount ());
+      SendRequest (transaction);
+    }
+    void
+    Session::ReceiveAck (uint16_t transactionId)
+    {
+      NS_LOG_FUNCTION (this << transactionId);
+      TransactionTableI i = m_outstandingRequests.find (transactionId);
+      if (i == m_outstandingRequests.end () || 
+          i->second->IsToBeDeleted () ||
+          i->second->GetState () != Transaction::WAIT_ACK)
+        {
+          return;
+        }
+      Ptr<Transaction> transaction = i->second;
+      if (transaction->GetTransmissionCount () == 1)
+        {
+          m_rtt->Measurement (Simulator::Now () - transaction->GetSendTime ());
+        }
+      transaction->SetState (Transaction::WAIT_RESPONSE_MSG);
+      // The peer holds the request, only its response can still be
+      // lost from now on;
+      transaction->CancelRetransmitEvent ();
+      if (m_retransmit)
+        {
+          transaction->SetRetransmitEvent (Simulator::Schedule (m_maxRto, &Session::RetransmitTimeout, 
+                                                                this, transactionId));
+        }
+    }
+    bool
+    Session::ReceiveDuplicateRequest (MihHeader requestHeader)
+    {
+      NS_LOG_FUNCTION (this << requestHeader.GetTransactionId ());
+      uint16_t transactionId = requestHeader.GetTransactionId ();
+      if (!m_retransmit)
+        {
+          return false;
+        }
+      if (m_pendingResponses.find (transactionId) != m_pendingResponses.end ())
+        {
+          NS_LOG_LOGIC ("Request " << transactionId << " is still processed");
+          AcknowledgeRequest (requestHeader);
+          return true;
+        }
+      ExpireSentResponses ();
+      std::map<uint16_t, SentResponse>::iterator i = m_sentResponses.find (transactionId);
+      if (i == m_sentResponses.end ())
+        {
+          return false;
+        }
+      NS_LOG_LOGIC ("Replaying response to request " << transactionId);
+      NotifyPduSent (i->second.packet);
+      SendPdu (i->second.packet->Copy ());
+      return true;
+    }
+    void
+    Session::AcknowledgeRequest (MihHeader requestHeader)
+    {
+      NS_LOG_FUNCTION (this << requestHeader.GetTransactionId ());
+      if (!requestHeader.GetAckRequest () ||
+          m_pendingResponses.find (requestHeader.GetTransactionId ()) == m_pendingResponses.end ())
+        {
+          // Answered already, the response acknowledges the request;
+          return;
+        }
+      MihHeader ackHeader = requestHeader;
+      ackHeader.SetAckRequest (false);
+      ackHeader.SetAckResponse (true);
+      ackHeader.SetPayloadLength (0);
+      Ptr<Packet> packet = Create<Packet> ();
+      packet->AddHeader (ackHeader);
+      NotifyPduSent (packet);
+      SendPdu (packet);
+    }
+    void
+    Session::ExpireSentResponses (void)
+    {
+      NS_LOG_FUNCTION (this);
+      while (!m_sentResponseExpiries.empty () &&
+             m_sentResponseExpiries.front ().first <= Simulator::Now ())
+        {
+          std::map<uint16_t, SentResponse>::iterator i = 
+            m_sentResponses.find (m_sentResponseExpiries.front ().second);
+          if (i != m_sentResponses.end () && 
+              i->second.expires == m_sentResponseExpiries.front ().first)
+            {
+              m_sentResponses.erase (i);
+            }
+          m_sentResponseExpiries.pop_front ();
+        }
+    }
+    void
+    Session::NotifyPendingResponseDone (uint16_t transactionId)
+    {
+      NS_LOG_FUNCTION (this << transactionId);
+      // DisposePendingResponse ();
+      Simulator::ScheduleNow (&Session::DisposePendingResponse, Ptr<Session> (this), transactionId);
+    }
+    void
+    Session::NotifyOutstandingRequestDone (uint16_t transactionId)
+    {
+      NS_LOG_FUNCTION (this << transactionId);
+      Simulator::ScheduleNow (&Session::DisposeOutstandingRequest, Ptr<Session> (this), transactionId);
+    }
+    void
+    Session::DisposePendingResponse (uint16_t transactionId)
+    {
+      NS_LOG_FUNCTION (this << transactionId);
+      if (m_closed)
+        {
+          return;
+        }
+      TransactionTableI i = m_pendingResponses.find (transactionId);
+      NS_ASSERT (i != m_pendingResponses.end ());
+      NS_ASSERT (i->second->IsToBeDeleted ());
+      if (m_retransmit && i->second->GetResponsePacket () != 0)
+        {
+          // Kept as long as the requester may retransmit;
+          ExpireSentResponses ();
+          SentResponse sentResponse;
+          sentResponse.packet = i->second->GetResponsePacket ();
+          sentResponse.expires = Simulator::Now () + m_maxRto * (m_maxRetransmissions + 1);
+          m_sentResponses[transactionId] = sentResponse;
+          m_sentResponseExpiries.push_back (std::make_pair (sentResponse.expires, transactionId));
+        }
+      m_pendingResponses.erase (i);
+    }
+    void
+    Session::DisposeOutstandingRequest (uint16_t transactionId)
+    {
+      NS_LOG_FUNCTION (this << transactionId);
+      if (m_closed)
+        {
+          return;
+        }
+      TransactionTableI i = m_outstandingRequests.find (transactionId);
+      NS_ASSERT (i != m_outstandingRequests.end ());
+      NS_ASSERT (i->second->IsToBeDeleted ());
+      m_outstandingRequests.erase (i);
+      NotifyNewPendingRequest ();
+    }
+    void
+    Session::AddPendingResponse (Ptr<Transaction> transaction)
+    {
+      NS_LOG_FUNCTION (this << transaction->GetTransactionId ());
+      NS_ASSERT_MSG (m_pendingResponses.find (transaction->GetTransactionId ()) == m_pendingResponses.end (),
+                     "Duplicate request for transaction " << transaction->GetTransactionId ());
+      transaction->SetSendResponseCallback (MakeCallback (&Session::SendResponse, this));
+      m_pendingResponses[transaction->GetTransactionId ()] = transaction;
+    }
+    Ptr<Transaction>
+    Session::LookupOutstandingRequest (uint16_t transactionId)
+    {
+      NS_LOG_FUNCTION (this << transactionId);
+      TransactionTableI i = m_outstandingRequests.find (transactionId);
+      if (i == m_outstandingRequests.end () || i->second->IsToBeDeleted ())
+        {
+          NS_LOG_LOGIC ("Dropping late or duplicate response " << transactionId);
+          return 0;
+        }
+      Ptr<Transaction> transaction = i->second;
+      NS_ASSERT (transaction->GetState () == Transaction::WAIT_ACK ||
+                 transaction->GetState () == Transaction::WAIT_RESPONSE_MSG);
+      transaction->CancelRetransmitEvent ();
+      // Karn's algorithm: only requests sent once give an unambiguous
+      // round trip time, and acknowledged ones were sampled already;
+      if (transaction->GetTransmissionCount () == 1 &&
+          transaction->GetState () == (m_ackRequested ? Transaction::WAIT_ACK : Transaction::WAIT_RESPONSE_MSG))
+        {
+          m_rtt->Measurement (Simulator::Now () - transaction->GetSendTime ());
+        }
+      if (!m_transactionLatencyCallback.IsNull ())
+        {
+          m_transactionLatencyCallback (GetToMihfId (), transactionId,
+                                        Simulator::Now () - transaction->GetStartTime ());
+        }
+      return transaction;
     }
     // Remote events access methods;
     RemoteEventSourceTrap&
@@ -217,8 +720,8 @@ namespace ns3 {
     Session::SendEvent (Ptr<Packet> packet)
     {
       NS_LOG_FUNCTION (this);
-      //m_socket->Send (packet);
-      m_socket->SendTo (packet, 0, m_destinationInetSocketAddress);
+      NotifyPduSent (packet);
+      SendPdu (packet);
     }
     // Command Service transport;
     void 
@@ -227,13 +730,11 @@ namespace ns3 {
     {
       NS_LOG_FUNCTION (this);
       MihHeader mihHeader;
-      uint16_t transactionId = m_nextTransactionId;
-      m_nextTransactionId++;
       mihHeader.SetVersion (MihHeader::VERSION_ONE);
       mihHeader.SetServiceId (MihHeader::MANAGEMENT);
       mihHeader.SetOpCode (MihHeader::REQUEST);
       mihHeader.SetActionId (MihHeader::MIH_REGISTER);
-      mihHeader.SetTransactionId (transactionId);
+      mihHeader.SetAckRequest (m_ackRequested);
       mihHeader.SetPayloadLength (packet->GetSize ());
       packet->AddHeader (mihHeader);
 
@@ -242,12 +743,12 @@ namespace ns3 {
                                             GetFromMihfId (), 
                                             GetToMihfId (), 
                                             GetToAddress (), 
-                                            transactionId,
+                                            0,
                                             registerConfirmCallback);
-      registerRequestTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyPendingCurrentRequestDone, 
+      registerRequestTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyOutstandingRequestDone, 
                                                                        this));
       m_pendingRequestQueue.push_back (registerRequestTransaction);
-      Simulator::ScheduleNow (&Session::NotifyNewPendingRequest, this);
+      Simulator::ScheduleNow (&Session::NotifyNewPendingRequest, Ptr<Session> (this));
     }
     MihRegisterResponseCallback 
     Session::ReceiveRegisterRequest (Ptr<Packet> packet, 
@@ -263,41 +764,115 @@ namespace ns3 {
                                              m_socket);
       registerResponseTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyPendingResponseDone, 
                                                                         this));
-      NS_ASSERT (m_pendingResponseTransaction == 0);
-      NS_LOG_WARN ("Check to assure that the following line is bug free!");
-      m_pendingResponseTransaction = registerResponseTransaction;
+      registerResponseTransaction->SetRegistrationCallback (MakeCallback (&Session::NotifyRegistrationGranted,
+                                                                          this));
+      AddPendingResponse (registerResponseTransaction);
       return MakeCallback (&RegisterResponseTransaction::SendRegisterResponse, 
                            registerResponseTransaction);
     }
     void 
     Session::ReceiveRegisterResponse (MihfId fromMihfId, 
                                       Status status, 
-                                      uint32_t validLifeTime)
+                                      uint32_t validLifeTime,
+                                      uint16_t transactionId)
     {
       NS_LOG_FUNCTION (this);
-      NS_ASSERT (m_currentTransaction != 0);
-      NS_ASSERT (m_currentTransaction->GetState () == Transaction::WAIT_RESPONSE_MSG);
-      NS_ASSERT (m_currentTransaction->IsToBeDeleted () == false);
       Ptr<RegisterRequestTransaction> transaction = 
-        DynamicCast<RegisterRequestTransaction, Transaction> (m_currentTransaction);
-      NS_ASSERT (transaction != 0);
+        DynamicCast<RegisterRequestTransaction, Transaction> (LookupOutstandingRequest (transactionId));
+      if (transaction == 0)
+        {
+          return;
+        }
+      if (status.GetType () == Status::SUCCESS)
+        {
+          m_registrant = true;
+          m_registrationLifetime = validLifeTime;
+          if (!m_registeredCallback.IsNull ())
+            {
+              m_registeredCallback (Ptr<Session> (this), validLifeTime);
+            }
+        }
       transaction->RegisterConfirm (fromMihfId, status, validLifeTime);
       transaction->SetState (Transaction::SUCCESS);
       transaction->SetToBeDeleted ();
     }
     void 
+    Session::SendDeRegisterRequest (Ptr<Packet> packet, 
+                                    MihDeRegisterConfirmCallback deRegisterConfirmCallback)
+    {
+      NS_LOG_FUNCTION (this);
+      MihHeader mihHeader;
+      mihHeader.SetVersion (MihHeader::VERSION_ONE);
+      mihHeader.SetServiceId (MihHeader::MANAGEMENT);
+      mihHeader.SetOpCode (MihHeader::REQUEST);
+      mihHeader.SetActionId (MihHeader::MIH_DEREGISTER);
+      mihHeader.SetAckRequest (m_ackRequested);
+      mihHeader.SetPayloadLength (packet->GetSize ());
+      packet->AddHeader (mihHeader);
+
+      Ptr<DeRegisterRequestTransaction> deRegisterRequestTransaction = 
+        Create<DeRegisterRequestTransaction> (packet, 
+                                              GetFromMihfId (), 
+                                              GetToMihfId (), 
+                                              GetToAddress (), 
+                                              0,
+                                              deRegisterConfirmCallback);
+      deRegisterRequestTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyOutstandingRequestDone, 
+                                                                         this));
+      m_pendingRequestQueue.push_back (deRegisterRequestTransaction);
+      Simulator::ScheduleNow (&Session::NotifyNewPendingRequest, Ptr<Session> (this));
+    }
+    MihDeRegisterResponseCallback 
+    Session::ReceiveDeRegisterRequest (Ptr<Packet> packet, 
+                                       uint16_t transactionId)
+    {
+      NS_LOG_FUNCTION (this);
+      Ptr<DeRegisterResponseTransaction> deRegisterResponseTransaction = 
+        Create<DeRegisterResponseTransaction> (packet, 
+                                               GetFromMihfId (), 
+                                               GetToMihfId (), 
+                                               GetToAddress (), 
+                                               transactionId,
+                                               m_socket);
+      deRegisterResponseTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyPendingResponseDone, 
+                                                                          this));
+      deRegisterResponseTransaction->SetDeRegistrationCallback (MakeCallback (&Session::NotifyDeRegistrationAccepted,
+                                                                              this));
+      AddPendingResponse (deRegisterResponseTransaction);
+      return MakeCallback (&DeRegisterResponseTransaction::SendDeRegisterResponse, 
+                           deRegisterResponseTransaction);
+    }
+    void 
+    Session::ReceiveDeRegisterResponse (MihfId fromMihfId, 
+                                        Status status, 
+                                        uint16_t transactionId)
+    {
+      NS_LOG_FUNCTION (this);
+      Ptr<DeRegisterRequestTransaction> transaction = 
+        DynamicCast<DeRegisterRequestTransaction, Transaction> (LookupOutstandingRequest (transactionId));
+      if (transaction == 0)
+        {
+          return;
+        }
+      transaction->DeRegisterConfirm (fromMihfId, status);
+      transaction->SetState (Transaction::SUCCESS);
+      transaction->SetToBeDeleted ();
+      if (status.GetType () == Status::SUCCESS)
+        {
+          NotifyDeRegistrationAccepted ();
+        }
+    }
+    void 
     Session::SendCapabilityDiscoverRequest (Ptr<Packet> packet,
                                             MihCapabilityDiscoverConfirmCallback capabilityDiscoverConfirmCallback)
     {
       NS_LOG_FUNCTION (this);
       MihHeader mihHeader;
-      uint16_t transactionId = m_nextTransactionId;
-      m_nextTransactionId++;
       mihHeader.SetVersion (MihHeader::VERSION_ONE);
       mihHeader.SetServiceId (MihHeader::MANAGEMENT);
       mihHeader.SetOpCode (MihHeader::REQUEST);
       mihHeader.SetActionId (MihHeader::MIH_CAPABILITY_DISCOVER);
-      mihHeader.SetTransactionId (transactionId);
+      mihHeader.SetAckRequest (m_ackRequested);
       mihHeader.SetPayloadLength (packet->GetSize ());
       packet->AddHeader (mihHeader);
 
@@ -306,12 +881,12 @@ namespace ns3 {
                                                       GetFromMihfId (), 
                                                       GetToMihfId (), 
                                                       GetToAddress (), 
-                                                      transactionId,
+                                                      0,
                                                       capabilityDiscoverConfirmCallback);
-      capabilityDiscoverRequestTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyPendingCurrentRequestDone, 
+      capabilityDiscoverRequestTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyOutstandingRequestDone, 
                                                                                  this));
       m_pendingRequestQueue.push_back (capabilityDiscoverRequestTransaction);
-      Simulator::ScheduleNow (&Session::NotifyNewPendingRequest, this);
+      Simulator::ScheduleNow (&Session::NotifyNewPendingRequest, Ptr<Session> (this));
     }
     MihCapabilityDiscoverResponseCallback 
     Session::ReceiveCapabilityDiscoverRequest (Ptr<Packet> packet, 
@@ -327,9 +902,7 @@ namespace ns3 {
                                                        m_socket);
       capabilityDiscoverResponseTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyPendingResponseDone,
                                                                                   this));
-      NS_ASSERT (m_pendingResponseTransaction == 0);
-      NS_LOG_WARN ("Check to assure that the following line is bug free!");
-      m_pendingResponseTransaction = capabilityDiscoverResponseTransaction;
+      AddPendingResponse (capabilityDiscoverResponseTransaction);
       return MakeCallback (&CapabilityDiscoverResponseTransaction::SendCapabilityDiscoverResponse,
                            capabilityDiscoverResponseTransaction);
     }
@@ -341,15 +914,16 @@ namespace ns3 {
                                                 MihCommandList commands,
                                                 InformationServiceQueryTypeList miisQueries,
                                                 TransportSupportList transportOptions,
-                                                MakeBeforeBreakSupportList mbbSupportList)
+                                                MakeBeforeBreakSupportList mbbSupportList,
+                                                uint16_t transactionId)
     {
       NS_LOG_FUNCTION (this);
-      NS_ASSERT (m_currentTransaction != 0);
-      NS_ASSERT (m_currentTransaction->GetState () == Transaction::WAIT_RESPONSE_MSG);
-      NS_ASSERT (m_currentTransaction->IsToBeDeleted () == false);
       Ptr<CapabilityDiscoverRequestTransaction> transaction =
-        DynamicCast<CapabilityDiscoverRequestTransaction, Transaction> (m_currentTransaction);
-      NS_ASSERT (transaction != 0);
+        DynamicCast<CapabilityDiscoverRequestTransaction, Transaction> (LookupOutstandingRequest (transactionId));
+      if (transaction == 0)
+        {
+          return;
+        }
       transaction->CapabilityDiscoverConfirm (fromMihfId,
                                               status,
                                               networkTypeAddresses,
@@ -376,13 +950,11 @@ namespace ns3 {
     {
       NS_LOG_FUNCTION (this);
       MihHeader mihHeader;
-      uint16_t transactionId = m_nextTransactionId;
-      m_nextTransactionId++;
       mihHeader.SetVersion (MihHeader::VERSION_ONE);
       mihHeader.SetServiceId (MihHeader::MANAGEMENT);
       mihHeader.SetOpCode (MihHeader::REQUEST);
       mihHeader.SetActionId (MihHeader::MIH_EVENT_SUBSCRIBE);
-      mihHeader.SetTransactionId (transactionId);
+      mihHeader.SetAckRequest (m_ackRequested);
       mihHeader.SetPayloadLength (packet->GetSize ());
       packet->AddHeader (mihHeader);
 
@@ -391,10 +963,10 @@ namespace ns3 {
                                                   GetFromMihfId (), 
                                                   GetToMihfId (), 
                                                   GetToAddress (), 
-                                                  transactionId,
+                                                  0,
                                                   subscribeConfirmCallback);
       
-      eventSubscribeRequestTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyPendingCurrentRequestDone,
+      eventSubscribeRequestTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyOutstandingRequestDone,
                                                                              this));
       m_pendingRequestQueue.push_back (eventSubscribeRequestTransaction);
 
@@ -431,7 +1003,7 @@ namespace ns3 {
         {
           m_remoteEventDestinationTrap.AddLinkPduTxStatusCallback (linkPduTxStatusEventCallback8);
         }
-      Simulator::ScheduleNow (&Session::NotifyNewPendingRequest, this);
+      Simulator::ScheduleNow (&Session::NotifyNewPendingRequest, Ptr<Session> (this));
     }
     MihEventSubscribeConfirmCallback 
     Session::ReceiveEventSubscribeRequest (Ptr<Packet> packet, 
@@ -447,8 +1019,7 @@ namespace ns3 {
                                                    m_socket);
       eventSubscribeResponseTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyPendingResponseDone, 
                                                                               this));
-      NS_ASSERT (m_pendingResponseTransaction == 0);
-      m_pendingResponseTransaction = eventSubscribeResponseTransaction;
+      AddPendingResponse (eventSubscribeResponseTransaction);
       return MakeCallback (&EventSubscribeResponseTransaction::SendEventSubcribeResponse, 
                            eventSubscribeResponseTransaction);
     }
@@ -456,15 +1027,16 @@ namespace ns3 {
     Session::ReceiveEventSubscribeResponse (MihfId fromMihfId, 
                                             Status status, 
                                             LinkIdentifier linkIdentifier, 
-                                            EventList events)
+                                            EventList events,
+                                            uint16_t transactionId)
     {
       NS_LOG_FUNCTION (this);
-      NS_ASSERT (m_currentTransaction != 0);
-      NS_ASSERT (m_currentTransaction->GetState () == Transaction::WAIT_RESPONSE_MSG);
-      NS_ASSERT (m_currentTransaction->IsToBeDeleted () == false);
       Ptr<EventSubscribeRequestTransaction> transaction = 
-        DynamicCast<EventSubscribeRequestTransaction, Transaction> (m_currentTransaction);
-      NS_ASSERT (transaction != 0);
+        DynamicCast<EventSubscribeRequestTransaction, Transaction> (LookupOutstandingRequest (transactionId));
+      if (transaction == 0)
+        {
+          return;
+        }
       transaction->EventSubscribeConfirm (fromMihfId,
                                           status,
                                           linkIdentifier,
@@ -478,13 +1050,11 @@ namespace ns3 {
     {
       NS_LOG_FUNCTION (this);
       MihHeader mihHeader;
-      uint16_t transactionId = m_nextTransactionId;
-      m_nextTransactionId++;
       mihHeader.SetVersion (MihHeader::VERSION_ONE);
       mihHeader.SetServiceId (MihHeader::COMMAND);
       mihHeader.SetOpCode (MihHeader::REQUEST);
       mihHeader.SetActionId (MihHeader::MIH_LINK_GET_PARAMETERS);
-      mihHeader.SetTransactionId (transactionId);
+      mihHeader.SetAckRequest (m_ackRequested);
       mihHeader.SetPayloadLength (packet->GetSize ());
       packet->AddHeader (mihHeader);
       
@@ -493,12 +1063,12 @@ namespace ns3 {
                                                      GetFromMihfId (),
                                                      GetToMihfId (),
                                                      GetToAddress (),
-                                                     transactionId,
+                                                     0,
                                                      getParamtersConfirmCallback);
-      linkGetParametersRequestTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyPendingCurrentRequestDone, 
+      linkGetParametersRequestTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyOutstandingRequestDone, 
                                                                                 this));
       m_pendingRequestQueue.push_back (linkGetParametersRequestTransaction);
-      Simulator::ScheduleNow (&Session::NotifyNewPendingRequest, this);
+      Simulator::ScheduleNow (&Session::NotifyNewPendingRequest, Ptr<Session> (this));
     }
     MihLinkGetParametersConfirmCallback 
     Session::ReceiveLinkGetParametersRequest (Ptr<Packet> packet, 
@@ -514,8 +1084,7 @@ namespace ns3 {
                                                       m_socket);
       linkGetParametersResponseTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyPendingResponseDone, 
                                                                                  this));
-      NS_ASSERT (m_pendingResponseTransaction == 0);
-      m_pendingResponseTransaction = linkGetParametersResponseTransaction;
+      AddPendingResponse (linkGetParametersResponseTransaction);
       return MakeCallback (&LinkGetParametersResponseTransaction::SendLinkGetParametersResponse, 
                            linkGetParametersResponseTransaction);
     }
@@ -523,15 +1092,16 @@ namespace ns3 {
     Session::ReceiveLinkGetParametersResponse (MihfId mihfId, 
                                                Status status,
                                                DeviceStatesResponseList deviceStatesResponseList,
-                                               LinkStatusResponseList linkStatusResponseList)
+                                               LinkStatusResponseList linkStatusResponseList,
+                                               uint16_t transactionId)
     {
       NS_LOG_FUNCTION (this);
-      NS_ASSERT (m_currentTransaction != 0);
-      NS_ASSERT (m_currentTransaction->GetState () == Transaction::WAIT_RESPONSE_MSG);
-      NS_ASSERT (m_currentTransaction->IsToBeDeleted () == false);
       Ptr<LinkGetParametersRequestTransaction> transaction =
-        DynamicCast<LinkGetParametersRequestTransaction, Transaction> (m_currentTransaction);
-      NS_ASSERT (transaction != 0);
+        DynamicCast<LinkGetParametersRequestTransaction, Transaction> (LookupOutstandingRequest (transactionId));
+      if (transaction == 0)
+        {
+          return;
+        }
       transaction->LinkGetParametersConfirm (mihfId,
                                              status,
                                              deviceStatesResponseList,
@@ -545,13 +1115,11 @@ namespace ns3 {
     {
       NS_LOG_FUNCTION (this);
       MihHeader mihHeader;
-      uint16_t transactionId = m_nextTransactionId;
-      m_nextTransactionId++;
       mihHeader.SetVersion (MihHeader::VERSION_ONE);
       mihHeader.SetServiceId (MihHeader::COMMAND);
       mihHeader.SetOpCode (MihHeader::REQUEST);
       mihHeader.SetActionId (MihHeader::MIH_LINK_CONFIGURE_THRESHOLDS);
-      mihHeader.SetTransactionId (transactionId);
+      mihHeader.SetAckRequest (m_ackRequested);
       mihHeader.SetPayloadLength (packet->GetSize ());
       packet->AddHeader (mihHeader);
       
@@ -560,12 +1128,12 @@ namespace ns3 {
                                                            GetFromMihfId (),
                                                            GetToMihfId (),
                                                            GetToAddress (),
-                                                           transactionId,
+                                                           0,
                                                            configureThresholdsConfirmCallback);
-      linkConfigureThresholdsRequestTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyPendingCurrentRequestDone, 
+      linkConfigureThresholdsRequestTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyOutstandingRequestDone, 
                                                                                 this));
       m_pendingRequestQueue.push_back (linkConfigureThresholdsRequestTransaction);
-      Simulator::ScheduleNow (&Session::NotifyNewPendingRequest, this);
+      Simulator::ScheduleNow (&Session::NotifyNewPendingRequest, Ptr<Session> (this));
     }
     MihLinkConfigureThresholdsConfirmCallback 
     Session::ReceiveLinkConfigureThresholdsRequest (Ptr<Packet> packet, 
@@ -581,8 +1149,7 @@ namespace ns3 {
                                                             m_socket);
       linkConfigureThresholdsResponseTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyPendingResponseDone, 
                                                                                        this));
-      NS_ASSERT (m_pendingResponseTransaction == 0);
-      m_pendingResponseTransaction = linkConfigureThresholdsResponseTransaction;
+      AddPendingResponse (linkConfigureThresholdsResponseTransaction);
       return MakeCallback (&LinkConfigureThresholdsResponseTransaction::SendLinkConfigureThresholdsResponse, 
                            linkConfigureThresholdsResponseTransaction);
     }
@@ -590,15 +1157,16 @@ namespace ns3 {
     Session::ReceiveLinkConfigureThresholdsResponse (MihfId mihfId, 
                                                      Status status,
                                                      LinkIdentifier linkIdentifier, 
-                                                     LinkConfigurationStatusList linkConfigurationStatusList)
+                                                     LinkConfigurationStatusList linkConfigurationStatusList,
+                                                     uint16_t transactionId)
     {
       NS_LOG_FUNCTION (this);
-      NS_ASSERT (m_currentTransaction != 0);
-      NS_ASSERT (m_currentTransaction->GetState () == Transaction::WAIT_RESPONSE_MSG);
-      NS_ASSERT (m_currentTransaction->IsToBeDeleted () == false);
       Ptr<LinkConfigureThresholdsRequestTransaction> transaction =
-        DynamicCast<LinkConfigureThresholdsRequestTransaction, Transaction> (m_currentTransaction);
-      NS_ASSERT (transaction != 0);
+        DynamicCast<LinkConfigureThresholdsRequestTransaction, Transaction> (LookupOutstandingRequest (transactionId));
+      if (transaction == 0)
+        {
+          return;
+        }
       transaction->LinkConfigureThresholdsConfirm (mihfId,
                                                    status,
                                                    linkIdentifier,
@@ -606,5 +1174,68 @@ namespace ns3 {
       transaction->SetState (Transaction::SUCCESS);
       transaction->SetToBeDeleted ();
     }
+    void
+    Session::SendGetInformationRequest (Ptr<Packet> packet,
+                                        MihGetInformationConfirmCallback getInformationConfirmCallback)
+    {
+      NS_LOG_FUNCTION (this);
+      MihHeader mihHeader;
+      mihHeader.SetVersion (MihHeader::VERSION_ONE);
+      mihHeader.SetServiceId (MihHeader::INFORMATION);
+      mihHeader.SetOpCode (MihHeader::REQUEST);
+      mihHeader.SetActionId (MihHeader::MIH_GET_INFORMATION);
+      mihHeader.SetAckRequest (m_ackRequested);
+      mihHeader.SetPayloadLength (packet->GetSize ());
+      packet->AddHeader (mihHeader);
+
+      Ptr<GetInformationRequestTransaction> getInformationRequestTransaction =
+        Create<GetInformationRequestTransaction> (packet,
+                                                  GetFromMihfId (),
+                                                  GetToMihfId (),
+                                                  GetToAddress (),
+                                                  0,
+                                                  getInformationConfirmCallback);
+      getInformationRequestTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyOutstandingRequestDone,
+                                                                             this));
+      m_pendingRequestQueue.push_back (getInformationRequestTransaction);
+      Simulator::ScheduleNow (&Session::NotifyNewPendingRequest, Ptr<Session> (this));
+    }
+    MihGetInformationConfirmCallback
+    Session::ReceiveGetInformationRequest (Ptr<Packet> packet,
+                                           uint16_t transactionId)
+    {
+      NS_LOG_FUNCTION (this);
+      Ptr<GetInformationResponseTransaction> getInformationResponseTransaction =
+        Create<GetInformationResponseTransaction> (packet,
+                                                   GetFromMihfId (),
+                                                   GetToMihfId (),
+                                                   GetToAddress (),
+                                                   transactionId,
+                                                   m_socket);
+      getInformationResponseTransaction->SetNotifyDoneCallback (MakeCallback (&Session::NotifyPendingResponseDone,
+                                                                              this));
+      AddPendingResponse (getInformationResponseTransaction);
+      return MakeCallback (&GetInformationResponseTransaction::SendGetInformationResponse,
+                           getInformationResponseTransaction);
+    }
+    void
+    Session::ReceiveGetInformationResponse (MihfId mihfId,
+                                            Status status,
+                                            PoaDescriptorList poaDescriptorList,
+                                            uint16_t transactionId)
+    {
+      NS_LOG_FUNCTION (this);
+      Ptr<GetInformationRequestTransaction> transaction =
+        DynamicCast<GetInformationRequestTransaction, Transaction> (LookupOutstandingRequest (transactionId));
+      if (transaction == 0)
+        {
+          return;
+        }
+      transaction->GetInformationConfirm (mihfId,
+                                          status,
+                                          poaDescriptorList);
+      transaction->SetState (Transaction::SUCCESS);
+      transaction->SetToBeDeleted ();
+    }
   } // namespace mih
 } // namespace ns3
@@ -22,9 +22,14 @@
 #define   	MIH_SESSION_H
 
 #include <vector>
+#include <deque>
+#include <map>
 #include "ns3/ref-count-base.h"
 #include "ns3/packet.h"
 #include "ns3/socket.h"
+#include "ns3/nstime.h"
+#include "ns3/rtt-estimator.h"
+#include "mih-header.h"
 #include "mih-transaction.h"
 #include "mih-callbacks.h"
 #include "mih-remote-event-destination-trap.h"
@@ -53,6 +58,51 @@ namespace ns3 {
       void SetInitComplete (void);
       bool IsRegistered (void);
       void SetRegistered (void);
+      // Granted registrations, on either side, and deregistrations
+      // accepted by the registrar or confirmed to the registrant;
+      void SetRegistrationCallbacks (Callback<void, Ptr<Session>, uint32_t> registeredCallback,
+                                     Callback<void, Ptr<Session> > deRegisteredCallback);
+      // Whether this end asked for the registration, and the links it
+      // asked for, to refresh it;
+      bool IsRegistrant (void);
+      LinkIdentifierList GetRegistrationLinks (void);
+      void SetRegistrationLinks (LinkIdentifierList linkIdentifierList);
+      uint32_t GetRegistrationLifetime (void);
+      // Tick of the MihProtocol timer wheel at which the registration
+      // is refreshed or expires, zero when none is armed;
+      uint64_t GetRegistrationTimer (void);
+      void SetRegistrationTimer (uint64_t tick);
+      // Confirms the outstanding requests with a failure status, drops
+      // the pending responses and detaches the remote event source;
+      void Close (void);
+      bool IsClosed (void);
+      // Maximum number of requests waiting for their response at
+      // once; further requests are queued until a slot frees up.
+      void SetWindowSize (uint16_t windowSize);
+      uint16_t GetWindowSize (void);
+      // Requests released together are written with a single Send on
+      // a stream socket;
+      void SetStreamTransport (bool stream);
+      // Writes what the stream socket refused for lack of room in its
+      // send buffer, from its send callback;
+      void DrainSendBacklog (void);
+      // Requests without a response are sent again after a timeout
+      // estimated from the round trip times seen so far, and confirmed
+      // with a failure status after maxRetransmissions attempts.
+      void SetRetransmission (Time initialRto, Time minRto, Time maxRto,
+                              uint32_t maxRetransmissions, bool ackRequested);
+      void SetTransactionTraceCallbacks (Callback<void, MihfId, uint16_t, uint32_t> retransmitCallback,
+                                         Callback<void, MihfId, uint16_t> timeoutCallback);
+      // Every PDU sent to the peer, the time from each request to its
+      // response, and the number of requests waiting for a window slot;
+      void SetTrafficTraceCallbacks (Callback<void, MihfId, Ptr<const Packet> > pduSentCallback,
+                                     Callback<void, MihfId, uint16_t, Time> transactionLatencyCallback,
+                                     Callback<void, MihfId, uint32_t> queueDepthCallback);
+      // Acknowledgements and retransmitted requests, seen by MihProtocol
+      // before any decoding of the payload;
+      void ReceiveAck (uint16_t transactionId);
+      bool ReceiveDuplicateRequest (MihHeader requestHeader);
+      void AcknowledgeRequest (MihHeader requestHeader);
       // Register
       void SendRegisterRequest (Ptr<Packet> packet, 
 				MihRegisterConfirmCallback registerConfirmCallback);
@@ -60,7 +110,16 @@ namespace ns3 {
                                                           uint16_t transactionId);
       void ReceiveRegisterResponse (MihfId from, 
                                     Status status, 
-                                    uint32_t validLifeTime = 0);
+                                    uint32_t validLifeTime,
+                                    uint16_t transactionId);
+      // DeRegister
+      void SendDeRegisterRequest (Ptr<Packet> packet, 
+                                  MihDeRegisterConfirmCallback deRegisterConfirmCallback);
+      MihDeRegisterResponseCallback ReceiveDeRegisterRequest (Ptr<Packet> packet, 
+                                                              uint16_t transactionId);
+      void ReceiveDeRegisterResponse (MihfId from, 
+                                      Status status, 
+                                      uint16_t transactionId);
       // Capability Discover
       void SendCapabilityDiscoverRequest (Ptr<Packet> packet, 
                                           MihCapabilityDiscoverConfirmCallback capabilityDiscoverConfirmCallback);
@@ -73,7 +132,8 @@ namespace ns3 {
                                               MihCommandList commands,
                                               InformationServiceQueryTypeList miisQueries,
                                               TransportSupportList transportOptions,
-                                              MakeBeforeBreakSupportList mbbSupportList);
+                                              MakeBeforeBreakSupportList mbbSupportList,
+                                              uint16_t transactionId);
       // Event Subscribe
       void SendEventSubscribeRequest (Ptr<Packet> packet,
                                       EventList events,
@@ -91,7 +151,8 @@ namespace ns3 {
       void ReceiveEventSubscribeResponse (MihfId mihfId, 
                                           Status status, 
                                           LinkIdentifier linkIdentifier, 
-                                          EventList events);
+                                          EventList events,
+                                          uint16_t transactionId);
       // LingGetParamters
       void SendLinkGetParametersRequest (Ptr<Packet> packet,
                                          MihLinkGetParametersConfirmCallback getParamtersConfirmCallback);
@@ -100,7 +161,8 @@ namespace ns3 {
       void ReceiveLinkGetParametersResponse (MihfId mihfId, 
                                              Status status,
                                              DeviceStatesResponseList deviceStatesResponseList,
-                                             LinkStatusResponseList linkStatusResponseList);
+                                             LinkStatusResponseList linkStatusResponseList,
+                                             uint16_t transactionId);
       // LinkConfigureThresholds
       void SendLinkConfigureThresholdsRequest (Ptr<Packet> packet,
                                                MihLinkConfigureThresholdsConfirmCallback configureThresholdsConfiirmCallback);
@@ -109,7 +171,17 @@ namespace ns3 {
       void ReceiveLinkConfigureThresholdsResponse (MihfId mihfId, 
                                                    Status status,
                                                    LinkIdentifier linkIdentifier, 
-                                                   LinkConfigurationStatusList linkConfigurationStatusList);
+                                                   LinkConfigurationStatusList linkConfigurationStatusList,
+                                                   uint16_t transactionId);
+      // GetInformation
+      void SendGetInformationRequest (Ptr<Packet> packet,
+                                      MihGetInformationConfirmCallback getInformationConfirmCallback);
+      MihGetInformationConfirmCallback ReceiveGetInformationRequest (Ptr<Packet> packet,
+                                                                     uint16_t transactionId);
+      void ReceiveGetInformationResponse (MihfId mihfId,
+                                          Status status,
+                                          PoaDescriptorList poaDescriptorList,
+                                          uint16_t transactionId);
       // Remote events access methods;
       RemoteEventSourceTrap& GetRemoteEventSourceTrap (void);
       RemoteEventDestinationTrap& GetRemoteEventDestinationTrap (void);
@@ -122,13 +194,25 @@ namespace ns3 {
 /*       uint16_t GetNextTransactionId (void); */
 /*       void HandleRead (void); */
 
+      uint16_t AllocateTransactionId (void);
+      Time GetRetransmissionTimeout (uint32_t backoff);
+      void SendRequest (Ptr<Transaction> transaction);
+      void SendResponse (Ptr<Packet> packet);
+      void SendPdu (Ptr<Packet> packet);
+      void NotifyPduSent (Ptr<const Packet> packet);
+      void RetransmitTimeout (uint16_t transactionId);
+      void ExpireSentResponses (void);
       void NotifyNewPendingRequest (void);
       void NotifyResponseReceived (void);
-      void NotifyPendingResponseDone (void);
-      void NotifyPendingCurrentRequestDone (void);
+      void NotifyPendingResponseDone (uint16_t transactionId);
+      void NotifyOutstandingRequestDone (uint16_t transactionId);
+      void NotifyRegistrationGranted (uint32_t validLifeTime);
+      void NotifyDeRegistrationAccepted (void);
 
-      void DisposePendingResponse (void);
-      void DisposePendingCurrentRequest (void);
+      void DisposePendingResponse (uint16_t transactionId);
+      void DisposeOutstandingRequest (uint16_t transactionId);
+      void AddPendingResponse (Ptr<Transaction> transaction);
+      Ptr<Transaction> LookupOutstandingRequest (uint16_t transactionId);
       
       // Inner members;
       MihfId m_sourceMihfid;
@@ -138,17 +222,47 @@ namespace ns3 {
       Ptr<Socket> m_socket;
       bool m_initComplete;
       bool m_isRegistered;
+      bool m_closed;
+      bool m_registrant;
+      LinkIdentifierList m_registrationLinks;
+      uint32_t m_registrationLifetime;
+      uint64_t m_registrationTimer;
+      Callback<void, Ptr<Session>, uint32_t> m_registeredCallback;
+      Callback<void, Ptr<Session> > m_deRegisteredCallback;
       
       uint16_t m_nextTransactionId;
       uint16_t m_delay;
-      uint16_t m_maxSize;
+      uint16_t m_windowSize;
       TransactionQueue m_pendingRequestQueue;
-      Ptr<Transaction> m_currentTransaction;
-      Ptr<Transaction> m_pendingResponseTransaction;
+      TransactionTable m_outstandingRequests;
+      TransactionTable m_pendingResponses;
       TransactionQueue m_pendingEventQueue;
 
       RemoteEventDestinationTrap m_remoteEventDestinationTrap;
       RemoteEventSourceTrap m_remoteEventSourceTrap;
+
+      bool m_stream;
+      // Bytes the stream socket had no room for yet, in order;
+      std::deque<Ptr<Packet> > m_sendBacklog;
+      bool m_retransmit;
+      Ptr<RttEstimator> m_rtt;
+      Time m_initialRto;
+      Time m_minRto;
+      Time m_maxRto;
+      uint32_t m_maxRetransmissions;
+      bool m_ackRequested;
+      Callback<void, MihfId, uint16_t, uint32_t> m_retransmitCallback;
+      Callback<void, MihfId, uint16_t> m_timeoutCallback;
+      Callback<void, MihfId, Ptr<const Packet> > m_pduSentCallback;
+      Callback<void, MihfId, uint16_t, Time> m_transactionLatencyCallback;
+      Callback<void, MihfId, uint32_t> m_queueDepthCallback;
+      // Responses already sent, replayed to retransmitted requests;
+      struct SentResponse {
+        Ptr<Packet> packet;
+        Time expires;
+      };
+      std::map<uint16_t, SentResponse> m_sentResponses;
+      std::deque<std::pair<Time, uint16_t> > m_sentResponseExpiries;
     };
     typedef std::vector<Ptr<Session> > SessionList;
     typedef SessionList::iterator SessionListI;
@@ -40,14 +40,14 @@ namespace ns3 {
       return Tlv::GetSerializedSizeU64 ();
     }
     void
-    SignalStrength::TlvSerialize (Buffer &buffer) const
+    SignalStrength::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU64 (buffer, m_signalStrength, TLV_SIGNAL_STRENGTH);
+      Tlv::SerializeU64 (i, m_signalStrength, TLV_SIGNAL_STRENGTH);
     }
     uint32_t
-    SignalStrength::TlvDeserialize (Buffer &buffer)
+    SignalStrength::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU64 (buffer, m_signalStrength, TLV_SIGNAL_STRENGTH);
+      return Tlv::DeserializeU64 (i, m_signalStrength, TLV_SIGNAL_STRENGTH);
     }
   } // namespace mih
 } // namespace ns3
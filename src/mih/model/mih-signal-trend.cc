@@ -0,0 +1,86 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include <cmath>
+#include "ns3/simulator.h"
+#include "mih-signal-trend.h"
+
+namespace ns3 {
+  namespace mih {
+    SignalTrend::SignalTrend (void)
+    {
+      Reset ();
+    }
+    void
+    SignalTrend::Reset (void)
+    {
+      m_valid = false;
+      m_level = 0;
+      m_slope = 0;
+      m_lastUpdate = Seconds (0);
+    }
+    bool
+    SignalTrend::Update (double sample, Time levelTimeConstant, Time slopeTimeConstant)
+    {
+      Time now = Simulator::Now ();
+      if (!m_valid)
+        {
+          m_valid = true;
+          m_level = sample;
+          m_slope = 0;
+          m_lastUpdate = now;
+          return false;
+        }
+      double dt = (now - m_lastUpdate).GetSeconds ();
+      if (dt <= 0)
+        {
+          return false;
+        }
+      m_lastUpdate = now;
+      double predicted = m_level + m_slope * dt;
+      double alpha = 1 - std::exp (-dt / levelTimeConstant.GetSeconds ());
+      double beta = 1 - std::exp (-dt / slopeTimeConstant.GetSeconds ());
+      double level = predicted + alpha * (sample - predicted);
+      m_slope += beta * ((level - m_level) / dt - m_slope);
+      m_level = level;
+      return true;
+    }
+    double
+    SignalTrend::GetLevel (void) const
+    {
+      return m_level;
+    }
+    double
+    SignalTrend::GetSlope (void) const
+    {
+      return m_slope;
+    }
+    double
+    SignalTrend::GetTimeToThreshold (double threshold) const
+    {
+      if (m_level <= threshold)
+        {
+          return 0;
+        }
+      if (m_slope < 0)
+        {
+          return (threshold - m_level) / m_slope;
+        }
+      return -1;
+    }
+  } // namespace mih
+} // namespace ns3
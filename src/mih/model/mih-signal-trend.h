@@ -0,0 +1,53 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef   	MIH_SIGNAL_TREND_H
+#define   	MIH_SIGNAL_TREND_H
+
+#include "ns3/nstime.h"
+
+namespace ns3 {
+  namespace mih {
+    // Holt smoothing of the serving link signal strength or quality,
+    // sampled at irregular times: a level and a slope per second. The
+    // gains depend on the time since the previous sample, so that a
+    // burst of samples weighs as much as a single one spread over the
+    // same time. Link SAPs use it to tell, and to give in their
+    // LinkGoingDown, how soon the link is expected to be lost;
+    class SignalTrend {
+    public:
+      SignalTrend (void);
+      void Reset (void);
+      // False for the first sample after a reset and for samples
+      // taken at the time of the previous one, which only set or keep
+      // the level;
+      bool Update (double sample, Time levelTimeConstant, Time slopeTimeConstant);
+      double GetLevel (void) const;
+      double GetSlope (void) const;
+      // Seconds until the level is predicted to fall to threshold:
+      // zero once it is below, negative while it is not falling;
+      double GetTimeToThreshold (double threshold) const;
+    private:
+      bool m_valid;
+      double m_level;
+      double m_slope;
+      Time m_lastUpdate;
+    };
+  } // namespace mih
+} // namespace ns3
+
+#endif 	    /* !MIH_SIGNAL_TREND_H */
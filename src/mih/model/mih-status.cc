@@ -51,16 +51,16 @@ namespace ns3 {
       os << "Status = " << static_cast<int> (m_type) << std::endl;
     }
     void
-    Status::TlvSerialize (Buffer &buffer) const
+    Status::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU8 (buffer, static_cast<uint8_t> (m_type), TLV_STATUS);
+      Tlv::SerializeU8 (i, static_cast<uint8_t> (m_type), TLV_STATUS);
     }
     uint32_t
-    Status::TlvDeserialize (Buffer &buffer)
+    Status::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t bytesRead = 0;
       uint8_t typ = 0;
-      bytesRead += Tlv::DeserializeU8 (buffer, typ, TLV_STATUS);
+      bytesRead += Tlv::DeserializeU8 (i, typ, TLV_STATUS);
       m_type = static_cast<enum Status::Type> (typ);
       return bytesRead;
     }
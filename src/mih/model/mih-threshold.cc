@@ -81,34 +81,26 @@ namespace ns3 {
       return 1 + lengthOfLengthField + payloadLength;
     }
     void 
-    Threshold::TlvSerialize (Buffer &buffer) const
+    Threshold::TlvSerialize (Buffer::Iterator &i) const
     {
-      uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
 
       payloadLength = Tlv::GetSerializedSizeU16 () + // m_value;
         Tlv::GetSerializedSizeU8 (); // m_xdir
-      lengthOfLengthField = 1;
 
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field + Length field only;
-      
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (GetTlvTypeValue ()); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length field;
       
-      Tlv::SerializeU16 (buffer, m_value, TLV_THRESHOLD_VALUE);
-      Tlv::SerializeU8 (buffer, static_cast<uint8_t> (m_crossDirection), TLV_THRESHOLD_X_DIRECTION);
+      Tlv::SerializeU16 (i, m_value, TLV_THRESHOLD_VALUE);
+      Tlv::SerializeU8 (i, static_cast<uint8_t> (m_crossDirection), TLV_THRESHOLD_X_DIRECTION);
     }
     uint32_t 
-    Threshold::TlvDeserialize (Buffer &buffer)
+    Threshold::TlvDeserialize (Buffer::Iterator &i)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
 
-      Buffer::Iterator i = buffer.Begin ();
       uint8_t vl = i.ReadU8 ();
       NS_LOG_WARN ("GetTlvTypeValue () = " << (int)GetTlvTypeValue () << "; TLV_THRESHOLD = " << (int)TLV_THRESHOLD << "; i.ReadU8 () = " << (int)vl);
       NS_ASSERT (vl == GetTlvTypeValue ());
@@ -117,11 +109,10 @@ namespace ns3 {
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
 
-      totalBytesRead += Tlv::DeserializeU16 (buffer, m_value, TLV_THRESHOLD_VALUE);
+      totalBytesRead += Tlv::DeserializeU16 (i, m_value, TLV_THRESHOLD_VALUE);
       uint8_t xdir = 0;
-      totalBytesRead += Tlv::DeserializeU8 (buffer, xdir, TLV_THRESHOLD_X_DIRECTION);
+      totalBytesRead += Tlv::DeserializeU8 (i, xdir, TLV_THRESHOLD_X_DIRECTION);
       m_crossDirection = static_cast<enum CrossDirectionCode> (xdir);
       return totalBytesRead;
     }    
@@ -135,10 +126,20 @@ namespace ns3 {
     {
       Tlv::Serialize<Threshold> (buffer, thresholdList, TLV_THRESHOLD_LIST);
     }
+    void
+    TlvSerialize (Buffer::Iterator &i, const ThresholdList &thresholdList)
+    {
+      Tlv::Serialize<Threshold> (i, thresholdList, TLV_THRESHOLD_LIST);
+    }
     uint32_t
     TlvDeserialize (Buffer &buffer, ThresholdList &thresholdList)
     {
       return Tlv::Deserialize<Threshold> (buffer, thresholdList, TLV_THRESHOLD_LIST);      
     }
+    uint32_t
+    TlvDeserialize (Buffer::Iterator &i, ThresholdList &thresholdList)
+    {
+      return Tlv::Deserialize<Threshold> (i, thresholdList, TLV_THRESHOLD_LIST);
+    }
   } // namespace mih
 } // namespace ns3
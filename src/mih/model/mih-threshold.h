@@ -42,8 +42,10 @@ namespace ns3 {
       enum CrossDirectionCode GetCrossDirection (void);
       virtual void Print (std::ostream &os) const;
       virtual uint32_t GetTlvSerializedSize (void) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       static Ptr<Threshold> CreateFromTlvType (uint8_t tlvTypeValue);
       TLV_TYPE_HELPER_HEADER (Threshold);
     protected:
@@ -54,7 +56,9 @@ namespace ns3 {
     typedef ThresholdList::iterator ThresholdListI;
     uint32_t GetTlvSerializedSize (const ThresholdList &thresholdList);
     void TlvSerialize (Buffer &buffer, const ThresholdList &thresholdList);
+    void TlvSerialize (Buffer::Iterator &i, const ThresholdList &thresholdList);
     uint32_t TlvDeserialize (Buffer &buffer, ThresholdList &thresholdList);
+    uint32_t TlvDeserialize (Buffer::Iterator &i, ThresholdList &thresholdList);
   } // namespace mih
 } // namespace ns3
 
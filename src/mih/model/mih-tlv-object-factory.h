@@ -21,50 +21,84 @@
 #ifndef   	MIH_TLV_OBJECT_FACTORY_H
 #define   	MIH_TLV_OBJECT_FACTORY_H
 
-#include <map>
 #include <stdint.h>
 #include "ns3/ptr.h"
 #include "ns3/assert.h"
-#include "ns3/callback.h"
 
 namespace ns3 {
   namespace mih {
     /**
-     * This factory class bears the callback map used to create object
-     * based on their tlv type value. The template type T is that of
-     * the parent class type.
+     * This factory class bears the table of constructors used to
+     * create objects based on their tlv type value. The template type
+     * T is that of the parent class type. The tlv type space being a
+     * single byte, the table is indexed directly by the tlv type and
+     * filled at load time by TLV_OBJECT_FACTORY_REGISTER.
      */
 
     template <typename T>
       class TlvObjectFactory
       {
       public:
-	Ptr<T> Create (uint8_t tlv);
-	void AddTlvTypeConstructor 
-	  (uint8_t tlv, Callback<Ptr<T> > cb);
+        typedef Ptr<T> (* Constructor) (void);
+        static TlvObjectFactory<T> *Get (void);
+	Ptr<T> Create (uint8_t tlv) const;
+	void AddTlvTypeConstructor (uint8_t tlv, Constructor constructor);
       private:
-	std::map<uint8_t, Callback<Ptr<T> > > m_constructorMap;
+        TlvObjectFactory (void);
+	Constructor m_constructors[256];
       };
 
+    template <typename T>
+      class TlvObjectFactoryRegistration
+      {
+      public:
+        TlvObjectFactoryRegistration (uint8_t tlv, typename TlvObjectFactory<T>::Constructor constructor)
+        {
+          TlvObjectFactory<T>::Get ()->AddTlvTypeConstructor (tlv, constructor);
+        }
+      };
+
+    template <typename T>
+    TlvObjectFactory<T>::TlvObjectFactory (void)
+      {
+        for (uint32_t tlv = 0; tlv < 256; tlv++)
+          {
+            m_constructors[tlv] = 0;
+          }
+      }
+    template <typename T>
+    TlvObjectFactory<T> *
+    TlvObjectFactory<T>::Get (void)
+      {
+        // Not a SimulationSingleton: registrations happen once, before
+        // main, and must outlive Simulator::Destroy;
+        static TlvObjectFactory<T> factory;
+        return &factory;
+      }
     template <typename T>
     Ptr<T>
-    TlvObjectFactory<T>::Create (uint8_t tlv)
+    TlvObjectFactory<T>::Create (uint8_t tlv) const
       {
-	NS_ASSERT (m_constructorMap.count (tlv) == 1);
-	return (m_constructorMap[tlv] ());
+	NS_ASSERT_MSG (m_constructors[tlv] != 0, "No constructor registered for tlv type " << (uint32_t) tlv);
+	return m_constructors[tlv] ();
       }
     template <typename T>
     void
-    TlvObjectFactory<T>::AddTlvTypeConstructor
-      (uint8_t tlv, Callback<Ptr<T> > cb)
+    TlvObjectFactory<T>::AddTlvTypeConstructor (uint8_t tlv, Constructor constructor)
        {
-	 if (m_constructorMap.count (tlv) != 0)
+	 if (m_constructors[tlv] != 0)
 	   {
 	     return;
 	   }
-	 m_constructorMap[tlv] = cb;
+	 m_constructors[tlv] = constructor;
        }
   } // namespace mih
 } // namespace ns3
 
+// Registers child, a CHOICE_HELPER class, as the parent alternative
+// decoded from tlvTypeValue. To be used next to TLV_TYPE_HELPER_IMPLEM;
+#define TLV_OBJECT_FACTORY_REGISTER(child,parent,tlvTypeValue)          \
+  static ns3::mih::TlvObjectFactoryRegistration<parent>                 \
+  g_##child##TlvObjectFactoryRegistration (tlvTypeValue, &child::Create);
+
 #endif 	    /* !MIH_TLV_OBJECT_FACTORY_H */
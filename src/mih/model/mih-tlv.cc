@@ -22,19 +22,47 @@
 #include "ns3/assert.h"
 #include "ns3/address.h"
 #include "mih-tlv.h"
+#include "mih-message-arena.h"
 
-NS_LOG_COMPONENT_DEFINE ("Tlv");
+NS_LOG_COMPONENT_DEFINE ("MihTlv");
 
 namespace ns3 {
   namespace mih {
     Tlv::~Tlv (void) {
     }
+    void *
+    Tlv::operator new (size_t size)
+    {
+      return MihMessageArena::Allocate (size);
+    }
+    void
+    Tlv::operator delete (void *p)
+    {
+      MihMessageArena::Deallocate (p);
+    }
     uint8_t
     Tlv::RegisterTlvType (void) {
       static uint8_t typ = 0;
       typ++;
       return typ;
     }
+    void
+    Tlv::TlvSerialize (Buffer &buffer) const
+    {
+      uint32_t formerBufferSize = buffer.GetSize ();
+      buffer.AddAtEnd (GetTlvSerializedSize ());
+      Buffer::Iterator i = buffer.Begin ();
+      i.Next (formerBufferSize);
+      TlvSerialize (i);
+    }
+    uint32_t
+    Tlv::TlvDeserialize (Buffer &buffer)
+    {
+      Buffer::Iterator i = buffer.Begin ();
+      uint32_t bytesRead = TlvDeserialize (i);
+      buffer.RemoveAtStart (bytesRead);
+      return bytesRead;
+    }
     uint32_t 
     Tlv::ComputeLengthOfLengthField (uint32_t payloadLength)
     {
@@ -77,21 +105,28 @@ namespace ns3 {
       else if (payloadLength <= (1 << 16))
         {
           i.WriteU8 (128 + 2);
-          i.WriteU8 (((payloadLength - 128) >> 8) && 0xff);
-          i.WriteU8 ((payloadLength - 128) && 0xff);
+          i.WriteU8 (((payloadLength - 128) >> 8) & 0xff);
+          i.WriteU8 ((payloadLength - 128) & 0xff);
         }
       else if (payloadLength <= (1 << 24))
         {
           i.WriteU8 (128 + 3);
-          i.WriteU8 (((payloadLength - 128) >> 16) && 0xff);
-          i.WriteU8 (((payloadLength - 128) >> 8) && 0xff);
-          i.WriteU8 ((payloadLength - 128) && 0xff);
+          i.WriteU8 (((payloadLength - 128) >> 16) & 0xff);
+          i.WriteU8 (((payloadLength - 128) >> 8) & 0xff);
+          i.WriteU8 ((payloadLength - 128) & 0xff);
         }
       else
         {
           NS_ASSERT (payloadLength <= (1 << 24));
         }
     }
+    void
+    Tlv::ReadTypeField (Buffer::Iterator &i, uint8_t tlvTypeValue)
+    {
+      uint8_t vl = i.ReadU8 ();
+      NS_LOG_INFO ("TlvTypeValue = " << (int) tlvTypeValue << " i.ReadU8 () = " << (int) vl);
+      NS_ASSERT_MSG (vl == tlvTypeValue, "TLV type values mismatch!");
+    }
     uint32_t 
     Tlv::ReadPayloadLengthField (Buffer::Iterator &i, uint32_t roomSize, uint32_t &payloadLengthValue)
     {
@@ -147,11 +182,17 @@ namespace ns3 {
                     Address address, 
                     uint8_t tlvTypeValue)
     {
-      uint32_t roomSize = GetSerializedSize (address);
       uint32_t formerBufferSize = buffer.GetSize ();
-      buffer.AddAtEnd (roomSize);
+      buffer.AddAtEnd (GetSerializedSize (address));
       Buffer::Iterator i = buffer.Begin ();
       i.Next (formerBufferSize);
+      Tlv::Serialize (i, address, tlvTypeValue);
+    }
+    void
+    Tlv::Serialize (Buffer::Iterator &i,
+                    Address address,
+                    uint8_t tlvTypeValue)
+    {
       i.WriteU8 (tlvTypeValue);
       i.WriteU8 (address.GetSerializedSize ());
       /*i.WriteU8 (address.m_type);
@@ -178,26 +219,21 @@ namespace ns3 {
     Tlv::Deserialize (Buffer &buffer, Address &address, uint8_t tlvTypeValue)
     {
       Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT_MSG (i.ReadU8 () == tlvTypeValue, "Address TLV type values mismatch!");
+      uint32_t bytesRead = Tlv::Deserialize (i, address, tlvTypeValue);
+      buffer.RemoveAtStart (bytesRead);
+      return bytesRead;
+    }
+    uint32_t
+    Tlv::Deserialize (Buffer::Iterator &i, Address &address, uint8_t tlvTypeValue)
+    {
+      Tlv::ReadTypeField (i, tlvTypeValue);
       i.Next (1);
-      /*address.m_type = i.ReadU8 ();
-      address.m_len = i.ReadU8 ();
-      uint8_t *data = address.m_data;
-      for (uint32_t j = 0; j < address.m_len; j++, data++)
-        {
-          *data = i.ReadU8 ();
-        }
-      */
       uint8_t buf[Address::MAX_SIZE];
       buf[0] = i.ReadU8 ();
       buf[1] = i.ReadU8 ();
-      uint8_t *data = buf + 2;
-      for (uint32_t j = 0; j < address.GetLength (); j++, data++)
-        {
-          *data = i.ReadU8 ();
-        }
+      NS_ASSERT (buf[1] <= Address::MAX_SIZE - 2);
+      i.Read (buf + 2, buf[1]);
       address.CopyAllFrom (buf, Address::MAX_SIZE);
-      buffer.RemoveAtStart (1 + 1 + 1 + 1 + address.GetLength ());
       return 1 + 1 + 1 + 1 + address.GetLength ();
     }
     // TLV for bool values;
@@ -214,14 +250,31 @@ namespace ns3 {
       element ? Tlv::SerializeU8 (buffer, 1, tlvTypeValue) :
         Tlv::SerializeU8 (buffer, 0, tlvTypeValue);
     }
+    void
+    Tlv::SerializeBool (Buffer::Iterator &i,
+                        bool element,
+                        uint8_t tlvTypeValue)
+    {
+      Tlv::SerializeU8 (i, element ? 1 : 0, tlvTypeValue);
+    }
     uint32_t
     Tlv::DeserializeBool (Buffer &buffer, 
                           bool &element, 
                           uint8_t tlvTypeValue)
+    {
+      Buffer::Iterator i = buffer.Begin ();
+      uint32_t bytesRead = Tlv::DeserializeBool (i, element, tlvTypeValue);
+      buffer.RemoveAtStart (bytesRead);
+      return bytesRead;
+    }
+    uint32_t
+    Tlv::DeserializeBool (Buffer::Iterator &i,
+                          bool &element,
+                          uint8_t tlvTypeValue)
     {
       uint8_t res;
       uint32_t size;
-      size = Tlv::DeserializeU8 (buffer, res, tlvTypeValue);
+      size = Tlv::DeserializeU8 (i, res, tlvTypeValue);
       if (res == 0)
         {
           element = false;
@@ -235,8 +288,7 @@ namespace ns3 {
           NS_ASSERT (res == 0 || res == 1);
         }
       return size;
-      
-    }    
+    }
     // TLV for uint8_t values;
     uint32_t 
     Tlv::GetSerializedSizeU8 (void)
@@ -248,11 +300,17 @@ namespace ns3 {
                       uint8_t element, 
                       uint8_t tlvTypeValue) 
     {
-      uint32_t roomSize = Tlv::GetSerializedSizeU8();
       uint32_t formerBufferSize = buffer.GetSize ();
-      buffer.AddAtEnd (roomSize);
+      buffer.AddAtEnd (Tlv::GetSerializedSizeU8 ());
       Buffer::Iterator i = buffer.Begin ();
       i.Next (formerBufferSize);
+      Tlv::SerializeU8 (i, element, tlvTypeValue);
+    }
+    void
+    Tlv::SerializeU8 (Buffer::Iterator &i,
+                      uint8_t element,
+                      uint8_t tlvTypeValue)
+    {
       i.WriteU8 (tlvTypeValue);
       i.WriteU8 (1);
       i.WriteU8 (element);
@@ -263,12 +321,18 @@ namespace ns3 {
                         uint8_t tlvTypeValue)
     {
       Buffer::Iterator i = buffer.Begin ();
-      uint8_t vl = i.ReadU8 ();
-      NS_LOG_INFO ("TlvTypeValue = " << (int) tlvTypeValue << " i.ReadU8 () = " << (int) vl);
-      NS_ASSERT (vl == tlvTypeValue);
+      uint32_t bytesRead = Tlv::DeserializeU8 (i, element, tlvTypeValue);
+      buffer.RemoveAtStart (bytesRead);
+      return bytesRead;
+    }
+    uint32_t
+    Tlv::DeserializeU8 (Buffer::Iterator &i,
+                        uint8_t &element,
+                        uint8_t tlvTypeValue)
+    {
+      Tlv::ReadTypeField (i, tlvTypeValue);
       i.Next ();
       element = i.ReadU8 ();
-      buffer.RemoveAtStart (1 + 1 + 1);
       return 1 + 1 + 1;
     }
     // TLV for uint16_t values;
@@ -282,30 +346,40 @@ namespace ns3 {
                        uint16_t element, 
                        uint8_t tlvTypeValue)
     {
-      uint32_t roomSize = Tlv::GetSerializedSizeU16 ();
       uint32_t formerBufferSize = buffer.GetSize ();
-      buffer.AddAtEnd (roomSize);
+      buffer.AddAtEnd (Tlv::GetSerializedSizeU16 ());
       Buffer::Iterator i = buffer.Begin ();
       i.Next (formerBufferSize);
+      Tlv::SerializeU16 (i, element, tlvTypeValue);
+    }
+    void
+    Tlv::SerializeU16 (Buffer::Iterator &i,
+                       uint16_t element,
+                       uint8_t tlvTypeValue)
+    {
       i.WriteU8 (tlvTypeValue);
       i.WriteU8 (2);
       i.WriteU16 (element);
-      
     }
     uint32_t 
-    Tlv::DeserializeU16 (Buffer &buffer, 
-                         uint16_t &element, 
+    Tlv::DeserializeU16 (Buffer &buffer,
+                         uint16_t &element,
                          uint8_t tlvTypeValue)
     {
       Buffer::Iterator i = buffer.Begin ();
-      uint8_t vl = i.ReadU8 ();
-      NS_LOG_INFO ("TlvTypeValue = " << (int) tlvTypeValue << " i.ReadU8 () = " << (int) vl);
-      NS_ASSERT (vl == tlvTypeValue);
+      uint32_t bytesRead = Tlv::DeserializeU16 (i, element, tlvTypeValue);
+      buffer.RemoveAtStart (bytesRead);
+      return bytesRead;
+    }
+    uint32_t
+    Tlv::DeserializeU16 (Buffer::Iterator &i,
+                         uint16_t &element,
+                         uint8_t tlvTypeValue)
+    {
+      Tlv::ReadTypeField (i, tlvTypeValue);
       i.Next ();
       element = i.ReadU16 ();
-      buffer.RemoveAtStart (1 + 1 + 2);
       return 1 + 1 + 2;
-      
     }
     // TLV for uint32_t values;
     uint32_t 
@@ -318,11 +392,17 @@ namespace ns3 {
                        uint32_t element, 
                        uint8_t tlvTypeValue)
     {
-      uint32_t roomSize = Tlv::GetSerializedSizeU32 ();
       uint32_t formerBufferSize = buffer.GetSize ();
-      buffer.AddAtEnd (roomSize);
+      buffer.AddAtEnd (Tlv::GetSerializedSizeU32 ());
       Buffer::Iterator i = buffer.Begin ();
       i.Next (formerBufferSize);
+      Tlv::SerializeU32 (i, element, tlvTypeValue);
+    }
+    void
+    Tlv::SerializeU32 (Buffer::Iterator &i,
+                       uint32_t element,
+                       uint8_t tlvTypeValue)
+    {
       i.WriteU8 (tlvTypeValue);
       i.WriteU8 (4);
       i.WriteU32 (element);
@@ -333,11 +413,19 @@ namespace ns3 {
                          uint8_t tlvTypeValue)
     {
       Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == tlvTypeValue);
+      uint32_t bytesRead = Tlv::DeserializeU32 (i, element, tlvTypeValue);
+      buffer.RemoveAtStart (bytesRead);
+      return bytesRead;
+    }
+    uint32_t
+    Tlv::DeserializeU32 (Buffer::Iterator &i,
+                         uint32_t &element,
+                         uint8_t tlvTypeValue)
+    {
+      Tlv::ReadTypeField (i, tlvTypeValue);
       i.Next ();
       element = i.ReadU32 ();
-      buffer.RemoveAtStart (1 + 1 + 4);
-      return 1 + 1 + 4;      
+      return 1 + 1 + 4;
     }
     // TLV for uint64_t values;
     uint32_t
@@ -350,25 +438,39 @@ namespace ns3 {
                        uint64_t element, 
                        uint8_t tlvTypeValue)
     {
-      uint32_t roomSize = Tlv::GetSerializedSizeU64 ();
       uint32_t formerBufferSize = buffer.GetSize ();
-      buffer.AddAtEnd (roomSize);
+      buffer.AddAtEnd (Tlv::GetSerializedSizeU64 ());
       Buffer::Iterator i = buffer.Begin ();
       i.Next (formerBufferSize);
+      Tlv::SerializeU64 (i, element, tlvTypeValue);
+    }
+    void
+    Tlv::SerializeU64 (Buffer::Iterator &i,
+                       uint64_t element,
+                       uint8_t tlvTypeValue)
+    {
       i.WriteU8 (tlvTypeValue);
       i.WriteU8 (8);
       i.WriteU64 (element);
     }
     uint32_t 
-    Tlv::DeserializeU64 (Buffer &buffer, 
+    Tlv::DeserializeU64 (Buffer &buffer,
                          uint64_t &element,
                          uint8_t tlvTypeValue)
     {
       Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == tlvTypeValue);
+      uint32_t bytesRead = Tlv::DeserializeU64 (i, element, tlvTypeValue);
+      buffer.RemoveAtStart (bytesRead);
+      return bytesRead;
+    }
+    uint32_t
+    Tlv::DeserializeU64 (Buffer::Iterator &i,
+                         uint64_t &element,
+                         uint8_t tlvTypeValue)
+    {
+      Tlv::ReadTypeField (i, tlvTypeValue);
       i.Next ();
       element = i.ReadU64 ();
-      buffer.RemoveAtStart (1 + 1 + 8);
       return 1 + 1 + 8;
     }
     // TLV for string values;
@@ -389,18 +491,21 @@ namespace ns3 {
                           uint8_t tlvTypeValue)
     {
       uint32_t formerBufferSize = buffer.GetSize ();
-      uint32_t lengthOfLengthField = 0;
-      uint32_t payloadLength = 0;
-      
-      payloadLength = element.length ();
-      NS_ASSERT (payloadLength <= 253);
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-      buffer.AddAtEnd (1 + lengthOfLengthField + payloadLength);       
+      buffer.AddAtEnd (Tlv::GetSerializedSizeString (element));
       Buffer::Iterator i = buffer.Begin ();
       i.Next (formerBufferSize);
+      Tlv::SerializeString (i, element, tlvTypeValue);
+    }
+    void
+    Tlv::SerializeString (Buffer::Iterator &i,
+                          std::string element,
+                          uint8_t tlvTypeValue)
+    {
+      uint32_t payloadLength = element.length ();
+      NS_ASSERT (payloadLength <= 253);
       i.WriteU8 (tlvTypeValue); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length field;
-      for (uint32_t j = 0; j < element.length (); j++)
+      for (uint32_t j = 0; j < payloadLength; j++)
         {
           i.WriteU8 (element[j]);
         }
@@ -409,25 +514,33 @@ namespace ns3 {
     Tlv::DeserializeString (Buffer &buffer,
                             std::string &element, 
                             uint8_t tlvTypeValue)
+    {
+      Buffer::Iterator i = buffer.Begin ();
+      uint32_t bytesRead = Tlv::DeserializeString (i, element, tlvTypeValue);
+      buffer.RemoveAtStart (bytesRead);
+      return bytesRead;
+    }
+    uint32_t
+    Tlv::DeserializeString (Buffer::Iterator &i,
+                            std::string &element,
+                            uint8_t tlvTypeValue)
     {
       uint32_t totalBytesRead = 0;
       uint32_t roomSize;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT (i.ReadU8 () == tlvTypeValue);
+      Tlv::ReadTypeField (i, tlvTypeValue);
       totalBytesRead++;
       roomSize = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, roomSize, payloadLengthValue);
 
-      element = "";
+      element.resize (payloadLengthValue);
       for (uint32_t j = 0; j < payloadLengthValue; j++)
         {
-          element += i.ReadU8 ();
-          totalBytesRead++;
+          element[j] = i.ReadU8 ();
         }
-      buffer.RemoveAtStart (totalBytesRead);
+      totalBytesRead += payloadLengthValue;
       return totalBytesRead;
     }
   } // namespace mih
@@ -148,15 +148,51 @@ namespace ns3 {
       TLV_SCAN_RESPONSE_LIST = TLV_EXPERIMENTAL + 47,
       TLV_LINK_ACTION_RESPONSE =  TLV_EXPERIMENTAL + 48,
       TLV_LINK_ACTION_RESULT = TLV_EXPERIMENTAL + 50,
+      TLV_EVENT_BATCH_ENTRY = TLV_EXPERIMENTAL + 51,
+      TLV_POA_DESCRIPTOR = TLV_EXPERIMENTAL + 52,
+      TLV_POA_DESCRIPTOR_LIST = TLV_EXPERIMENTAL + 53,
+      TLV_POA_LOCATION = TLV_EXPERIMENTAL + 54,
+      TLV_NETWORK_COST = TLV_EXPERIMENTAL + 55,
+      TLV_QUERY_RADIUS = TLV_EXPERIMENTAL + 56,
+      TLV_QUERY_MAX_RESULTS = TLV_EXPERIMENTAL + 57,
+      TLV_LINK_PARAMETER_LTE = TLV_EXPERIMENTAL + 58,
+      TLV_LINK_PARAMETER_80216 = TLV_EXPERIMENTAL + 59,
     };
 
     class Tlv {
     public:
       virtual ~Tlv (void);
+      // Instances created on the heap come from the current
+      // MihMessageArena, if any, and from the global operator new
+      // otherwise, without any header;
+      static void *operator new (size_t size);
+      static void operator delete (void *p);
       // TTLV-Serialization interface
       virtual uint32_t GetTlvSerializedSize (void) const = 0;
-      virtual void TlvSerialize (Buffer &buffer) const = 0;
-      virtual uint32_t TlvDeserialize (Buffer &buffer) = 0;
+      /**
+       * \brief Write the TLV representation at the iterator position.
+       *
+       * The caller must have reserved GetTlvSerializedSize () bytes
+       * beforehand; nested TLVs are written through the same iterator
+       * so that a whole message is encoded in a single pass.
+       */
+      virtual void TlvSerialize (Buffer::Iterator &i) const = 0;
+      /**
+       * \brief Append the TLV representation at the end of buffer.
+       *
+       * Room is reserved once for the whole TLV, then the iterator
+       * variant is used.
+       */
+      void TlvSerialize (Buffer &buffer) const;
+      /**
+       * \brief Read the TLV representation at the iterator position.
+       * \return Number of bytes read; the iterator is left past the TLV.
+       */
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i) = 0;
+      /**
+       * \brief Read the TLV at the start of buffer and remove it.
+       */
+      uint32_t TlvDeserialize (Buffer &buffer);
       // The following are defined through TLV_HELPER_xxx macros, so
       // there is no need to account for them.
       virtual uint8_t GetTlvType (void) const = 0;
@@ -166,6 +202,10 @@ namespace ns3 {
       static uint32_t ComputeLengthOfLengthField (uint32_t payloadLength);
       static void WritePayloadLengthField (Buffer::Iterator &i, 
                                            uint32_t payloadLength);
+      /**
+       * \brief Consume the type field and check it against tlvTypeValue.
+       */
+      static void ReadTypeField (Buffer::Iterator &i, uint8_t tlvTypeValue);
       /**
        * \brief Read the payload length field from a TLV representation.
        * \return Number of bytes read.
@@ -180,66 +220,116 @@ namespace ns3 {
       static void Serialize (Buffer &buffer, 
                              const std::vector<Ptr<T> > &tList, 
                              uint8_t tlvTypeValue);
+      template<typename T>
+      static void Serialize (Buffer::Iterator &i, 
+                             const std::vector<Ptr<T> > &tList, 
+                             uint8_t tlvTypeValue);
       template <typename T>
       static uint32_t Deserialize (Buffer &buffer, 
                                    std::vector<Ptr<T> > &tList, 
                                    uint8_t tlvTypeValue);
+      template <typename T>
+      static uint32_t Deserialize (Buffer::Iterator &i, 
+                                   std::vector<Ptr<T> > &tList, 
+                                   uint8_t tlvTypeValue);
       // TLV for Address values;
       static uint32_t GetSerializedSize (Address address);
       static void Serialize (Buffer &buffer,
                              Address address, 
                              uint8_t tlvTypeValue);
+      static void Serialize (Buffer::Iterator &i,
+                             Address address,
+                             uint8_t tlvTypeValue);
       static uint32_t Deserialize (Buffer &buffer, 
                                    Address &address, 
                                    uint8_t tlvTypeValue);
+      static uint32_t Deserialize (Buffer::Iterator &i,
+                                   Address &address,
+                                   uint8_t tlvTypeValue);
       // TLV for bool values;
       static uint32_t GetSerializedSizeBool (void);
       static void SerializeBool (Buffer &buffer, 
                                  bool element, 
                                  uint8_t tlvTypeValue);
+      static void SerializeBool (Buffer::Iterator &i,
+                                 bool element,
+                                 uint8_t tlvTypeValue);
       static uint32_t DeserializeBool (Buffer &buffer, 
                                        bool &element, 
                                        uint8_t tlvTypeValue);    
+      static uint32_t DeserializeBool (Buffer::Iterator &i,
+                                       bool &element,
+                                       uint8_t tlvTypeValue);
       // TLV for uint8_t values;
       static uint32_t GetSerializedSizeU8 (void);
       static void SerializeU8 (Buffer &buffer, 
                                uint8_t element, 
                                uint8_t tlvTypeValue);
+      static void SerializeU8 (Buffer::Iterator &i,
+                               uint8_t element,
+                               uint8_t tlvTypeValue);
       static uint32_t DeserializeU8 (Buffer &buffer,
                                      uint8_t &element,
                                      uint8_t tlvTypeValue);
+      static uint32_t DeserializeU8 (Buffer::Iterator &i,
+                                     uint8_t &element,
+                                     uint8_t tlvTypeValue);
       // TLV for uint16_t values;
       static uint32_t GetSerializedSizeU16 (void);
       static void SerializeU16 (Buffer &buffer,
                                 uint16_t element, 
                                 uint8_t tlvTypeValue);
+      static void SerializeU16 (Buffer::Iterator &i,
+                                uint16_t element,
+                                uint8_t tlvTypeValue);
       static uint32_t DeserializeU16 (Buffer &buffer, 
                                       uint16_t &element, 
                                       uint8_t tlvTypeValue);
+      static uint32_t DeserializeU16 (Buffer::Iterator &i,
+                                      uint16_t &element,
+                                      uint8_t tlvTypeValue);
       // TLV for uint32_t values;
       static uint32_t GetSerializedSizeU32 (void);
       static void SerializeU32 (Buffer &buffer, 
                                 uint32_t element, 
                                 uint8_t tlvTypeValue);
+      static void SerializeU32 (Buffer::Iterator &i,
+                                uint32_t element,
+                                uint8_t tlvTypeValue);
       static uint32_t DeserializeU32 (Buffer &buffer,
                                       uint32_t &element,
                                       uint8_t tlvTypeValue);
+      static uint32_t DeserializeU32 (Buffer::Iterator &i,
+                                      uint32_t &element,
+                                      uint8_t tlvTypeValue);
       // TLV for uint64_t values;
       static uint32_t GetSerializedSizeU64 (void);
       static void SerializeU64 (Buffer &buffer,
                                 uint64_t element, 
                                 uint8_t tlvTypeValue);
+      static void SerializeU64 (Buffer::Iterator &i,
+                                uint64_t element,
+                                uint8_t tlvTypeValue);
       static uint32_t DeserializeU64 (Buffer &buffer, 
                                       uint64_t &element,
                                       uint8_t tlvTypeValue);
+      static uint32_t DeserializeU64 (Buffer::Iterator &i,
+                                      uint64_t &element,
+                                      uint8_t tlvTypeValue);
       // TLV for string values;
       static uint32_t GetSerializedSizeString (std::string element);
       static void SerializeString (Buffer &buffer,
                                    std::string element, 
                                    uint8_t tlvTypeValue);
+      static void SerializeString (Buffer::Iterator &i,
+                                   std::string element,
+                                   uint8_t tlvTypeValue);
       static uint32_t DeserializeString (Buffer &buffer,
                                          std::string &element, 
                                          uint8_t tlvTypeValue);
+      static uint32_t DeserializeString (Buffer::Iterator &i,
+                                         std::string &element,
+                                         uint8_t tlvTypeValue);
     };
     
     template<typename T>
@@ -266,26 +356,31 @@ namespace ns3 {
     Tlv::Serialize (Buffer &buffer, 
                     const std::vector<Ptr<T> > &tList, 
                     uint8_t tlvTypeValue)
+    {
+      uint32_t formerBufferSize = buffer.GetSize ();
+      buffer.AddAtEnd (Tlv::GetSerializedSize (tList));
+      Buffer::Iterator i = buffer.Begin ();
+      i.Next (formerBufferSize);
+      Tlv::Serialize (i, tList, tlvTypeValue);
+    }
+    template<typename T>
+    void
+    Tlv::Serialize (Buffer::Iterator &i, 
+                    const std::vector<Ptr<T> > &tList, 
+                    uint8_t tlvTypeValue)
     {
       uint32_t sizeOfList = tList.size ();
-      uint32_t lengthOfLengthField = 0;
       uint32_t payloadLength = 0;
-      uint32_t formerBufferSize = buffer.GetSize ();
       for (uint32_t j = 0; j < sizeOfList; j++)
         {
           payloadLength += tList[j]->GetTlvSerializedSize ();
         }
-      lengthOfLengthField = Tlv::ComputeLengthOfLengthField (payloadLength);
-      buffer.AddAtEnd (1 + lengthOfLengthField); // Type field +
-                                                 // Length field only;
-      Buffer::Iterator i = buffer.Begin ();
-      i.Next (formerBufferSize);
       i.WriteU8 (tlvTypeValue); // Type field;
       Tlv::WritePayloadLengthField (i, payloadLength); // Length
                                                        // field;
       for (uint32_t j = 0; j < sizeOfList; j++)
         {
-          tList[j]->TlvSerialize (buffer);
+          tList[j]->TlvSerialize (i);
         }
     }
     template <typename T>
@@ -293,25 +388,33 @@ namespace ns3 {
     Tlv::Deserialize (Buffer &buffer, 
                       std::vector<Ptr<T> > &tList, 
                       uint8_t tlvTypeValue) 
+    {
+      Buffer::Iterator i = buffer.Begin ();
+      uint32_t totalBytesRead = Tlv::Deserialize (i, tList, tlvTypeValue);
+      buffer.RemoveAtStart (totalBytesRead);
+      return totalBytesRead;
+    }
+    template <typename T>
+    uint32_t
+    Tlv::Deserialize (Buffer::Iterator &i, 
+                      std::vector<Ptr<T> > &tList, 
+                      uint8_t tlvTypeValue) 
     {
       uint32_t totalBytesRead = 0;
       uint32_t lengthOfLengthField = 0;
       uint32_t payloadLengthValue = 0;
-      Buffer::Iterator i = buffer.Begin ();
-      NS_ASSERT_MSG (i.ReadU8 () == tlvTypeValue, "List TLV type values mismatch!");
+      Tlv::ReadTypeField (i, tlvTypeValue);
       totalBytesRead++;
       lengthOfLengthField = i.ReadU8 ();
       totalBytesRead++;
       
       totalBytesRead += Tlv::ReadPayloadLengthField (i, lengthOfLengthField, payloadLengthValue);
-      buffer.RemoveAtStart (totalBytesRead);
       
       uint32_t bytesReadFromList = 0;
       while (bytesReadFromList < payloadLengthValue)
         {
-          i = buffer.Begin ();
-          Ptr<T> item = T::CreateFromTlvType (i.ReadU8 ());
-          uint32_t bytesRead = item->TlvDeserialize (buffer);
+          Ptr<T> item = T::CreateFromTlvType (i.PeekU8 ());
+          uint32_t bytesRead = item->TlvDeserialize (i);
           bytesReadFromList += bytesRead;
           totalBytesRead += bytesRead;
           tList.push_back (item);
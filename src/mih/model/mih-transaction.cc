@@ -42,7 +42,12 @@ namespace ns3 {
       m_toBedeleted (false),
       m_transactionId (tid),
       m_state (Transaction::INIT),
-      m_notifyDone (MakeNullCallback<void> ())
+      m_notifyDone (MakeNullCallback<void, uint16_t> ()),
+      m_sendResponse (MakeNullCallback<void, Ptr<Packet> > ()),
+      m_retransmitEvent (),
+      m_sendTime (),
+      m_transmissionCount (0),
+      m_responsePacket (0)
     {
       NS_LOG_FUNCTION (this);
     }
@@ -50,7 +55,9 @@ namespace ns3 {
     {
       NS_LOG_FUNCTION (this);
       NS_ASSERT (m_toBedeleted == true);
+      m_retransmitEvent.Cancel ();
       m_packet = 0;
+      m_responsePacket = 0;
     }
     Time 
     Transaction::GetStartTime (void)
@@ -64,12 +71,21 @@ namespace ns3 {
       NS_LOG_FUNCTION (this);
       return m_transactionId;
     }
+    void
+    Transaction::SetTransactionId (uint16_t tid)
+    {
+      NS_LOG_FUNCTION (this << tid);
+      m_transactionId = tid;
+    }
     void 
     Transaction::SetToBeDeleted (void)
     {
       NS_LOG_FUNCTION (this);
       m_toBedeleted = true;
-      m_notifyDone ();
+      if (!m_notifyDone.IsNull ())
+        {
+          m_notifyDone (m_transactionId);
+        }
     }
     bool 
     Transaction::IsToBeDeleted (void)
@@ -96,11 +112,88 @@ namespace ns3 {
       return m_state;
     }
     void 
-    Transaction::SetNotifyDoneCallback (Callback<void> doneCb)
+    Transaction::SetNotifyDoneCallback (Callback<void, uint16_t> doneCb)
     {
       NS_LOG_FUNCTION (this);
       m_notifyDone = doneCb;
     }
+    void
+    Transaction::SetSendResponseCallback (Callback<void, Ptr<Packet> > sendCb)
+    {
+      NS_LOG_FUNCTION (this);
+      m_sendResponse = sendCb;
+    }
+    void
+    Transaction::Abandon (void)
+    {
+      NS_LOG_FUNCTION (this);
+      m_retransmitEvent.Cancel ();
+      m_notifyDone = MakeNullCallback<void, uint16_t> ();
+      m_sendResponse = MakeNullCallback<void, Ptr<Packet> > ();
+      m_toBedeleted = true;
+    }
+    void
+    Transaction::Fail (void)
+    {
+      NS_LOG_FUNCTION (this);
+    }
+    void
+    Transaction::NotifySent (EventId retransmitEvent)
+    {
+      NS_LOG_FUNCTION (this);
+      m_sendTime = Simulator::Now ();
+      m_transmissionCount++;
+      m_retransmitEvent = retransmitEvent;
+    }
+    void
+    Transaction::SetRetransmitEvent (EventId retransmitEvent)
+    {
+      NS_LOG_FUNCTION (this);
+      m_retransmitEvent = retransmitEvent;
+    }
+    void
+    Transaction::CancelRetransmitEvent (void)
+    {
+      NS_LOG_FUNCTION (this);
+      m_retransmitEvent.Cancel ();
+    }
+    Time
+    Transaction::GetSendTime (void)
+    {
+      return m_sendTime;
+    }
+    uint32_t
+    Transaction::GetTransmissionCount (void)
+    {
+      return m_transmissionCount;
+    }
+    Ptr<Packet>
+    Transaction::GetResponsePacket (void)
+    {
+      return m_responsePacket;
+    }
+    void
+    Transaction::SendResponse (Ptr<Socket> socket, Ptr<Packet> packet)
+    {
+      NS_LOG_FUNCTION (this);
+      if (m_toBedeleted)
+        {
+          NS_LOG_LOGIC ("Session closed, response " << m_transactionId << " dropped");
+          return;
+        }
+      // Kept until the session forgets about this transaction, so that a
+      // retransmitted request is answered without asking the user again;
+      m_responsePacket = packet->Copy ();
+      if (!m_sendResponse.IsNull ())
+        {
+          m_sendResponse (packet);
+        }
+      else
+        {
+          socket->SendTo (packet, 0, m_to);
+        }
+      SetToBeDeleted ();
+    }
     //    class RegisterRequestTransaction
     RegisterRequestTransaction::RegisterRequestTransaction (Ptr<Packet> packet, 
                                                             MihfId fromMihfid, 
@@ -118,6 +211,12 @@ namespace ns3 {
       NS_LOG_FUNCTION (this);
     }
     void
+    RegisterRequestTransaction::Fail (void)
+    {
+      NS_LOG_FUNCTION (this);
+      RegisterConfirm (m_toMihfId, Status (Status::UNSPECIFIED_FAILURE), 0);
+    }
+    void
     RegisterRequestTransaction::RegisterConfirm (MihfId mihfid, Status status, uint32_t validLifetime)
     {
       NS_LOG_FUNCTION (this);
@@ -150,12 +249,18 @@ namespace ns3 {
       Buffer buffer;
       Ptr<Packet> packet;
       // TLV-Serialize in buffer;
-      m_fromMihfId.TlvSerialize (buffer);
-      m_toMihfId.TlvSerialize (buffer);
-      status.TlvSerialize (buffer);
-      if (status.GetType () == Status::SUCCESS)
+      bool withLifetime = status.GetType () == Status::SUCCESS;
+      buffer.AddAtEnd (m_fromMihfId.GetTlvSerializedSize () +
+                       m_toMihfId.GetTlvSerializedSize () +
+                       status.GetTlvSerializedSize () +
+                       (withLifetime ? Tlv::GetSerializedSizeU32 () : 0));
+      Buffer::Iterator i = buffer.Begin ();
+      m_fromMihfId.TlvSerialize (i);
+      m_toMihfId.TlvSerialize (i);
+      status.TlvSerialize (i);
+      if (withLifetime)
         {
-          Tlv::SerializeU32 (buffer, validLifetime, TLV_VALID_TIME_INTERVAL);
+          Tlv::SerializeU32 (i, validLifetime, TLV_VALID_TIME_INTERVAL);
         }
       // Fill the packet with payload from buffer
       packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
@@ -168,10 +273,105 @@ namespace ns3 {
       mihHeader.SetTransactionId (GetTransactionId ());
       mihHeader.SetPayloadLength (packet->GetSize ());
       packet->AddHeader (mihHeader);
+      if (withLifetime && !IsToBeDeleted () && !m_registrationCallback.IsNull ())
+        {
+          m_registrationCallback (validLifetime);
+        }
       // Send via socket;
       // Add possibilities to select the source interface
-      m_socket->SendTo (packet, 0, m_to);
-      SetToBeDeleted ();      
+      SendResponse (m_socket, packet);
+    }
+    void
+    RegisterResponseTransaction::SetRegistrationCallback (Callback<void, uint32_t> registrationCallback)
+    {
+      NS_LOG_FUNCTION (this);
+      m_registrationCallback = registrationCallback;
+    }
+    //    class DeRegisterRequestTransaction
+    DeRegisterRequestTransaction::DeRegisterRequestTransaction (Ptr<Packet> packet, 
+                                                                MihfId fromMihfid, 
+                                                                MihfId toMihfid, 
+                                                                Address to, 
+                                                                uint16_t tid, 
+                                                                MihDeRegisterConfirmCallback deRegisterConfirmCallback) :
+      Transaction (packet, fromMihfid, toMihfid, to, tid),
+      m_deRegisterConfirmCallback (deRegisterConfirmCallback)
+    {
+      NS_LOG_FUNCTION (this);
+    }
+    DeRegisterRequestTransaction::~DeRegisterRequestTransaction (void)
+    {
+      NS_LOG_FUNCTION (this);
+    }
+    void
+    DeRegisterRequestTransaction::Fail (void)
+    {
+      NS_LOG_FUNCTION (this);
+      DeRegisterConfirm (m_toMihfId, Status (Status::UNSPECIFIED_FAILURE));
+    }
+    void
+    DeRegisterRequestTransaction::DeRegisterConfirm (MihfId mihfid, Status status)
+    {
+      NS_LOG_FUNCTION (this);
+      m_deRegisterConfirmCallback (mihfid, status);
+    }
+    //    class DeRegisterResponseTransaction
+    DeRegisterResponseTransaction::DeRegisterResponseTransaction (Ptr<Packet> packet, 
+                                                                  MihfId fromMihfid, 
+                                                                  MihfId toMihfid, 
+                                                                  Address to, 
+                                                                  uint16_t tid, 
+                                                                  Ptr<Socket> socket) :
+      Transaction (packet, fromMihfid, toMihfid, to, tid),
+      m_socket (socket)
+    {
+      NS_LOG_FUNCTION (this);
+    }
+    DeRegisterResponseTransaction::~DeRegisterResponseTransaction (void)
+    {
+      NS_LOG_FUNCTION (this);
+      m_socket = 0;
+    }
+    void
+    DeRegisterResponseTransaction::SendDeRegisterResponse (MihfId mihfId,
+                                                           Status status)
+    {
+      NS_LOG_FUNCTION (this);
+      NS_ASSERT (mihfId == m_fromMihfId);
+      Buffer buffer;
+      Ptr<Packet> packet;
+      // TLV-Serialize in buffer;
+      buffer.AddAtEnd (m_fromMihfId.GetTlvSerializedSize () +
+                       m_toMihfId.GetTlvSerializedSize () +
+                       status.GetTlvSerializedSize ());
+      Buffer::Iterator i = buffer.Begin ();
+      m_fromMihfId.TlvSerialize (i);
+      m_toMihfId.TlvSerialize (i);
+      status.TlvSerialize (i);
+      // Fill the packet with payload from buffer
+      packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
+      // Mih Header;
+      MihHeader mihHeader;
+      mihHeader.SetVersion (MihHeader::VERSION_ONE);
+      mihHeader.SetServiceId (MihHeader::MANAGEMENT);
+      mihHeader.SetOpCode (MihHeader::RESPONSE);
+      mihHeader.SetActionId (MihHeader::MIH_DEREGISTER);
+      mihHeader.SetTransactionId (GetTransactionId ());
+      mihHeader.SetPayloadLength (packet->GetSize ());
+      packet->AddHeader (mihHeader);
+      if (status.GetType () == Status::SUCCESS && 
+          !IsToBeDeleted () && 
+          !m_deRegistrationCallback.IsNull ())
+        {
+          m_deRegistrationCallback ();
+        }
+      SendResponse (m_socket, packet);
+    }
+    void
+    DeRegisterResponseTransaction::SetDeRegistrationCallback (Callback<void> deRegistrationCallback)
+    {
+      NS_LOG_FUNCTION (this);
+      m_deRegistrationCallback = deRegistrationCallback;
     }
     //    class CapabilityDiscoverRequestTransaction
     CapabilityDiscoverRequestTransaction::CapabilityDiscoverRequestTransaction (Ptr<Packet> packet, 
@@ -190,6 +390,15 @@ namespace ns3 {
       NS_LOG_FUNCTION (this);
     }
     void
+    CapabilityDiscoverRequestTransaction::Fail (void)
+    {
+      NS_LOG_FUNCTION (this);
+      CapabilityDiscoverConfirm (m_toMihfId, Status (Status::UNSPECIFIED_FAILURE),
+                                 NetworkTypeAddressList (), EventList (), MihCommandList (),
+                                 InformationServiceQueryTypeList (), TransportSupportList (),
+                                 MakeBeforeBreakSupportList ());
+    }
+    void
     CapabilityDiscoverRequestTransaction::CapabilityDiscoverConfirm (MihfId mihfId, 
                                                                      Status status, 
                                                                      NetworkTypeAddressList networkTypeAddessList, 
@@ -241,15 +450,25 @@ namespace ns3 {
       Buffer buffer;
       Ptr<Packet> packet;
       // TLV-Serialize in buffer;
-      m_fromMihfId.TlvSerialize (buffer);
-      m_toMihfId.TlvSerialize (buffer);
-      status.TlvSerialize (buffer);
-      TlvSerialize (buffer, networkTypeAddresses);
-      events.TlvSerialize (buffer);
-      commands.TlvSerialize (buffer);
-      miisQueries.TlvSerialize (buffer);
-      transportOptions.TlvSerialize (buffer);
-      TlvSerialize (buffer, mbbSupportList);
+      buffer.AddAtEnd (m_fromMihfId.GetTlvSerializedSize () +
+                       m_toMihfId.GetTlvSerializedSize () +
+                       status.GetTlvSerializedSize () +
+                       GetTlvSerializedSize (networkTypeAddresses) +
+                       events.GetTlvSerializedSize () +
+                       commands.GetTlvSerializedSize () +
+                       miisQueries.GetTlvSerializedSize () +
+                       transportOptions.GetTlvSerializedSize () +
+                       GetTlvSerializedSize (mbbSupportList));
+      Buffer::Iterator i = buffer.Begin ();
+      m_fromMihfId.TlvSerialize (i);
+      m_toMihfId.TlvSerialize (i);
+      status.TlvSerialize (i);
+      TlvSerialize (i, networkTypeAddresses);
+      events.TlvSerialize (i);
+      commands.TlvSerialize (i);
+      miisQueries.TlvSerialize (i);
+      transportOptions.TlvSerialize (i);
+      TlvSerialize (i, mbbSupportList);
       // Fill the packet with payload from buffer
       packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
       // Mih Header;
@@ -263,8 +482,7 @@ namespace ns3 {
       packet->AddHeader (mihHeader);
       // Send via socket;
       // Add possibilities to select the source interface
-      m_socket->SendTo (packet, 0, m_to);
-      SetToBeDeleted ();
+      SendResponse (m_socket, packet);
     }
     //class EventSubscribeRequestTransaction;
     EventSubscribeRequestTransaction::EventSubscribeRequestTransaction (Ptr<Packet> packet, 
@@ -281,6 +499,13 @@ namespace ns3 {
     EventSubscribeRequestTransaction::~EventSubscribeRequestTransaction (void)
     {}
     void
+    EventSubscribeRequestTransaction::Fail (void)
+    {
+      NS_LOG_FUNCTION (this);
+      EventSubscribeConfirm (m_toMihfId, Status (Status::UNSPECIFIED_FAILURE),
+                             LinkIdentifier (), EventList ());
+    }
+    void
     EventSubscribeRequestTransaction::EventSubscribeConfirm (MihfId mihfId, 
                                                              Status status, 
                                                              LinkIdentifier linkIdentifier, 
@@ -318,11 +543,17 @@ namespace ns3 {
       Buffer buffer;
       Ptr<Packet> packet;
       // TLV-Serialize in buffer;
-      m_fromMihfId.TlvSerialize (buffer);
-      m_toMihfId.TlvSerialize (buffer);
-      status.TlvSerialize (buffer);
-      linkIdentifier.TlvSerialize (buffer);
-      events.TlvSerialize (buffer);
+      buffer.AddAtEnd (m_fromMihfId.GetTlvSerializedSize () +
+                       m_toMihfId.GetTlvSerializedSize () +
+                       status.GetTlvSerializedSize () +
+                       linkIdentifier.GetTlvSerializedSize () +
+                       events.GetTlvSerializedSize ());
+      Buffer::Iterator i = buffer.Begin ();
+      m_fromMihfId.TlvSerialize (i);
+      m_toMihfId.TlvSerialize (i);
+      status.TlvSerialize (i);
+      linkIdentifier.TlvSerialize (i);
+      events.TlvSerialize (i);
       // Fill the packet with payload from buffer
       packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
       // Mih Header;
@@ -336,8 +567,7 @@ namespace ns3 {
       packet->AddHeader (mihHeader);
       // Send via socket;
       // Add possibilities to select the source interface
-      m_socket->SendTo (packet, 0, m_to);
-      SetToBeDeleted ();
+      SendResponse (m_socket, packet);
     }
     //    class LinkGetParametersRequestTransaction;
     LinkGetParametersRequestTransaction::LinkGetParametersRequestTransaction (Ptr<Packet> packet, 
@@ -353,6 +583,13 @@ namespace ns3 {
     }
     LinkGetParametersRequestTransaction::~LinkGetParametersRequestTransaction (void)
     {}
+    void
+    LinkGetParametersRequestTransaction::Fail (void)
+    {
+      NS_LOG_FUNCTION (this);
+      LinkGetParametersConfirm (m_toMihfId, Status (Status::UNSPECIFIED_FAILURE),
+                                DeviceStatesResponseList (), LinkStatusResponseList ());
+    }
     void 
     LinkGetParametersRequestTransaction::LinkGetParametersConfirm (MihfId mihfId, 
                                                                    Status status, 
@@ -392,11 +629,17 @@ namespace ns3 {
       Buffer buffer;
       Ptr<Packet> packet;
       // TLV-Serialize in buffer;
-      m_fromMihfId.TlvSerialize (buffer);
-      m_toMihfId.TlvSerialize (buffer);
-      status.TlvSerialize (buffer);
-      TlvSerialize (buffer, deviceStatesResponseList);
-      TlvSerialize (buffer, linkStatusResponseList);
+      buffer.AddAtEnd (m_fromMihfId.GetTlvSerializedSize () +
+                       m_toMihfId.GetTlvSerializedSize () +
+                       status.GetTlvSerializedSize () +
+                       GetTlvSerializedSize (deviceStatesResponseList) +
+                       GetTlvSerializedSize (linkStatusResponseList));
+      Buffer::Iterator i = buffer.Begin ();
+      m_fromMihfId.TlvSerialize (i);
+      m_toMihfId.TlvSerialize (i);
+      status.TlvSerialize (i);
+      TlvSerialize (i, deviceStatesResponseList);
+      TlvSerialize (i, linkStatusResponseList);
       // Fill the packet with payload from buffer
       packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
       // Mih Header;
@@ -410,8 +653,7 @@ namespace ns3 {
       packet->AddHeader (mihHeader);
       // Send via socket;
       // Add possibilities to select the source interface
-      m_socket->SendTo (packet, 0, m_to);
-      SetToBeDeleted ();
+      SendResponse (m_socket, packet);
     }
     //    class LinkConfigureThresholdsRequestTransaction
     LinkConfigureThresholdsRequestTransaction::LinkConfigureThresholdsRequestTransaction (Ptr<Packet> packet, 
@@ -430,6 +672,13 @@ namespace ns3 {
       NS_LOG_FUNCTION (this);
     }
     void
+    LinkConfigureThresholdsRequestTransaction::Fail (void)
+    {
+      NS_LOG_FUNCTION (this);
+      LinkConfigureThresholdsConfirm (m_toMihfId, Status (Status::UNSPECIFIED_FAILURE),
+                                      LinkIdentifier (), LinkConfigurationStatusList ());
+    }
+    void
     LinkConfigureThresholdsRequestTransaction::LinkConfigureThresholdsConfirm (MihfId mihfId, 
                                                                                Status status, 
                                                                                LinkIdentifier linkIdentifier, 
@@ -468,11 +717,17 @@ namespace ns3 {
       Buffer buffer;
       Ptr<Packet> packet;
       // TLV-Serialize in buffer;
-      m_fromMihfId.TlvSerialize (buffer);
-      m_toMihfId.TlvSerialize (buffer);
-      status.TlvSerialize (buffer);
-      linkIdentifier.TlvSerialize (buffer);
-      TlvSerialize (buffer, linkConfigurationStatusList);
+      buffer.AddAtEnd (m_fromMihfId.GetTlvSerializedSize () +
+                       m_toMihfId.GetTlvSerializedSize () +
+                       status.GetTlvSerializedSize () +
+                       linkIdentifier.GetTlvSerializedSize () +
+                       GetTlvSerializedSize (linkConfigurationStatusList));
+      Buffer::Iterator i = buffer.Begin ();
+      m_fromMihfId.TlvSerialize (i);
+      m_toMihfId.TlvSerialize (i);
+      status.TlvSerialize (i);
+      linkIdentifier.TlvSerialize (i);
+      TlvSerialize (i, linkConfigurationStatusList);
       // Fill the packet with payload from buffer
       packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
       // Mih Header;
@@ -486,8 +741,89 @@ namespace ns3 {
       packet->AddHeader (mihHeader);
       // Send via socket;
       // Add possibilities to select the source interface
-      m_socket->SendTo (packet, 0, m_to);
-      SetToBeDeleted ();
+      SendResponse (m_socket, packet);
+    }
+    //    class GetInformationRequestTransaction
+    GetInformationRequestTransaction::GetInformationRequestTransaction (Ptr<Packet> packet,
+                                                                        MihfId fromMihfid,
+                                                                        MihfId toMihfid,
+                                                                        Address to,
+                                                                        uint16_t tid,
+                                                                        MihGetInformationConfirmCallback getInformationConfirmCallback) :
+      Transaction (packet, fromMihfid, toMihfid, to, tid),
+      m_getInformationConfirmCallback (getInformationConfirmCallback)
+    {
+      NS_LOG_FUNCTION (this);
+    }
+    GetInformationRequestTransaction::~GetInformationRequestTransaction (void)
+    {
+      NS_LOG_FUNCTION (this);
+    }
+    void
+    GetInformationRequestTransaction::Fail (void)
+    {
+      NS_LOG_FUNCTION (this);
+      GetInformationConfirm (m_toMihfId, Status (Status::UNSPECIFIED_FAILURE),
+                             PoaDescriptorList ());
+    }
+    void
+    GetInformationRequestTransaction::GetInformationConfirm (MihfId mihfId,
+                                                             Status status,
+                                                             PoaDescriptorList poaDescriptorList)
+    {
+      NS_LOG_FUNCTION (this);
+      m_getInformationConfirmCallback (mihfId,
+                                       status,
+                                       poaDescriptorList);
+    }
+    //    class GetInformationResponseTransaction
+    GetInformationResponseTransaction::GetInformationResponseTransaction (Ptr<Packet> packet,
+                                                                          MihfId fromMihfid,
+                                                                          MihfId toMihfid,
+                                                                          Address to,
+                                                                          uint16_t tid,
+                                                                          Ptr<Socket> socket) :
+      Transaction (packet, fromMihfid, toMihfid, to, tid),
+      m_socket (socket)
+    {
+      NS_LOG_FUNCTION (this);
+    }
+    GetInformationResponseTransaction::~GetInformationResponseTransaction (void)
+    {
+      NS_LOG_FUNCTION (this);
+    }
+    void
+    GetInformationResponseTransaction::SendGetInformationResponse (MihfId mihfId,
+                                                                   Status status,
+                                                                   PoaDescriptorList poaDescriptorList)
+    {
+      NS_LOG_FUNCTION (this);
+      NS_ASSERT (mihfId == m_fromMihfId);
+      Buffer buffer;
+      Ptr<Packet> packet;
+      // TLV-Serialize in buffer;
+      buffer.AddAtEnd (m_fromMihfId.GetTlvSerializedSize () +
+                       m_toMihfId.GetTlvSerializedSize () +
+                       status.GetTlvSerializedSize () +
+                       GetTlvSerializedSize (poaDescriptorList));
+      Buffer::Iterator i = buffer.Begin ();
+      m_fromMihfId.TlvSerialize (i);
+      m_toMihfId.TlvSerialize (i);
+      status.TlvSerialize (i);
+      TlvSerialize (i, poaDescriptorList);
+      // Fill the packet with payload from buffer
+      packet = Create<Packet> (buffer.PeekData (), buffer.GetSize ());
+      // Mih Header;
+      MihHeader mihHeader;
+      mihHeader.SetVersion (MihHeader::VERSION_ONE);
+      mihHeader.SetServiceId (MihHeader::INFORMATION);
+      mihHeader.SetOpCode (MihHeader::RESPONSE);
+      mihHeader.SetActionId (MihHeader::MIH_GET_INFORMATION);
+      mihHeader.SetTransactionId (GetTransactionId ());
+      mihHeader.SetPayloadLength (packet->GetSize ());
+      packet->AddHeader (mihHeader);
+      // Send via socket;
+      SendResponse (m_socket, packet);
     }
   } // namespace mih
 } // namespace ns3
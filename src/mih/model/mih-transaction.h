@@ -22,6 +22,7 @@
 #define   	MIH_TRANSACTION_H
 
 #include <deque>
+#include <map>
 #include <stdint.h>
 #include "ns3/ref-count-base.h"
 #include "ns3/packet.h"
@@ -52,13 +53,32 @@ namespace ns3 {
       virtual ~Transaction (void);
       virtual Time GetStartTime (void);
       virtual uint16_t GetTransactionId (void);
+      // Requests are numbered once they enter the session window;
+      void SetTransactionId (uint16_t tid);
       virtual void SetToBeDeleted (void);
       virtual bool IsToBeDeleted (void);
       virtual Ptr<Packet> GetPacket (void);
       virtual void SetState (enum State state);
       virtual enum State GetState (void);
-      void SetNotifyDoneCallback (Callback<void> doneCb);
+      void SetNotifyDoneCallback (Callback<void, uint16_t> doneCb);
+      // Takes the response over from the socket, for the session to
+      // account for it and send it;
+      void SetSendResponseCallback (Callback<void, Ptr<Packet> > sendCb);
+      // Forgets the session this transaction belongs to, which is
+      // being closed: a response the MIH user sends later is dropped;
+      void Abandon (void);
+      // Confirms a request that got no response with a failure status;
+      virtual void Fail (void);
+      // Request (re)transmission bookkeeping;
+      void NotifySent (EventId retransmitEvent);
+      void SetRetransmitEvent (EventId retransmitEvent);
+      void CancelRetransmitEvent (void);
+      Time GetSendTime (void);
+      uint32_t GetTransmissionCount (void);
+      // The response sent for this request, if any;
+      Ptr<Packet> GetResponsePacket (void);
     protected:
+      void SendResponse (Ptr<Socket> socket, Ptr<Packet> packet);
       Ptr<Packet> m_packet;
       MihfId m_fromMihfId;
       MihfId m_toMihfId;
@@ -67,7 +87,12 @@ namespace ns3 {
       bool m_toBedeleted;
       uint16_t m_transactionId;
       enum State m_state;
-      Callback<void> m_notifyDone;
+      Callback<void, uint16_t> m_notifyDone;
+      Callback<void, Ptr<Packet> > m_sendResponse;
+      EventId m_retransmitEvent;
+      Time m_sendTime;
+      uint32_t m_transmissionCount;
+      Ptr<Packet> m_responsePacket;
     };
     class RegisterRequestTransaction : public Transaction {
     public:
@@ -78,6 +103,7 @@ namespace ns3 {
                                   uint16_t tid, 
                                   MihRegisterConfirmCallback registerConfirmCallback);
       virtual ~RegisterRequestTransaction (void);
+      virtual void Fail (void);
       void RegisterConfirm (MihfId mihfid, 
                             Status status,
                             uint32_t validLifetime);
@@ -96,8 +122,45 @@ namespace ns3 {
       void SendRegisterResponse (MihfId mihfid, 
                                  Status status, 
                                  uint32_t validLifetime);
+      // Called with the lifetime of a registration granted by the
+      // MIH user, just before the response is sent;
+      void SetRegistrationCallback (Callback<void, uint32_t> registrationCallback);
     protected:
       Ptr<Socket> m_socket;
+      Callback<void, uint32_t> m_registrationCallback;
+    };
+    class DeRegisterRequestTransaction : public Transaction {
+    public:
+      DeRegisterRequestTransaction (Ptr<Packet> packet, 
+                                    MihfId fromMihfid, 
+                                    MihfId toMihfid, 
+                                    Address to, 
+                                    uint16_t tid, 
+                                    MihDeRegisterConfirmCallback deRegisterConfirmCallback);
+      virtual ~DeRegisterRequestTransaction (void);
+      virtual void Fail (void);
+      void DeRegisterConfirm (MihfId mihfid, 
+                              Status status);
+    protected:
+      MihDeRegisterConfirmCallback m_deRegisterConfirmCallback;
+    };
+    class DeRegisterResponseTransaction : public Transaction {
+    public:
+      DeRegisterResponseTransaction (Ptr<Packet> packet,
+                                     MihfId fromMihfid, 
+                                     MihfId toMihfid, 
+                                     Address to, 
+                                     uint16_t tid, 
+                                     Ptr<Socket> socket);
+      virtual ~DeRegisterResponseTransaction (void);
+      void SendDeRegisterResponse (MihfId mihfid, 
+                                   Status status);
+      // Called once the MIH user accepted the deregistration, just
+      // before the response is sent;
+      void SetDeRegistrationCallback (Callback<void> deRegistrationCallback);
+    protected:
+      Ptr<Socket> m_socket;
+      Callback<void> m_deRegistrationCallback;
     };
     class CapabilityDiscoverRequestTransaction : public Transaction {
     public:
@@ -108,6 +171,7 @@ namespace ns3 {
                                             uint16_t tid, 
                                             MihCapabilityDiscoverConfirmCallback capabilityDiscoverConfirmCallback);
       virtual ~CapabilityDiscoverRequestTransaction (void);
+      virtual void Fail (void);
       void CapabilityDiscoverConfirm (MihfId mihfId, 
                                       Status status, 
                                       NetworkTypeAddressList networkTypeAddessList, 
@@ -148,6 +212,7 @@ namespace ns3 {
                                         uint16_t tid,
                                         MihEventSubscribeConfirmCallback subscribeConfirmCallback);
       virtual ~EventSubscribeRequestTransaction (void);
+      virtual void Fail (void);
       void EventSubscribeConfirm (MihfId mihfId, 
                                   Status status, 
                                   LinkIdentifier linkIdentifier, 
@@ -181,6 +246,7 @@ namespace ns3 {
                                            uint16_t tid,
                                            MihLinkGetParametersConfirmCallback getParamtersConfirmCallback);
       virtual ~LinkGetParametersRequestTransaction (void);
+      virtual void Fail (void);
       void LinkGetParametersConfirm (MihfId mihfId, 
                                      Status status, 
                                      DeviceStatesResponseList deviceStatesResponseList, 
@@ -213,6 +279,7 @@ namespace ns3 {
                                                  uint16_t tid,
                                                  MihLinkConfigureThresholdsConfirmCallback configureThresholdsConfirmCallback);
       virtual ~LinkConfigureThresholdsRequestTransaction (void);
+      virtual void Fail (void);
       void LinkConfigureThresholdsConfirm (MihfId mihfId, 
                                            Status status, 
                                            LinkIdentifier linkIdentifier, 
@@ -236,9 +303,43 @@ namespace ns3 {
     protected:
       Ptr<Socket> m_socket;
     };
+    class GetInformationRequestTransaction : public Transaction {
+    public:
+      GetInformationRequestTransaction (Ptr<Packet> packet,
+                                        MihfId fromMihfid,
+                                        MihfId toMihfid,
+                                        Address to,
+                                        uint16_t tid,
+                                        MihGetInformationConfirmCallback getInformationConfirmCallback);
+      virtual ~GetInformationRequestTransaction (void);
+      virtual void Fail (void);
+      void GetInformationConfirm (MihfId mihfId,
+                                  Status status,
+                                  PoaDescriptorList poaDescriptorList);
+    protected:
+      MihGetInformationConfirmCallback m_getInformationConfirmCallback;
+    };
+    class GetInformationResponseTransaction : public Transaction {
+    public:
+      GetInformationResponseTransaction (Ptr<Packet> packet,
+                                         MihfId fromMihfid,
+                                         MihfId toMihfid,
+                                         Address to,
+                                         uint16_t tid,
+                                         Ptr<Socket> socket);
+      virtual ~GetInformationResponseTransaction (void);
+      void SendGetInformationResponse (MihfId mihfId,
+                                       Status status,
+                                       PoaDescriptorList poaDescriptorList);
+    protected:
+      Ptr<Socket> m_socket;
+    };
     typedef std::deque<Ptr<Transaction> > TransactionQueue;
     typedef TransactionQueue::reverse_iterator TransactionQueueRI;
     typedef TransactionQueue::iterator TransactionQueueI;
+    // Transactions in flight, keyed by transaction identifier;
+    typedef std::map<uint16_t, Ptr<Transaction> > TransactionTable;
+    typedef TransactionTable::iterator TransactionTableI;
   } // namespace mih
 } // namespace ns3
 
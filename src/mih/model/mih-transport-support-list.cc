@@ -50,14 +50,14 @@ namespace ns3 {
         ;
     }
     void
-    TransportSupportList::TlvSerialize (Buffer &buffer) const
+    TransportSupportList::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeU16 (buffer, m_bitmap, TLV_TRANSPORT_OPTION_LIST);
+      Tlv::SerializeU16 (i, m_bitmap, TLV_TRANSPORT_OPTION_LIST);
     }
     uint32_t 
-    TransportSupportList::TlvDeserialize (Buffer &buffer)
+    TransportSupportList::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeU16 (buffer, m_bitmap, TLV_TRANSPORT_OPTION_LIST);
+      return Tlv::DeserializeU16 (i, m_bitmap, TLV_TRANSPORT_OPTION_LIST);
     }
   } // namespace mih
 } // namespace ns3
@@ -27,7 +27,7 @@
 
 namespace ns3 {
   namespace mih {
-    class TransportSupportList {
+    class TransportSupportList : public Tlv {
     public:
       enum Type {
         INVALID = 0x0000,
@@ -40,8 +40,10 @@ namespace ns3 {
       uint16_t GetTransportSupports (void);
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       TLV_TYPE_HELPER_HEADER (TransportSupportList);
     protected:
       uint16_t m_bitmap;
@@ -18,6 +18,9 @@
  * Author: Providence SALUMU M. <Providence.Salumu_Munga@it-sudparis.eu>
  */
 
+#include <deque>
+#include <vector>
+#include <unordered_map>
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "mihf-id.h"
@@ -26,64 +29,176 @@ NS_LOG_COMPONENT_DEFINE ("MihfId");
 
 namespace ns3 {
   namespace mih {
+    namespace {
+      // Set once the registry is gone, for the identifiers held by
+      // other static objects destroyed after it;
+      bool g_registryDestroyed = false;
+      // A deque keeps the stored names in place as it grows, so
+      // PeekString results stay valid. Each name counts the MihfId
+      // objects holding its handle and is released with the last of
+      // them, its handle being reused;
+      struct MihfIdRegistry {
+        MihfIdRegistry (void)
+        {
+          names.push_back ("");
+          counts.push_back (0);
+          handles[names.back ()] = 0;
+        }
+        ~MihfIdRegistry (void)
+        {
+          g_registryDestroyed = true;
+        }
+        std::deque<std::string> names;
+        std::vector<uint32_t> counts;
+        std::vector<uint32_t> freeHandles;
+        std::unordered_map<std::string, uint32_t> handles;
+      };
+      MihfIdRegistry &
+      GetMihfIdRegistry (void)
+      {
+        static MihfIdRegistry registry;
+        return registry;
+      }
+    } // anonymous namespace
+    uint32_t
+    MihfId::Intern (const std::string &mihfid)
+    {
+      MihfIdRegistry &registry = GetMihfIdRegistry ();
+      std::unordered_map<std::string, uint32_t>::const_iterator it = registry.handles.find (mihfid);
+      if (it != registry.handles.end ())
+        {
+          return it->second;
+        }
+      uint32_t handle;
+      if (registry.freeHandles.empty ())
+        {
+          handle = registry.names.size ();
+          registry.names.push_back (mihfid);
+          registry.counts.push_back (0);
+        }
+      else
+        {
+          handle = registry.freeHandles.back ();
+          registry.freeHandles.pop_back ();
+          registry.names[handle] = mihfid;
+        }
+      registry.handles[mihfid] = handle;
+      NS_LOG_LOGIC ("Interned " << mihfid << " as " << handle);
+      return handle;
+    }
+    void
+    MihfId::Acquire (uint32_t handle)
+    {
+      if (handle != 0)
+        {
+          GetMihfIdRegistry ().counts[handle]++;
+        }
+    }
+    void
+    MihfId::Release (uint32_t handle)
+    {
+      if (handle == 0 || g_registryDestroyed)
+        {
+          return;
+        }
+      MihfIdRegistry &registry = GetMihfIdRegistry ();
+      NS_ASSERT (registry.counts[handle] > 0);
+      if (--registry.counts[handle] > 0)
+        {
+          return;
+        }
+      NS_LOG_LOGIC ("Released " << registry.names[handle] << " from " << handle);
+      registry.handles.erase (registry.names[handle]);
+      std::string ().swap (registry.names[handle]);
+      registry.freeHandles.push_back (handle);
+    }
+    uint32_t
+    MihfId::GetInternedN (void)
+    {
+      return GetMihfIdRegistry ().handles.size ();
+    }
     MihfId::MihfId (void) :
-      m_mihfid ("")
+      m_handle (0)
     {}
     MihfId::MihfId (std::string mihfid) :
-      m_mihfid (mihfid)
+      m_handle (Intern (mihfid))
     {
       NS_ASSERT (mihfid.length () <= 253);
+      Acquire (m_handle);
     }
     MihfId::MihfId (MihfId const &o) :
-      m_mihfid (o.m_mihfid)
-    {}
+      m_handle (o.m_handle)
+    {
+      Acquire (m_handle);
+    }
+    MihfId::~MihfId (void)
+    {
+      Release (m_handle);
+    }
     TLV_TYPE_HELPER_IMPLEM (MihfId, TLV_SOURCE_MIHFID)
     const char * 
     MihfId::PeekString (void) const
     {
-      return m_mihfid.c_str ();
+      return GetMihfIdRegistry ().names[m_handle].c_str ();
+    }
+    uint32_t
+    MihfId::GetHandle (void) const
+    {
+      return m_handle;
     }
     uint32_t 
     MihfId::GetTlvSerializedSize (void) const
     {
-      return Tlv::GetSerializedSizeString (m_mihfid);
+      return Tlv::GetSerializedSizeString (GetMihfIdRegistry ().names[m_handle]);
     }
     void
     MihfId::Print (std::ostream &os) const
     {
-      os << "MihfId = " << m_mihfid << std::endl;
+      os << "MihfId = " << PeekString () << std::endl;
     }
     void 
-    MihfId::TlvSerialize (Buffer &buffer) const
+    MihfId::TlvSerialize (Buffer::Iterator &i) const
     {
-      Tlv::SerializeString (buffer, m_mihfid, GetTlvTypeValue ());
+      Tlv::SerializeString (i, GetMihfIdRegistry ().names[m_handle], GetTlvTypeValue ());
     }
     uint32_t 
-    MihfId::TlvDeserialize (Buffer &buffer)
+    MihfId::TlvDeserialize (Buffer::Iterator &i)
     {
-      return Tlv::DeserializeString (buffer, m_mihfid, GetTlvTypeValue ());
+      // Reused across calls so that decoding a known identifier
+      // does not allocate;
+      static std::string scratch;
+      uint32_t size = Tlv::DeserializeString (i, scratch, GetTlvTypeValue ());
+      uint32_t handle = Intern (scratch);
+      Acquire (handle);
+      Release (m_handle);
+      m_handle = handle;
+      return size;
     }
     MihfId&
     MihfId::operator = (MihfId const &o)
     {
-      m_mihfid = o.m_mihfid;
+      Acquire (o.m_handle);
+      Release (m_handle);
+      m_handle = o.m_handle;
       return *this;
     }
     bool 
     operator == (const MihfId &a, const MihfId &b)
     {
-      return (a.m_mihfid.compare (b.m_mihfid) == 0);
+      return a.m_handle == b.m_handle;
     }
     bool 
     operator != (const MihfId &a, const MihfId &b)
     {
-      return (a.m_mihfid.compare (b.m_mihfid) != 0);
+      return a.m_handle != b.m_handle;
     }
 
+    // Orders by name, handles depend on the interning order;
     bool
     operator < (const MihfId &a, const MihfId &b)
     {
-      return (a.m_mihfid.compare (b.m_mihfid) < 0 ? true : false);
+      return a.m_handle != b.m_handle &&
+        GetMihfIdRegistry ().names[a.m_handle] < GetMihfIdRegistry ().names[b.m_handle];
     }
 
     ATTRIBUTE_HELPER_CPP (MihfId);
@@ -28,6 +28,12 @@
 
 namespace ns3 {
   namespace mih {
+    // MIHF identifiers are interned: each distinct name is stored once
+    // in a process-wide registry and a MihfId only carries its integer
+    // handle. Copies, equality and hashing never touch the string,
+    // which is only looked up for printing, ordering and TLV
+    // serialization. A name is dropped from the registry once no
+    // MihfId holds it any more;
     class MihfId : public Tlv {
     public:
       enum {
@@ -36,18 +42,28 @@ namespace ns3 {
       MihfId (void);
       MihfId (std::string mihfid);
       MihfId (MihfId const &o);
+      virtual ~MihfId (void);
       const char * PeekString (void) const;
+      // Stable while a MihfId holds the name, 0 is the empty
+      // identifier;
+      uint32_t GetHandle (void) const;
       virtual uint32_t GetTlvSerializedSize (void) const;
       virtual void Print (std::ostream &os) const;
-      virtual void TlvSerialize (Buffer &buffer) const;
-      virtual uint32_t TlvDeserialize (Buffer &buffer);
+      using Tlv::TlvSerialize;
+      virtual void TlvSerialize (Buffer::Iterator &i) const;
+      using Tlv::TlvDeserialize;
+      virtual uint32_t TlvDeserialize (Buffer::Iterator &i);
       MihfId& operator = (MihfId const &a);
       TLV_TYPE_HELPER_HEADER (MihfId);
+      static uint32_t GetInternedN (void);
     protected:
+      static uint32_t Intern (const std::string &mihfid);
+      static void Acquire (uint32_t handle);
+      static void Release (uint32_t handle);
       friend bool operator == (const MihfId &a, const MihfId &b);
       friend bool operator != (const MihfId &a, const MihfId &b);
       friend bool operator < (const MihfId &a, const MihfId &b);
-      std::string m_mihfid;
+      uint32_t m_handle;
     };
     std::ostream &operator << (std::ostream &os, const MihfId &mihfId);
     std::istream &operator >> (std::istream &is, MihfId &mihfId);
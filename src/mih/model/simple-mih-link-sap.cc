@@ -20,6 +20,7 @@
 
 #include "ns3/log.h"
 #include "ns3/boolean.h"
+#include "ns3/simulator.h"
 #include "ns3/mac48-address.h"
 #include "simple-mih-link-sap.h"
 #include "mih-device-information.h"
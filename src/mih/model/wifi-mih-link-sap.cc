@@ -18,12 +18,19 @@
  * Author: Providence SALUMU M. <Providence.Salumu_Munga@it-sudparis.eu>
  */
 
+#include <cmath>
+#include <sstream>
+#include <algorithm>
 #include "ns3/log.h"
 #include "ns3/boolean.h"
 #include "ns3/mac48-address.h"
 #include "wifi-mih-link-sap.h"
 #include "mih-device-information.h"
+#include "mih-link-parameter-80211.h"
 #include "ns3/double.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
 
 NS_LOG_COMPONENT_DEFINE ("WifiMihLinkSap");
 
@@ -37,6 +44,57 @@ namespace ns3 {
       static TypeId tid = TypeId ("ns3::mih::WifiMihLinkSap")
 	.SetParent<MihLinkSap> ()
 	.AddConstructor<WifiMihLinkSap> ()
+        .AddAttribute ("RssiTimeConstant",
+                       "Time constant of the moving average of the serving link signal strength.",
+                       TimeValue (MilliSeconds (250)),
+                       MakeTimeAccessor (&WifiMihLinkSap::m_rssiTimeConstant),
+                       MakeTimeChecker ())
+        .AddAttribute ("RssiTrendTimeConstant",
+                       "Time constant of the moving average of the signal strength slope.",
+                       TimeValue (Seconds (1)),
+                       MakeTimeAccessor (&WifiMihLinkSap::m_rssiTrendTimeConstant),
+                       MakeTimeChecker ())
+        .AddAttribute ("GoingDownThreshold",
+                       "Signal strength (dBm) below which the serving link is expected to be lost.",
+                       DoubleValue (-85.0),
+                       MakeDoubleAccessor (&WifiMihLinkSap::m_goingDownThreshold),
+                       MakeDoubleChecker<double> ())
+        .AddAttribute ("GoingDownHorizon",
+                       "Raise LinkGoingDown once the signal strength trend is predicted to "
+                       "fall below GoingDownThreshold within this time.",
+                       TimeValue (Seconds (1)),
+                       MakeTimeAccessor (&WifiMihLinkSap::m_goingDownHorizon),
+                       MakeTimeChecker ())
+        .AddAttribute ("HandoverOnGoingDown",
+                       "Accept association with any detected PoA stronger than the serving "
+                       "one once LinkGoingDown was raised, rather than only after LinkDown.",
+                       BooleanValue (false),
+                       MakeBooleanAccessor (&WifiMihLinkSap::m_handoverOnGoingDown),
+                       MakeBooleanChecker ())
+        .AddAttribute ("AutonomousHandover",
+                       "Associate with a detected PoA stronger and less loaded than the "
+                       "serving one. If false, only with the PoAs given to LINK_ACTIONS.",
+                       BooleanValue (true),
+                       MakeBooleanAccessor (&WifiMihLinkSap::m_autonomousHandover),
+                       MakeBooleanChecker ())
+        .AddAttribute ("ScanChannels",
+                       "Comma separated channels probed by a LINK_SCAN action, "
+                       "the operating channel only if empty.",
+                       StringValue (""),
+                       MakeStringAccessor (&WifiMihLinkSap::SetScanChannels,
+                                           &WifiMihLinkSap::GetScanChannels),
+                       MakeStringChecker ())
+        .AddAttribute ("ScanDwellTime",
+                       "Time spent waiting for probe responses on each scanned channel.",
+                       TimeValue (MilliSeconds (20)),
+                       MakeTimeAccessor (&WifiMihLinkSap::m_scanDwellTime),
+                       MakeTimeChecker ())
+        .AddAttribute ("ScanCacheTimeToLive",
+                       "Age up to which the results of the last LINK_SCAN action "
+                       "answer a new one without probing again.",
+                       TimeValue (Seconds (1)),
+                       MakeTimeAccessor (&WifiMihLinkSap::m_scanCacheTimeToLive),
+                       MakeTimeChecker ())
 	;
       return tid;
     }
@@ -46,6 +104,11 @@ namespace ns3 {
       NS_LOG_FUNCTION_NOARGS ();
       m_signalStrength = 0;
       m_stationCount = 0;
+      m_powerUp = true;
+      m_scanning = false;
+      m_scanResultsValid = false;
+      m_thresholdEngine.SetReportCallback (MakeCallback (&WifiMihLinkSap::ReportLinkParameters, this));
+      ResetRssiTrend ();
       //m_eventTriggerInterval = CreateObject<UniformRandomVariable> ();
       //m_eventTriggerInterval->SetAttribute ("Min", DoubleValue(0));
       //m_eventTriggerInterval->SetAttribute ("Max", DoubleValue(0.5));
@@ -74,8 +137,27 @@ namespace ns3 {
         {
           NS_LOG_DEBUG (rates.GetRate (j)<<", ");
         }
+      if (IsEventSubscribed (EventList::LINK_DETECTED))
+        {
+          LinkDetectedInformationList linkDetectedInfoList;
+          linkDetectedInfoList.push_back (Create<LinkDetectedInformation> (linkDetectedInfo));
+          MihLinkSap::LinkDetected (sourceMihfId, linkDetectedInfoList);
+        }
       double signalStrength = linkDetectedInfo.GetSignalStrength ().GetValue ();
       uint32_t stationCount = linkDetectedInfo.GetStationCount ();
+      if (!m_handoverTarget.IsInvalid ()
+          && linkDetectedInfo.GetLinkIdentifier ().GetPoALinkAddress () == m_handoverTarget)
+        {
+          NS_LOG_LOGIC ("Handover to " << m_handoverTarget);
+          m_handoverTarget = Address ();
+          m_signalStrength = signalStrength;
+          m_stationCount = stationCount + 1;
+          return true;
+        }
+      if (!m_autonomousHandover)
+        {
+          return false;
+        }
       if (signalStrength > m_signalStrength && stationCount <= m_stationCount)
         {
           m_signalStrength = signalStrength;
@@ -95,13 +177,74 @@ namespace ns3 {
     {
       NS_LOG_FUNCTION (this);
       SetLinkIdentifier (linkIdentifier);
+      ResetRssiTrend ();
       MihLinkSap::LinkUp (sourceMihfId, linkIdentifier, oldAR, newAR, ipRenewal, mobilitySupport);
     }
 
+    void
+    WifiMihLinkSap::LinkDown (MihfId sourceMihfId,
+                              LinkIdentifier linkIdentifier,
+                              Address oldAR,
+                              LinkDownReason reason)
+    {
+      NS_LOG_FUNCTION (this);
+      ResetRssiTrend ();
+      // With the serving PoA gone any detected one will do;
+      m_signalStrength = 0;
+      MihLinkSap::LinkDown (sourceMihfId, linkIdentifier, oldAR, reason);
+    }
+
+    void
+    WifiMihLinkSap::ResetRssiTrend (void)
+    {
+      m_rssiTrend.Reset ();
+      m_goingDownRaised = false;
+    }
+
+    void
+    WifiMihLinkSap::NotifyServingRssi (double rssi)
+    {
+      NotifyLinkParameterSample (LinkParameter80211::BEACON_CHANNEL_RSSI, rssi);
+      if (!m_rssiTrend.Update (rssi, m_rssiTimeConstant, m_rssiTrendTimeConstant))
+        {
+          return;
+        }
+      if (m_goingDownRaised)
+        {
+          // Re-arm once the link clearly recovered;
+          if (m_rssiTrend.GetSlope () >= 0 && m_rssiTrend.GetLevel () > m_goingDownThreshold)
+            {
+              m_goingDownRaised = false;
+            }
+          return;
+        }
+      double timeToThreshold = m_rssiTrend.GetTimeToThreshold (m_goingDownThreshold);
+      if (timeToThreshold < 0 || timeToThreshold > m_goingDownHorizon.GetSeconds ())
+        {
+          return;
+        }
+      m_goingDownRaised = true;
+      NS_LOG_INFO ("Link going down in " << timeToThreshold << "s, RSSI = " << m_rssiTrend.GetLevel ()
+                   << " dBm, slope = " << m_rssiTrend.GetSlope () << " dB/s");
+      if (m_handoverOnGoingDown)
+        {
+          // Same scale as the signal strength of detected links;
+          m_signalStrength = (uint16_t) (int32_t) std::floor (m_rssiTrend.GetLevel ());
+        }
+      LinkGoingDown (m_mihfId, m_linkIdentifier,
+                     (uint64_t) (timeToThreshold * 1000),
+                     LinkGoingDownReason (LinkGoingDownReason::LINK_PARAMETER_DEGRADING));
+    }
+
     void
     WifiMihLinkSap::DoDispose (void)
     {
       NS_LOG_FUNCTION (this);
+      m_thresholdEngine.Clear ();
+      m_scan = MakeNullCallback<void, std::vector<uint8_t>, Time> ();
+      m_power = MakeNullCallback<void, bool> ();
+      m_scanResults.clear ();
+      m_scanConfirms.clear ();
       MihLinkSap::DoDispose ();
     }
   
@@ -196,6 +339,42 @@ namespace ns3 {
       NS_LOG_FUNCTION (this);
       m_sendAssoc = sendAssoc;
     }
+    void
+    WifiMihLinkSap::SetScanCallback (Callback<void, std::vector<uint8_t>, Time> scan)
+    {
+      NS_LOG_FUNCTION (this);
+      m_scan = scan;
+    }
+    void
+    WifiMihLinkSap::SetPowerCallback (Callback<void, bool> power)
+    {
+      NS_LOG_FUNCTION (this);
+      m_power = power;
+    }
+    void
+    WifiMihLinkSap::SetScanChannels (std::string channels)
+    {
+      NS_LOG_FUNCTION (this << channels);
+      m_scanChannels.clear ();
+      std::replace (channels.begin (), channels.end (), ',', ' ');
+      std::istringstream iss (channels);
+      uint32_t channel;
+      while (iss >> channel)
+        {
+          NS_ASSERT (channel > 0 && channel <= 0xff);
+          m_scanChannels.push_back (channel);
+        }
+    }
+    std::string
+    WifiMihLinkSap::GetScanChannels (void) const
+    {
+      std::ostringstream oss;
+      for (uint32_t j = 0; j < m_scanChannels.size (); j++)
+        {
+          oss << (j == 0 ? "" : ",") << (uint32_t) m_scanChannels[j];
+        }
+      return oss.str ();
+    }
 
     LinkCapabilityDiscoverConfirm
     WifiMihLinkSap::CapabilityDiscover (void) 
@@ -207,7 +386,8 @@ namespace ns3 {
 					     EventList::LINK_DOWN |
 					     EventList::LINK_PARAMETERS_REPORT),
 					    (MihCommandList::LINK_GET_PARAMETERS |
-					     MihCommandList::LINK_CONFIGURE_THRESHOLDS));
+					     MihCommandList::LINK_CONFIGURE_THRESHOLDS |
+					     MihCommandList::LINK_ACTIONS));
     }
     LinkGetParametersConfirm 
     WifiMihLinkSap::GetParameters (LinkParameterTypeList linkParametersRequest, 
@@ -221,8 +401,13 @@ namespace ns3 {
     WifiMihLinkSap::ConfigureThresholds (LinkConfigurationParameterList configureParameters)
     {
       NS_LOG_FUNCTION (this);
-      //      NS_ASSERT (m_powerUp);
-      return LinkConfigureThresholdsConfirm (Status::UNSPECIFIED_FAILURE);
+      return m_thresholdEngine.Configure (configureParameters);
+    }
+    void
+    WifiMihLinkSap::ReportLinkParameters (LinkParameterReportList parameters)
+    {
+      NS_LOG_FUNCTION (this);
+      LinkParametersReport (m_mihfId, m_linkIdentifier, parameters);
     }
     EventId
     WifiMihLinkSap::Action (LinkAction action, 
@@ -230,7 +415,178 @@ namespace ns3 {
 			      Address poaLinkAddress,
 			      LinkActionConfirmCallback actionConfirmCb)
     {
-      return EventId ();
+      NS_LOG_FUNCTION (this << executionDelay);
+      if (executionDelay == 0
+          && action.GetType () == LinkAction::NONE
+          && (action.GetActionAttribute () & LinkAction::LINK_SCAN)
+          && IsScanCacheFresh ())
+        {
+          NS_LOG_LOGIC ("Scan answered from the cache");
+          actionConfirmCb (Status (Status::SUCCESS),
+                           m_scanResults,
+                           LinkActionResponse::SUCCESS,
+                           m_linkIdentifier);
+          return EventId ();
+        }
+      return Simulator::Schedule (MilliSeconds (executionDelay),
+                                  &WifiMihLinkSap::DoAction,
+                                  this,
+                                  action,
+                                  poaLinkAddress,
+                                  actionConfirmCb);
+    }
+    Time
+    WifiMihLinkSap::GetActionDuration (LinkAction action)
+    {
+      if (!(action.GetActionAttribute () & LinkAction::LINK_SCAN) || m_scan.IsNull ())
+        {
+          return Seconds (0);
+        }
+      // Confirmed once every channel was dwelt on;
+      return m_scanDwellTime * m_scanChannels.size ();
+    }
+    void
+    WifiMihLinkSap::DoAction (LinkAction action,
+                              Address poaLinkAddress,
+                              LinkActionConfirmCallback actionConfirmCb)
+    {
+      NS_LOG_FUNCTION (this << poaLinkAddress);
+      LinkActionResponse::ActionResult result = LinkActionResponse::SUCCESS;
+      switch (action.GetType ())
+        {
+        case LinkAction::NONE:
+          // Associate with this PoA on its next beacon;
+          if (!poaLinkAddress.IsInvalid () && poaLinkAddress != GetPoAAddress ())
+            {
+              m_handoverTarget = poaLinkAddress;
+            }
+          break;
+        case LinkAction::LINK_POWER_DOWN:
+          if (m_power.IsNull ())
+            {
+              result = LinkActionResponse::INCAPABLE;
+            }
+          else if (m_powerUp)
+            {
+              if (m_scanning)
+                {
+                  CompleteScan (LinkActionResponse::FAILURE);
+                }
+              m_scanResultsValid = false;
+              m_powerUp = false;
+              m_power (false);
+            }
+          break;
+        case LinkAction::LINK_POWER_UP:
+          if (m_power.IsNull ())
+            {
+              result = LinkActionResponse::INCAPABLE;
+            }
+          else if (!m_powerUp)
+            {
+              m_powerUp = true;
+              m_power (true);
+            }
+          break;
+        default:
+          result = LinkActionResponse::INCAPABLE;
+          break;
+        }
+      if (!(action.GetActionAttribute () & LinkAction::LINK_SCAN))
+        {
+          actionConfirmCb (Status (Status::SUCCESS),
+                           ScanResponseList (),
+                           result,
+                           m_linkIdentifier);
+          return;
+        }
+      if (result != LinkActionResponse::SUCCESS || m_scan.IsNull () || !m_powerUp)
+        {
+          if (result == LinkActionResponse::SUCCESS)
+            {
+              result = m_scan.IsNull () ? LinkActionResponse::INCAPABLE : LinkActionResponse::REFUSED;
+            }
+          actionConfirmCb (Status (Status::SUCCESS),
+                           ScanResponseList (),
+                           result,
+                           m_linkIdentifier);
+          return;
+        }
+      if (IsScanCacheFresh ())
+        {
+          actionConfirmCb (Status (Status::SUCCESS),
+                           m_scanResults,
+                           LinkActionResponse::SUCCESS,
+                           m_linkIdentifier);
+          return;
+        }
+      // Requests arriving during a scan share its results;
+      m_scanConfirms.push_back (actionConfirmCb);
+      if (!m_scanning)
+        {
+          m_scanning = true;
+          m_scanResultsValid = false;
+          m_scanResults.clear ();
+          m_scan (m_scanChannels, m_scanDwellTime);
+        }
+    }
+    bool
+    WifiMihLinkSap::IsScanCacheFresh (void) const
+    {
+      return m_scanResultsValid
+        && Simulator::Now () - m_scanTime <= m_scanCacheTimeToLive;
+    }
+    void
+    WifiMihLinkSap::NotifyScanResponse (Address poaLinkAddress, std::string ssid, double rssi)
+    {
+      NS_LOG_FUNCTION (this << poaLinkAddress << ssid << rssi);
+      if (!m_scanning)
+        {
+          return;
+        }
+      // Same scale as the signal strength of detected links;
+      Ptr<ScanResponse> response = Create<ScanResponse> (poaLinkAddress,
+                                                         NetworkIdentifier (ssid),
+                                                         SignalStrength ((uint16_t) (int32_t) std::floor (rssi)));
+      for (ScanResponseListI i = m_scanResults.begin (); i != m_scanResults.end (); i++)
+        {
+          if ((*i)->GetPoALinkAddress () == poaLinkAddress)
+            {
+              *i = response;
+              return;
+            }
+        }
+      m_scanResults.push_back (response);
+    }
+    void
+    WifiMihLinkSap::NotifyScanComplete (void)
+    {
+      NS_LOG_FUNCTION (this);
+      if (!m_scanning)
+        {
+          return;
+        }
+      NS_LOG_LOGIC (m_scanResults.size () << " PoAs found");
+      m_scanResultsValid = true;
+      m_scanTime = Simulator::Now ();
+      CompleteScan (LinkActionResponse::SUCCESS);
+    }
+    void
+    WifiMihLinkSap::CompleteScan (LinkActionResponse::ActionResult result)
+    {
+      NS_LOG_FUNCTION (this);
+      m_scanning = false;
+      std::vector<LinkActionConfirmCallback> confirms;
+      confirms.swap (m_scanConfirms);
+      ScanResponseList scans;
+      if (result == LinkActionResponse::SUCCESS)
+        {
+          scans = m_scanResults;
+        }
+      for (uint32_t j = 0; j < confirms.size (); j++)
+        {
+          confirms[j] (Status (Status::SUCCESS), scans, result, m_linkIdentifier);
+        }
     }
     Ptr<DeviceStatesResponse> 
     WifiMihLinkSap::GetDeviceStates (void)
@@ -21,10 +21,13 @@
 #ifndef   	WIFI_MIH_LINK_SAP_H
 #define   	WIFI_MIH_LINK_SAP_H
 
+#include <vector>
+#include <string>
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
 #include "mihf-id.h"
 #include "mih-link-sap.h"
+#include "mih-signal-trend.h"
 
 namespace ns3 {
   namespace mih {
@@ -41,6 +44,12 @@ namespace ns3 {
                            Address newAR,
                            bool ipRenewal,
                            MobilityManagementSupport mobilitySupport);
+      virtual void LinkDown (MihfId sourceMihfId,
+                             LinkIdentifier linkIdentifier,
+                             Address oldAR,
+                             LinkDownReason reason);
+      // Signal strength (dBm) of a frame from the serving PoA;
+      void NotifyServingRssi (double rssi);
       virtual LinkType GetLinkType (void);
       void SetLinkType (LinkType linkType);
       virtual Address GetLinkAddress (void);
@@ -63,9 +72,20 @@ namespace ns3 {
                               uint64_t executionDelay, 
                               Address poaLinkAddress,
                               LinkActionConfirmCallback actionConfirmCb);
+      virtual Time GetActionDuration (LinkAction action);
       MihfId GetMihfId ();
       void SetMihfId (MihfId mihfId);
       void SetSendAssocCallback (Callback<void> sendAssoc);
+      // Probe the given channels, staying the given time on each, and
+      // call NotifyScanComplete once back on the operating channel;
+      void SetScanCallback (Callback<void, std::vector<uint8_t>, Time> scan);
+      // Switch the radio off (false) or back on (true);
+      void SetPowerCallback (Callback<void, bool> power);
+      // PoA answering a LINK_SCAN probe, signal strength (dBm);
+      void NotifyScanResponse (Address poaLinkAddress, std::string ssid, double rssi);
+      void NotifyScanComplete (void);
+      void SetScanChannels (std::string channels);
+      std::string GetScanChannels (void) const;
 
       //void Run (void);
       
@@ -78,12 +98,16 @@ namespace ns3 {
       //void TriggerLinkUp (void);
       //void TriggerLinkDown (void);
 
-      //void DoAction (LinkAction action,
-      //               Address poaLinkAddress,
-      //               LinkActionConfirmCallback actionConfirmCb);
+      void DoAction (LinkAction action,
+                     Address poaLinkAddress,
+                     LinkActionConfirmCallback actionConfirmCb);
+      bool IsScanCacheFresh (void) const;
+      void CompleteScan (LinkActionResponse::ActionResult result);
         
       virtual void DoDispose (void);
       virtual Ptr<DeviceStatesResponse> GetDeviceStates (void);
+      void ReportLinkParameters (LinkParameterReportList parameters);
+      void ResetRssiTrend (void);
       LinkIdentifier m_linkIdentifier;
       //EventId m_nextEventId;
       //Ptr<UniformRandomVariable> m_eventTriggerInterval;// rng for next Tx
@@ -93,9 +117,32 @@ namespace ns3 {
     
       MihfId m_mihfId;
       Callback<void> m_sendAssoc;
+      Callback<void, std::vector<uint8_t>, Time> m_scan;
+      Callback<void, bool> m_power;
       double m_signalStrength;
       uint32_t m_stationCount;
-      //bool m_powerUp;
+      // Serving link RSSI trend, level in dBm and slope in dB/s;
+      Time m_rssiTimeConstant;
+      Time m_rssiTrendTimeConstant;
+      double m_goingDownThreshold;
+      Time m_goingDownHorizon;
+      bool m_handoverOnGoingDown;
+      bool m_autonomousHandover;
+      // PoA given to LINK_ACTIONS, associated with once detected;
+      Address m_handoverTarget;
+      SignalTrend m_rssiTrend;
+      bool m_goingDownRaised;
+      bool m_powerUp;
+      // LINK_SCAN actions, the last results are served again until they
+      // are older than ScanCacheTimeToLive;
+      std::vector<uint8_t> m_scanChannels;
+      Time m_scanDwellTime;
+      Time m_scanCacheTimeToLive;
+      bool m_scanning;
+      ScanResponseList m_scanResults;
+      bool m_scanResultsValid;
+      Time m_scanTime;
+      std::vector<LinkActionConfirmCallback> m_scanConfirms;
 
     };
   } // namespace mih
@@ -0,0 +1,356 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include "ns3/log.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "wimax-mih-link-sap.h"
+#include "mih-device-information.h"
+#include "mih-link-parameter-80216.h"
+
+NS_LOG_COMPONENT_DEFINE ("WimaxMihLinkSap");
+
+namespace ns3 {
+  namespace mih {
+    NS_OBJECT_ENSURE_REGISTERED (WimaxMihLinkSap);
+
+    TypeId
+    WimaxMihLinkSap::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::mih::WimaxMihLinkSap")
+        .SetParent<MihLinkSap> ()
+        .AddConstructor<WimaxMihLinkSap> ()
+        .AddAttribute ("CinrTimeConstant",
+                       "Time constant of the moving average of the downlink CINR.",
+                       TimeValue (MilliSeconds (250)),
+                       MakeTimeAccessor (&WimaxMihLinkSap::m_cinrTimeConstant),
+                       MakeTimeChecker ())
+        .AddAttribute ("CinrTrendTimeConstant",
+                       "Time constant of the moving average of the CINR slope.",
+                       TimeValue (Seconds (1)),
+                       MakeTimeAccessor (&WimaxMihLinkSap::m_cinrTrendTimeConstant),
+                       MakeTimeChecker ())
+        .AddAttribute ("GoingDownThreshold",
+                       "Downlink CINR (dB) below which the link is expected to be lost.",
+                       DoubleValue (6.0),
+                       MakeDoubleAccessor (&WimaxMihLinkSap::m_goingDownThreshold),
+                       MakeDoubleChecker<double> ())
+        .AddAttribute ("GoingDownHorizon",
+                       "Raise LinkGoingDown once the CINR trend is predicted to fall below "
+                       "GoingDownThreshold within this time.",
+                       TimeValue (Seconds (1)),
+                       MakeTimeAccessor (&WimaxMihLinkSap::m_goingDownHorizon),
+                       MakeTimeChecker ())
+        .AddAttribute ("GoingDownHysteresis",
+                       "CINR (dB) above GoingDownThreshold the downlink must get back to, "
+                       "and no longer fall, before LinkGoingDown may be raised again.",
+                       DoubleValue (2.0),
+                       MakeDoubleAccessor (&WimaxMihLinkSap::m_goingDownHysteresis),
+                       MakeDoubleChecker<double> (0.0))
+        ;
+      return tid;
+    }
+    WimaxMihLinkSap::WimaxMihLinkSap (void) :
+      m_linkIdentifier (),
+      m_registered (false),
+      m_cinr (0),
+      m_stationCount (0),
+      m_goingDownRaised (false)
+    {
+      NS_LOG_FUNCTION_NOARGS ();
+      m_linkIdentifier.SetType (LinkType (LinkType::WIRELESS_802_16));
+      m_thresholdEngine.SetReportCallback (MakeCallback (&WimaxMihLinkSap::ReportLinkParameters, this));
+    }
+    WimaxMihLinkSap::~WimaxMihLinkSap (void)
+    {
+      NS_LOG_FUNCTION_NOARGS ();
+    }
+    void
+    WimaxMihLinkSap::DoDispose (void)
+    {
+      NS_LOG_FUNCTION (this);
+      m_thresholdEngine.Clear ();
+      MihLinkSap::DoDispose ();
+    }
+    bool
+    WimaxMihLinkSap::ConnectDevice (Ptr<NetDevice> device)
+    {
+      NS_LOG_FUNCTION (this << device);
+      SetLinkAddress (device->GetAddress ());
+      std::ostringstream oss;
+      oss << "/NodeList/" << device->GetNode ()->GetId ()
+          << "/DeviceList/" << device->GetIfIndex () << "/";
+      std::string path = oss.str ();
+      std::string typeName = device->GetInstanceTypeId ().GetName ();
+      if (typeName == "ns3::SubscriberStationNetDevice")
+        {
+          path += "$ns3::SubscriberStationNetDevice/";
+          Config::ConnectWithoutContext (path + "StateChange",
+                                         MakeCallback (&WimaxMihLinkSap::SsStateChange, this));
+          Config::ConnectWithoutContext (path + "Phy/$ns3::SimpleOfdmWimaxPhy/RxCinr",
+                                         MakeCallback (&WimaxMihLinkSap::SsRxCinr, this));
+          return true;
+        }
+      if (typeName == "ns3::BaseStationNetDevice")
+        {
+          SetPoAAddress (device->GetAddress ());
+          path += "$ns3::BaseStationNetDevice/LinkManager/";
+          Config::ConnectWithoutContext (path + "SsRegistered",
+                                         MakeCallback (&WimaxMihLinkSap::BsSsRegistered, this));
+          return true;
+        }
+      NS_LOG_WARN ("Not a WiMAX device: " << typeName);
+      return false;
+    }
+    bool
+    WimaxMihLinkSap::IsRegisteredState (uint8_t state)
+    {
+      return state >= SS_STATE_REGISTERED && state != SS_STATE_STOPPED;
+    }
+    void
+    WimaxMihLinkSap::SsStateChange (Mac48Address baseStationId, uint8_t oldState, uint8_t newState)
+    {
+      NS_LOG_FUNCTION (this << baseStationId << (uint32_t) oldState << (uint32_t) newState);
+      if (oldState == SS_STATE_SYNCHRONIZING && newState == SS_STATE_ACQUIRING_PARAMETERS)
+        {
+          if (!IsEventSubscribed (EventList::LINK_DETECTED))
+            {
+              return;
+            }
+          NS_LOG_DEBUG ("BS " << baseStationId << " detected, CINR = " << m_cinr << " dB");
+          LinkDetectedInformation *info = new LinkDetectedInformation (LinkIdentifier (GetLinkType (), GetLinkAddress (), baseStationId),
+                                                                       NetworkIdentifier (),
+                                                                       NetworkAuxiliaryIdentifier (),
+                                                                       SignalStrength (),
+                                                                       (uint16_t) std::max (0.0, std::floor (m_cinr)),
+                                                                       SupportedRates (),
+                                                                       MihCapabilityFlag (),
+                                                                       NetworkCapabilities (),
+                                                                       0);
+          LinkDetectedInformationList linkDetectedInfoList;
+          linkDetectedInfoList.push_back (Ptr<LinkDetectedInformation> (info, false));
+          LinkDetected (m_mihfId, linkDetectedInfoList);
+        }
+      else if (!m_registered && IsRegisteredState (newState))
+        {
+          Address oldAR = GetPoAAddress ();
+          m_registered = true;
+          m_goingDownRaised = false;
+          m_cinrTrend.Reset ();
+          SetPoAAddress (baseStationId);
+          LinkUp (m_mihfId, m_linkIdentifier, oldAR, baseStationId, oldAR != Address (baseStationId),
+                  MobilityManagementSupport (MobilityManagementSupport::MOBILE_IPV4_RFC3344));
+        }
+      else if (m_registered && !IsRegisteredState (newState))
+        {
+          m_registered = false;
+          LinkDown (m_mihfId, m_linkIdentifier, GetPoAAddress (),
+                    LinkDownReason (newState == SS_STATE_STOPPED ?
+                                    LinkDownReason::EXPLICIT_DISCONNECT :
+                                    LinkDownReason::NO_BROADCAST));
+        }
+    }
+    void
+    WimaxMihLinkSap::SsRxCinr (double cinr)
+    {
+      m_cinr = cinr;
+      if (!m_registered)
+        {
+          return;
+        }
+      NotifyLinkParameterSample (LinkThresholdEngine::WIMAX_PARAMETER_BASE + LinkParameter80216::CINR, cinr);
+      if (!m_cinrTrend.Update (cinr, m_cinrTimeConstant, m_cinrTrendTimeConstant))
+        {
+          return;
+        }
+      if (m_goingDownRaised)
+        {
+          if (m_cinrTrend.GetSlope () >= 0 &&
+              m_cinrTrend.GetLevel () > m_goingDownThreshold + m_goingDownHysteresis)
+            {
+              m_goingDownRaised = false;
+            }
+          return;
+        }
+      double timeToThreshold = m_cinrTrend.GetTimeToThreshold (m_goingDownThreshold);
+      if (timeToThreshold < 0 || timeToThreshold > m_goingDownHorizon.GetSeconds ())
+        {
+          return;
+        }
+      m_goingDownRaised = true;
+      NS_LOG_INFO ("Link going down in " << timeToThreshold << "s, CINR = " << m_cinrTrend.GetLevel ()
+                   << " dB, slope = " << m_cinrTrend.GetSlope () << " dB/s");
+      LinkGoingDown (m_mihfId, m_linkIdentifier,
+                     (uint64_t) (timeToThreshold * 1000),
+                     LinkGoingDownReason (LinkGoingDownReason::LINK_PARAMETER_DEGRADING));
+    }
+    void
+    WimaxMihLinkSap::BsSsRegistered (Mac48Address ssAddress)
+    {
+      NS_LOG_FUNCTION (this << ssAddress);
+      m_stationCount++;
+    }
+
+    LinkType
+    WimaxMihLinkSap::GetLinkType (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_linkIdentifier.GetType ();
+    }
+    void
+    WimaxMihLinkSap::SetLinkType (LinkType linkType)
+    {
+      NS_LOG_FUNCTION (this);
+      m_linkIdentifier.SetType (linkType);
+    }
+    Address
+    WimaxMihLinkSap::GetLinkAddress (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_linkIdentifier.GetDeviceLinkAddress ();
+    }
+    void
+    WimaxMihLinkSap::SetLinkAddress (Address addr)
+    {
+      NS_LOG_FUNCTION (this);
+      m_linkIdentifier.SetDeviceLinkAddress (addr);
+    }
+    LinkIdentifier
+    WimaxMihLinkSap::GetLinkIdentifier (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_linkIdentifier;
+    }
+    void
+    WimaxMihLinkSap::SetLinkIdentifier (LinkIdentifier linkIdentifier)
+    {
+      NS_LOG_FUNCTION (this);
+      m_linkIdentifier = linkIdentifier;
+    }
+    Address
+    WimaxMihLinkSap::GetPoAAddress (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_linkIdentifier.GetPoALinkAddress ();
+    }
+    void
+    WimaxMihLinkSap::SetPoAAddress (Address addr)
+    {
+      NS_LOG_FUNCTION (this);
+      m_linkIdentifier.SetPoALinkAddress (addr);
+    }
+    double
+    WimaxMihLinkSap::GetSignalStrength (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_cinr;
+    }
+    uint32_t
+    WimaxMihLinkSap::GetStationCount (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_stationCount;
+    }
+    bool
+    WimaxMihLinkSap::IsRegistered (void) const
+    {
+      return m_registered;
+    }
+    MihfId
+    WimaxMihLinkSap::GetMihfId ()
+    {
+      NS_LOG_FUNCTION (this);
+      return m_mihfId;
+    }
+    void
+    WimaxMihLinkSap::SetMihfId (MihfId mihfId)
+    {
+      NS_LOG_FUNCTION (this);
+      m_mihfId = mihfId;
+    }
+
+    LinkCapabilityDiscoverConfirm
+    WimaxMihLinkSap::CapabilityDiscover (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return LinkCapabilityDiscoverConfirm (Status::SUCCESS,
+                                            (EventList::LINK_DETECTED |
+                                             EventList::LINK_UP |
+                                             EventList::LINK_DOWN |
+                                             EventList::LINK_PARAMETERS_REPORT |
+                                             EventList::LINK_GOING_DOWN),
+                                            (MihCommandList::LINK_GET_PARAMETERS |
+                                             MihCommandList::LINK_CONFIGURE_THRESHOLDS));
+    }
+    LinkGetParametersConfirm
+    WimaxMihLinkSap::GetParameters (LinkParameterTypeList linkParametersRequest,
+                                    LinkStatesRequest linkStatesRequest,
+                                    LinkDescriptorsRequest descriptors)
+    {
+      NS_LOG_FUNCTION (this);
+      return LinkGetParametersConfirm ();
+    }
+    LinkConfigureThresholdsConfirm
+    WimaxMihLinkSap::ConfigureThresholds (LinkConfigurationParameterList configureParameters)
+    {
+      NS_LOG_FUNCTION (this);
+      return m_thresholdEngine.Configure (configureParameters);
+    }
+    void
+    WimaxMihLinkSap::ReportLinkParameters (LinkParameterReportList parameters)
+    {
+      NS_LOG_FUNCTION (this);
+      LinkParametersReport (m_mihfId, m_linkIdentifier, parameters);
+    }
+    EventId
+    WimaxMihLinkSap::Action (LinkAction action,
+                             uint64_t executionDelay,
+                             Address poaLinkAddress,
+                             LinkActionConfirmCallback actionConfirmCb)
+    {
+      NS_LOG_FUNCTION (this << executionDelay);
+      return Simulator::Schedule (MilliSeconds (executionDelay),
+                                  &WimaxMihLinkSap::DoAction,
+                                  this,
+                                  action,
+                                  poaLinkAddress,
+                                  actionConfirmCb);
+    }
+    void
+    WimaxMihLinkSap::DoAction (LinkAction action,
+                               Address poaLinkAddress,
+                               LinkActionConfirmCallback actionConfirmCb)
+    {
+      NS_LOG_FUNCTION (this << poaLinkAddress);
+      // Network entry and handovers are left to the SS MAC;
+      actionConfirmCb (Status (Status::SUCCESS),
+                       ScanResponseList (),
+                       LinkActionResponse::INCAPABLE,
+                       m_linkIdentifier);
+    }
+    Ptr<DeviceStatesResponse>
+    WimaxMihLinkSap::GetDeviceStates (void)
+    {
+      NS_LOG_FUNCTION (this);
+      return Create<DeviceInformation> ("OEM = ns-3Team");
+    }
+  } // namespace mih
+} // namespace ns3
@@ -0,0 +1,116 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef   	WIMAX_MIH_LINK_SAP_H
+#define   	WIMAX_MIH_LINK_SAP_H
+
+#include "ns3/nstime.h"
+#include "ns3/net-device.h"
+#include "ns3/mac48-address.h"
+#include "mihf-id.h"
+#include "mih-link-sap.h"
+#include "mih-signal-trend.h"
+
+namespace ns3 {
+  namespace mih {
+    // Link SAP of a 802.16 SS or BS device. As for LteMihLinkSap, the
+    // events are derived from trace sources of the device hooked by
+    // configuration path, the mih module does not depend on the wimax
+    // one:
+    //
+    // - SS: the StateChange trace gives LinkDetected once it is
+    //   synchronized with a BS, LinkUp once the initial ranging
+    //   succeeded and LinkDown when the BS is lost or the device
+    //   stopped; the downlink CINR reported by the PHY feeds the CINR
+    //   thresholds and the CINR trend LinkGoingDown is raised from,
+    //   with the time left before the CINR is predicted to reach
+    //   GoingDownThreshold;
+    // - BS: SS registrations keep the station count. The BS does not
+    //   detect SSs leaving, hence the count never decreases.
+    class WimaxMihLinkSap : public MihLinkSap {
+    public:
+      static TypeId GetTypeId (void);
+      WimaxMihLinkSap (void);
+      virtual ~WimaxMihLinkSap (void);
+      // Hooks a SubscriberStationNetDevice or a BaseStationNetDevice,
+      // false if the device is neither;
+      bool ConnectDevice (Ptr<NetDevice> device);
+      virtual LinkType GetLinkType (void);
+      void SetLinkType (LinkType linkType);
+      virtual Address GetLinkAddress (void);
+      void SetLinkAddress (Address addr);
+      virtual LinkIdentifier GetLinkIdentifier (void);
+      virtual void SetLinkIdentifier (LinkIdentifier linkIdentifier);
+      virtual Address GetPoAAddress (void);
+      virtual void SetPoAAddress (Address addr);
+      // Downlink CINR (dB) of the last burst received, the PHY does
+      // not report the received power;
+      virtual double GetSignalStrength (void);
+      virtual uint32_t GetStationCount (void);
+      bool IsRegistered (void) const;
+
+      virtual LinkCapabilityDiscoverConfirm CapabilityDiscover (void);
+      virtual LinkGetParametersConfirm GetParameters (LinkParameterTypeList linkParametersRequest,
+                                                      LinkStatesRequest linkStatesRequest,
+                                                      LinkDescriptorsRequest descriptors);
+      virtual LinkConfigureThresholdsConfirm ConfigureThresholds (LinkConfigurationParameterList configureParameters);
+      virtual EventId Action (LinkAction action,
+                              uint64_t executionDelay,
+                              Address poaLinkAddress,
+                              LinkActionConfirmCallback actionConfirmCb);
+      MihfId GetMihfId ();
+      void SetMihfId (MihfId mihfId);
+
+    protected:
+      // SubscriberStationNetDevice::State values the SAP relies on;
+      enum SsState {
+        SS_STATE_SYNCHRONIZING = 2,
+        SS_STATE_ACQUIRING_PARAMETERS = 3,
+        SS_STATE_REGISTERED = 8,
+        SS_STATE_STOPPED = 10,
+      };
+      virtual void DoDispose (void);
+      virtual Ptr<DeviceStatesResponse> GetDeviceStates (void);
+      void ReportLinkParameters (LinkParameterReportList parameters);
+      // Confirms every action as INCAPABLE;
+      void DoAction (LinkAction action,
+                     Address poaLinkAddress,
+                     LinkActionConfirmCallback actionConfirmCb);
+      static bool IsRegisteredState (uint8_t state);
+      // SubscriberStationNetDevice and SimpleOfdmWimaxPhy trace sinks;
+      void SsStateChange (Mac48Address baseStationId, uint8_t oldState, uint8_t newState);
+      void SsRxCinr (double cinr);
+      // BSLinkManager trace sink;
+      void BsSsRegistered (Mac48Address ssAddress);
+
+      LinkIdentifier m_linkIdentifier;
+      MihfId m_mihfId;
+      bool m_registered;
+      double m_cinr;
+      uint32_t m_stationCount;
+      // Downlink CINR trend, level in dB and slope in dB/s;
+      SignalTrend m_cinrTrend;
+      Time m_cinrTimeConstant;
+      Time m_cinrTrendTimeConstant;
+      double m_goingDownThreshold;
+      Time m_goingDownHorizon;
+      double m_goingDownHysteresis;
+      bool m_goingDownRaised;
+    };
+  } // namespace mih
+} // namespace ns3
+
+#endif 	    /* !WIMAX_MIH_LINK_SAP_H */
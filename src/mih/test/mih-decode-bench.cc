@@ -0,0 +1,175 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Decoding cost of MIH_Link_Detected indications, with the list
+// elements allocated one by one or from a MihMessageArena: heap
+// allocations and time per decoded message.
+//
+// ./waf --run "mih-decode-bench --n=10000 --entries=8 --min-iterations=10"
+
+#include <iostream>
+#include <limits>
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <cstdlib>
+#include "ns3/command-line.h"
+#include "ns3/buffer.h"
+#include "ns3/mac48-address.h"
+#include "ns3/mihf-id.h"
+#include "ns3/mih-link-detected-information.h"
+#include "ns3/mih-message-arena.h"
+
+using namespace ns3;
+
+static uint64_t g_allocations = 0;
+
+void *
+operator new (size_t size)
+{
+  g_allocations++;
+  void *p = std::malloc (size);
+  if (p == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+static Buffer g_message;
+static uint64_t g_decoded = 0;
+// Held for the whole run, as the MIH function and its session hold
+// them, so that decoding finds the names interned;
+static mih::MihfId g_from;
+static mih::MihfId g_to;
+
+static void
+Setup (uint32_t entries)
+{
+  g_from = mih::MihfId ("poa-mihf@ap");
+  g_to = mih::MihfId ("mn-mihf@sta");
+  mih::LinkDetectedInformationList list;
+  for (uint32_t j = 0; j < entries; j++)
+    {
+      uint8_t mac[6] = { 0, 0, 0, 0, 1, static_cast<uint8_t> (j + 1) };
+      Mac48Address poa;
+      poa.CopyFrom (mac);
+      mih::LinkIdentifier linkId (mih::LinkType (mih::LinkType::WIRELESS_802_11),
+                                  Mac48Address ("00:00:00:00:00:01"),
+                                  poa);
+      mih::LinkDetectedInformation *info =
+        new mih::LinkDetectedInformation (linkId,
+                                          mih::NetworkIdentifier ("ns-3-ssid"),
+                                          mih::NetworkAuxiliaryIdentifier (),
+                                          mih::SignalStrength (180),
+                                          25,
+                                          SupportedRates (),
+                                          mih::MihCapabilityFlag (),
+                                          mih::NetworkCapabilities (),
+                                          3);
+      list.push_back (Ptr<mih::LinkDetectedInformation> (info, false));
+    }
+  g_message.AddAtEnd (g_from.GetTlvSerializedSize () +
+                      g_to.GetTlvSerializedSize () +
+                      mih::GetTlvSerializedSize (list));
+  Buffer::Iterator i = g_message.Begin ();
+  g_from.TlvSerialize (i);
+  g_to.TlvSerialize (i);
+  mih::TlvSerialize (i, list);
+}
+
+// Decode one message and drop it, as HandleRead does once the
+// indication callback returned.
+static void
+Decode (void)
+{
+  mih::MihfId from;
+  mih::MihfId to;
+  mih::LinkDetectedInformationList list;
+  Buffer::Iterator i = g_message.Begin ();
+  from.TlvDeserialize (i);
+  to.TlvDeserialize (i);
+  mih::TlvDeserialize (i, list);
+  g_decoded += list.size ();
+}
+
+static void
+benchHeap (uint32_t n)
+{
+  for (uint32_t j = 0; j < n; j++)
+    {
+      Decode ();
+    }
+}
+
+static void
+benchArena (uint32_t n)
+{
+  for (uint32_t j = 0; j < n; j++)
+    {
+      mih::MihMessageArena arena;
+      Decode ();
+    }
+}
+
+static void
+runBench (void (*bench) (uint32_t), uint32_t n, uint32_t minIterations, char const *name)
+{
+  typedef std::chrono::steady_clock Clock;
+  int64_t minDelay = std::numeric_limits<int64_t>::max ();
+  uint64_t allocations = 0;
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      uint64_t allocationsBefore = g_allocations;
+      Clock::time_point start = Clock::now ();
+      (*bench) (n);
+      int64_t delay = std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now () - start).count ();
+      minDelay = std::min (minDelay, delay);
+      allocations = g_allocations - allocationsBefore;
+    }
+  std::cout << static_cast<double> (allocations) / n << " allocations/message, "
+            << minDelay / n << " ns/message"
+            << " (" << minDelay / 1000000 << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 10000;
+  uint32_t entries = 8;
+  uint32_t minIterations = 10;
+
+  CommandLine cmd;
+  cmd.AddValue ("n", "number of indications to decode", n);
+  cmd.AddValue ("entries", "number of detected links per indication", entries);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  Setup (entries);
+  std::cout << "Decoding " << n << " MIH_Link_Detected indications of "
+            << entries << " links (" << g_message.GetSize () << " bytes)" << std::endl;
+  runBench (&benchHeap, n, minIterations, "Heap allocated");
+  runBench (&benchArena, n, minIterations, "Message arena");
+
+  return 0;
+}
@@ -0,0 +1,368 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include <sstream>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/node.h"
+#include "ns3/socket.h"
+#include "ns3/mac48-address.h"
+#include "ns3/mih-session.h"
+#include "ns3/mih-payload.h"
+#include "ns3/mih-link-parameter-80211.h"
+#include "ns3/mih-link-parameter-value.h"
+
+using namespace ns3;
+using namespace ns3::mih;
+
+// Keeps the PDUs a datagram session sends instead of putting them on
+// a network;
+class PduCaptureSocket : public Socket
+{
+public:
+  virtual enum SocketErrno GetErrno (void) const { return ERROR_NOTERROR; }
+  virtual enum SocketType GetSocketType (void) const { return NS3_SOCK_DGRAM; }
+  virtual Ptr<Node> GetNode (void) const { return 0; }
+  virtual int Bind (const Address &address) { return 0; }
+  virtual int Bind () { return 0; }
+  virtual int Bind6 () { return 0; }
+  virtual int Close (void) { return 0; }
+  virtual int ShutdownSend (void) { return 0; }
+  virtual int ShutdownRecv (void) { return 0; }
+  virtual int Connect (const Address &address) { return 0; }
+  virtual int Listen (void) { return -1; }
+  virtual uint32_t GetTxAvailable (void) const { return 0xffffffff; }
+  virtual int Send (Ptr<Packet> p, uint32_t flags);
+  virtual int SendTo (Ptr<Packet> p, uint32_t flags, const Address &toAddress);
+  virtual uint32_t GetRxAvailable (void) const { return 0; }
+  virtual Ptr<Packet> Recv (uint32_t maxSize, uint32_t flags) { return 0; }
+  virtual Ptr<Packet> RecvFrom (uint32_t maxSize, uint32_t flags, Address &fromAddress) { return 0; }
+  virtual int GetSockName (Address &address) const { return 0; }
+  virtual int GetPeerName (Address &address) const { return -1; }
+  virtual bool SetAllowBroadcast (bool allowBroadcast) { return false; }
+  virtual bool GetAllowBroadcast () const { return false; }
+
+  std::vector<Ptr<Packet> > m_pdus;
+};
+
+int
+PduCaptureSocket::Send (Ptr<Packet> p, uint32_t flags)
+{
+  m_pdus.push_back (p->Copy ());
+  return p->GetSize ();
+}
+
+int
+PduCaptureSocket::SendTo (Ptr<Packet> p, uint32_t flags, const Address &toAddress)
+{
+  return Send (p, flags);
+}
+
+// Link events raised on the remote event source of a session, decoded
+// from the PDUs it sent and fired again by a remote event destination:
+// the same indications must come out, in the order they were raised;
+class EventBatchTestCase : public TestCase
+{
+public:
+  EventBatchTestCase (std::string name);
+
+protected:
+  virtual void DoSetup (void);
+  virtual void DoTeardown (void);
+  // Raises indication n, a link detected, up, down or parameters
+  // report in turn, or a link going down if goingDown;
+  void Raise (uint32_t n, bool goingDown = false);
+  // Decodes the PDUs sent so far, returning their actions;
+  std::vector<uint16_t> Receive (void);
+  void CheckOrder (void);
+
+  void LinkDetected (MihfId mihfId, LinkDetectedInformationList linkDetectedInfoList);
+  void LinkUp (MihfId mihfId, LinkIdentifier linkIdentifier, Address oldAR, Address newAR,
+               bool ipRenewalFlag, MobilityManagementSupport mobilitySupport);
+  void LinkDown (MihfId mihfId, LinkIdentifier linkIdentifier, Address oldAR, LinkDownReason reasonCode);
+  void LinkParametersReport (MihfId mihfId, LinkIdentifier linkIdentifier, LinkParameterReportList parameters);
+  void LinkGoingDown (MihfId mihfId, LinkIdentifier linkIdentifier, uint64_t timeInterval,
+                      LinkGoingDownReason reasonCode);
+
+  Ptr<PduCaptureSocket> m_socket;
+  Ptr<Session> m_session;
+  RemoteEventDestinationTrap m_destination;
+  std::vector<std::string> m_raised;
+  std::vector<std::string> m_received;
+  uint32_t m_nPdus;
+};
+
+EventBatchTestCase::EventBatchTestCase (std::string name)
+  : TestCase (name),
+    m_nPdus (0)
+{
+}
+
+void
+EventBatchTestCase::DoSetup (void)
+{
+  m_socket = CreateObject<PduCaptureSocket> ();
+  m_session = Create<Session> ();
+  m_session->SetFromMihfId (MihfId ("mn@sta"));
+  m_session->SetToMihfId (MihfId ("pos@net"));
+  m_session->SetSocket (m_socket);
+  m_session->GetRemoteEventSourceTrap ().SetSession (m_session);
+  m_destination.AddLinkDetectedCallback (MakeCallback (&EventBatchTestCase::LinkDetected, this));
+  m_destination.AddLinkUpCallback (MakeCallback (&EventBatchTestCase::LinkUp, this));
+  m_destination.AddLinkDownCallback (MakeCallback (&EventBatchTestCase::LinkDown, this));
+  m_destination.AddLinkParamatersReportCallback (MakeCallback (&EventBatchTestCase::LinkParametersReport, this));
+  m_destination.AddLinkGoingDownCallback (MakeCallback (&EventBatchTestCase::LinkGoingDown, this));
+}
+
+void
+EventBatchTestCase::DoTeardown (void)
+{
+  // Detaches the event source, which holds the session;
+  m_session->Close ();
+  m_session = 0;
+  m_socket = 0;
+  Simulator::Destroy ();
+}
+
+void
+EventBatchTestCase::Raise (uint32_t n, bool goingDown)
+{
+  RemoteEventSourceTrap &source = m_session->GetRemoteEventSourceTrap ();
+  MihfId mihfId = m_session->GetFromMihfId ();
+  LinkIdentifier linkIdentifier (LinkType (LinkType::WIRELESS_802_11), Mac48Address::Allocate (),
+                                 Mac48Address::Allocate ());
+  std::ostringstream oss;
+  if (goingDown)
+    {
+      oss << "going down " << linkIdentifier.GetPoALinkAddress () << " " << n;
+      source.LinkGoingDown (mihfId, linkIdentifier, n, LinkGoingDownReason (LinkGoingDownReason::LOW_POWER));
+    }
+  else if (n % 4 == 0)
+    {
+      LinkDetectedInformationList linkDetectedInfoList;
+      for (uint32_t j = 0; j <= n % 3; j++)
+        {
+          LinkDetectedInformation *info = new LinkDetectedInformation (linkIdentifier, NetworkIdentifier (),
+                                                                       NetworkAuxiliaryIdentifier (),
+                                                                       SignalStrength (static_cast<uint16_t> (n)),
+                                                                       static_cast<uint16_t> (j), SupportedRates (),
+                                                                       MihCapabilityFlag (), NetworkCapabilities (), n);
+          linkDetectedInfoList.push_back (Ptr<LinkDetectedInformation> (info, false));
+        }
+      oss << "detected " << linkIdentifier.GetPoALinkAddress () << " " << linkDetectedInfoList.size ();
+      source.LinkDetected (mihfId, linkDetectedInfoList);
+    }
+  else if (n % 4 == 1)
+    {
+      oss << "up " << linkIdentifier.GetPoALinkAddress () << " " << (n % 3 == 0);
+      source.LinkUp (mihfId, linkIdentifier, Address (), Address (), n % 3 == 0, MobilityManagementSupport ());
+    }
+  else if (n % 4 == 2)
+    {
+      LinkDownReason reason (static_cast<LinkDownReason::Type> (n % 6));
+      oss << "down " << linkIdentifier.GetPoALinkAddress () << " " << reason.GetReason ();
+      source.LinkDown (mihfId, linkIdentifier, Address (), reason);
+    }
+  else
+    {
+      LinkParameterReportList parameters;
+      for (uint32_t j = 0; j <= n % 3; j++)
+        {
+          Ptr<LinkParameter> parameter = Create<LinkParameter> (Create<LinkParameter80211> (LinkParameter80211::BEACON_CHANNEL_RSSI),
+                                                                Create<LinkParameterValue> (static_cast<uint16_t> (n + j)));
+          parameters.push_back (Create<LinkParameterReport> (Threshold (static_cast<uint16_t> (n + j)), parameter));
+        }
+      oss << "report " << linkIdentifier.GetPoALinkAddress () << " " << n << " " << parameters.size ();
+      source.LinkParametersReport (mihfId, linkIdentifier, parameters);
+    }
+  m_raised.push_back (oss.str ());
+}
+
+std::vector<uint16_t>
+EventBatchTestCase::Receive (void)
+{
+  std::vector<uint16_t> actions;
+  for (; m_nPdus < m_socket->m_pdus.size (); m_nPdus++)
+    {
+      Ptr<Packet> packet = m_socket->m_pdus[m_nPdus]->Copy ();
+      MihHeader mihHeader;
+      packet->RemoveHeader (mihHeader);
+      NS_TEST_EXPECT_MSG_EQ (mihHeader.GetServiceId (), MihHeader::EVENT, "Not an event");
+      NS_TEST_EXPECT_MSG_EQ (mihHeader.GetPayloadLength (), packet->GetSize (), "Wrong payload length");
+      MihPayload payload (mihHeader);
+      packet->PeekHeader (payload);
+      NS_TEST_EXPECT_MSG_EQ (payload.GetSourceMihfId (), MihfId ("mn@sta"), "Wrong source MIHF");
+      m_destination.ReceiveIndications (payload.GetSourceMihfId (), payload.GetLinkEventIndicationList ());
+      actions.push_back (mihHeader.GetActionId ());
+    }
+  return actions;
+}
+
+void
+EventBatchTestCase::CheckOrder (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (m_received.size (), m_raised.size (), "Indications lost or duplicated");
+  for (uint32_t j = 0; j < m_raised.size (); j++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_received[j], m_raised[j], "Indication " << j << " differs");
+    }
+}
+
+void
+EventBatchTestCase::LinkDetected (MihfId mihfId, LinkDetectedInformationList linkDetectedInfoList)
+{
+  std::ostringstream oss;
+  oss << "detected " << linkDetectedInfoList[0]->GetLinkIdentifier ().GetPoALinkAddress () << " "
+      << linkDetectedInfoList.size ();
+  m_received.push_back (oss.str ());
+}
+
+void
+EventBatchTestCase::LinkUp (MihfId mihfId, LinkIdentifier linkIdentifier, Address oldAR, Address newAR,
+                            bool ipRenewalFlag, MobilityManagementSupport mobilitySupport)
+{
+  std::ostringstream oss;
+  oss << "up " << linkIdentifier.GetPoALinkAddress () << " " << ipRenewalFlag;
+  m_received.push_back (oss.str ());
+}
+
+void
+EventBatchTestCase::LinkDown (MihfId mihfId, LinkIdentifier linkIdentifier, Address oldAR, LinkDownReason reasonCode)
+{
+  std::ostringstream oss;
+  oss << "down " << linkIdentifier.GetPoALinkAddress () << " " << reasonCode.GetReason ();
+  m_received.push_back (oss.str ());
+}
+
+void
+EventBatchTestCase::LinkParametersReport (MihfId mihfId, LinkIdentifier linkIdentifier, LinkParameterReportList parameters)
+{
+  std::ostringstream oss;
+  oss << "report " << linkIdentifier.GetPoALinkAddress () << " " << parameters[0]->GetThreshold ().GetThresholdValue ()
+      << " " << parameters.size ();
+  m_received.push_back (oss.str ());
+}
+
+void
+EventBatchTestCase::LinkGoingDown (MihfId mihfId, LinkIdentifier linkIdentifier, uint64_t timeInterval,
+                                   LinkGoingDownReason reasonCode)
+{
+  std::ostringstream oss;
+  oss << "going down " << linkIdentifier.GetPoALinkAddress () << " " << timeInterval;
+  m_received.push_back (oss.str ());
+}
+
+// Mixed entries, sent as one batch as the buffer doubles, cut by an
+// indication that is never batched;
+class EventBatchMixedTest : public EventBatchTestCase
+{
+public:
+  EventBatchMixedTest ();
+  virtual void DoRun (void);
+};
+
+EventBatchMixedTest::EventBatchMixedTest ()
+  : EventBatchTestCase ("Mixed entries")
+{
+}
+
+void
+EventBatchMixedTest::DoRun (void)
+{
+  m_session->GetRemoteEventSourceTrap ().SetAggregation (Seconds (1), 1000);
+  for (uint32_t n = 0; n < 40; n++)
+    {
+      Raise (n);
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_socket->m_pdus.size (), 0, "Batch sent before its window");
+  Raise (40, true);
+  for (uint32_t n = 41; n < 45; n++)
+    {
+      Raise (n);
+    }
+  m_session->GetRemoteEventSourceTrap ().Flush ();
+  std::vector<uint16_t> actions = Receive ();
+  NS_TEST_ASSERT_MSG_EQ (actions.size (), 3, "Wrong number of PDUs");
+  NS_TEST_ASSERT_MSG_EQ (actions[0], MihHeader::MIH_LINK_EVENT_BATCH, "Not a batch");
+  NS_TEST_ASSERT_MSG_EQ (actions[1], MihHeader::MIH_LINK_GOING_DOWN, "Link going down batched");
+  NS_TEST_ASSERT_MSG_EQ (actions[2], MihHeader::MIH_LINK_EVENT_BATCH, "Not a batch");
+  CheckOrder ();
+
+  // A single pending indication goes in a batch of one entry;
+  Raise (45);
+  m_session->GetRemoteEventSourceTrap ().Flush ();
+  actions = Receive ();
+  NS_TEST_ASSERT_MSG_EQ (actions.size (), 1, "Wrong number of PDUs");
+  NS_TEST_ASSERT_MSG_EQ (actions[0], MihHeader::MIH_LINK_EVENT_BATCH, "Not a batch");
+  CheckOrder ();
+}
+
+// A batch is flushed before its payload would outgrow the 16-bit
+// payload length;
+class EventBatchLimitTest : public EventBatchTestCase
+{
+public:
+  EventBatchLimitTest ();
+  virtual void DoRun (void);
+};
+
+EventBatchLimitTest::EventBatchLimitTest ()
+  : EventBatchTestCase ("Payload length limit")
+{
+}
+
+void
+EventBatchLimitTest::DoRun (void)
+{
+  m_session->GetRemoteEventSourceTrap ().SetAggregation (Seconds (1), 100000);
+  uint32_t n = 0;
+  while (m_socket->m_pdus.size () < 2)
+    {
+      Raise (n++);
+    }
+  m_session->GetRemoteEventSourceTrap ().Flush ();
+  std::vector<uint16_t> actions = Receive ();
+  NS_TEST_ASSERT_MSG_EQ (actions.size (), 3, "Wrong number of PDUs");
+  for (uint32_t j = 0; j < m_socket->m_pdus.size (); j++)
+    {
+      MihHeader mihHeader;
+      m_socket->m_pdus[j]->PeekHeader (mihHeader);
+      NS_TEST_ASSERT_MSG_EQ (actions[j], MihHeader::MIH_LINK_EVENT_BATCH, "Not a batch");
+      // Full but for less than one more entry;
+      if (j < 2)
+        {
+          NS_TEST_ASSERT_MSG_GT (mihHeader.GetPayloadLength (), 0xffff - 256, "Batch " << j << " flushed early");
+        }
+    }
+  CheckOrder ();
+}
+
+class EventBatchTestSuite : public TestSuite
+{
+public:
+  EventBatchTestSuite ();
+};
+
+EventBatchTestSuite::EventBatchTestSuite ()
+  : TestSuite ("mih-event-batch", UNIT)
+{
+  AddTestCase (new EventBatchMixedTest, TestCase::QUICK);
+  AddTestCase (new EventBatchLimitTest, TestCase::QUICK);
+}
+
+static EventBatchTestSuite g_eventBatchTestSuite; ///< the test suite
@@ -0,0 +1,250 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/mac48-address.h"
+#include "ns3/mih-information-cache.h"
+
+using namespace ns3;
+using namespace ns3::mih;
+
+static Ptr<PoaDescriptor>
+CreatePoa (Vector position)
+{
+  return Create<PoaDescriptor> (LinkType (LinkType::WIRELESS_802_11), Mac48Address::Allocate (),
+                                NetworkIdentifier (), Location (position));
+}
+
+static InformationCacheKey
+GetKey (const InformationCache &cache, double x, double y)
+{
+  return cache.GetKey (MihfId ("miis@net"), Vector (x, y, 0), 100, LinkType (LinkType::WIRELESS_802_11));
+}
+
+// The least recently used entry goes first, a lookup counting as a use;
+class InformationCacheEvictionTest : public TestCase
+{
+public:
+  InformationCacheEvictionTest ();
+  virtual void DoRun (void);
+};
+
+InformationCacheEvictionTest::InformationCacheEvictionTest ()
+  : TestCase ("Eviction order")
+{
+}
+
+void
+InformationCacheEvictionTest::DoRun (void)
+{
+  InformationCache cache;
+  cache.SetCellSize (50);
+  cache.SetCapacity (3);
+  InformationCacheKey a = GetKey (cache, 10, 10);
+  InformationCacheKey b = GetKey (cache, 60, 10);
+  InformationCacheKey c = GetKey (cache, 110, 10);
+  InformationCacheKey d = GetKey (cache, 160, 10);
+  PoaDescriptorList poas;
+  poas.push_back (CreatePoa (Vector (10, 10, 0)));
+  cache.Insert (a, poas);
+  cache.Insert (b, poas);
+  cache.Insert (c, poas);
+  NS_TEST_ASSERT_MSG_EQ (cache.GetSize (), 3, "Entries lost");
+
+  PoaDescriptorList found;
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (a, found), true, "Entry missed");
+  NS_TEST_ASSERT_MSG_EQ (found.size (), 1, "Wrong answer");
+  cache.Insert (d, poas);
+  NS_TEST_ASSERT_MSG_EQ (cache.GetSize (), 3, "Capacity exceeded");
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (b, found), false, "Least recently used entry kept");
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (a, found), true, "Recently used entry evicted");
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (c, found), true, "Entry evicted out of order");
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (d, found), true, "Inserted entry missed");
+
+  // Replacing an entry makes it the most recently used one;
+  cache.Insert (a, poas);
+  cache.Insert (b, poas);
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (c, found), false, "Least recently used entry kept");
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (a, found), true, "Replaced entry evicted");
+
+  // Shrinking keeps the most recently used entries;
+  cache.SetCapacity (1);
+  NS_TEST_ASSERT_MSG_EQ (cache.GetSize (), 1, "Capacity exceeded");
+  NS_TEST_ASSERT_MSG_EQ (cache.Lookup (a, found), true, "Most recently used entry evicted");
+
+  cache.SetCapacity (0);
+  NS_TEST_ASSERT_MSG_EQ (cache.IsEnabled (), false, "Empty cache enabled");
+  cache.Insert (a, poas);
+  NS_TEST_ASSERT_MSG_EQ (cache.GetSize (), 0, "Disabled cache filled");
+}
+
+// Entries are fresh for the time to live from their last insertion;
+class InformationCacheExpiryTest : public TestCase
+{
+public:
+  InformationCacheExpiryTest ();
+  virtual void DoRun (void);
+
+private:
+  void Insert (void);
+  void Lookup (bool fresh, uint32_t size);
+  InformationCache m_cache;
+  InformationCacheKey m_key;
+};
+
+InformationCacheExpiryTest::InformationCacheExpiryTest ()
+  : TestCase ("Expiry")
+{
+}
+
+void
+InformationCacheExpiryTest::Insert (void)
+{
+  PoaDescriptorList poas;
+  poas.push_back (CreatePoa (Vector (10, 10, 0)));
+  m_cache.Insert (m_key, poas);
+}
+
+void
+InformationCacheExpiryTest::Lookup (bool fresh, uint32_t size)
+{
+  PoaDescriptorList poas;
+  NS_TEST_EXPECT_MSG_EQ (m_cache.Lookup (m_key, poas), fresh,
+                         "Wrong freshness at " << Simulator::Now ().GetSeconds () << "s");
+  NS_TEST_EXPECT_MSG_EQ (m_cache.GetSize (), size,
+                         "Wrong size at " << Simulator::Now ().GetSeconds () << "s");
+}
+
+void
+InformationCacheExpiryTest::DoRun (void)
+{
+  m_cache.SetTimeToLive (Seconds (10));
+  m_key = GetKey (m_cache, 10, 10);
+  Simulator::Schedule (Seconds (1), &InformationCacheExpiryTest::Insert, this);
+  Simulator::Schedule (Seconds (10.9), &InformationCacheExpiryTest::Lookup, this, true, 1);
+  // Expired entries are dropped when looked up;
+  Simulator::Schedule (Seconds (11), &InformationCacheExpiryTest::Lookup, this, false, 0);
+  Simulator::Schedule (Seconds (12), &InformationCacheExpiryTest::Insert, this);
+  Simulator::Schedule (Seconds (20), &InformationCacheExpiryTest::Insert, this);
+  Simulator::Schedule (Seconds (29), &InformationCacheExpiryTest::Lookup, this, true, 1);
+  Simulator::Schedule (Seconds (30), &InformationCacheExpiryTest::Lookup, this, false, 0);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  m_cache.SetTimeToLive (Seconds (0));
+  NS_TEST_ASSERT_MSG_EQ (m_cache.IsEnabled (), false, "Cache enabled without a time to live");
+}
+
+// The answer cached for a cell holds every PoA near any position of
+// it, so filtering it gives the same result as a query from there;
+class InformationCacheCellTest : public TestCase
+{
+public:
+  InformationCacheCellTest ();
+  virtual void DoRun (void);
+};
+
+InformationCacheCellTest::InformationCacheCellTest ()
+  : TestCase ("Widened cell query")
+{
+}
+
+void
+InformationCacheCellTest::DoRun (void)
+{
+  InformationCache cache;
+  cache.SetCellSize (50);
+  PoaDescriptorList all;
+  for (double x = -190; x <= 190; x += 12.5)
+    {
+      for (double y = -190; y <= 190; y += 12.5)
+        {
+          all.push_back (CreatePoa (Vector (x, y, 0)));
+        }
+    }
+
+  double radius = 40;
+  // Corners, edges and inner points of cells on both sides of the
+  // origin;
+  double offsets[] = { 0, 0.01, 12.5, 25, 37.5, 49.99 };
+  int32_t cells[] = { -2, -1, 0, 1 };
+  uint32_t nOffsets = sizeof (offsets) / sizeof (offsets[0]);
+  for (uint32_t cx = 0; cx < sizeof (cells) / sizeof (cells[0]); cx++)
+    {
+      for (uint32_t cy = 0; cy < sizeof (cells) / sizeof (cells[0]); cy++)
+        {
+          InformationCacheKey key = cache.GetKey (MihfId ("miis@net"),
+                                                  Vector (cells[cx] * 50 + 25, cells[cy] * 50 + 25, 0),
+                                                  radius, LinkType (LinkType::WIRELESS_802_11));
+          NS_TEST_ASSERT_MSG_EQ (key.x, cells[cx], "Wrong cell");
+          NS_TEST_ASSERT_MSG_EQ (key.y, cells[cy], "Wrong cell");
+          PoaDescriptorList answer = InformationCache::Filter (all, cache.GetCellCenter (key),
+                                                               cache.GetCellQueryRadius (key), 0);
+          for (uint32_t ox = 0; ox < nOffsets; ox++)
+            {
+              for (uint32_t oy = 0; oy < nOffsets; oy++)
+                {
+                  Vector position (cells[cx] * 50 + offsets[ox], cells[cy] * 50 + offsets[oy], 0);
+                  InformationCacheKey positionKey = cache.GetKey (MihfId ("miis@net"), position, radius,
+                                                                  LinkType (LinkType::WIRELESS_802_11));
+                  NS_TEST_ASSERT_MSG_EQ ((positionKey == key), true, "Position " << position << " out of its cell");
+                  PoaDescriptorList expected = InformationCache::Filter (all, position, radius, 0);
+                  PoaDescriptorList cached = InformationCache::Filter (answer, position, radius, 0);
+                  NS_TEST_ASSERT_MSG_EQ (cached.size (), expected.size (),
+                                         "Cell answer misses PoAs near " << position);
+                  // Same PoAs, in the same order up to ties;
+                  for (uint32_t j = 0; j < cached.size (); j++)
+                    {
+                      NS_TEST_ASSERT_MSG_EQ ((std::find (expected.begin (), expected.end (), cached[j]) != expected.end ()),
+                                             true, "Wrong PoA near " << position);
+                      NS_TEST_ASSERT_MSG_EQ_TOL (CalculateDistance (position, cached[j]->GetPosition ()),
+                                                 CalculateDistance (position, expected[j]->GetPosition ()),
+                                                 1e-9, "PoAs out of order near " << position);
+                    }
+                  PoaDescriptorList nearest = InformationCache::Filter (answer, position, radius, 2);
+                  NS_TEST_ASSERT_MSG_EQ (nearest.size (), std::min<uint32_t> (2, expected.size ()), "maxResults ignored");
+                }
+            }
+        }
+    }
+
+  // Different radii and link types do not share entries;
+  InformationCacheKey key = GetKey (cache, 10, 10);
+  InformationCacheKey other = cache.GetKey (MihfId ("miis@net"), Vector (10, 10, 0), 50,
+                                            LinkType (LinkType::WIRELESS_802_11));
+  NS_TEST_ASSERT_MSG_EQ ((key != other), true, "Radius ignored");
+  other = cache.GetKey (MihfId ("miis@net"), Vector (10, 10, 0), 100, LinkType (LinkType::WIRELESS_802_16));
+  NS_TEST_ASSERT_MSG_EQ ((key != other), true, "Link type ignored");
+}
+
+class InformationCacheTestSuite : public TestSuite
+{
+public:
+  InformationCacheTestSuite ();
+};
+
+InformationCacheTestSuite::InformationCacheTestSuite ()
+  : TestSuite ("mih-information-cache", UNIT)
+{
+  AddTestCase (new InformationCacheEvictionTest, TestCase::QUICK);
+  AddTestCase (new InformationCacheExpiryTest, TestCase::QUICK);
+  AddTestCase (new InformationCacheCellTest, TestCase::QUICK);
+}
+
+static InformationCacheTestSuite g_informationCacheTestSuite; ///< the test suite
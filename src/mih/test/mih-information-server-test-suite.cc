@@ -0,0 +1,238 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include "ns3/test.h"
+#include "ns3/double.h"
+#include "ns3/mac48-address.h"
+#include "ns3/mih-information-server.h"
+
+using namespace ns3;
+using namespace ns3::mih;
+
+class MihInformationServerTestCase : public TestCase
+{
+public:
+  MihInformationServerTestCase (std::string name);
+
+protected:
+  Ptr<PoaDescriptor> AddPoa (double x, double y, LinkType linkType = LinkType (LinkType::WIRELESS_802_11));
+  // Every PoA within radius of position, checked one by one;
+  uint32_t CountInRange (Vector position, double radius) const;
+  void CheckQuery (Vector position, double radius);
+  void Query (Vector position, double radius, uint32_t visited, uint32_t results);
+
+  Ptr<MihInformationServer> m_server;
+  PoaDescriptorList m_poas;
+  uint32_t m_visited;
+};
+
+MihInformationServerTestCase::MihInformationServerTestCase (std::string name)
+  : TestCase (name),
+    m_visited (0)
+{
+}
+
+Ptr<PoaDescriptor>
+MihInformationServerTestCase::AddPoa (double x, double y, LinkType linkType)
+{
+  uint32_t n = m_poas.size () + 1;
+  uint8_t mac[6] = { 0, 0, 0, static_cast<uint8_t> (n >> 16), static_cast<uint8_t> (n >> 8), static_cast<uint8_t> (n) };
+  Mac48Address address;
+  address.CopyFrom (mac);
+  Ptr<PoaDescriptor> poa = Create<PoaDescriptor> (linkType, address, NetworkIdentifier (),
+                                                  Location (Vector (x, y, 0)));
+  m_server->AddPoa (poa);
+  m_poas.push_back (poa);
+  return poa;
+}
+
+uint32_t
+MihInformationServerTestCase::CountInRange (Vector position, double radius) const
+{
+  uint32_t n = 0;
+  for (uint32_t j = 0; j < m_poas.size (); j++)
+    {
+      if (CalculateDistance (position, m_poas[j]->GetPosition ()) <= radius)
+        {
+          n++;
+        }
+    }
+  return n;
+}
+
+void
+MihInformationServerTestCase::CheckQuery (Vector position, double radius)
+{
+  PoaDescriptorList poas = m_server->Query (position, radius, LinkType (), 0);
+  NS_TEST_ASSERT_MSG_EQ (poas.size (), CountInRange (position, radius),
+                         "Wrong number of PoAs within " << radius << " of " << position);
+  double previous = 0;
+  for (uint32_t j = 0; j < poas.size (); j++)
+    {
+      double distance = CalculateDistance (position, poas[j]->GetPosition ());
+      NS_TEST_ASSERT_MSG_EQ ((distance <= radius), true, "PoA out of range of " << position);
+      NS_TEST_ASSERT_MSG_EQ ((distance >= previous), true, "PoAs not sorted nearest first");
+      previous = distance;
+    }
+}
+
+void
+MihInformationServerTestCase::Query (Vector position, double radius, uint32_t visited, uint32_t results)
+{
+  m_visited = visited;
+}
+
+// PoAs and queries on both sides of the origin, where the cell
+// coordinates turn negative;
+class MihInformationServerNegativeTest : public MihInformationServerTestCase
+{
+public:
+  MihInformationServerNegativeTest ();
+  virtual void DoRun (void);
+};
+
+MihInformationServerNegativeTest::MihInformationServerNegativeTest ()
+  : MihInformationServerTestCase ("Negative coordinates")
+{
+}
+
+void
+MihInformationServerNegativeTest::DoRun (void)
+{
+  m_server = CreateObject<MihInformationServer> ();
+  m_server->SetAttribute ("CellSize", DoubleValue (10));
+  double coordinates[] = { -35, -20.5, -10.01, -9.99, -5, -0.01, 0.01, 5, 9.99, 10.01, 20.5, 35 };
+  uint32_t n = sizeof (coordinates) / sizeof (coordinates[0]);
+  for (uint32_t j = 0; j < n; j++)
+    {
+      for (uint32_t k = 0; k < n; k++)
+        {
+          AddPoa (coordinates[j], coordinates[k]);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_server->GetNPoas (), n * n, "PoAs lost");
+
+  double radii[] = { 0.5, 3, 10, 17.5, 40 };
+  for (uint32_t r = 0; r < sizeof (radii) / sizeof (radii[0]); r++)
+    {
+      for (double x = -30; x <= 30; x += 7.5)
+        {
+          for (double y = -30; y <= 30; y += 7.5)
+            {
+              CheckQuery (Vector (x, y, 0), radii[r]);
+            }
+        }
+    }
+
+  // Across the origin: the two PoAs nearest to it sit in cells -1 and 0;
+  PoaDescriptorList poas = m_server->Query (Vector (0, 0, 0), 0.02, LinkType (), 0);
+  NS_TEST_ASSERT_MSG_EQ (poas.size (), 4, "PoAs around the origin missed");
+  poas = m_server->Query (Vector (-5, -5, 0), 0.5, LinkType (), 0);
+  NS_TEST_ASSERT_MSG_EQ (poas.size (), 1, "PoA in a negative cell missed");
+  NS_TEST_ASSERT_MSG_EQ (CalculateDistance (poas[0]->GetPosition (), Vector (-5, -5, 0)), 0, "Wrong PoA");
+
+  m_server->Dispose ();
+}
+
+// PoAs lying on cell edges, found from either side of them;
+class MihInformationServerBoundaryTest : public MihInformationServerTestCase
+{
+public:
+  MihInformationServerBoundaryTest ();
+  virtual void DoRun (void);
+};
+
+MihInformationServerBoundaryTest::MihInformationServerBoundaryTest ()
+  : MihInformationServerTestCase ("Cell boundaries")
+{
+}
+
+void
+MihInformationServerBoundaryTest::DoRun (void)
+{
+  m_server = CreateObject<MihInformationServer> ();
+  m_server->SetAttribute ("CellSize", DoubleValue (100));
+  m_server->TraceConnectWithoutContext ("Query", MakeCallback (&MihInformationServerBoundaryTest::Query, this));
+  for (int32_t x = -200; x <= 200; x += 100)
+    {
+      for (int32_t y = -200; y <= 200; y += 100)
+        {
+          AddPoa (x, y);
+        }
+    }
+
+  // A radius reaching exactly a PoA includes it;
+  PoaDescriptorList poas = m_server->Query (Vector (50, 0, 0), 50, LinkType (), 0);
+  NS_TEST_ASSERT_MSG_EQ (poas.size (), 2, "PoAs on the radius missed");
+  poas = m_server->Query (Vector (-50, 0, 0), 50, LinkType (), 0);
+  NS_TEST_ASSERT_MSG_EQ (poas.size (), 2, "PoAs on the radius missed");
+  poas = m_server->Query (Vector (0, 0, 0), 100, LinkType (), 0);
+  NS_TEST_ASSERT_MSG_EQ (poas.size (), 5, "PoAs on the radius missed");
+  NS_TEST_ASSERT_MSG_EQ (CalculateDistance (poas[0]->GetPosition (), Vector (0, 0, 0)), 0, "Nearest PoA not first");
+
+  // Queries centered on cell edges and corners;
+  for (int32_t x = -200; x <= 200; x += 50)
+    {
+      for (int32_t y = -200; y <= 200; y += 50)
+        {
+          CheckQuery (Vector (x, y, 0), 0);
+          CheckQuery (Vector (x, y, 0), 50);
+          CheckQuery (Vector (x, y, 0), 100);
+          CheckQuery (Vector (x, y, 0), 141.5);
+        }
+    }
+
+  // A small query only visits the cells under its disc;
+  m_server->Query (Vector (150, 150, 0), 10, LinkType (), 0);
+  NS_TEST_ASSERT_MSG_EQ (m_visited, 1, "Query visited cells away from its disc");
+
+  // Moving the grid keeps every PoA where it was;
+  m_server->SetAttribute ("CellSize", DoubleValue (30));
+  NS_TEST_ASSERT_MSG_EQ (m_server->GetNPoas (), m_poas.size (), "PoAs lost when re-bucketed");
+  for (int32_t x = -200; x <= 200; x += 50)
+    {
+      CheckQuery (Vector (x, -x, 0), 100);
+    }
+
+  poas = m_server->Query (Vector (0, 0, 0), 1000, LinkType (), 3);
+  NS_TEST_ASSERT_MSG_EQ (poas.size (), 3, "maxResults ignored");
+  NS_TEST_ASSERT_MSG_EQ (CalculateDistance (poas[0]->GetPosition (), Vector (0, 0, 0)), 0, "Nearest PoA not first");
+  poas = m_server->Query (Vector (0, 0, 0), 1000, LinkType (LinkType::WIRELESS_802_16), 0);
+  NS_TEST_ASSERT_MSG_EQ (poas.size (), 0, "Link type ignored");
+
+  NS_TEST_ASSERT_MSG_EQ (m_server->RemovePoa (m_poas[0]->GetPoALinkAddress ()), true, "PoA not removed");
+  NS_TEST_ASSERT_MSG_EQ (m_server->RemovePoa (m_poas[0]->GetPoALinkAddress ()), false, "PoA removed twice");
+  poas = m_server->Query (m_poas[0]->GetPosition (), 1, LinkType (), 0);
+  NS_TEST_ASSERT_MSG_EQ (poas.size (), 0, "Removed PoA still found");
+
+  m_server->Dispose ();
+}
+
+class MihInformationServerTestSuite : public TestSuite
+{
+public:
+  MihInformationServerTestSuite ();
+};
+
+MihInformationServerTestSuite::MihInformationServerTestSuite ()
+  : TestSuite ("mih-information-server", UNIT)
+{
+  AddTestCase (new MihInformationServerNegativeTest, TestCase::QUICK);
+  AddTestCase (new MihInformationServerBoundaryTest, TestCase::QUICK);
+}
+
+static MihInformationServerTestSuite g_mihInformationServerTestSuite; ///< the test suite
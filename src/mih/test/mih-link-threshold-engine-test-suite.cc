@@ -0,0 +1,322 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/mih-link-threshold-engine.h"
+#include "ns3/mih-link-parameter-value.h"
+
+using namespace ns3;
+using namespace ns3::mih;
+
+class LinkThresholdEngineTestCase : public TestCase
+{
+public:
+  LinkThresholdEngineTestCase (std::string name);
+
+protected:
+  void Report (LinkParameterReportList reports);
+  void Configure (LinkConfigurationParameter::ThresholdAction action, uint64_t interval,
+                  ThresholdList thresholds);
+  static Ptr<Threshold> MakeThreshold (int16_t value, Threshold::CrossDirectionCode direction);
+  static int16_t GetReportedValue (Ptr<LinkParameterReport> report);
+
+  LinkThresholdEngine m_engine;
+  uint8_t m_index;
+  uint32_t m_notifications;
+  LinkParameterReportList m_reports;
+};
+
+LinkThresholdEngineTestCase::LinkThresholdEngineTestCase (std::string name)
+  : TestCase (name),
+    m_index (LinkParameter80211::BEACON_CHANNEL_RSSI),
+    m_notifications (0)
+{
+  m_engine.SetReportCallback (MakeCallback (&LinkThresholdEngineTestCase::Report, this));
+}
+
+void
+LinkThresholdEngineTestCase::Report (LinkParameterReportList reports)
+{
+  m_notifications++;
+  m_reports.insert (m_reports.end (), reports.begin (), reports.end ());
+}
+
+void
+LinkThresholdEngineTestCase::Configure (LinkConfigurationParameter::ThresholdAction action, uint64_t interval,
+                                        ThresholdList thresholds)
+{
+  LinkConfigurationParameterList parameters;
+  parameters.push_back (Create<LinkConfigurationParameter> (Create<LinkParameter80211> (LinkParameter80211::BEACON_CHANNEL_RSSI),
+                                                            interval, action, thresholds));
+  LinkConfigureThresholdsConfirm confirm = m_engine.Configure (parameters);
+  NS_TEST_ASSERT_MSG_EQ (confirm.GetStatus ().GetType (), Status::SUCCESS, "Configure rejected");
+}
+
+Ptr<Threshold>
+LinkThresholdEngineTestCase::MakeThreshold (int16_t value, Threshold::CrossDirectionCode direction)
+{
+  return Create<Threshold> (static_cast<uint16_t> (value), direction);
+}
+
+int16_t
+LinkThresholdEngineTestCase::GetReportedValue (Ptr<LinkParameterReport> report)
+{
+  Ptr<LinkParameterValue> value = DynamicCast<LinkParameterValue> (report->GetParameter ()->GetParameterValue ());
+  return static_cast<int16_t> (value->GetValue ());
+}
+
+// One sample crossing several thresholds reports each of them, and
+// only the ones crossed in their direction;
+class LinkThresholdEngineBandTest : public LinkThresholdEngineTestCase
+{
+public:
+  LinkThresholdEngineBandTest ();
+  virtual void DoRun (void);
+};
+
+LinkThresholdEngineBandTest::LinkThresholdEngineBandTest ()
+  : LinkThresholdEngineTestCase ("Band stepping over several thresholds")
+{
+}
+
+void
+LinkThresholdEngineBandTest::DoRun (void)
+{
+  ThresholdList thresholds;
+  thresholds.push_back (MakeThreshold (-60, Threshold::ABOVE_THRESHOLD));
+  thresholds.push_back (MakeThreshold (-80, Threshold::ABOVE_THRESHOLD));
+  thresholds.push_back (MakeThreshold (-70, Threshold::ABOVE_THRESHOLD));
+  Configure (LinkConfigurationParameter::NORMAL_THRESHOLD, 0, thresholds);
+  NS_TEST_ASSERT_MSG_EQ (m_engine.IsConfigured (m_index), true, "Parameter not configured");
+
+  // The first sample only sets the band;
+  m_engine.NotifySample (m_index, -90);
+  NS_TEST_ASSERT_MSG_EQ (m_notifications, 0, "Report without a previous sample");
+
+  m_engine.NotifySample (m_index, -55.4);
+  NS_TEST_ASSERT_MSG_EQ (m_notifications, 1, "Crossings not reported at once");
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 3, "Wrong number of crossed thresholds");
+  NS_TEST_ASSERT_MSG_EQ ((int16_t) m_reports[0]->GetThreshold ().GetThresholdValue (), -80, "Crossings out of order");
+  NS_TEST_ASSERT_MSG_EQ ((int16_t) m_reports[1]->GetThreshold ().GetThresholdValue (), -70, "Crossings out of order");
+  NS_TEST_ASSERT_MSG_EQ ((int16_t) m_reports[2]->GetThreshold ().GetThresholdValue (), -60, "Crossings out of order");
+  NS_TEST_ASSERT_MSG_EQ (GetReportedValue (m_reports[2]), -55, "Sample not rounded");
+
+  // Staying in the same band reports nothing;
+  m_engine.NotifySample (m_index, -50);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 3, "Report without a crossing");
+
+  // Going down does not cross ABOVE_THRESHOLD thresholds, but moves
+  // the band so they fire again on the way up;
+  m_engine.NotifySample (m_index, -90);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 3, "Report while going down");
+  m_engine.NotifySample (m_index, -65);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 5, "Wrong number of crossed thresholds");
+  NS_TEST_ASSERT_MSG_EQ ((int16_t) m_reports[4]->GetThreshold ().GetThresholdValue (), -70, "Wrong crossed threshold");
+
+  // A sample equal to a threshold crosses it;
+  m_engine.NotifySample (m_index, -60);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 6, "Threshold value not crossed");
+}
+
+class LinkThresholdEngineDirectionTest : public LinkThresholdEngineTestCase
+{
+public:
+  LinkThresholdEngineDirectionTest ();
+  virtual void DoRun (void);
+};
+
+LinkThresholdEngineDirectionTest::LinkThresholdEngineDirectionTest ()
+  : LinkThresholdEngineTestCase ("Cross direction")
+{
+}
+
+void
+LinkThresholdEngineDirectionTest::DoRun (void)
+{
+  ThresholdList thresholds;
+  thresholds.push_back (MakeThreshold (-70, Threshold::BELOW_THRESHOLD));
+  thresholds.push_back (MakeThreshold (-60, Threshold::ABOVE_THRESHOLD));
+  Configure (LinkConfigurationParameter::NORMAL_THRESHOLD, 0, thresholds);
+
+  m_engine.NotifySample (m_index, -65);
+  m_engine.NotifySample (m_index, -55);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 1, "ABOVE_THRESHOLD not reported");
+  NS_TEST_ASSERT_MSG_EQ (m_reports[0]->GetThreshold ().GetCrossDirection (), Threshold::ABOVE_THRESHOLD, "Wrong direction");
+  NS_TEST_ASSERT_MSG_EQ ((int16_t) m_reports[0]->GetThreshold ().GetThresholdValue (), -60, "Wrong threshold");
+
+  // Going down over both thresholds only reports the BELOW_THRESHOLD one;
+  m_engine.NotifySample (m_index, -75);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 2, "BELOW_THRESHOLD not reported");
+  NS_TEST_ASSERT_MSG_EQ (m_reports[1]->GetThreshold ().GetCrossDirection (), Threshold::BELOW_THRESHOLD, "Wrong direction");
+  NS_TEST_ASSERT_MSG_EQ ((int16_t) m_reports[1]->GetThreshold ().GetThresholdValue (), -70, "Wrong threshold");
+  NS_TEST_ASSERT_MSG_EQ (GetReportedValue (m_reports[1]), -75, "Wrong reported value");
+
+  // Going up over the BELOW_THRESHOLD one reports nothing;
+  m_engine.NotifySample (m_index, -65);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 2, "BELOW_THRESHOLD reported going up");
+}
+
+class LinkThresholdEngineOneShotTest : public LinkThresholdEngineTestCase
+{
+public:
+  LinkThresholdEngineOneShotTest ();
+  virtual void DoRun (void);
+};
+
+LinkThresholdEngineOneShotTest::LinkThresholdEngineOneShotTest ()
+  : LinkThresholdEngineTestCase ("One shot thresholds")
+{
+}
+
+void
+LinkThresholdEngineOneShotTest::DoRun (void)
+{
+  ThresholdList thresholds;
+  thresholds.push_back (MakeThreshold (-70, Threshold::ABOVE_THRESHOLD));
+  thresholds.push_back (MakeThreshold (-80, Threshold::BELOW_THRESHOLD));
+  Configure (LinkConfigurationParameter::ONE_SHOT_THRESHOLD, 0, thresholds);
+
+  m_engine.NotifySample (m_index, -75);
+  m_engine.NotifySample (m_index, -65);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 1, "One shot threshold not reported");
+  NS_TEST_ASSERT_MSG_EQ (m_engine.IsConfigured (m_index), true, "Configuration dropped with a threshold left");
+
+  // The fired threshold is gone;
+  m_engine.NotifySample (m_index, -75);
+  m_engine.NotifySample (m_index, -65);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 1, "One shot threshold reported twice");
+
+  m_engine.NotifySample (m_index, -85);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 2, "One shot threshold not reported");
+  NS_TEST_ASSERT_MSG_EQ ((int16_t) m_reports[1]->GetThreshold ().GetThresholdValue (), -80, "Wrong threshold");
+  NS_TEST_ASSERT_MSG_EQ (m_engine.IsConfigured (m_index), false, "Configuration kept after the last one shot");
+
+  m_engine.NotifySample (m_index, -75);
+  m_engine.NotifySample (m_index, -85);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 2, "Report after the last one shot");
+}
+
+class LinkThresholdEngineCancelTest : public LinkThresholdEngineTestCase
+{
+public:
+  LinkThresholdEngineCancelTest ();
+  virtual void DoRun (void);
+};
+
+LinkThresholdEngineCancelTest::LinkThresholdEngineCancelTest ()
+  : LinkThresholdEngineTestCase ("Cancel action")
+{
+}
+
+void
+LinkThresholdEngineCancelTest::DoRun (void)
+{
+  ThresholdList thresholds;
+  thresholds.push_back (MakeThreshold (-70, Threshold::ABOVE_THRESHOLD));
+  Configure (LinkConfigurationParameter::NORMAL_THRESHOLD, 0, thresholds);
+  m_engine.NotifySample (m_index, -75);
+
+  Configure (LinkConfigurationParameter::CANCEL_SHOT_THRESHOLD, 0, ThresholdList ());
+  NS_TEST_ASSERT_MSG_EQ (m_engine.IsConfigured (m_index), false, "Configuration not cancelled");
+  m_engine.NotifySample (m_index, -65);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 0, "Report after cancel");
+
+  // A new configuration starts from the last sample;
+  Configure (LinkConfigurationParameter::NORMAL_THRESHOLD, 0, thresholds);
+  m_engine.NotifySample (m_index, -60);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 0, "Report without a crossing");
+  m_engine.NotifySample (m_index, -75);
+  m_engine.NotifySample (m_index, -60);
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 1, "Threshold not reported after reconfiguration");
+}
+
+// Periodic reports go out with the first sample at or after the
+// interval expired, unless a crossing is already reported;
+class LinkThresholdEnginePeriodicTest : public LinkThresholdEngineTestCase
+{
+public:
+  LinkThresholdEnginePeriodicTest ();
+  virtual void DoRun (void);
+
+private:
+  void Sample (double value);
+  std::vector<Time> m_reportTimes;
+};
+
+LinkThresholdEnginePeriodicTest::LinkThresholdEnginePeriodicTest ()
+  : LinkThresholdEngineTestCase ("Periodic interval")
+{
+}
+
+void
+LinkThresholdEnginePeriodicTest::Sample (double value)
+{
+  uint32_t notifications = m_notifications;
+  m_engine.NotifySample (m_index, value);
+  if (m_notifications != notifications)
+    {
+      m_reportTimes.push_back (Simulator::Now ());
+    }
+}
+
+void
+LinkThresholdEnginePeriodicTest::DoRun (void)
+{
+  ThresholdList thresholds;
+  thresholds.push_back (MakeThreshold (-70, Threshold::ABOVE_THRESHOLD));
+  Configure (LinkConfigurationParameter::NORMAL_THRESHOLD, 100, thresholds);
+
+  Simulator::Schedule (MilliSeconds (0), &LinkThresholdEnginePeriodicTest::Sample, this, -80);
+  Simulator::Schedule (MilliSeconds (50), &LinkThresholdEnginePeriodicTest::Sample, this, -80);
+  Simulator::Schedule (MilliSeconds (100), &LinkThresholdEnginePeriodicTest::Sample, this, -80);
+  Simulator::Schedule (MilliSeconds (150), &LinkThresholdEnginePeriodicTest::Sample, this, -80);
+  Simulator::Schedule (MilliSeconds (230), &LinkThresholdEnginePeriodicTest::Sample, this, -60);
+  Simulator::Schedule (MilliSeconds (260), &LinkThresholdEnginePeriodicTest::Sample, this, -60);
+  Simulator::Schedule (MilliSeconds (330), &LinkThresholdEnginePeriodicTest::Sample, this, -60);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_reportTimes.size (), 3, "Wrong number of reports");
+  NS_TEST_ASSERT_MSG_EQ (m_reportTimes[0], MilliSeconds (100), "Periodic report not sent on the interval");
+  NS_TEST_ASSERT_MSG_EQ (m_reportTimes[1], MilliSeconds (230), "Periodic report not sent with the next sample");
+  NS_TEST_ASSERT_MSG_EQ (m_reportTimes[2], MilliSeconds (330), "Periodic report not rescheduled");
+  NS_TEST_ASSERT_MSG_EQ (m_reports.size (), 3, "Wrong number of reports");
+  NS_TEST_ASSERT_MSG_EQ (m_reports[0]->GetThreshold ().GetThresholdValue (), 0, "Periodic report with a threshold");
+  NS_TEST_ASSERT_MSG_EQ (GetReportedValue (m_reports[0]), -80, "Wrong reported value");
+  // The crossing replaces the periodic report;
+  NS_TEST_ASSERT_MSG_EQ ((int16_t) m_reports[1]->GetThreshold ().GetThresholdValue (), -70, "Crossing not reported");
+  NS_TEST_ASSERT_MSG_EQ (GetReportedValue (m_reports[2]), -60, "Wrong reported value");
+}
+
+class LinkThresholdEngineTestSuite : public TestSuite
+{
+public:
+  LinkThresholdEngineTestSuite ();
+};
+
+LinkThresholdEngineTestSuite::LinkThresholdEngineTestSuite ()
+  : TestSuite ("mih-link-threshold-engine", UNIT)
+{
+  AddTestCase (new LinkThresholdEngineBandTest, TestCase::QUICK);
+  AddTestCase (new LinkThresholdEngineDirectionTest, TestCase::QUICK);
+  AddTestCase (new LinkThresholdEngineOneShotTest, TestCase::QUICK);
+  AddTestCase (new LinkThresholdEngineCancelTest, TestCase::QUICK);
+  AddTestCase (new LinkThresholdEnginePeriodicTest, TestCase::QUICK);
+}
+
+static LinkThresholdEngineTestSuite g_linkThresholdEngineTestSuite; ///< the test suite
@@ -0,0 +1,433 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Scalability of the MIH signalling: mobile stations roam with random
+// waypoint mobility among APs laid on a grid, all bridged to a server
+// on a csma backbone. Each station registers with the network MIHF of
+// the server, which subscribes to the Wi-Fi link events of the
+// station in return. The wall clock time, simulator events per
+// second, peak resident set size and MIH PDUs per second are reported.
+// With a short lifetime and some churn, stations deregister and come
+// back, and registrations lapse unless refreshed: the session table of
+// the server is then expected to stay bounded.
+//
+//   Wifi 10.1.0.0/16 (one ESS, bridged)
+//
+//    AP0 ------ AP1 ------ AP2
+//     |   n0 ~    n1 ~      |
+//    AP3 ------ AP4 ------ AP5
+//     |                     |
+//     +----------+----------+
+//                |  csma
+//              server
+//
+// ./waf --run "mih-scale-bench --nMn=50 --nAp=9 --stop=30"
+// ./waf --run "mih-scale-bench --nMn=50 --lifetime=10 --churn=5 --stop=60"
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <sys/resource.h>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/bridge-module.h"
+#include "ns3/mih-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("MihScaleBench");
+
+static const uint16_t MIH_PORT = 4551;
+static const mih::MihfId NETWORK_MIHF_ID = mih::MihfId ("pos@net");
+
+struct BenchStats
+{
+  uint32_t registered;
+  uint32_t subscribed;
+  uint32_t linkDetected;
+  uint32_t linkUp;
+  uint32_t linkDown;
+  uint32_t linkGoingDown;
+  uint32_t deRegistered;
+  uint32_t expired;
+  uint32_t peakSessions;
+};
+
+static BenchStats g_stats;
+static Ptr<mih::MihFunction> g_networkMihf;
+static uint32_t g_lifetime = 3600;
+static double g_churn = 0;
+static Ptr<UniformRandomVariable> g_stay;
+
+static void
+LinkDetected (mih::MihfId mihfId, mih::LinkDetectedInformationList linkDetectedInfoList)
+{
+  g_stats.linkDetected++;
+}
+
+static void
+LinkUp (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+        Address oldAR, Address newAR, bool ipRenewal,
+        mih::MobilityManagementSupport mobilitySupport)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s " << mihfId << " LinkUp with " << newAR);
+  g_stats.linkUp++;
+}
+
+static void
+LinkDown (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+          Address oldAR, mih::LinkDownReason reason)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s " << mihfId << " LinkDown");
+  g_stats.linkDown++;
+}
+
+static void
+LinkGoingDown (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier,
+               uint64_t timeInterval, mih::LinkGoingDownReason reason)
+{
+  g_stats.linkGoingDown++;
+}
+
+static void
+EventSubscribeConfirm (mih::MihfId mihfId, mih::Status status,
+                       mih::LinkIdentifier linkIdentifier, mih::EventList events)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s subscribed to " << mihfId);
+  if (status.GetType () == mih::Status::SUCCESS)
+    {
+      g_stats.subscribed++;
+    }
+}
+
+static void
+EventSubscribe (mih::MihfId mihfId, mih::LinkIdentifier linkIdentifier)
+{
+  g_networkMihf->EventSubscribe (mihfId, linkIdentifier, MakeCallback (&EventSubscribeConfirm),
+                                 mih::EventList::LINK_DETECTED, MakeCallback (&LinkDetected),
+                                 mih::EventList::LINK_UP, MakeCallback (&LinkUp),
+                                 mih::EventList::LINK_DOWN, MakeCallback (&LinkDown),
+                                 mih::EventList::LINK_GOING_DOWN, MakeCallback (&LinkGoingDown));
+}
+
+// The network MIHF accepts every station and asks for the events of
+// the link it registered with;
+static void
+RegisterIndication (mih::MihfId mihfId, mih::LinkIdentifierList linkIdentifierList,
+                    mih::RegistrationCode registrationCode,
+                    mih::MihRegisterResponseCallback responseCallback)
+{
+  responseCallback (NETWORK_MIHF_ID, mih::Status (mih::Status::SUCCESS), g_lifetime);
+  if (registrationCode.GetCode () == mih::RegistrationCode::RE_REGISTRATION)
+    {
+      // Subscribed already;
+      return;
+    }
+  for (uint32_t j = 0; j < linkIdentifierList.size (); j++)
+    {
+      Simulator::ScheduleNow (&EventSubscribe, mihfId, *linkIdentifierList[j]);
+    }
+}
+
+static void
+RegisterConfirm (mih::MihfId mihfId, mih::Status status, uint32_t lifetime)
+{
+  if (status.GetType () == mih::Status::SUCCESS)
+    {
+      g_stats.registered++;
+    }
+}
+
+static void
+DeRegisterConfirm (mih::MihfId mihfId, mih::Status status)
+{
+  if (status.GetType () == mih::Status::SUCCESS)
+    {
+      g_stats.deRegistered++;
+    }
+}
+
+static void Leave (Ptr<mih::MihFunction> mihf, mih::LinkIdentifier linkIdentifier);
+
+static void
+Register (Ptr<mih::MihFunction> mihf, mih::LinkIdentifier linkIdentifier)
+{
+  mih::LinkIdentifierList linkIdentifierList;
+  linkIdentifierList.push_back (Create<mih::LinkIdentifier> (linkIdentifier));
+  mihf->Register (NETWORK_MIHF_ID, linkIdentifierList,
+                  mih::RegistrationCode (mih::RegistrationCode::REGISTRATION),
+                  MakeCallback (&RegisterConfirm));
+  if (g_churn > 0)
+    {
+      Simulator::Schedule (Seconds (g_stay->GetValue ()), &Leave, mihf, linkIdentifier);
+    }
+}
+
+// The station leaves the network and comes back a second later;
+static void
+Leave (Ptr<mih::MihFunction> mihf, mih::LinkIdentifier linkIdentifier)
+{
+  mihf->DeRegister (NETWORK_MIHF_ID, MakeCallback (&DeRegisterConfirm));
+  Simulator::Schedule (Seconds (1), &Register, mihf, linkIdentifier);
+}
+
+static void
+RegistrationExpired (mih::MihfId mihfId)
+{
+  NS_LOG_INFO (Simulator::Now ().GetSeconds () << "s registration of " << mihfId << " expired");
+  g_stats.expired++;
+}
+
+static void
+SessionCountChanged (uint32_t oldCount, uint32_t newCount)
+{
+  g_stats.peakSessions = std::max (g_stats.peakSessions, newCount);
+}
+
+static Ptr<mih::MihFunction>
+CreateMihFunction (mih::MihfId mihfId, Ptr<Node> node, Ipv4Address address, bool tcp)
+{
+  Ptr<mih::MihFunction> mihf = CreateObject<mih::MihFunction> ();
+  mihf->SetMihfId (mihfId);
+  Ptr<mih::MihProtocol> protocol = CreateObject<mih::MihProtocol> ();
+  protocol->SetAttribute ("Local", AddressValue (InetSocketAddress (address, MIH_PORT)));
+  protocol->SetAttribute ("Node", PointerValue (node));
+  if (tcp)
+    {
+      protocol->SetAttribute ("Protocol", TypeIdValue (TcpSocketFactory::GetTypeId ()));
+    }
+  mihf->AggregateObject (protocol);
+  protocol->AddDestinationEntry (mihfId, InetSocketAddress (address, 0));
+  node->AggregateObject (mihf);
+  return mihf;
+}
+
+static uint64_t
+GetPeakRss (void)
+{
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+  return usage.ru_maxrss; // kB on Linux;
+}
+
+static void
+Noop (void)
+{
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nMn = 20;
+  uint32_t nAp = 4;
+  double apDistance = 100;
+  double stop = 30;
+  bool tcp = false;
+  bool stats = false;
+  bool verbose = false;
+  bool refresh = true;
+
+  CommandLine cmd;
+  cmd.AddValue ("nMn", "Number of mobile stations", nMn);
+  cmd.AddValue ("nAp", "Number of APs, laid on a square grid", nAp);
+  cmd.AddValue ("apDistance", "Distance between neighbouring APs (m)", apDistance);
+  cmd.AddValue ("stop", "Simulation time (s)", stop);
+  cmd.AddValue ("tcp", "Carry the MIH PDUs over TCP instead of UDP", tcp);
+  cmd.AddValue ("stats", "Print the MIH signalling statistics of the run", stats);
+  cmd.AddValue ("verbose", "Log the registrations and link events", verbose);
+  cmd.AddValue ("lifetime", "Registration lifetime granted by the server (s), 0 for unlimited", g_lifetime);
+  cmd.AddValue ("refresh", "Refresh the registrations before they expire", refresh);
+  cmd.AddValue ("churn", "Mean time a station stays registered before it leaves (s), 0 for ever", g_churn);
+  cmd.Parse (argc,argv);
+
+  Config::SetDefault ("ns3::mih::MihProtocol::RegistrationRefresh", BooleanValue (refresh));
+  if (g_churn > 0)
+    {
+      g_stay = CreateObject<UniformRandomVariable> ();
+      g_stay->SetAttribute ("Min", DoubleValue (g_churn / 2));
+      g_stay->SetAttribute ("Max", DoubleValue (g_churn * 3 / 2));
+    }
+
+  if (verbose)
+    {
+      LogComponentEnable ("MihScaleBench", LOG_LEVEL_INFO);
+    }
+
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point setupStart = Clock::now ();
+
+  NodeContainer staNodes;
+  staNodes.Create (nMn);
+  NodeContainer apNodes;
+  apNodes.Create (nAp);
+  NodeContainer serverNode;
+  serverNode.Create (1);
+
+  // The link SAPs must be there before the Wi-Fi devices;
+  WifiMihLinkSapHelper wifiMihLinkSapHelper;
+  std::vector<Ptr<mih::WifiMihLinkSap> > mihLinkSaps;
+  for (uint32_t i = 0; i < nMn; i++)
+    {
+      mihLinkSaps.push_back (wifiMihLinkSapHelper.Install (staNodes.Get (i)));
+    }
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+
+  WifiHelper wifi;
+  wifi.SetRemoteStationManager ("ns3::AarfWifiManager");
+
+  WifiMacHelper mac;
+  Ssid ssid = Ssid ("ns-3-ssid");
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+  NetDeviceContainer staDevices = wifi.Install (phy, mac, staNodes);
+
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid));
+  NetDeviceContainer apDevices = wifi.Install (phy, mac, apNodes);
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", StringValue ("1Gbps"));
+  csma.SetChannelAttribute ("Delay", TimeValue (MicroSeconds (10)));
+  NodeContainer backboneNodes (serverNode, apNodes);
+  NetDeviceContainer backboneDevices = csma.Install (backboneNodes);
+
+  BridgeHelper bridge;
+  for (uint32_t i = 0; i < apNodes.GetN (); i++)
+    {
+      NetDeviceContainer bridgedDevices (apDevices.Get (i), backboneDevices.Get (i + 1));
+      bridge.Install (apNodes.Get (i), bridgedDevices);
+    }
+
+  uint32_t columns = std::ceil (std::sqrt (nAp));
+  uint32_t rows = (nAp + columns - 1) / columns;
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (apDistance),
+                                 "DeltaY", DoubleValue (apDistance),
+                                 "GridWidth", UintegerValue (columns),
+                                 "LayoutType", StringValue ("RowFirst"));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (apNodes);
+
+  // The stations wander over the area the grid covers, half the AP
+  // distance around its edges included;
+  std::ostringstream x;
+  x << "ns3::UniformRandomVariable[Min=" << -apDistance / 2
+    << "|Max=" << (columns - 0.5) * apDistance << "]";
+  std::ostringstream y;
+  y << "ns3::UniformRandomVariable[Min=" << -apDistance / 2
+    << "|Max=" << (rows - 0.5) * apDistance << "]";
+  ObjectFactory positionFactory;
+  positionFactory.SetTypeId ("ns3::RandomRectanglePositionAllocator");
+  positionFactory.Set ("X", StringValue (x.str ()));
+  positionFactory.Set ("Y", StringValue (y.str ()));
+  Ptr<PositionAllocator> waypoints = positionFactory.Create ()->GetObject<PositionAllocator> ();
+  mobility.SetPositionAllocator (waypoints);
+  mobility.SetMobilityModel ("ns3::RandomWaypointMobilityModel",
+                             "Speed", StringValue ("ns3::UniformRandomVariable[Min=1.0|Max=10.0]"),
+                             "Pause", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=2.0]"),
+                             "PositionAllocator", PointerValue (waypoints));
+  mobility.Install (staNodes);
+
+  InternetStackHelper stack;
+  stack.Install (staNodes);
+  stack.Install (serverNode);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.0.0", "255.255.0.0");
+  Ipv4InterfaceContainer serverInterfaces = address.Assign (NetDeviceContainer (backboneDevices.Get (0)));
+  Ipv4InterfaceContainer staInterfaces = address.Assign (staDevices);
+
+  MihStatsHelper mihStats;
+  g_networkMihf = CreateMihFunction (NETWORK_MIHF_ID, serverNode.Get (0),
+                                     serverInterfaces.GetAddress (0), tcp);
+  Ptr<mih::MihProtocol> networkProtocol = g_networkMihf->GetObject<mih::MihProtocol> ();
+  g_networkMihf->RegisterMihRegisterIndicationCallback (MakeCallback (&RegisterIndication));
+  networkProtocol->TraceConnectWithoutContext ("RegistrationExpired", MakeCallback (&RegistrationExpired));
+  networkProtocol->TraceConnectWithoutContext ("SessionCountChanged", MakeCallback (&SessionCountChanged));
+  mihStats.Install (g_networkMihf);
+
+  // Spread the registrations over a second, once most stations are
+  // associated;
+  Ptr<UniformRandomVariable> registerTime = CreateObject<UniformRandomVariable> ();
+  registerTime->SetAttribute ("Min", DoubleValue (1));
+  registerTime->SetAttribute ("Max", DoubleValue (2));
+  for (uint32_t i = 0; i < nMn; i++)
+    {
+      std::ostringstream name;
+      name << "mn" << i << "@sta";
+      mih::MihfId mihfId = mih::MihfId (name.str ().c_str ());
+      Ptr<mih::MihFunction> mihf = CreateMihFunction (mihfId, staNodes.Get (i),
+                                                      staInterfaces.GetAddress (i), tcp);
+      Ptr<mih::MihProtocol> protocol = mihf->GetObject<mih::MihProtocol> ();
+      protocol->AddDestinationEntry (NETWORK_MIHF_ID, InetSocketAddress (serverInterfaces.GetAddress (0), MIH_PORT));
+      networkProtocol->AddDestinationEntry (mihfId, InetSocketAddress (staInterfaces.GetAddress (i), MIH_PORT));
+      mihStats.Install (mihf);
+      protocol->Init ();
+
+      // The link SAP is found by the station address before association;
+      mih::LinkIdentifier linkIdentifier (mih::LinkType (mih::LinkType::WIRELESS_802_11),
+                                          staDevices.Get (i)->GetAddress (),
+                                          Address ());
+      mihLinkSaps[i]->SetLinkIdentifier (linkIdentifier);
+      mihLinkSaps[i]->SetMihfId (mihfId);
+      mihf->Register (mihLinkSaps[i]);
+      Simulator::Schedule (Seconds (registerTime->GetValue ()), &Register, mihf, linkIdentifier);
+    }
+  networkProtocol->Init ();
+
+  double setupTime = std::chrono::duration<double> (Clock::now () - setupStart).count ();
+  uint32_t eventsBefore = Simulator::ScheduleNow (&Noop).GetUid ();
+  Clock::time_point runStart = Clock::now ();
+  Simulator::Stop (Seconds (stop));
+  Simulator::Run ();
+  double runTime = std::chrono::duration<double> (Clock::now () - runStart).count ();
+  uint32_t events = Simulator::ScheduleNow (&Noop).GetUid () - eventsBefore;
+
+  std::cout << "MIH scalability: " << nMn << " stations, " << nAp << " APs, "
+            << stop << " s simulated over " << (tcp ? "TCP" : "UDP") << std::endl;
+  std::cout << "  Setup:             " << setupTime << " s" << std::endl;
+  std::cout << "  Run:               " << runTime << " s wall clock" << std::endl;
+  std::cout << "  Simulator events:  " << events << " (" << events / runTime << " per second)" << std::endl;
+  std::cout << "  Peak RSS:          " << GetPeakRss () / 1024 << " MB" << std::endl;
+  std::cout << "  MIH PDUs:          " << mihStats.GetTxPduCount () << " ("
+            << mihStats.GetTxPduCount () / runTime << " per second, "
+            << mihStats.GetTxPduCount () / stop << " per simulated second)" << std::endl;
+  std::cout << "  Registered:        " << g_stats.registered << "/" << nMn
+            << ", subscribed " << g_stats.subscribed << "/" << nMn << std::endl;
+  std::cout << "  Link events:       " << g_stats.linkDetected << " detected, "
+            << g_stats.linkUp << " up, " << g_stats.linkDown << " down, "
+            << g_stats.linkGoingDown << " going down" << std::endl;
+  std::cout << "  Server sessions:   " << networkProtocol->GetSessionCount () << " open, "
+            << g_stats.peakSessions << " at most, " << g_stats.deRegistered << " deregistered, "
+            << g_stats.expired << " expired" << std::endl;
+  if (stats)
+    {
+      mihStats.WriteSummary (std::cout);
+    }
+
+  Simulator::Destroy ();
+  return 0;
+}
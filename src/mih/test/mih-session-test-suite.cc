@@ -0,0 +1,162 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/mih-session.h"
+
+using namespace ns3;
+using namespace ns3::mih;
+
+// Opens up the transaction tables of a session, to fill them without
+// any peer;
+class TransactionIdSession : public Session
+{
+public:
+  virtual ~TransactionIdSession ();
+  using Session::AllocateTransactionId;
+  void SetNextTransactionId (uint16_t transactionId);
+  void AddOutstandingRequest (uint16_t transactionId);
+  void AddSentResponse (uint16_t transactionId, Time expires);
+};
+
+TransactionIdSession::~TransactionIdSession ()
+{
+  // Never answered, the requests go with the session;
+  for (TransactionTableI i = m_outstandingRequests.begin (); i != m_outstandingRequests.end (); i++)
+    {
+      i->second->SetToBeDeleted ();
+    }
+}
+
+void
+TransactionIdSession::SetNextTransactionId (uint16_t transactionId)
+{
+  m_nextTransactionId = transactionId;
+}
+
+void
+TransactionIdSession::AddOutstandingRequest (uint16_t transactionId)
+{
+  m_outstandingRequests[transactionId] = Create<Transaction> (Create<Packet> (), MihfId ("mn@sta"),
+                                                              MihfId ("pos@net"), Address (),
+                                                              transactionId);
+}
+
+void
+TransactionIdSession::AddSentResponse (uint16_t transactionId, Time expires)
+{
+  SentResponse response;
+  response.packet = Create<Packet> ();
+  response.expires = expires;
+  m_sentResponses[transactionId] = response;
+  m_sentResponseExpiries.push_back (std::make_pair (expires, transactionId));
+}
+
+// Identifiers follow each other, skipping the outstanding requests
+// and the responses kept for replay;
+class SessionTransactionIdSkipTest : public TestCase
+{
+public:
+  SessionTransactionIdSkipTest ();
+  virtual void DoRun (void);
+};
+
+SessionTransactionIdSkipTest::SessionTransactionIdSkipTest ()
+  : TestCase ("Outstanding and replayed identifiers")
+{
+}
+
+void
+SessionTransactionIdSkipTest::DoRun (void)
+{
+  Ptr<TransactionIdSession> session = Create<TransactionIdSession> ();
+  NS_TEST_ASSERT_MSG_EQ (session->AllocateTransactionId (), 0, "First identifier");
+  NS_TEST_ASSERT_MSG_EQ (session->AllocateTransactionId (), 1, "Identifiers not sequential");
+  session->AddOutstandingRequest (2);
+  session->AddOutstandingRequest (3);
+  // Responses are kept in the order they were sent;
+  session->AddSentResponse (8, Seconds (0));
+  session->AddSentResponse (4, Seconds (10));
+  session->AddOutstandingRequest (6);
+  NS_TEST_ASSERT_MSG_EQ (session->AllocateTransactionId (), 5, "Outstanding or replayed identifier reused");
+  NS_TEST_ASSERT_MSG_EQ (session->AllocateTransactionId (), 7, "Outstanding identifier reused");
+
+  // A response no longer kept for replay frees its identifier;
+  NS_TEST_ASSERT_MSG_EQ (session->AllocateTransactionId (), 8, "Expired response identifier skipped");
+  Simulator::Destroy ();
+}
+
+// The 12-bit identifier wraps around to zero, still skipping the
+// identifiers in use past the wrap;
+class SessionTransactionIdWrapTest : public TestCase
+{
+public:
+  SessionTransactionIdWrapTest ();
+  virtual void DoRun (void);
+};
+
+SessionTransactionIdWrapTest::SessionTransactionIdWrapTest ()
+  : TestCase ("Wraparound")
+{
+}
+
+void
+SessionTransactionIdWrapTest::DoRun (void)
+{
+  Ptr<TransactionIdSession> session = Create<TransactionIdSession> ();
+  session->SetNextTransactionId (0x0ffe);
+  session->AddOutstandingRequest (0x0fff);
+  session->AddOutstandingRequest (0);
+  session->AddSentResponse (1, Seconds (10));
+  NS_TEST_ASSERT_MSG_EQ (session->AllocateTransactionId (), 0x0ffe, "Last identifier skipped");
+  NS_TEST_ASSERT_MSG_EQ (session->AllocateTransactionId (), 2, "Identifier in use reused past the wrap");
+  NS_TEST_ASSERT_MSG_EQ (session->AllocateTransactionId (), 3, "Identifiers not sequential past the wrap");
+
+  // Every identifier but the outstanding ones kept for replay: the
+  // next replayed one is reused, the outstanding ones never are;
+  session = Create<TransactionIdSession> ();
+  session->SetNextTransactionId (0x0ff0);
+  for (uint16_t transactionId = 0x0ff0; transactionId <= 0x0fff; transactionId++)
+    {
+      session->AddOutstandingRequest (transactionId);
+    }
+  for (uint16_t transactionId = 0; transactionId < 0x0ff0; transactionId++)
+    {
+      session->AddSentResponse (transactionId, Seconds (10));
+    }
+  NS_TEST_ASSERT_MSG_EQ (session->AllocateTransactionId (), 0, "Outstanding identifier reused");
+  NS_TEST_ASSERT_MSG_EQ (session->AllocateTransactionId (), 1, "Replayed identifiers not reused in order");
+  Simulator::Destroy ();
+}
+
+class SessionTestSuite : public TestSuite
+{
+public:
+  SessionTestSuite ();
+};
+
+SessionTestSuite::SessionTestSuite ()
+  : TestSuite ("mih-session", UNIT)
+{
+  AddTestCase (new SessionTransactionIdSkipTest, TestCase::QUICK);
+  AddTestCase (new SessionTransactionIdWrapTest, TestCase::QUICK);
+}
+
+static SessionTestSuite g_sessionTestSuite; ///< the test suite
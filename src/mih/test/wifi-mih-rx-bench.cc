@@ -0,0 +1,143 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Receive path cost of a Wi-Fi station with and without a
+// WifiMihLinkSap installed: an AP sends back to back data frames to
+// one associated station and the wall clock time spent per frame
+// received by the station is reported.
+//
+// ./waf --run "wifi-mih-rx-bench --duration=5 --min-iterations=3"
+
+#include <iostream>
+#include <limits>
+#include <algorithm>
+#include <chrono>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mih-module.h"
+
+using namespace ns3;
+
+static uint64_t g_received = 0;
+static double g_duration = 5;
+static uint32_t g_packetSize = 1000;
+static Time g_interval = MicroSeconds (250);
+
+static bool
+DeviceRx (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  g_received++;
+  return true;
+}
+
+static void
+Send (Ptr<NetDevice> ap, Address to)
+{
+  ap->Send (Create<Packet> (g_packetSize), to, 0x0800);
+  Simulator::Schedule (g_interval, &Send, ap, to);
+}
+
+// Returns the number of data frames received by the station;
+static uint64_t
+Run (bool withMih)
+{
+  g_received = 0;
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  if (withMih)
+    {
+      WifiMihLinkSapHelper wifiMihLinkSapHelper;
+      wifiMihLinkSapHelper.Install (nodes.Get (0));
+      wifiMihLinkSapHelper.Install (nodes.Get (1));
+    }
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate54Mbps"));
+
+  WifiMacHelper mac;
+  Ssid ssid = Ssid ("ns-3-ssid");
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+  NetDeviceContainer staDevices = wifi.Install (phy, mac, nodes.Get (0));
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid));
+  NetDeviceContainer apDevices = wifi.Install (phy, mac, nodes.Get (1));
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (5, 0, 0));
+  positionAlloc->Add (Vector (0, 0, 0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  staDevices.Get (0)->SetReceiveCallback (MakeCallback (&DeviceRx));
+  Simulator::Schedule (Seconds (1), &Send, apDevices.Get (0), staDevices.Get (0)->GetAddress ());
+
+  Simulator::Stop (Seconds (1 + g_duration));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return g_received;
+}
+
+static void
+runBench (bool withMih, uint32_t minIterations, char const *name)
+{
+  typedef std::chrono::steady_clock Clock;
+  int64_t minDelay = std::numeric_limits<int64_t>::max ();
+  uint64_t received = 0;
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      Clock::time_point start = Clock::now ();
+      received = Run (withMih);
+      int64_t delay = std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now () - start).count ();
+      minDelay = std::min (minDelay, delay);
+    }
+  std::cout << received << " frames, "
+            << static_cast<uint64_t> (received * 1e9 / minDelay) << " rx/s"
+            << " (" << minDelay / std::max<uint64_t> (received, 1) << " ns/frame, "
+            << minDelay / 1000000 << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t minIterations = 3;
+
+  CommandLine cmd;
+  cmd.AddValue ("duration", "simulated seconds of downlink traffic", g_duration);
+  cmd.AddValue ("packetSize", "size of the data frames payload", g_packetSize);
+  cmd.AddValue ("interval", "time between two frames handed to the AP", g_interval);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Receiving " << g_duration << " s of downlink data frames" << std::endl;
+  runBench (false, minIterations, "Without MIH");
+  runBench (true, minIterations, "With WifiMihLinkSap");
+
+  return 0;
+}
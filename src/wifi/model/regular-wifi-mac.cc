@@ -587,6 +587,13 @@ RegularWifiMac::SetMihLinkDetectedCallback (Callback<bool, mih::LinkDetectedInfo
   m_mihLinkDetected = linkDetected;
 }
 
+void
+RegularWifiMac::SetMihRssiSampleCallback (Callback<void, double> rssiSample)
+{
+  NS_LOG_FUNCTION (this);
+  m_mihRssiSample = rssiSample;
+}
+
 void
 RegularWifiMac::SetQosSupported (bool enable)
 {
@@ -287,6 +287,11 @@ public:
    * \param mihLinkDetected the callback to invoke when a link is detected to generate the MIH event.
    */
   void SetMihLinkDetectedCallback (Callback<bool, mih::LinkDetectedInformation> linkDetected);
+  /**
+   * \param rssiSample the callback to invoke with the signal strength (dBm)
+   *        of each frame received from the BSS we are associated with.
+   */
+  void SetMihRssiSampleCallback (Callback<void, double> rssiSample);
 
   /* Next functions are not pure virtual so non Qos WifiMacs are not
    * forced to implement them.
@@ -315,6 +320,7 @@ protected:
   Callback<void, mih::LinkIdentifier, Address, Address, bool, mih::MobilityManagementSupport> m_mihLinkUp;
   Callback<void, mih::LinkIdentifier, Address, mih::LinkDownReason> m_mihLinkDown;
   Callback<bool, mih::LinkDetectedInformation> m_mihLinkDetected;
+  Callback<void, double> m_mihRssiSample;
 
   Ssid m_ssid; //!< Service Set ID (SSID)
 
@@ -20,9 +20,11 @@
  *          Mirko Banchi <mk.banchi@gmail.com>
  */
 
+#include <cmath>
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/double.h"
 #include "sta-wifi-mac.h"
 #include "wifi-phy.h"
 #include "mac-low.h"
@@ -84,6 +86,18 @@ StaWifiMac::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&StaWifiMac::SetActiveProbing, &StaWifiMac::GetActiveProbing),
                    MakeBooleanChecker ())
+    .AddAttribute ("MihLinkDetectedHysteresis",
+                   "Change of the signal strength (dB) of an already detected PoA "
+                   "needed for a new MIH LinkDetected indication.",
+                   DoubleValue (2.0),
+                   MakeDoubleAccessor (&StaWifiMac::m_mihDetectedHysteresis),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("MihLinkDetectedRefresh",
+                   "Interval after which an already detected PoA is indicated again "
+                   "even if its beacons did not change.",
+                   TimeValue (MilliSeconds (500)),
+                   MakeTimeAccessor (&StaWifiMac::m_mihDetectedRefresh),
+                   MakeTimeChecker ())
     .AddTraceSource ("Assoc", "Associated with an access point.",
                      MakeTraceSourceAccessor (&StaWifiMac::m_assocLogger),
                      "ns3::Mac48Address::TracedCallback")
@@ -98,7 +112,10 @@ StaWifiMac::StaWifiMac ()
   : m_state (BEACON_MISSED),
     m_probeRequestEvent (),
     m_assocRequestEvent (),
-    m_beaconWatchdogEnd (Seconds (0))
+    m_beaconWatchdogEnd (Seconds (0)),
+    m_mihScanning (false),
+    m_mihScanNext (0),
+    m_mihScanHomeChannel (0)
 {
   NS_LOG_FUNCTION (this);
 
@@ -112,6 +129,15 @@ StaWifiMac::~StaWifiMac ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+StaWifiMac::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_mihScanEvent.Cancel ();
+  m_mihLinkSap = 0;
+  InfrastructureWifiMac::DoDispose ();
+}
+
 void
 StaWifiMac::SetActiveProbing (bool enable)
 {
@@ -141,6 +167,106 @@ StaWifiMac::SetWifiPhy (const Ptr<WifiPhy> phy)
   m_phy->SetCapabilitiesChangedCallback (MakeCallback (&StaWifiMac::PhyCapabilitiesChanged, this));
 }
 
+void
+StaWifiMac::SetMihLinkSap (const Ptr<mih::WifiMihLinkSap> mihLinkSap)
+{
+  NS_LOG_FUNCTION (this << mihLinkSap);
+  m_mihLinkSap = mihLinkSap;
+  m_mihLinkSap->SetScanCallback (MakeCallback (&StaWifiMac::StartMihScan, this));
+  m_mihLinkSap->SetPowerCallback (MakeCallback (&StaWifiMac::SetMihPower, this));
+}
+
+void
+StaWifiMac::StartMihScan (std::vector<uint8_t> channels, Time dwell)
+{
+  NS_LOG_FUNCTION (this << channels.size () << dwell);
+  NS_ASSERT (!m_mihScanning);
+  m_mihScanning = true;
+  m_mihScanHomeChannel = m_phy->GetChannelNumber ();
+  m_mihScanChannels = channels;
+  if (m_mihScanChannels.empty ())
+    {
+      m_mihScanChannels.push_back (m_mihScanHomeChannel);
+    }
+  m_mihScanNext = 0;
+  m_mihScanDwell = dwell;
+  MihScanNextChannel ();
+}
+
+void
+StaWifiMac::MihScanNextChannel (void)
+{
+  NS_LOG_FUNCTION (this);
+  //A channel switch would be postponed to the end of the transmission.
+  if (m_phy->IsStateSwitching () || m_phy->IsStateTx ())
+    {
+      m_mihScanEvent = Simulator::Schedule (m_phy->GetDelayUntilIdle (),
+                                            &StaWifiMac::MihScanNextChannel, this);
+      return;
+    }
+  if (m_mihScanNext == m_mihScanChannels.size ())
+    {
+      m_phy->SetChannelNumber (m_mihScanHomeChannel);
+      m_mihScanning = false;
+      if (m_mihLinkSap != 0)
+        {
+          m_mihLinkSap->NotifyScanComplete ();
+        }
+      return;
+    }
+  m_phy->SetChannelNumber (m_mihScanChannels[m_mihScanNext++]);
+  //Probe for any SSID so that every PoA in range answers.
+  QueueProbeRequest (Ssid ());
+  m_mihScanEvent = Simulator::Schedule (m_mihScanDwell, &StaWifiMac::MihScanNextChannel, this);
+}
+
+void
+StaWifiMac::SetMihPower (bool on)
+{
+  NS_LOG_FUNCTION (this << on);
+  if (!on)
+    {
+      if (m_phy->IsStateOff ())
+        {
+          return;
+        }
+      //The operating channel is restored once the PHY is back on.
+      m_mihScanEvent.Cancel ();
+      m_mihScanning = false;
+      m_probeRequestEvent.Cancel ();
+      m_assocRequestEvent.Cancel ();
+      m_beaconWatchdog.Cancel ();
+      m_beaconWatchdogEnd = Simulator::Now ();
+      if (IsAssociated ())
+        {
+          m_linkDown ();
+          if (!m_mihLinkDown.IsNull ())
+            {
+              mih::LinkIdentifier linkId = mih::LinkIdentifier (mih::LinkType (mih::LinkType::WIRELESS_802_11),
+                                                                GetAddress (), GetBssid ());
+              m_mihLinkDown (linkId, GetBssid (), mih::LinkDownReason (mih::LinkDownReason::EXPLICIT_DISCONNECT));
+            }
+        }
+      //Nothing is sent from this state until the PHY is back on.
+      SetState (WAIT_PROBE_RESP);
+      m_phy->SetOffMode ();
+      return;
+    }
+  if (!m_phy->IsStateOff ())
+    {
+      return;
+    }
+  m_phy->ResumeFromOff ();
+  if (m_mihScanHomeChannel != 0)
+    {
+      m_phy->SetChannelNumber (m_mihScanHomeChannel);
+    }
+  if (GetActiveProbing ())
+    {
+      SendProbeRequest ();
+    }
+}
+
 void
 StaWifiMac::SetWifiRemoteStationManager (const Ptr<WifiRemoteStationManager> stationManager)
 {
@@ -153,6 +279,19 @@ void
 StaWifiMac::SendProbeRequest (void)
 {
   NS_LOG_FUNCTION (this);
+  QueueProbeRequest (GetSsid ());
+  if (m_probeRequestEvent.IsRunning ())
+    {
+      m_probeRequestEvent.Cancel ();
+    }
+  m_probeRequestEvent = Simulator::Schedule (m_probeRequestTimeout,
+                                             &StaWifiMac::ProbeRequestTimeout, this);
+}
+
+void
+StaWifiMac::QueueProbeRequest (Ssid ssid)
+{
+  NS_LOG_FUNCTION (this << ssid);
   WifiMacHeader hdr;
   hdr.SetType (WIFI_MAC_MGT_PROBE_REQUEST);
   hdr.SetAddr1 (Mac48Address::GetBroadcast ());
@@ -163,7 +302,7 @@ StaWifiMac::SendProbeRequest (void)
   hdr.SetNoOrder ();
   Ptr<Packet> packet = Create<Packet> ();
   MgtProbeRequestHeader probe;
-  probe.SetSsid (GetSsid ());
+  probe.SetSsid (ssid);
   probe.SetSupportedRates (GetSupportedRates ());
   if (GetHtSupported () || GetVhtSupported () || GetHeSupported ())
     {
@@ -185,13 +324,6 @@ StaWifiMac::SendProbeRequest (void)
   //use the non-QoS for these regardless of whether we have a QoS
   //association or not.
   m_txop->Queue (packet, hdr);
-
-  if (m_probeRequestEvent.IsRunning ())
-    {
-      m_probeRequestEvent.Cancel ();
-    }
-  m_probeRequestEvent = Simulator::Schedule (m_probeRequestTimeout,
-                                             &StaWifiMac::ProbeRequestTimeout, this);
 }
 
 void
@@ -498,6 +630,14 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
     {
       SendCfPollResponse ();
     }
+  if (!m_mihRssiSample.IsNull () && IsAssociated () && hdr->GetAddr2 () == GetBssid ())
+    {
+      SignalStrengthTag signalStrengthTag;
+      if (packet->PeekPacketTag (signalStrengthTag))
+        {
+          m_mihRssiSample (signalStrengthTag.Get ());
+        }
+    }
   if (hdr->IsData ())
     {
       if (!IsAssociated ())
@@ -573,19 +713,34 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
             }
         }
       SupportedRates rates = beacon.GetSupportedRates ();
+      if (m_mihScanning)
+        {
+          SignalStrengthTag signalStrengthTag;
+          packet->PeekPacketTag (signalStrengthTag);
+          m_mihLinkSap->NotifyScanResponse (hdr->GetAddr3 (), beacon.GetSsid ().PeekString (),
+                                            signalStrengthTag.Get ());
+          if (m_phy->GetChannelNumber () != m_mihScanHomeChannel)
+            {
+              NS_LOG_LOGIC ("Beacon received away from the operating channel");
+              return;
+            }
+        }
       
       bool sendAssoc = false;
       if (!m_mihLinkDetected.IsNull ())
         {
-          if (!(IsAssociated () && hdr->GetAddr3 () == GetBssid ()))
+          SignalStrengthTag signalStrengthTag;
+          packet->PeekPacketTag (signalStrengthTag);
+          StationCountTag stationCountTag;
+          packet->PeekPacketTag (stationCountTag);
+          if (!(IsAssociated () && hdr->GetAddr3 () == GetBssid ())
+              && IsMihLinkDetectedDue (hdr->GetAddr2 (), signalStrengthTag.Get (), stationCountTag.Get ()))
             {
               mih::LinkIdentifier linkId = mih::LinkIdentifier (mih::LinkType (mih::LinkType::WIRELESS_802_11),
                                                                 GetAddress (),
                                                                 hdr->GetAddr2 ());
               mih::NetworkIdentifier networkId = mih::NetworkIdentifier ();
               mih::NetworkAuxiliaryIdentifier networkAuxiliaryId = mih::NetworkAuxiliaryIdentifier ();
-              SignalStrengthTag signalStrengthTag;
-              packet->RemovePacketTag (signalStrengthTag);
               uint16_t signal = (uint16_t) signalStrengthTag.Get ();
               mih::SignalStrength signalStrength = mih::SignalStrength (signal);
               SnrTag tag;
@@ -593,14 +748,17 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
               uint16_t snr = (uint16_t) tag.Get ();
               mih::MihCapabilityFlag mihCapabilityFlag = mih::MihCapabilityFlag ();
               mih::NetworkCapabilities networkCapabilities =  mih::NetworkCapabilities ();
-              StationCountTag stationCountTag;
-              packet->RemovePacketTag (stationCountTag);
               uint32_t stationCount = stationCountTag.Get ();
               mih::LinkDetectedInformation linkInfo = mih::LinkDetectedInformation (linkId, networkId,
                                                                                     networkAuxiliaryId, signalStrength, snr, 
                                                                                     rates, mihCapabilityFlag,
                                                                                     networkCapabilities, stationCount);
               sendAssoc = m_mihLinkDetected (linkInfo);
+              if (sendAssoc)
+                {
+                  // The handover criteria changed, so re-evaluate every PoA;
+                  m_mihDetectedPoas.clear ();
+                }
             }
         }
       if (IsAssociated () && sendAssoc)
@@ -761,6 +919,17 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
     }
   else if (hdr->IsProbeResp ())
     {
+      if (m_mihScanning)
+        {
+          MgtProbeResponseHeader probeResp;
+          packet->PeekHeader (probeResp);
+          SignalStrengthTag signalStrengthTag;
+          packet->PeekPacketTag (signalStrengthTag);
+          m_mihLinkSap->NotifyScanResponse (hdr->GetAddr3 (), probeResp.GetSsid ().PeekString (),
+                                            signalStrengthTag.Get ());
+          //Associate once back on the operating channel.
+          return;
+        }
       if (m_state == WAIT_PROBE_RESP)
         {
           NS_LOG_DEBUG ("Probe response received");
@@ -1110,9 +1279,34 @@ StaWifiMac::GetCapabilities (void) const
   return capabilities;
 }
 
+bool
+StaWifiMac::IsMihLinkDetectedDue (Mac48Address poa, double signal, uint32_t stationCount)
+{
+  NS_LOG_FUNCTION (this << poa << signal << stationCount);
+  Time now = Simulator::Now ();
+  std::map<Mac48Address, MihDetectedPoa>::iterator i = m_mihDetectedPoas.find (poa);
+  if (i != m_mihDetectedPoas.end ()
+      && std::abs (signal - i->second.signal) < m_mihDetectedHysteresis
+      && stationCount == i->second.stationCount
+      && now - i->second.lastIndication < m_mihDetectedRefresh)
+    {
+      return false;
+    }
+  MihDetectedPoa &detected = m_mihDetectedPoas[poa];
+  detected.signal = signal;
+  detected.stationCount = stationCount;
+  detected.lastIndication = now;
+  return true;
+}
+
 void
 StaWifiMac::SetState (MacState value)
 {
+  if ((value == ASSOCIATED) != (m_state == ASSOCIATED))
+    {
+      // Detected PoAs are judged against the serving one;
+      m_mihDetectedPoas.clear ();
+    }
   if (value == ASSOCIATED
       && m_state != ASSOCIATED)
     {
@@ -1140,6 +1334,11 @@ void
 StaWifiMac::PhyCapabilitiesChanged (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_mihScanning)
+    {
+      NS_LOG_DEBUG ("PHY capabilities changed by an MIH scan: ignore");
+      return;
+    }
   if (IsAssociated ())
     {
       NS_LOG_DEBUG ("PHY capabilities changed: send reassociation request");
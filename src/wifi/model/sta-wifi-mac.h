@@ -23,6 +23,8 @@
 #ifndef STA_WIFI_MAC_H
 #define STA_WIFI_MAC_H
 
+#include <map>
+#include <vector>
 #include "infrastructure-wifi-mac.h"
 
 namespace ns3  {
@@ -30,6 +32,9 @@ namespace ns3  {
 class MgtAddBaRequestHeader;
 class SupportedRates;
 class CapabilityInformation;
+namespace mih {
+class WifiMihLinkSap;
+}
 
 /**
  * \ingroup wifi
@@ -69,6 +74,29 @@ public:
    * \param phy the physical layer attached to this MAC.
    */
   void SetWifiPhy (const Ptr<WifiPhy> phy);
+  /**
+   * Let the MIH link SAP of the node drive scans and the radio power
+   * of this STA through LINK_ACTIONS.
+   *
+   * \param mihLinkSap the MIH link SAP of this MAC's device
+   */
+  void SetMihLinkSap (const Ptr<mih::WifiMihLinkSap> mihLinkSap);
+  /**
+   * Probe the given channels one after the other, reporting every probe
+   * response and beacon to the MIH link SAP, then return to the
+   * operating channel and notify the MIH link SAP of the end of the scan.
+   *
+   * \param channels the channels to probe, the operating one if empty
+   * \param dwell the time spent waiting for responses on each channel
+   */
+  void StartMihScan (std::vector<uint8_t> channels, Time dwell);
+  /**
+   * Switch the PHY off or back on. The association is dropped when the
+   * PHY goes off, and restarted once it is back on.
+   *
+   * \param on whether the PHY is to be on
+   */
+  void SetMihPower (bool on);
 
 
 private:
@@ -104,6 +132,17 @@ private:
    * queue for management frames if QoS is supported. We always use the DCF.
    */
   void SendProbeRequest (void);
+  /**
+   * Forward a probe request packet for the given SSID to the DCF.
+   *
+   * \param ssid the SSID probed for
+   */
+  void QueueProbeRequest (Ssid ssid);
+  /**
+   * Move the MIH scan to its next channel, or back to the operating
+   * channel once all of them were probed.
+   */
+  void MihScanNextChannel (void);
   /**
    * Forward an association or reassociation request packet to the DCF.
    * The standard is not clear on the correct queue for management frames if QoS is supported.
@@ -193,6 +232,21 @@ private:
    * Indicate that PHY capabilities have changed.
    */
   void PhyCapabilitiesChanged (void);
+  /**
+   * Check whether a beacon from a PoA we are not associated with is worth
+   * an MIH LinkDetected indication and, if so, record it as indicated.
+   *
+   * \param poa the address of the PoA that sent the beacon
+   * \param signal the signal strength of the beacon (dBm)
+   * \param stationCount the station count advertised by the PoA
+   *
+   * \return true if the PoA is new, its signal strength or station count
+   *         changed beyond MihLinkDetectedHysteresis, or it was last
+   *         indicated more than MihLinkDetectedRefresh ago
+   */
+  bool IsMihLinkDetectedDue (Mac48Address poa, double signal, uint32_t stationCount);
+
+  virtual void DoDispose (void);
 
   MacState m_state;            ///< MAC state
   Time m_probeRequestTimeout;  ///< probe request timeout
@@ -204,6 +258,24 @@ private:
   uint32_t m_maxMissedBeacons; ///< maximum missed beacons
   bool m_activeProbing;        ///< active probing
 
+  /// Last MIH LinkDetected indication raised for a PoA
+  struct MihDetectedPoa
+  {
+    double signal;          ///< signal strength (dBm)
+    uint32_t stationCount;  ///< advertised station count
+    Time lastIndication;    ///< time of the indication
+  };
+  std::map<Mac48Address, MihDetectedPoa> m_mihDetectedPoas; ///< PoAs already indicated
+  double m_mihDetectedHysteresis; ///< signal change (dB) that triggers a new indication
+  Time m_mihDetectedRefresh;      ///< period after which a PoA is indicated again
+  Ptr<mih::WifiMihLinkSap> m_mihLinkSap; ///< MIH link SAP, if any
+  bool m_mihScanning;                    ///< whether an MIH scan is ongoing
+  std::vector<uint8_t> m_mihScanChannels; ///< channels of the MIH scan
+  uint32_t m_mihScanNext;                ///< next channel of the MIH scan
+  uint8_t m_mihScanHomeChannel;          ///< operating channel
+  Time m_mihScanDwell;                   ///< time spent on each channel
+  EventId m_mihScanEvent;                ///< MIH scan channel switch event
+
   TracedCallback<Mac48Address> m_assocLogger;   ///< assoc logger
   TracedCallback<Mac48Address> m_deAssocLogger; ///< deassoc logger
 };
@@ -234,6 +234,11 @@ public:
    * \param mihLinkDetected the callback to invoke when a link is detected to generate the MIH event.
    */
   virtual void SetMihLinkDetectedCallback (Callback<bool, mih::LinkDetectedInformation> linkDetected) = 0;
+  /**
+   * \param rssiSample the callback to invoke with the signal strength (dBm)
+   *        of each frame received from the BSS we are associated with.
+   */
+  virtual void SetMihRssiSampleCallback (Callback<void, double> rssiSample) = 0;
 
   /* Next functions are not pure virtual so non Qos WifiMacs are not
    * forced to implement them.
@@ -28,6 +28,7 @@
 #include "wifi-net-device.h"
 #include "wifi-phy.h"
 #include "regular-wifi-mac.h"
+#include "sta-wifi-mac.h"
 #include "wifi-mac-queue.h"
 
 namespace ns3 {
@@ -87,6 +88,7 @@ WifiNetDevice::DoDispose (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_node = 0;
+  m_mihLinkSap = 0;
   m_mac->Dispose ();
   m_phy->Dispose ();
   m_stationManager->Dispose ();
@@ -123,12 +125,19 @@ WifiNetDevice::CompleteConfig (void)
   m_mac->SetForwardUpCallback (MakeCallback (&WifiNetDevice::ForwardUp, this));
   m_mac->SetLinkUpCallback (MakeCallback (&WifiNetDevice::LinkUp, this));
   m_mac->SetLinkDownCallback (MakeCallback (&WifiNetDevice::LinkDown, this));
-  Ptr<mih::WifiMihLinkSap> mihLinkSap= m_node->GetObject<mih::WifiMihLinkSap> ();
-  if (mihLinkSap != 0)
+  m_mihLinkSap = m_node->GetObject<mih::WifiMihLinkSap> ();
+  if (m_mihLinkSap != 0)
     {
       m_mac->SetMihLinkUpCallback (MakeCallback (&WifiNetDevice::MihLinkUp, this));
       m_mac->SetMihLinkDownCallback (MakeCallback (&WifiNetDevice::MihLinkDown, this));
       m_mac->SetMihLinkDetectedCallback (MakeCallback (&WifiNetDevice::MihLinkDetected, this));
+      m_mac->SetMihRssiSampleCallback (MakeCallback (&mih::WifiMihLinkSap::NotifyServingRssi, m_mihLinkSap));
+      m_phy->SetMihLinkSap (m_mihLinkSap);
+      Ptr<StaWifiMac> staMac = DynamicCast<StaWifiMac> (m_mac);
+      if (staMac != 0)
+        {
+          staMac->SetMihLinkSap (m_mihLinkSap);
+        }
     }
   m_stationManager->SetupPhy (m_phy);
   m_stationManager->SetupMac (m_mac);
@@ -448,8 +457,7 @@ WifiNetDevice::MihLinkUp (mih::LinkIdentifier linkIdentifier, Address oldAR, Add
                           bool ipRenewal, mih::MobilityManagementSupport mobilitySupport)
 {
   //m_mihLinkUp(linkIdentifier, oldAR, newAR, ipRenewal, mobilitySupport);
-  Ptr<mih::WifiMihLinkSap> mihLinkSap= m_node->GetObject<mih::WifiMihLinkSap> ();
-  mihLinkSap->LinkUp (mihLinkSap->GetMihfId (), linkIdentifier, oldAR, newAR, ipRenewal, mobilitySupport);
+  m_mihLinkSap->LinkUp (m_mihLinkSap->GetMihfId (), linkIdentifier, oldAR, newAR, ipRenewal, mobilitySupport);
 }
 
 void
@@ -457,16 +465,14 @@ WifiNetDevice::MihLinkDown (mih::LinkIdentifier linkIdentifier, Address oldAR,
                           mih::LinkDownReason reason)
 {
   //m_mihLinkUp(linkIdentifier, oldAR, newAR, ipRenewal, mobilitySupport);
-  Ptr<mih::WifiMihLinkSap> mihLinkSap= m_node->GetObject<mih::WifiMihLinkSap> ();
-  mihLinkSap->LinkDown (mihLinkSap->GetMihfId (), linkIdentifier, oldAR, reason);
+  m_mihLinkSap->LinkDown (m_mihLinkSap->GetMihfId (), linkIdentifier, oldAR, reason);
 }
 
 bool
 WifiNetDevice::MihLinkDetected (mih::LinkDetectedInformation linkInfo)
 {
   //m_mihLinkUp(linkIdentifier, oldAR, newAR, ipRenewal, mobilitySupport);
-  Ptr<mih::WifiMihLinkSap> mihLinkSap= m_node->GetObject<mih::WifiMihLinkSap> ();
-  return mihLinkSap->LinkDetected (mihLinkSap->GetMihfId (), linkInfo);
+  return m_mihLinkSap->LinkDetected (m_mihLinkSap->GetMihfId (), linkInfo);
 }
 
 bool
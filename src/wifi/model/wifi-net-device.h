@@ -237,6 +237,7 @@ private:
   Ptr<Node> m_node; //!< the node
   Ptr<WifiPhy> m_phy; //!< the phy
   Ptr<WifiMac> m_mac; //!< the MAC
+  Ptr<mih::WifiMihLinkSap> m_mihLinkSap; //!< the MIH link SAP of the node, if any
   Ptr<WifiRemoteStationManager> m_stationManager; //!< the station manager
   Ptr<NetDeviceQueueInterface> m_queueInterface;   //!< NetDevice queue interface
   NetDevice::ReceiveCallback m_forwardUp; //!< forward up callback
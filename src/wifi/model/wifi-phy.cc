@@ -384,6 +384,7 @@ WifiPhy::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
   m_device = 0;
+  m_mihLinkSap = 0;
   m_mobility = 0;
   m_state = 0;
   m_wifiRadioEnergyModel = 0;
@@ -652,6 +653,12 @@ WifiPhy::GetDevice (void) const
   return m_device;
 }
 
+void
+WifiPhy::SetMihLinkSap (const Ptr<mih::WifiMihLinkSap> mihLinkSap)
+{
+  m_mihLinkSap = mihLinkSap;
+}
+
 void
 WifiPhy::SetMobility (const Ptr<MobilityModel> mobility)
 {
@@ -2529,6 +2536,31 @@ WifiPhy::StartReceivePacket (Ptr<Packet> packet,
     }
 }
 
+/**
+ * \param packet the received MPDU, MAC header first
+ * \param txVector the TXVECTOR the MPDU was received with
+ * \return true if the MPDU carries a management frame
+ *
+ * Only the frame control type bits are read so that data frames do not
+ * pay for a full WifiMacHeader deserialization. Management frames are
+ * never aggregated, so A-MPDU subframes and S-MPDUs are skipped without
+ * looking at their contents.
+ */
+static bool
+IsMgtFrame (Ptr<const Packet> packet, WifiTxVector txVector)
+{
+  if (txVector.IsAggregation ())
+    {
+      return false;
+    }
+  uint8_t frameControl;
+  if (packet->CopyData (&frameControl, 1) != 1)
+    {
+      return false;
+    }
+  return ((frameControl >> 2) & 0x3) == 0;
+}
+
 void
 WifiPhy::EndReceive (Ptr<Packet> packet, WifiPreamble preamble, MpduType mpdutype, Ptr<Event> event)
 {
@@ -2556,13 +2588,11 @@ WifiPhy::EndReceive (Ptr<Packet> packet, WifiPreamble preamble, MpduType mpdutyp
           aMpdu.type = mpdutype;
           aMpdu.mpduRefNumber = m_rxMpduReferenceNumber;
           NotifyMonitorSniffRx (packet, GetFrequency (), event->GetTxVector (), aMpdu, signalNoise);
-          Ptr<mih::WifiMihLinkSap> mihLinkSap= m_device->GetNode ()->GetObject<mih::WifiMihLinkSap> ();
-          if (mihLinkSap != 0)
-            { 
+          if (m_mihLinkSap != 0 && IsMgtFrame (packet, event->GetTxVector ()))
+            {
               SignalStrengthTag tag;
-              packet->RemovePacketTag (tag);
-              tag.Set (signalNoise.signal); 
-              packet->AddPacketTag (tag);
+              tag.Set (signalNoise.signal);
+              packet->ReplacePacketTag (tag);
             }
           m_state->SwitchFromRxEndOk (packet, snrPer.snr, event->GetTxVector ());
         }
@@ -41,6 +41,9 @@ class WifiPhyStateHelper;
 class FrameCaptureModel;
 class WifiRadioEnergyModel;
 class UniformRandomVariable;
+namespace mih {
+class WifiMihLinkSap;
+}
 
 /// SignalNoiseDbm structure
 struct SignalNoiseDbm
@@ -1292,6 +1295,14 @@ public:
    * \return the device this PHY is associated with
    */
   Ptr<NetDevice> GetDevice (void) const;
+  /**
+   * Sets the MIH link SAP for which received management frames are
+   * tagged with their signal strength. Resolved once by the device
+   * instead of being looked up on the node for every received frame.
+   *
+   * \param mihLinkSap the MIH link SAP of this PHY's device, or 0
+   */
+  void SetMihLinkSap (const Ptr<mih::WifiMihLinkSap> mihLinkSap);
   /**
    * \brief assign a mobility model to this device
    *
@@ -1785,6 +1796,7 @@ private:
   double m_totalAmpduNumSymbols; //!< Number of symbols previously transmitted for the MPDUs in an A-MPDU, used for the computation of the number of symbols needed for the last MPDU in the A-MPDU
 
   Ptr<NetDevice>     m_device;   //!< Pointer to the device
+  Ptr<mih::WifiMihLinkSap> m_mihLinkSap; //!< MIH link SAP, if any
   Ptr<MobilityModel> m_mobility; //!< Pointer to the mobility model
 
   Ptr<Event> m_currentEvent; //!< Hold the current event
@@ -26,6 +26,7 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/trace-source-accessor.h"
 #include "burst-profile-manager.h"
 #include "ss-record.h"
 #include "ss-manager.h"
@@ -42,7 +43,11 @@ TypeId BSLinkManager::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::BSLinkManager")
     .SetParent<Object> ()
-    .SetGroupName("Wimax");
+    .SetGroupName("Wimax")
+    .AddTraceSource ("SsRegistered",
+                     "The initial ranging of a SS succeeded for the first time.",
+                     MakeTraceSourceAccessor (&BSLinkManager::m_ssRegisteredTrace),
+                     "ns3::BSLinkManager::SsRegisteredTracedCallback");
   return tid;
 }
 
@@ -291,7 +296,12 @@ BSLinkManager::AcceptRanging (Cid cid, RngRsp *rngrsp, SSRecord *ssRecord)
   /*Shall not be set until the SS receives the RNG-RSP, as it may be lost etc. may be state field
    is also added to SSRecord which then set to SS_STATE_REGISTERED once confirmed that SS has received
    this RNG-RSP, but how to determine that, may be as a data packet is received by the SS*/
+  bool registered = ssRecord->GetRangingStatus () == WimaxNetDevice::RANGING_STATUS_SUCCESS;
   ssRecord->SetRangingStatus (WimaxNetDevice::RANGING_STATUS_SUCCESS);
+  if (!registered)
+    {
+      m_ssRegisteredTrace (ssRecord->GetMacAddress ());
+    }
 
   ssRecord->DisablePollForRanging ();
 }
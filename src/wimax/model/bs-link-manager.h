@@ -27,6 +27,7 @@
 #include "wimax-net-device.h"
 #include "bs-net-device.h"
 #include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
 #include "cid.h"
 #include "mac-messages.h"
 
@@ -71,6 +72,13 @@ public:
    * \param uiuc the ranging
    */
   void VerifyInvitedRanging (Cid cid, uint8_t uiuc);
+
+  /**
+   * TracedCallback signature for SS registrations.
+   *
+   * \param [in] ssAddress The MAC address of the SS.
+   */
+  typedef void (* SsRegisteredTracedCallback)(Mac48Address ssAddress);
 private:
   /// copy constructor (disabled)
   BSLinkManager (const BSLinkManager &);
@@ -166,6 +174,14 @@ private:
   uint32_t m_signalQuality; ///< signal quality
   uint8_t m_signalQualityThreshold; ///< signal quality threshold
   int tries; ///< variable to test multiple RNG-REQ by the SS for example undecodable at BS or lost RNG-RSP
+
+  /**
+   * The trace source fired when the initial ranging of a SS succeeds
+   * for the first time.
+   *
+   * \see class CallBackTraceSource
+   */
+  TracedCallback<Mac48Address> m_ssRegisteredTrace;
 };
 
 } // namespace ns3
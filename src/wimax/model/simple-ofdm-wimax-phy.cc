@@ -127,7 +127,12 @@ TypeId SimpleOfdmWimaxPhy::GetTypeId (void)
     .AddTraceSource ("PhyRxDrop",
                      "Trace source indicating a packet has been dropped by the device during reception",
                      MakeTraceSourceAccessor (&SimpleOfdmWimaxPhy::m_phyRxDropTrace),
-                     "ns3::PacketBurst::TracedCallback");
+                     "ns3::PacketBurst::TracedCallback")
+
+    .AddTraceSource ("RxCinr",
+                     "Trace source indicating the CINR (dB) of a downlink burst the device starts receiving",
+                     MakeTraceSourceAccessor (&SimpleOfdmWimaxPhy::m_rxCinrTrace),
+                     "ns3::SimpleOfdmWimaxPhy::CinrTracedCallback");
   return tid;
 }
 
@@ -408,6 +413,10 @@ SimpleOfdmWimaxPhy::StartReceive (uint32_t burstSize,
         {
           if (isFirstBlock)
             {
+              if (direction == WimaxNetDevice::DIRECTION_DOWNLINK)
+                {
+                  m_rxCinrTrace (SNR);
+                }
               NotifyRxBegin (burst);
               m_receivedFecBlocks->clear ();
               m_nrRecivedFecBlocks=0;
@@ -130,6 +130,13 @@ public:
                      double rxPower,
                      Ptr<PacketBurst> burst);
 
+  /**
+   * TracedCallback signature for the CINR of received bursts.
+   *
+   * \param [in] cinr The CINR of the burst, in dB.
+   */
+  typedef void (* CinrTracedCallback)(double cinr);
+
   /**
    * \return the bandwidth
    */
@@ -527,6 +534,15 @@ private:
    */
   TracedCallback<Ptr<PacketBurst > > m_phyRxDropTrace;
 
+  /**
+   * The trace source fired when the phy layer starts receiving a
+   * downlink burst, with its CINR. There being no interference model,
+   * the CINR is the SNR of the burst.
+   *
+   * \see class CallBackTraceSource
+   */
+  TracedCallback<double> m_rxCinrTrace;
+
   SNRToBlockErrorRateManager * m_snrToBlockErrorRateManager; ///< SNR to block error rate manager
 
   /// Provides uniform random variables.
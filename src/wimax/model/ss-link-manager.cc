@@ -135,13 +135,29 @@ SSLinkManager::StartScanning (
 {
   // temp parameter "type" just to check on expiry of which event the function was called
 
+  if (m_ss->GetState () == SubscriberStationNetDevice::SS_STATE_STOPPED)
+    {
+      return;
+    }
+
+  // the network entry starts over, the other timers that would restart it are obsolete
+  m_ss->CancelTimers ();
+  Simulator::Cancel (m_waitForRngRspEvent);
+  Simulator::Cancel (m_dlMapSyncTimeoutEvent);
+
   if (deleteParameters)
     {
       DeleteUplinkParameters ();
     }
 
-  NS_ASSERT_MSG (!m_ss->IsRegistered (),
-                 "Subscriber Station: Error while scanning: Already registered with a BS");
+  if (m_ss->IsRegistered ())
+    {
+      // the link with the BS was lost (DL-MAP, UL-MAP, DCD or UCD missing):
+      // rescan starting from the channel it was using, the BS keeps the
+      // management CIDs of the SS for the next initial ranging
+      NS_LOG_INFO ("SS: link with the BS lost, event " << type);
+      m_ss->SetState (SubscriberStationNetDevice::SS_STATE_IDLE);
+    }
 
   if (m_ss->GetState () != SubscriberStationNetDevice::SS_STATE_IDLE)
     {
@@ -203,6 +203,11 @@ SubscriberStationNetDevice::GetTypeId (void)
                      "layer.",
                      MakeTraceSourceAccessor (&SubscriberStationNetDevice::m_ssRxDropTrace),
                      "ns3::Packet::TracedCallback")
+
+    .AddTraceSource ("StateChange",
+                     "The SS changed state, with the ID of the BS it was last synchronized with.",
+                     MakeTraceSourceAccessor (&SubscriberStationNetDevice::m_stateChangeTrace),
+                     "ns3::SubscriberStationNetDevice::StateChangeTracedCallback")
     ;
   return tid;
 }
@@ -572,6 +577,17 @@ SubscriberStationNetDevice::Stop (void)
   SetState (SS_STATE_STOPPED);
 }
 
+void
+SubscriberStationNetDevice::SetState (uint8_t state)
+{
+  uint8_t oldState = GetState ();
+  WimaxNetDevice::SetState (state);
+  if (state != oldState)
+    {
+      m_stateChangeTrace (m_baseStationId, oldState, state);
+    }
+}
+
 void
 SubscriberStationNetDevice::AddServiceFlow (ServiceFlow sf)
 {
@@ -1148,9 +1164,11 @@ SubscriberStationNetDevice::ProcessUlMap (const UlMap &ulmap)
                                    ulMapIe.GetUiuc (),
                                    ulMapIe.GetDuration ());
             }
-          else // regular allocation/grant for data, for UGS flows or in response of requests for non-UGS flows
+          else if (IsRegistered ()) // regular allocation/grant for data, for UGS flows or in response of requests for non-UGS flows
 
             {
+              // grants the BS still allocates to the basic CID after the SS lost
+              // it are ignored until the SS registers again
 
               Ptr<WimaxConnection> connection = NULL;
               Simulator::Schedule (timeToAllocation,
@@ -1283,4 +1301,14 @@ SubscriberStationNetDevice::SetTimer (EventId eventId, EventId &event)
   event = eventId;
 }
 
+void
+SubscriberStationNetDevice::CancelTimers (void)
+{
+  Simulator::Cancel (m_lostDlMapEvent);
+  Simulator::Cancel (m_lostUlMapEvent);
+  Simulator::Cancel (m_dcdWaitTimeoutEvent);
+  Simulator::Cancel (m_ucdWaitTimeoutEvent);
+  Simulator::Cancel (m_rangOppWaitTimeoutEvent);
+}
+
 } // namespace ns`
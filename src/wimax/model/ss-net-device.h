@@ -302,6 +302,11 @@ public:
    * \param event EventId is set to first argument if not in stopped state
    */
   void SetTimer (EventId eventId, EventId &event);
+  /**
+   * \brief Cancel the timers restarting the scanning: lost DL-MAP and
+   * UL-MAP, DCD, UCD and ranging opportunity wait timeouts
+   */
+  void CancelTimers (void);
   /**
    * \returns true if the SS is registered to a BS, false otherwise
    */
@@ -341,6 +346,21 @@ public:
    * \param sfm service flow manager to be used
    */
   void SetServiceFlowManager (Ptr<SsServiceFlowManager> sfm);
+  /**
+   * \brief Set the device state and fire the StateChange trace source
+   * \param state the new state
+   */
+  virtual void SetState (uint8_t state);
+
+  /**
+   * TracedCallback signature for SS state changes.
+   *
+   * \param [in] baseStationId The ID of the last BS a DL-MAP was received from.
+   * \param [in] oldState The previous state.
+   * \param [in] newState The new state.
+   */
+  typedef void (* StateChangeTracedCallback)
+    (Mac48Address baseStationId, uint8_t oldState, uint8_t newState);
 
 private:
   /**
@@ -483,6 +503,15 @@ private:
    * \see class CallBackTraceSource
    */
   TracedCallback<Ptr<const Packet> > m_ssRxDropTrace;
+
+  /**
+   * The trace source fired when the SS changes state, e.g. once it is
+   * synchronized with a BS, registered with it or when it loses it and
+   * starts scanning again.
+   *
+   * \see class CallBackTraceSource
+   */
+  TracedCallback<Mac48Address, uint8_t, uint8_t> m_stateChangeTrace;
 };
 
 } // namespace ns3
@@ -164,7 +164,7 @@ public:
    * Set the device state
    * \param state the state
    */
-  void SetState (uint8_t state);
+  virtual void SetState (uint8_t state);
   /**
    * Get the device state
    * \returns the state
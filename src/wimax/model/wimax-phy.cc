@@ -135,6 +135,7 @@ WimaxPhy::StartScanning (uint64_t frequency, Time timeout, Callback<void, bool,
 
   m_state = PHY_STATE_SCANNING;
   m_scanningFrequency = frequency;
+  Simulator::Cancel (m_dlChnlSrchTimeoutEvent);
   m_dlChnlSrchTimeoutEvent = Simulator::Schedule (timeout, &WimaxPhy::EndScanning, this);
   m_scanningCallback = callback;
 }